@@ -126,6 +126,10 @@ public:
     {
         return "300000000";
     };
+    dev::eth::LocalisedLogEntries getLogs(dev::eth::LogFilter const&) override
+    {
+        return dev::eth::LocalisedLogEntries();
+    }
 
     dev::bytes getCode(dev::Address) override { return bytes(); }
 
@@ -201,6 +205,7 @@ public:
         dev::eth::TransactionReceipt reciept;
         return std::make_pair(res, reciept);
     }
+    Json::Value conflictPredictions() override { return Json::Value(); }
 
 private:
     std::shared_ptr<ExecutiveContext> m_executiveContext;
@@ -0,0 +1,312 @@
+/**
+ * @CopyRight:
+ * FISCO-BCOS is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * FISCO-BCOS is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with FISCO-BCOS.  If not, see <http://www.gnu.org/licenses/>
+ * (c) 2016-2018 fisco-dev contributors.
+ *
+ * @brief : the P2PInterface of the nodes of one process, the messages are encoded and decoded as
+ * on the wire and handled by the dispatcher of the receiver
+ * @file: LoopbackService.h
+ */
+#pragma once
+#include <libdevcore/Guards.h>
+#include <libdevcore/ThreadPool.h>
+#include <libethcore/Protocol.h>
+#include <libnetwork/SessionFace.h>
+#include <libp2p/P2PInterface.h>
+#include <libp2p/P2PMessageFactory.h>
+#include <libp2p/P2PSession.h>
+#include <map>
+#include <memory>
+
+class LoopbackService;
+
+/// the endpoint of a peer, nothing is sent through it
+class LoopbackSession : public dev::network::SessionFace
+{
+public:
+    explicit LoopbackSession(dev::network::NodeIPEndpoint const& _endpoint) : m_endpoint(_endpoint)
+    {}
+    void start() override {}
+    void disconnect(dev::network::DisconnectReason) override {}
+    void asyncSendMessage(dev::network::Message::Ptr,
+        dev::network::Options = dev::network::Options(),
+        CallbackFunc = CallbackFunc()) override
+    {}
+    bool asyncSendMessages(
+        std::vector<dev::network::Message::Ptr> const&, dev::network::Options) override
+    {
+        return true;
+    }
+    std::shared_ptr<dev::network::SocketFace> socket() override { return nullptr; }
+    void setMessageHandler(std::function<void(dev::network::NetworkException,
+            std::shared_ptr<dev::network::SessionFace>, dev::network::Message::Ptr)>) override
+    {}
+    dev::network::NodeIPEndpoint nodeIPEndpoint() const override { return m_endpoint; }
+    bool actived() const override { return true; }
+    bool congested(dev::network::PacketPriority) const override { return false; }
+    dev::network::WriteQueueStats writeQueueStats() const override
+    {
+        return dev::network::WriteQueueStats();
+    }
+
+private:
+    dev::network::NodeIPEndpoint m_endpoint;
+};
+
+/// the services of the nodes of the process
+class LoopbackNetwork
+{
+public:
+    typedef std::shared_ptr<LoopbackNetwork> Ptr;
+
+    void addNode(std::shared_ptr<LoopbackService> _service);
+    std::shared_ptr<LoopbackService> node(dev::p2p::NodeID const& _nodeID) const
+    {
+        dev::ReadGuard l(x_nodes);
+        auto it = m_nodes.find(_nodeID);
+        return it == m_nodes.end() ? nullptr : it->second;
+    }
+    std::map<dev::p2p::NodeID, std::shared_ptr<LoopbackService>> nodes() const
+    {
+        dev::ReadGuard l(x_nodes);
+        return m_nodes;
+    }
+
+private:
+    std::map<dev::p2p::NodeID, std::shared_ptr<LoopbackService>> m_nodes;
+    mutable dev::SharedMutex x_nodes;
+};
+
+class LoopbackService : public dev::p2p::P2PInterface
+{
+public:
+    typedef std::shared_ptr<LoopbackService> Ptr;
+
+    LoopbackService(LoopbackNetwork::Ptr _network, dev::p2p::NodeID const& _nodeID,
+        uint16_t _port, size_t _dispatchThreads)
+      : m_network(_network),
+        m_nodeID(_nodeID),
+        m_endpoint(boost::asio::ip::address::from_string("127.0.0.1"), _port, _port),
+        m_messageFactory(std::make_shared<dev::p2p::P2PMessageFactoryRC2>()),
+        m_dispatcher(std::make_shared<dev::ThreadPool>(
+            "loopback-" + std::to_string(_port), _dispatchThreads))
+    {}
+    ~LoopbackService() { m_dispatcher->stop(); }
+
+    dev::p2p::NodeID id() const override { return m_nodeID; }
+    dev::network::NodeIPEndpoint const& endpoint() const { return m_endpoint; }
+
+    /// the requests waiting for a response are not used by the ledgers
+    std::shared_ptr<dev::p2p::P2PMessage> sendMessageByNodeID(
+        dev::p2p::NodeID _nodeID, std::shared_ptr<dev::p2p::P2PMessage> _message) override
+    {
+        asyncSendMessageByNodeID(_nodeID, _message, nullptr);
+        return nullptr;
+    }
+
+    void asyncSendMessageByNodeID(dev::p2p::NodeID _nodeID,
+        std::shared_ptr<dev::p2p::P2PMessage> _message, CallbackFuncWithSession,
+        dev::network::Options = dev::network::Options()) override
+    {
+        auto peer = m_network->node(_nodeID);
+        if (!peer || _nodeID == m_nodeID)
+        {
+            return;
+        }
+        // the receiver gets its own copy as from the socket
+        dev::bytes buffer;
+        _message->encode(buffer);
+        peer->onMessage(m_nodeID, buffer);
+    }
+
+    std::shared_ptr<dev::p2p::P2PMessage> sendMessageByTopic(
+        std::string, std::shared_ptr<dev::p2p::P2PMessage>) override
+    {
+        return nullptr;
+    }
+    void asyncSendMessageByTopic(std::string, std::shared_ptr<dev::p2p::P2PMessage>,
+        CallbackFuncWithSession, dev::network::Options) override
+    {}
+    void asyncMulticastMessageByTopic(std::string, std::shared_ptr<dev::p2p::P2PMessage>) override
+    {}
+
+    void asyncMulticastMessageByNodeIDList(
+        dev::p2p::NodeIDs _nodeIDs, std::shared_ptr<dev::p2p::P2PMessage> _message) override
+    {
+        for (auto const& nodeID : _nodeIDs)
+        {
+            asyncSendMessageByNodeID(nodeID, _message, nullptr);
+        }
+    }
+
+    void asyncBroadcastMessage(
+        std::shared_ptr<dev::p2p::P2PMessage> _message, dev::network::Options) override
+    {
+        for (auto const& node : m_network->nodes())
+        {
+            asyncSendMessageByNodeID(node.first, _message, nullptr);
+        }
+    }
+
+    void registerHandlerByProtoclID(
+        dev::PROTOCOL_ID _protocolID, CallbackFuncWithSession _handler) override
+    {
+        dev::WriteGuard l(x_handlers);
+        m_handlers[_protocolID] = _handler;
+    }
+    void registerHandlerByTopic(std::string, CallbackFuncWithSession) override {}
+
+    dev::p2p::P2PSessionInfos sessionInfos() override
+    {
+        dev::p2p::P2PSessionInfos infos;
+        for (auto const& node : m_network->nodes())
+        {
+            if (node.first != m_nodeID)
+            {
+                infos.push_back(dev::p2p::P2PSessionInfo(
+                    session(node.first)->nodeInfo(), node.second->endpoint(), {}));
+            }
+        }
+        return infos;
+    }
+
+    /// the peers in the node list of the group, as Service does
+    dev::p2p::P2PSessionInfos sessionInfosByProtocolID(
+        dev::PROTOCOL_ID _protocolID) const override
+    {
+        auto groupID = dev::eth::getGroupAndProtocol(_protocolID).first;
+        dev::p2p::P2PSessionInfos infos;
+        dev::ReadGuard l(x_nodeList);
+        auto it = m_groupID2NodeList.find(groupID);
+        if (it == m_groupID2NodeList.end())
+        {
+            return infos;
+        }
+        for (auto const& nodeID : it->second)
+        {
+            auto peer = m_network->node(nodeID);
+            if (nodeID == m_nodeID || !peer)
+            {
+                continue;
+            }
+            dev::network::NodeInfo nodeInfo;
+            nodeInfo.nodeID = nodeID;
+            infos.push_back(dev::p2p::P2PSessionInfo(nodeInfo, peer->endpoint(), {}));
+        }
+        return infos;
+    }
+
+    bool isConnected(dev::p2p::NodeID const& _nodeID) const override
+    {
+        return m_network->node(_nodeID) != nullptr;
+    }
+    bool isCongested(dev::p2p::NodeID const&, dev::network::PacketPriority) const override
+    {
+        return false;
+    }
+
+    std::vector<std::string> topics() override { return std::vector<std::string>(); }
+    void setTopics(std::shared_ptr<std::vector<std::string>>) override {}
+
+    dev::h512s getNodeListByGroupID(dev::GROUP_ID _groupID) override
+    {
+        dev::ReadGuard l(x_nodeList);
+        auto it = m_groupID2NodeList.find(_groupID);
+        return it == m_groupID2NodeList.end() ? dev::h512s() : it->second;
+    }
+    void setGroupID2NodeList(std::map<dev::GROUP_ID, dev::h512s> _groupID2NodeList) override
+    {
+        dev::WriteGuard l(x_nodeList);
+        m_groupID2NodeList = _groupID2NodeList;
+    }
+    void setNodeListByGroupID(dev::GROUP_ID _groupID, dev::h512s _nodeList) override
+    {
+        dev::WriteGuard l(x_nodeList);
+        m_groupID2NodeList[_groupID] = _nodeList;
+    }
+
+    std::shared_ptr<dev::p2p::P2PMessageFactory> p2pMessageFactory() override
+    {
+        return m_messageFactory;
+    }
+
+    /// decode the message of the peer and hand it to the handler of its protocol
+    void onMessage(dev::p2p::NodeID const& _from, dev::bytes const& _buffer)
+    {
+        auto message =
+            std::dynamic_pointer_cast<dev::p2p::P2PMessage>(m_messageFactory->buildMessage());
+        if (message->decode(_buffer.data(), _buffer.size()) <= 0)
+        {
+            return;
+        }
+        CallbackFuncWithSession handler;
+        {
+            dev::ReadGuard l(x_handlers);
+            auto it = m_handlers.find(message->protocolID());
+            if (it == m_handlers.end())
+            {
+                return;
+            }
+            handler = it->second;
+        }
+        auto p2pSession = session(_from);
+        m_dispatcher->enqueue([handler, p2pSession, message]() {
+            handler(dev::network::NetworkException(), p2pSession, message);
+        });
+    }
+
+    void addPeer(dev::p2p::NodeID const& _nodeID, dev::network::NodeIPEndpoint const& _endpoint)
+    {
+        auto p2pSession = std::make_shared<dev::p2p::P2PSession>();
+        dev::network::NodeInfo nodeInfo;
+        nodeInfo.nodeID = _nodeID;
+        p2pSession->setNodeInfo(nodeInfo);
+        p2pSession->setSession(std::make_shared<LoopbackSession>(_endpoint));
+        dev::WriteGuard l(x_sessions);
+        m_sessions[_nodeID] = p2pSession;
+    }
+
+private:
+    dev::p2p::P2PSession::Ptr session(dev::p2p::NodeID const& _nodeID)
+    {
+        dev::ReadGuard l(x_sessions);
+        auto it = m_sessions.find(_nodeID);
+        return it == m_sessions.end() ? nullptr : it->second;
+    }
+
+    LoopbackNetwork::Ptr m_network;
+    dev::p2p::NodeID m_nodeID;
+    dev::network::NodeIPEndpoint m_endpoint;
+    std::shared_ptr<dev::p2p::P2PMessageFactory> m_messageFactory;
+    dev::ThreadPool::Ptr m_dispatcher;
+
+    std::map<dev::PROTOCOL_ID, CallbackFuncWithSession> m_handlers;
+    mutable dev::SharedMutex x_handlers;
+    std::map<dev::GROUP_ID, dev::h512s> m_groupID2NodeList;
+    mutable dev::SharedMutex x_nodeList;
+    std::map<dev::p2p::NodeID, dev::p2p::P2PSession::Ptr> m_sessions;
+    mutable dev::SharedMutex x_sessions;
+};
+
+/// every node is connected to the others
+inline void LoopbackNetwork::addNode(LoopbackService::Ptr _service)
+{
+    dev::WriteGuard l(x_nodes);
+    for (auto const& node : m_nodes)
+    {
+        node.second->addPeer(_service->id(), _service->endpoint());
+        _service->addPeer(node.first, node.second->endpoint());
+    }
+    m_nodes[_service->id()] = _service;
+}
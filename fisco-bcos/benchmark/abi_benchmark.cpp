@@ -0,0 +1,139 @@
+/**
+ * @CopyRight:
+ * FISCO-BCOS is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * FISCO-BCOS is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with FISCO-BCOS.  If not, see <http://www.gnu.org/licenses/>
+ * (c) 2016-2018 fisco-dev contributors.
+ *
+ * @brief : throughput of the ABI codec and of the DagTransfer precompiled calls
+ * @file: abi_benchmark.cpp
+ */
+#include <libblockverifier/ExecutiveContextFactory.h>
+#include <libethcore/ABI.h>
+#include <libprecompiled/extension/DagTransferPrecompiled.h>
+#include <libstorage/MemoryTableFactoryFactory2.h>
+#include <libstoragestate/StorageStateFactory.h>
+#include <boost/lexical_cast.hpp>
+#include <chrono>
+#include <iomanip>
+#include <iostream>
+
+using namespace std;
+using namespace dev;
+using namespace dev::blockverifier;
+using namespace dev::storage;
+using namespace dev::storagestate;
+using namespace dev::precompiled;
+
+/// the state starts empty, the rows written by the calls stay in the memory tables
+class EmptyStorage : public Storage
+{
+public:
+    Entries::Ptr select(h256, int64_t, TableInfo::Ptr, const std::string&, Condition::Ptr) override
+    {
+        return std::make_shared<Entries>();
+    }
+    size_t commit(h256, int64_t, const std::vector<TableData::Ptr>& _datas) override
+    {
+        return _datas.size();
+    }
+    bool onlyDirty() override { return false; }
+};
+
+void report(std::string const& _name, size_t _calls, std::chrono::duration<double> const& _elapsed)
+{
+    std::cout << std::setw(16) << std::left << _name << std::setiosflags(std::ios::fixed)
+              << std::setprecision(0) << std::setw(12) << std::right << _calls / _elapsed.count()
+              << " calls/s" << std::endl;
+}
+
+int main(int argc, char* argv[])
+{
+    if (argc > 1 && std::string(argv[1]) == "-h")
+    {
+        std::cout << "Usage: " << argv[0] << " [users, 1000] [transfers, 100000]" << std::endl;
+        return 0;
+    }
+    size_t users = argc > 1 ? boost::lexical_cast<size_t>(argv[1]) : 1000;
+    size_t transfers = argc > 2 ? boost::lexical_cast<size_t>(argv[2]) : 100000;
+
+    dev::eth::ContractABI abi;
+    std::vector<bytes> params;
+    for (size_t i = 0; i < transfers; ++i)
+    {
+        params.push_back(abi.abiIn("userTransfer(string,string,uint256)",
+            "user" + toString(i % users), "user" + toString((i + 1) % users), u256(1)));
+    }
+    std::cout << "users: " << users << ", transfers: " << transfers << std::endl;
+
+    // the codec alone, the arguments of a transfer decoded and the result encoded
+    size_t check = 0;
+    auto start = std::chrono::steady_clock::now();
+    for (auto const& param : params)
+    {
+        std::string from, to;
+        u256 amount;
+        abi.abiOut(ref(param).cropped(4), from, to, amount);
+        check += abi.abiIn("", u256(0), amount).size() + from.size() + to.size();
+    }
+    report("codec(string)", transfers, std::chrono::steady_clock::now() - start);
+    start = std::chrono::steady_clock::now();
+    for (auto const& param : params)
+    {
+        bytesConstRef from, to;
+        u256 amount;
+        abi.abiOut(ref(param).cropped(4), from, to, amount);
+        check -= abi.abiIn("", u256(0), amount).size() + from.size() + to.size();
+    }
+    report("codec(view)", transfers, std::chrono::steady_clock::now() - start);
+    if (check != 0)
+    {
+        std::cout << "ERROR: the views differ from the strings" << std::endl;
+        return 1;
+    }
+
+    BlockInfo blockInfo;
+    blockInfo.hash = h256(0);
+    blockInfo.number = 0;
+    auto context = std::make_shared<ExecutiveContext>();
+    ExecutiveContextFactory factory;
+    factory.setStateStorage(std::make_shared<EmptyStorage>());
+    factory.setStateFactory(std::make_shared<StorageStateFactory>(h256(0)));
+    factory.setTableFactoryFactory(std::make_shared<MemoryTableFactoryFactory2>());
+    factory.initExecutiveContext(blockInfo, h256(0), context);
+    auto dagTransfer = std::make_shared<DagTransferPrecompiled>();
+
+    for (size_t i = 0; i < users; ++i)
+    {
+        auto param = abi.abiIn("userAdd(string,uint256)", "user" + toString(i), u256(transfers));
+        dagTransfer->call(context, ref(param));
+    }
+    start = std::chrono::steady_clock::now();
+    for (auto const& param : params)
+    {
+        dagTransfer->getParallelTag(ref(param));
+    }
+    report("parallel tags", transfers, std::chrono::steady_clock::now() - start);
+    start = std::chrono::steady_clock::now();
+    for (auto const& param : params)
+    {
+        auto out = dagTransfer->call(context, ref(param));
+        u256 ret;
+        if (!abi.abiOut(ref(out), ret) || ret != 0)
+        {
+            std::cout << "ERROR: transfer failed, ret: " << ret << std::endl;
+            return 1;
+        }
+    }
+    report("userTransfer", transfers, std::chrono::steady_clock::now() - start);
+    return 0;
+}
@@ -0,0 +1,89 @@
+/**
+ * @CopyRight:
+ * FISCO-BCOS is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * FISCO-BCOS is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with FISCO-BCOS.  If not, see <http://www.gnu.org/licenses/>
+ * (c) 2016-2018 fisco-dev contributors.
+ *
+ * @brief : dbHash of the entries of a table, the whole table and the chunks
+ * @file: dbhash_benchmark.cpp
+ */
+#include <libconfig/GlobalConfigure.h>
+#include <libstorage/MemoryTable2.h>
+#include <tbb/task_arena.h>
+#include <boost/format.hpp>
+#include <boost/lexical_cast.hpp>
+#include <chrono>
+#include <iomanip>
+#include <iostream>
+
+using namespace std;
+using namespace dev;
+using namespace dev::storage;
+
+h256 run(std::string const& _name, tbb::concurrent_vector<Entry::Ptr> const& _entries,
+    size_t _rounds)
+{
+    h256 hash;
+    auto start = std::chrono::steady_clock::now();
+    for (size_t round = 0; round < _rounds; ++round)
+    {
+        hash = MemoryTable2::hashEntries(_entries);
+    }
+    std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+    std::cout << std::setw(10) << std::left << _name << std::setiosflags(std::ios::fixed)
+              << std::setprecision(2) << std::setw(10) << std::right
+              << elapsed.count() * 1000 / _rounds << " ms/table " << std::setprecision(0)
+              << std::setw(12) << _entries.size() * _rounds / elapsed.count() << " entries/s"
+              << std::endl;
+    return hash;
+}
+
+int main(int argc, char* argv[])
+{
+    if (argc > 1 && std::string(argv[1]) == "-h")
+    {
+        std::cout << "Usage: " << argv[0] << " [entries, 100000] [value size, 64] [rounds, 20]"
+                  << std::endl;
+        return 0;
+    }
+    size_t count = argc > 1 ? boost::lexical_cast<size_t>(argv[1]) : 100000;
+    size_t valueSize = argc > 2 ? boost::lexical_cast<size_t>(argv[2]) : 64;
+    size_t rounds = argc > 3 ? boost::lexical_cast<size_t>(argv[3]) : 20;
+
+    tbb::concurrent_vector<Entry::Ptr> entries;
+    for (size_t i = 0; i < count; ++i)
+    {
+        auto entry = std::make_shared<Entry>();
+        entry->setField("key", (boost::format("[%08d]") % i).str());
+        entry->setField("value", std::string(valueSize, 'a' + i % 26));
+        entries.push_back(entry);
+    }
+    std::cout << "entries: " << count << ", value size: " << valueSize << ", rounds: " << rounds
+              << ", chunk: " << MemoryTable2::c_hashChunkEntries << std::endl;
+
+    g_BCOSConfig.setSupportedVersion("2.0.0", RC3_VERSION);
+    run("whole", entries, rounds);
+    g_BCOSConfig.setSupportedVersion("2.1.0", V2_1_0);
+    h256 chunked = run("chunked", entries, rounds);
+
+    // the chunked hash must not depend on the number of the threads
+    h256 serial;
+    tbb::task_arena arena(1);
+    arena.execute([&]() { serial = run("chunked/1", entries, rounds); });
+    if (serial != chunked)
+    {
+        std::cout << "ERROR: the chunked hash depends on the number of the threads" << std::endl;
+        return 1;
+    }
+    return 0;
+}
@@ -0,0 +1,541 @@
+/**
+ * @CopyRight:
+ * FISCO-BCOS is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * FISCO-BCOS is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with FISCO-BCOS.  If not, see <http://www.gnu.org/licenses/>
+ * (c) 2016-2018 fisco-dev contributors.
+ *
+ * @brief : end-to-end throughput of the ledgers of several nodes in one process, from the txpool
+ * to the storage of every node, the result is printed as one line of json
+ * @file: e2e_benchmark.cpp
+ */
+#include "LoopbackService.h"
+#include <json/json.h>
+#include <libconfig/GlobalConfigure.h>
+#include <libdevcore/easylog.h>
+#include <libethcore/ABI.h>
+#include <libethcore/Exceptions.h>
+#include <libinitializer/Initializer.h>
+#include <libledger/Ledger.h>
+#include <sys/resource.h>
+#include <tbb/parallel_for.h>
+#include <boost/filesystem.hpp>
+#include <boost/program_options.hpp>
+#include <atomic>
+#include <chrono>
+#include <fstream>
+#include <iostream>
+#include <thread>
+
+using namespace std;
+using namespace dev;
+using namespace dev::eth;
+using namespace dev::ledger;
+using namespace dev::initializer;
+INITIALIZE_EASYLOGGINGPP
+
+namespace
+{
+struct BenchOptions
+{
+    size_t nodes;
+    size_t txs;
+    size_t users;
+    size_t threads;
+    size_t dispatchThreads;
+    size_t maxTransNum;
+    size_t timeout;
+    std::string workload;
+    std::string consensus;
+    std::string dir;
+    bool parallel;
+};
+
+/// a counter at slot 0 increased by every call, hand assembled as there is no compiler here:
+/// init: PUSH1 0x0a DUP1 PUSH1 0x0b PUSH1 0 CODECOPY PUSH1 0 RETURN
+/// runtime: PUSH1 0 SLOAD PUSH1 1 ADD PUSH1 0 SSTORE STOP
+const std::string c_counterCode = "600a80600b6000396000f360005460010160005500";
+const std::string c_table = "bench_t";
+const Address c_dagTransfer = Address(0x5002);
+const Address c_tableFactory = Address(0x1001);
+const Address c_crud = Address(0x1002);
+
+/// the blocks of the timed run
+struct BlockStat
+{
+    int64_t sealTime = 0;
+    int64_t firstCommit = 0;
+    int64_t lastCommit = 0;
+    size_t commits = 0;
+};
+
+int64_t cpuTimeUs()
+{
+    struct rusage usage;
+    getrusage(RUSAGE_SELF, &usage);
+    return (usage.ru_utime.tv_sec + usage.ru_stime.tv_sec) * 1000000 + usage.ru_utime.tv_usec +
+           usage.ru_stime.tv_usec;
+}
+
+Json::Value percentiles(std::vector<double> _samples)
+{
+    Json::Value ret(Json::objectValue);
+    ret["count"] = Json::UInt64(_samples.size());
+    if (_samples.empty())
+    {
+        return ret;
+    }
+    std::sort(_samples.begin(), _samples.end());
+    auto at = [&_samples](double _p) {
+        return _samples[std::min(_samples.size() - 1, size_t(_p * _samples.size()))];
+    };
+    ret["p50"] = at(0.5);
+    ret["p90"] = at(0.9);
+    ret["p99"] = at(0.99);
+    ret["max"] = _samples.back();
+    return ret;
+}
+
+void writeConfig(BenchOptions const& _options, std::string const& _nodeDir, h512s const& _sealers,
+    uint64_t _timestamp)
+{
+    boost::filesystem::create_directories(_nodeDir + "/conf");
+    std::ofstream genesis(_nodeDir + "/conf/group.1.genesis");
+    genesis << "[consensus]\n"
+            << "    consensus_type=" << _options.consensus << "\n"
+            << "    max_trans_num=" << _options.maxTransNum << "\n";
+    for (size_t i = 0; i < _sealers.size(); ++i)
+    {
+        genesis << "    node." << i << "=" << toHex(_sealers[i]) << "\n";
+    }
+    genesis << "[state]\n    type=storage\n"
+            << "[tx]\n    gas_limit=300000000\n"
+            << "[group]\n    id=1\n    timestamp=" << _timestamp << "\n";
+
+    std::ofstream ini(_nodeDir + "/conf/group.1.ini");
+    ini << "[consensus]\n    min_block_generation_time=0\n"
+        << "[storage]\n    type=RocksDB\n"
+        << "[tx_pool]\n    limit=" << std::max<size_t>(150000, 2 * _options.txs) << "\n"
+        << "[tx_execute]\n    enable_parallel=" << (_options.parallel ? "true" : "false") << "\n";
+}
+
+class Bench
+{
+public:
+    explicit Bench(BenchOptions const& _options) : m_options(_options) {}
+
+    void start()
+    {
+        std::string runDir = m_options.dir + "/run-" + toString(utcTime());
+        auto network = std::make_shared<LoopbackNetwork>();
+        std::vector<KeyPair> keyPairs;
+        h512s sealers;
+        for (size_t i = 0; i < m_options.nodes; ++i)
+        {
+            keyPairs.push_back(KeyPair::create());
+            sealers.push_back(keyPairs.back().pub());
+        }
+        auto timestamp = utcTime();
+        for (size_t i = 0; i < m_options.nodes; ++i)
+        {
+            auto nodeDir = runDir + "/node" + toString(i);
+            writeConfig(m_options, nodeDir, sealers, timestamp);
+            auto service = std::make_shared<LoopbackService>(
+                network, keyPairs[i].pub(), 30300 + i, m_options.dispatchThreads);
+            network->addNode(service);
+            auto ledger = std::make_shared<Ledger>(service, 1, keyPairs[i], nodeDir);
+            if (!ledger->initLedger(nodeDir + "/conf/group.1.genesis"))
+            {
+                BOOST_THROW_EXCEPTION(InitLedgerConfigFailed() << errinfo_comment(nodeDir));
+            }
+            m_handlers.push_back(ledger->blockChain()->onBlockCommitted(
+                boost::bind(&Bench::onBlockCommitted, this, _1)));
+            m_ledgers.push_back(ledger);
+        }
+        for (auto const& ledger : m_ledgers)
+        {
+            ledger->startAll();
+        }
+        m_resultDir = runDir;
+    }
+
+    void stop()
+    {
+        for (auto const& ledger : m_ledgers)
+        {
+            ledger->stopAll();
+        }
+        m_handlers.clear();
+    }
+
+    /// the users, the table and the contract of the workload, committed before the timed run
+    void prepare()
+    {
+        std::vector<Transaction> txs;
+        auto workload = m_options.workload;
+        bool mixed = workload == "mixed";
+        dev::eth::ContractABI abi;
+        if (workload == "dag" || mixed)
+        {
+            for (size_t i = 0; i < m_options.users; ++i)
+            {
+                txs.push_back(newTransaction(c_dagTransfer,
+                    abi.abiIn("userAdd(string,uint256)", "user" + toString(i), u256(1) << 64)));
+            }
+        }
+        if (workload == "crud" || mixed)
+        {
+            txs.push_back(newTransaction(c_tableFactory,
+                abi.abiIn("createTable(string,string,string)", c_table, std::string("k"),
+                    std::string("v"))));
+        }
+        bool deploy = workload == "evm" || mixed;
+        if (deploy)
+        {
+            txs.push_back(Transaction(
+                u256(0), u256(0), u256(30000000), fromHex(c_counterCode), nextNonce()));
+        }
+        signAll(txs);
+        submit(txs, false);
+        waitCommitted(m_accepted);
+        if (deploy)
+        {
+            m_contract = m_ledgers[0]
+                             ->blockChain()
+                             ->getTransactionReceiptByHash(txs.back().sha3())
+                             .contractAddress();
+        }
+        m_prepared = m_accepted;
+        m_startNumber = m_ledgers[0]->blockChain()->number();
+    }
+
+    Json::Value run()
+    {
+        std::vector<Transaction> txs;
+        txs.reserve(m_options.txs);
+        for (size_t i = 0; i < m_options.txs; ++i)
+        {
+            txs.push_back(newWorkloadTransaction(i));
+        }
+        signAll(txs);
+
+        m_submitTime.assign(txs.size(), 0);
+        m_submitLatency.assign(txs.size(), 0);
+        m_commitLatency.assign(txs.size(), 0);
+        auto cpuStart = cpuTimeUs();
+        auto start = std::chrono::steady_clock::now();
+        m_start = start;
+        submit(txs, true);
+        auto committed = waitCommitted(m_accepted) - m_prepared;
+        auto accepted = m_accepted - m_prepared;
+        auto elapsed = std::chrono::steady_clock::now() - start;
+        auto cpu = cpuTimeUs() - cpuStart;
+
+        double elapsedMs =
+            std::chrono::duration_cast<std::chrono::microseconds>(elapsed).count() / 1000.0;
+        Json::Value result(Json::objectValue);
+        result["nodes"] = Json::UInt64(m_options.nodes);
+        result["consensus"] = m_options.consensus;
+        result["workload"] = m_options.workload;
+        result["parallel"] = m_options.parallel;
+        result["txs"] = Json::UInt64(txs.size());
+        result["accepted"] = Json::UInt64(accepted);
+        result["committed"] = Json::UInt64(committed);
+        result["failed"] = Json::UInt64(m_failed);
+        result["elapsedMs"] = elapsedMs;
+        result["tps"] = elapsedMs > 0 ? committed * 1000.0 / elapsedMs : 0;
+        result["cpuUsPerTx"] = committed > 0 ? double(cpu) / committed : 0;
+        result["dataDir"] = m_resultDir;
+
+        std::vector<double> submitLatency, commitLatency, consensusLatency, replicationLatency;
+        for (size_t i = 0; i < txs.size(); ++i)
+        {
+            submitLatency.push_back(m_submitLatency[i] / 1000.0);
+            if (m_commitLatency[i] > 0)
+            {
+                commitLatency.push_back(m_commitLatency[i] / 1000.0);
+            }
+        }
+        size_t blocks = 0;
+        {
+            Guard l(x_blocks);
+            for (auto const& block : m_blocks)
+            {
+                if (block.first <= m_startNumber || block.second.commits < m_ledgers.size())
+                {
+                    continue;
+                }
+                ++blocks;
+                consensusLatency.push_back(block.second.firstCommit - block.second.sealTime);
+                replicationLatency.push_back(block.second.lastCommit - block.second.firstCommit);
+            }
+        }
+        result["blocks"] = Json::UInt64(blocks);
+        Json::Value latency(Json::objectValue);
+        /// txpool import of the submitting node
+        latency["submitMs"] = percentiles(submitLatency);
+        /// submit to the receipt on the submitting node
+        latency["commitMs"] = percentiles(commitLatency);
+        /// the seal of a block to its first commit
+        latency["consensusMs"] = percentiles(consensusLatency);
+        /// the first commit of a block to the last one
+        latency["replicationMs"] = percentiles(replicationLatency);
+        result["latency"] = latency;
+        return result;
+    }
+
+private:
+    u256 nextNonce() { return m_nonceBase + u256(m_nonce++); }
+
+    Transaction newTransaction(Address const& _dest, bytes const& _data)
+    {
+        return Transaction(u256(0), u256(0), u256(30000000), _dest, _data, nextNonce());
+    }
+
+    Transaction newWorkloadTransaction(size_t _i)
+    {
+        static const std::vector<std::string> c_mixed = {"transfer", "dag", "crud", "evm"};
+        auto workload = m_options.workload;
+        if (workload == "mixed")
+        {
+            workload = c_mixed[_i % c_mixed.size()];
+        }
+        dev::eth::ContractABI abi;
+        if (workload == "dag")
+        {
+            return newTransaction(c_dagTransfer,
+                abi.abiIn("userTransfer(string,string,uint256)",
+                    "user" + toString(_i % m_options.users),
+                    "user" + toString((_i + 1) % m_options.users), u256(1)));
+        }
+        if (workload == "crud")
+        {
+            auto key = "k" + toString(_i);
+            return newTransaction(c_crud, abi.abiIn("insert(string,string,string,string)", c_table,
+                                              key, "{\"k\":\"" + key + "\",\"v\":\"v\"}",
+                                              std::string()));
+        }
+        if (workload == "evm")
+        {
+            return newTransaction(m_contract, bytes());
+        }
+        // a call to an account without code
+        return newTransaction(Address(0x100000 + _i % m_options.users), bytes());
+    }
+
+    void sign(Transaction& _tx, u256 const& _blockLimit)
+    {
+        _tx.setBlockLimit(_blockLimit);
+        auto sig = dev::sign(m_keyPair.secret(), _tx.sha3(WithoutSignature));
+        _tx.updateSignature(SignatureStruct(sig));
+    }
+
+    /// signed before the timed run, the clients sign the transactions
+    void signAll(std::vector<Transaction>& _txs)
+    {
+        auto blockLimit = u256(m_ledgers[0]->blockChain()->number()) + u256(500);
+        tbb::parallel_for(tbb::blocked_range<size_t>(0, _txs.size()),
+            [this, &_txs, &blockLimit](tbb::blocked_range<size_t> const& _r) {
+                for (size_t i = _r.begin(); i != _r.end(); ++i)
+                {
+                    sign(_txs[i], blockLimit);
+                }
+            });
+    }
+
+    /// the transactions are submitted to the nodes in turn by the client threads
+    void submit(std::vector<Transaction>& _txs, bool _timed)
+    {
+        std::atomic<size_t> next(0);
+        std::vector<std::thread> clients;
+        for (size_t t = 0; t < m_options.threads; ++t)
+        {
+            clients.push_back(std::thread([this, &_txs, &next, _timed]() {
+                for (size_t i = next++; i < _txs.size(); i = next++)
+                {
+                    submitOne(_txs[i], i, _timed);
+                }
+            }));
+        }
+        for (auto& client : clients)
+        {
+            client.join();
+        }
+    }
+
+    void submitOne(Transaction& _tx, size_t _index, bool _timed)
+    {
+        auto txPool = m_ledgers[_index % m_ledgers.size()]->txPool();
+        if (_timed)
+        {
+            _tx.setRpcCallback(boost::bind(&Bench::onReceipt, this, _index, _1));
+        }
+        while (true)
+        {
+            try
+            {
+                if (_timed)
+                {
+                    m_submitTime[_index] = microseconds(std::chrono::steady_clock::now());
+                }
+                txPool->submit(_tx);
+                if (_timed)
+                {
+                    m_submitLatency[_index] =
+                        microseconds(std::chrono::steady_clock::now()) - m_submitTime[_index];
+                }
+                ++m_accepted;
+                return;
+            }
+            catch (TransactionRefused const&)
+            {
+                // the txpool is full, wait for the next block
+                std::this_thread::sleep_for(std::chrono::milliseconds(1));
+            }
+            catch (std::exception const& _e)
+            {
+                std::cerr << "submit failed: " << boost::diagnostic_information(_e) << std::endl;
+                return;
+            }
+        }
+    }
+
+    void onReceipt(size_t _index, LocalisedTransactionReceipt::Ptr _receipt)
+    {
+        m_commitLatency[_index] =
+            microseconds(std::chrono::steady_clock::now()) - m_submitTime[_index];
+        if (_receipt->status() != executive::TransactionException::None)
+        {
+            ++m_failed;
+        }
+    }
+
+    void onBlockCommitted(Block const& _block)
+    {
+        auto now = utcTime();
+        Guard l(x_blocks);
+        auto& block = m_blocks[_block.blockHeader().number()];
+        block.sealTime = int64_t(_block.blockHeader().timestamp());
+        block.firstCommit = block.commits == 0 ? now : block.firstCommit;
+        block.lastCommit = now;
+        ++block.commits;
+    }
+
+    /// @returns the transactions committed by every node when they reach _target or time out
+    size_t waitCommitted(size_t const _target)
+    {
+        auto deadline =
+            std::chrono::steady_clock::now() + std::chrono::seconds(m_options.timeout);
+        while (true)
+        {
+            size_t committed = _target;
+            for (auto const& ledger : m_ledgers)
+            {
+                committed = std::min<size_t>(
+                    committed, ledger->blockChain()->totalTransactionCount().first);
+            }
+            if (committed >= _target || std::chrono::steady_clock::now() > deadline)
+            {
+                return committed;
+            }
+            std::this_thread::sleep_for(std::chrono::milliseconds(10));
+        }
+    }
+
+    int64_t microseconds(std::chrono::steady_clock::time_point const& _time)
+    {
+        return std::chrono::duration_cast<std::chrono::microseconds>(_time - m_start).count();
+    }
+
+    BenchOptions m_options;
+    KeyPair m_keyPair = KeyPair::create();
+    u256 m_nonceBase = u256(utcTime()) << 32;
+    std::atomic<uint64_t> m_nonce{0};
+    std::vector<std::shared_ptr<Ledger>> m_ledgers;
+    std::vector<Handler<Block const&>> m_handlers;
+    std::string m_resultDir;
+    Address m_contract;
+    int64_t m_startNumber = 0;
+
+    std::chrono::steady_clock::time_point m_start = std::chrono::steady_clock::now();
+    size_t m_prepared = 0;
+    std::atomic<size_t> m_accepted{0};
+    std::atomic<size_t> m_failed{0};
+    std::vector<int64_t> m_submitTime;
+    std::vector<int64_t> m_submitLatency;
+    std::vector<int64_t> m_commitLatency;
+
+    std::map<int64_t, BlockStat> m_blocks;
+    Mutex x_blocks;
+};
+}  // namespace
+
+int main(int argc, const char* argv[])
+{
+    namespace po = boost::program_options;
+    BenchOptions options;
+    po::options_description description("end-to-end benchmark of the ledgers of several nodes");
+    description.add_options()("help,h", "help of the benchmark")(
+        "nodes,n", po::value<size_t>(&options.nodes)->default_value(4), "number of sealers")(
+        "txs,t", po::value<size_t>(&options.txs)->default_value(20000), "transactions to send")(
+        "workload,w", po::value<std::string>(&options.workload)->default_value("transfer"),
+        "transfer, dag, crud, evm or mixed")("consensus,c",
+        po::value<std::string>(&options.consensus)->default_value("pbft"), "pbft or raft")(
+        "users,u", po::value<size_t>(&options.users)->default_value(1000),
+        "accounts of the transfer and dag workloads")("threads",
+        po::value<size_t>(&options.threads)->default_value(4), "client threads submitting")(
+        "dispatch_threads", po::value<size_t>(&options.dispatchThreads)->default_value(2),
+        "message handling threads of a node")("max_trans_num",
+        po::value<size_t>(&options.maxTransNum)->default_value(1000), "transactions of a block")(
+        "parallel", po::value<bool>(&options.parallel)->default_value(true),
+        "execute the transactions in parallel")("timeout",
+        po::value<size_t>(&options.timeout)->default_value(300), "seconds to wait for commit")(
+        "dir", po::value<std::string>(&options.dir)->default_value("./e2e_benchmark"),
+        "directory of the data of the nodes");
+    po::variables_map vm;
+    try
+    {
+        po::store(po::parse_command_line(argc, argv, description), vm);
+        po::notify(vm);
+    }
+    catch (std::exception const& _e)
+    {
+        std::cerr << "invalid input: " << _e.what() << std::endl;
+        return 1;
+    }
+    if (vm.count("help") || options.nodes == 0 || options.users == 0 || options.threads == 0)
+    {
+        std::cout << description << std::endl;
+        return 0;
+    }
+
+    g_BCOSConfig.setSupportedVersion("2.1.0", V2_1_0);
+    boost::property_tree::ptree pt;
+    pt.put("log.level", "error");
+    pt.put("log.log_path", options.dir + "/log");
+    LogInitializer log;
+    log.initLog(pt);
+
+    Bench bench(options);
+    bench.start();
+    std::cerr << "preparing " << options.workload << " on " << options.nodes << " nodes"
+              << std::endl;
+    bench.prepare();
+    std::cerr << "sending " << options.txs << " transactions" << std::endl;
+    auto result = bench.run();
+    bench.stop();
+
+    Json::FastWriter writer;
+    writer.omitEndingLineFeed();
+    std::cout << writer.write(result) << std::endl;
+    return result["committed"].asUInt64() == result["accepted"].asUInt64() ? 0 : 1;
+}
@@ -0,0 +1,109 @@
+/**
+ * @CopyRight:
+ * FISCO-BCOS is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * FISCO-BCOS is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with FISCO-BCOS.  If not, see <http://www.gnu.org/licenses/>
+ * (c) 2016-2018 fisco-dev contributors.
+ *
+ * @brief : single core throughput of sha3 and of the sha3Batch kernels
+ * @file: hash_benchmark.cpp
+ */
+#include <libdevcrypto/HashBatch.h>
+#include <boost/lexical_cast.hpp>
+#include <chrono>
+#include <iomanip>
+#include <iostream>
+
+using namespace std;
+using namespace dev;
+using namespace dev::crypto;
+
+void report(std::string const& _name, size_t _hashes, size_t _bytes,
+    std::chrono::duration<double> const& _elapsed)
+{
+    std::cout << std::setw(12) << std::left << _name << std::setiosflags(std::ios::fixed)
+              << std::setprecision(0) << std::setw(12) << std::right
+              << _hashes / _elapsed.count() << " hashes/s " << std::setprecision(2)
+              << std::setw(10) << _bytes / _elapsed.count() / 1048576 << " MB/s" << std::endl;
+}
+
+int main(int argc, char* argv[])
+{
+    if (argc > 1 && std::string(argv[1]) == "-h")
+    {
+        std::cout << "Usage: " << argv[0] << " [input size, 200] [batch size, 1000] [rounds, 100]"
+                  << std::endl;
+        return 0;
+    }
+    // a transfer transaction is about 200 bytes
+    size_t inputSize = argc > 1 ? boost::lexical_cast<size_t>(argv[1]) : 200;
+    size_t batchSize = argc > 2 ? boost::lexical_cast<size_t>(argv[2]) : 1000;
+    size_t rounds = argc > 3 ? boost::lexical_cast<size_t>(argv[3]) : 100;
+
+    std::vector<bytes> contents(batchSize, bytes(inputSize));
+    std::vector<bytesConstRef> inputs;
+    for (size_t i = 0; i < batchSize; ++i)
+    {
+        for (size_t j = 0; j < inputSize; ++j)
+        {
+            contents[i][j] = (byte)(i + j);
+        }
+        inputs.push_back(ref(contents[i]));
+    }
+    size_t hashes = batchSize * rounds;
+    size_t totalBytes = hashes * inputSize;
+    std::cout << "input size: " << inputSize << ", batch size: " << batchSize
+              << ", rounds: " << rounds << ", best kernel: " << hashKernelName(bestHashKernel())
+              << std::endl;
+
+    h256 check;
+    auto start = std::chrono::steady_clock::now();
+    for (size_t round = 0; round < rounds; ++round)
+    {
+        for (auto const& input : inputs)
+        {
+            check ^= sha3(input);
+        }
+    }
+    report("sha3", hashes, totalBytes, std::chrono::steady_clock::now() - start);
+
+    std::vector<HashKernel> kernels{HashKernel::Scalar};
+    if (bestHashKernel() != HashKernel::Scalar)
+    {
+        kernels.push_back(HashKernel::AVX2);
+    }
+    if (bestHashKernel() == HashKernel::AVX512)
+    {
+        kernels.push_back(HashKernel::AVX512);
+    }
+    for (auto kernel : kernels)
+    {
+        h256 batchCheck;
+        start = std::chrono::steady_clock::now();
+        for (size_t round = 0; round < rounds; ++round)
+        {
+            for (auto const& hash : sha3Batch(inputs, kernel))
+            {
+                batchCheck ^= hash;
+            }
+        }
+        report(hashKernelName(kernel), hashes, totalBytes,
+            std::chrono::steady_clock::now() - start);
+        if (batchCheck != check)
+        {
+            std::cout << "ERROR: the hashes of the " << hashKernelName(kernel)
+                      << " kernel differ from sha3" << std::endl;
+            return 1;
+        }
+    }
+    return 0;
+}
@@ -52,9 +52,18 @@ class session : public std::enable_shared_from_this<session>
         m_mapRpc.insert(
             std::make_pair("getSyncStatus", std::bind(&dev::rpc::RpcFace::getSyncStatusI, m_rpcFace,
                                                 std::placeholders::_1, std::placeholders::_2)));
+        m_mapRpc.insert(std::make_pair("getConflictPredictions",
+            std::bind(&dev::rpc::RpcFace::getConflictPredictionsI, m_rpcFace, std::placeholders::_1,
+                std::placeholders::_2)));
         m_mapRpc.insert(std::make_pair(
             "getClientVersion", std::bind(&dev::rpc::RpcFace::getClientVersionI, m_rpcFace,
                                     std::placeholders::_1, std::placeholders::_2)));
+        m_mapRpc.insert(
+            std::make_pair("getMetrics", std::bind(&dev::rpc::RpcFace::getMetricsI, m_rpcFace,
+                                             std::placeholders::_1, std::placeholders::_2)));
+        m_mapRpc.insert(std::make_pair(
+            "getBlockTraces", std::bind(&dev::rpc::RpcFace::getBlockTracesI, m_rpcFace,
+                                  std::placeholders::_1, std::placeholders::_2)));
         m_mapRpc.insert(
             std::make_pair("getPeers", std::bind(&dev::rpc::RpcFace::getPeersI, m_rpcFace,
                                            std::placeholders::_1, std::placeholders::_2)));
@@ -85,6 +94,14 @@ class session : public std::enable_shared_from_this<session>
         m_mapRpc.insert(std::make_pair(
             "getTransactionReceipt", std::bind(&dev::rpc::RpcFace::getTransactionReceiptI,
                                          m_rpcFace, std::placeholders::_1, std::placeholders::_2)));
+        m_mapRpc.insert(std::make_pair("getTransactionByHashWithProof",
+            std::bind(&dev::rpc::RpcFace::getTransactionByHashWithProofI, m_rpcFace,
+                std::placeholders::_1, std::placeholders::_2)));
+        m_mapRpc.insert(std::make_pair("getTransactionReceiptByHashWithProof",
+            std::bind(&dev::rpc::RpcFace::getTransactionReceiptByHashWithProofI, m_rpcFace,
+                std::placeholders::_1, std::placeholders::_2)));
+        m_mapRpc.insert(std::make_pair("getLogs", std::bind(&dev::rpc::RpcFace::getLogsI, m_rpcFace,
+                                                      std::placeholders::_1, std::placeholders::_2)));
         m_mapRpc.insert(std::make_pair("getPendingTransactions",
             std::bind(&dev::rpc::RpcFace::getPendingTransactionsI, m_rpcFace, std::placeholders::_1,
                 std::placeholders::_2)));
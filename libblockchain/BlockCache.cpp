@@ -0,0 +1,160 @@
+/*
+ * @CopyRight:
+ * FISCO-BCOS is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * FISCO-BCOS is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with FISCO-BCOS.  If not, see <http://www.gnu.org/licenses/>
+ * (c) 2016-2018 fisco-dev contributors.
+ */
+
+/**
+ * @brief : size-aware LRU cache of the recent blocks
+ * @file: BlockCache.cpp
+ */
+#include "BlockCache.h"
+
+using namespace std;
+using namespace dev;
+using namespace dev::eth;
+using namespace dev::blockchain;
+
+std::shared_ptr<Block> BlockCache::add(Block const& _block, std::shared_ptr<bytes> _blockRLP)
+{
+    CacheEntry entry;
+    entry.number = _block.blockHeader().number();
+    entry.hash = _block.blockHeader().hash();
+    entry.block = std::make_shared<Block>(_block);
+    entry.blockRLP = _blockRLP;
+    // the decoded block takes about the same memory as its RLP
+    entry.size = _blockRLP->size() * 2;
+    auto block = entry.block;
+    insert(std::move(entry));
+    return block;
+}
+
+void BlockCache::add(int64_t _number, h256 const& _hash, std::shared_ptr<bytes> _blockRLP)
+{
+    CacheEntry entry;
+    entry.number = _number;
+    entry.hash = _hash;
+    entry.blockRLP = _blockRLP;
+    entry.size = _blockRLP->size();
+    insert(std::move(entry));
+}
+
+void BlockCache::insert(CacheEntry&& _entry)
+{
+    Guard l(x_cache);
+    auto it = m_hashIndex.find(_entry.hash);
+    if (it != m_hashIndex.end())
+    {
+        // never replace the decoded block with the RLP only
+        if (!_entry.block && it->second->block)
+        {
+            m_lru.splice(m_lru.begin(), m_lru, it->second);
+            return;
+        }
+        if (_entry.number < 0)
+        {
+            _entry.number = it->second->number;
+        }
+        m_usage -= it->second->size;
+        auto entryIt = it->second;
+        m_hashIndex.erase(it);
+        eraseNumberIndex(entryIt);
+        m_lru.erase(entryIt);
+    }
+    m_usage += _entry.size;
+    m_lru.push_front(std::move(_entry));
+    auto entryIt = m_lru.begin();
+    m_hashIndex[entryIt->hash] = entryIt;
+    if (entryIt->number >= 0)
+    {
+        m_numberIndex[entryIt->number] = entryIt;
+    }
+    evict();
+}
+
+void BlockCache::evict()
+{
+    // keep the latest entry even if it exceeds the capacity alone
+    while (m_usage > m_capacity && m_lru.size() > 1)
+    {
+        auto entryIt = std::prev(m_lru.end());
+        m_usage -= entryIt->size;
+        m_hashIndex.erase(entryIt->hash);
+        eraseNumberIndex(entryIt);
+        m_lru.erase(entryIt);
+    }
+}
+
+void BlockCache::eraseNumberIndex(EntryIterator _it)
+{
+    // the number may have been taken by another entry
+    auto numberIt = m_numberIndex.find(_it->number);
+    if (numberIt != m_numberIndex.end() && numberIt->second == _it)
+    {
+        m_numberIndex.erase(numberIt);
+    }
+}
+
+std::pair<std::shared_ptr<Block>, std::shared_ptr<bytes>> BlockCache::touch(EntryIterator _it)
+{
+    ++m_hits;
+    m_lru.splice(m_lru.begin(), m_lru, _it);
+    return std::make_pair(_it->block, _it->blockRLP);
+}
+
+std::pair<std::shared_ptr<Block>, std::shared_ptr<bytes>> BlockCache::get(h256 const& _hash)
+{
+    ++m_queries;
+    Guard l(x_cache);
+    auto it = m_hashIndex.find(_hash);
+    if (it == m_hashIndex.end())
+    {
+        return std::make_pair(nullptr, nullptr);
+    }
+    return touch(it->second);
+}
+
+std::pair<std::shared_ptr<Block>, std::shared_ptr<bytes>> BlockCache::get(int64_t _number)
+{
+    ++m_queries;
+    Guard l(x_cache);
+    auto it = m_numberIndex.find(_number);
+    if (it == m_numberIndex.end())
+    {
+        return std::make_pair(nullptr, nullptr);
+    }
+    return touch(it->second);
+}
+
+void BlockCache::clear()
+{
+    Guard l(x_cache);
+    m_lru.clear();
+    m_hashIndex.clear();
+    m_numberIndex.clear();
+    m_usage = 0;
+}
+
+size_t BlockCache::size() const
+{
+    Guard l(x_cache);
+    return m_lru.size();
+}
+
+void BlockCache::setCacheCapacity(int64_t _capacity)
+{
+    Guard l(x_cache);
+    m_capacity = _capacity;
+    evict();
+}
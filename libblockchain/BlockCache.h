@@ -0,0 +1,98 @@
+/*
+ * @CopyRight:
+ * FISCO-BCOS is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * FISCO-BCOS is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with FISCO-BCOS.  If not, see <http://www.gnu.org/licenses/>
+ * (c) 2016-2018 fisco-dev contributors.
+ */
+
+/**
+ * @brief : size-aware LRU cache of the recent blocks
+ * @file: BlockCache.h
+ */
+#pragma once
+
+#include <libdevcore/Guards.h>
+#include <libethcore/Block.h>
+#include <libstorage/MemoryArbiter.h>
+#include <atomic>
+#include <list>
+#include <map>
+#include <memory>
+
+namespace dev
+{
+namespace blockchain
+{
+/// default bytes of the block cache when no memory arbiter assigns it
+static int64_t const c_defaultBlockCacheCapacity = 32 * 1024 * 1024;
+
+/// The cache holds the RLP of the recent blocks and, once someone asked for it, the decoded
+/// block. Entries are indexed by both hash and number, and evicted in LRU order when the
+/// estimated memory exceeds the capacity.
+class BlockCache : public dev::storage::CacheConsumer
+{
+public:
+    typedef std::shared_ptr<BlockCache> Ptr;
+    BlockCache(int64_t _capacity = c_defaultBlockCacheCapacity) : m_capacity(_capacity) {}
+
+    /// cache the decoded block together with its RLP, return the cached block
+    std::shared_ptr<dev::eth::Block> add(
+        dev::eth::Block const& _block, std::shared_ptr<dev::bytes> _blockRLP);
+    /// cache the RLP only, _number is -1 if unknown
+    void add(int64_t _number, dev::h256 const& _hash, std::shared_ptr<dev::bytes> _blockRLP);
+
+    /// return the cached block and RLP, the block is nullptr if only the RLP has been cached
+    std::pair<std::shared_ptr<dev::eth::Block>, std::shared_ptr<dev::bytes>> get(
+        dev::h256 const& _hash);
+    std::pair<std::shared_ptr<dev::eth::Block>, std::shared_ptr<dev::bytes>> get(int64_t _number);
+    void clear();
+
+    int64_t capacity() const { return m_capacity; }
+    size_t size() const;
+
+    int64_t cacheUsage() override { return m_usage; }
+    uint64_t cacheQueries() override { return m_queries; }
+    uint64_t cacheHits() override { return m_hits; }
+    void setCacheCapacity(int64_t _capacity) override;
+
+private:
+    struct CacheEntry
+    {
+        int64_t number;
+        dev::h256 hash;
+        std::shared_ptr<dev::eth::Block> block;
+        std::shared_ptr<dev::bytes> blockRLP;
+        /// estimated memory of the entry
+        int64_t size;
+    };
+    typedef std::list<CacheEntry>::iterator EntryIterator;
+
+    void insert(CacheEntry&& _entry);
+    std::pair<std::shared_ptr<dev::eth::Block>, std::shared_ptr<dev::bytes>> touch(
+        EntryIterator _it);
+    void evict();
+    void eraseNumberIndex(EntryIterator _it);
+
+    mutable Mutex x_cache;
+    /// most recently used at the front
+    std::list<CacheEntry> m_lru;
+    std::map<dev::h256, EntryIterator> m_hashIndex;
+    std::map<int64_t, EntryIterator> m_numberIndex;
+
+    std::atomic<int64_t> m_capacity;
+    std::atomic<int64_t> m_usage = {0};
+    std::atomic<uint64_t> m_queries = {0};
+    std::atomic<uint64_t> m_hits = {0};
+};
+}  // namespace blockchain
+}  // namespace dev
@@ -24,6 +24,7 @@
 #include "BlockChainImp.h"
 #include <libblockverifier/ExecutiveContext.h>
 #include <libdevcore/CommonData.h>
+#include <libdevcore/Tracer.h>
 #include <libdevcore/easylog.h>
 #include <libethcore/Block.h>
 #include <libethcore/CommonJS.h>
@@ -35,7 +36,9 @@
 #include <boost/algorithm/string/classification.hpp>
 #include <boost/algorithm/string/split.hpp>
 #include <boost/lexical_cast.hpp>
+#include <algorithm>
 #include <csignal>
+#include <iterator>
 #include <string>
 #include <utility>
 #include <vector>
@@ -51,50 +54,26 @@ using namespace dev::precompiled;
 
 using boost::lexical_cast;
 
-std::shared_ptr<Block> BlockCache::add(Block const& _block)
+void BlockChainImp::reload()
 {
     {
-        WriteGuard guard(m_sharedMutex);
-        if (m_blockCache.size() > c_blockCacheSize)
-        {
-            BLOCKCHAIN_LOG(TRACE) << LOG_DESC("[add]Block cache full, start to remove old item...");
-            auto firstHash = m_blockCacheFIFO.front();
-            m_blockCacheFIFO.pop_front();
-            m_blockCache.erase(firstHash);
-            // in case something unexcept error
-            if (m_blockCache.size() > c_blockCacheSize)
-            {
-                // meet error, cache and cacheFIFO not sync, clear the cache
-                m_blockCache.clear();
-                m_blockCacheFIFO.clear();
-            }
-        }
-
-        auto blockHash = _block.blockHeader().hash();
-        auto block = std::make_shared<Block>(std::move(_block));
-        m_blockCache.insert(std::make_pair(blockHash, block));
-        // add hashindex to the blockCache queue, use to remove first element when the cache is full
-        m_blockCacheFIFO.push_back(blockHash);
-
-        return block;
+        WriteGuard l(m_blockNumberMutex);
+        m_blockNumber = -1;
     }
-}
-
-std::pair<std::shared_ptr<Block>, h256> BlockCache::get(h256 const& _hash)
-{
     {
-        ReadGuard guard(m_sharedMutex);
-
-        auto it = m_blockCache.find(_hash);
-        if (it == m_blockCache.end())
-        {
-            return std::make_pair(nullptr, h256(0));
-        }
-
-        return std::make_pair(it->second, _hash);
+        WriteGuard l(m_nodeListMutex);
+        m_cacheNumBySealer = -1;
+        m_cacheNumByObserver = -1;
     }
-
-    return std::make_pair(nullptr, h256(0));  // just make compiler happy
+    {
+        WriteGuard l(m_systemConfigMutex);
+        m_systemConfigRecord.clear();
+    }
+    m_blockCache->clear();
+    int64_t blockNumber = number();
+    BLOCKCHAIN_LOG(INFO) << LOG_DESC("[#reload]Reload blockchain from storage")
+                         << LOG_KV("number", blockNumber);
+    m_onReload(blockNumber);
 }
 
 void BlockChainImp::setStateStorage(Storage::Ptr stateStorage)
@@ -126,6 +105,16 @@ std::shared_ptr<Block> BlockChainImp::getBlock(int64_t _i)
     {
         return nullptr;
     }
+    auto cachedBlock = m_blockCache->get(_i);
+    if (bool(cachedBlock.first))
+    {
+        BLOCKCHAIN_LOG(TRACE) << LOG_DESC("[#getBlock]Cache hit, read from cache");
+        return cachedBlock.first;
+    }
+    if (bool(cachedBlock.second))
+    {
+        return decodeCachedBlock(cachedBlock.second);
+    }
     string blockHash = "";
     Table::Ptr tb = getMemoryTableFactory()->openTable(SYS_NUMBER_2_HASH);
     if (tb)
@@ -147,11 +136,23 @@ std::shared_ptr<Block> BlockChainImp::getBlock(int64_t _i)
     return nullptr;
 }
 
+std::shared_ptr<Block> BlockChainImp::decodeCachedBlock(std::shared_ptr<bytes> _blockRLP)
+{
+    auto record_time = utcTime();
+    auto block = Block(*_blockRLP, CheckTransaction::None);
+    auto constructBlock_time_cost = utcTime() - record_time;
+    auto blockPtr = m_blockCache->add(block, _blockRLP);
+    BLOCKCHAIN_LOG(DEBUG) << LOG_DESC("Decode block from cached RLP")
+                          << LOG_KV("constructBlockTimeCost", constructBlock_time_cost)
+                          << LOG_KV("totalTimeCost", utcTime() - record_time);
+    return blockPtr;
+}
+
 std::shared_ptr<Block> BlockChainImp::getBlock(dev::h256 const& _blockHash)
 {
     auto start_time = utcTime();
     auto record_time = utcTime();
-    auto cachedBlock = m_blockCache.get(_blockHash);
+    auto cachedBlock = m_blockCache->get(_blockHash);
     auto getCache_time_cost = utcTime() - record_time;
     record_time = utcTime();
 
@@ -160,6 +161,11 @@ std::shared_ptr<Block> BlockChainImp::getBlock(dev::h256 const& _blockHash)
         BLOCKCHAIN_LOG(TRACE) << LOG_DESC("[#getBlock]Cache hit, read from cache");
         return cachedBlock.first;
     }
+    else if (bool(cachedBlock.second))
+    {
+        BLOCKCHAIN_LOG(TRACE) << LOG_DESC("[#getBlock]RLP cache hit, decode the block");
+        return decodeCachedBlock(cachedBlock.second);
+    }
     else
     {
         BLOCKCHAIN_LOG(TRACE) << LOG_DESC("[#getBlock]Cache missed, read from storage");
@@ -179,12 +185,13 @@ std::shared_ptr<Block> BlockChainImp::getBlock(dev::h256 const& _blockHash)
                 auto getField_time_cost = utcTime() - record_time;
                 record_time = utcTime();
 
-                auto block = Block(fromHex(strBlock.c_str()), CheckTransaction::None);
+                auto blockRLP = std::make_shared<bytes>(fromHex(strBlock.c_str()));
+                auto block = Block(*blockRLP, CheckTransaction::None);
                 auto constructBlock_time_cost = utcTime() - record_time;
                 record_time = utcTime();
 
                 BLOCKCHAIN_LOG(TRACE) << LOG_DESC("[#getBlock]Write to cache");
-                auto blockPtr = m_blockCache.add(block);
+                auto blockPtr = m_blockCache->add(block, blockRLP);
                 auto addCache_time_cost = utcTime() - record_time;
                 BLOCKCHAIN_LOG(DEBUG) << LOG_DESC("Get block from leveldb")
                                       << LOG_KV("getCacheTimeCost", getCache_time_cost)
@@ -211,6 +218,12 @@ std::shared_ptr<bytes> BlockChainImp::getBlockRLP(int64_t _i)
     {
         return nullptr;
     }
+    auto cachedBlock = m_blockCache->get(_i);
+    if (bool(cachedBlock.second))
+    {
+        BLOCKCHAIN_LOG(TRACE) << LOG_DESC("[#getBlockRLP]Cache hit, read from cache");
+        return cachedBlock.second;
+    }
     string blockHash = "";
     Table::Ptr tb = getMemoryTableFactory()->openTable(SYS_NUMBER_2_HASH);
     if (tb)
@@ -220,7 +233,7 @@ std::shared_ptr<bytes> BlockChainImp::getBlockRLP(int64_t _i)
         {
             auto entry = entries->get(0);
             h256 blockHash = h256((entry->getField(SYS_VALUE)));
-            return getBlockRLP(blockHash);
+            return getBlockRLP(blockHash, _i);
         }
     }
 
@@ -228,22 +241,21 @@ std::shared_ptr<bytes> BlockChainImp::getBlockRLP(int64_t _i)
     return nullptr;
 }
 
-std::shared_ptr<bytes> BlockChainImp::getBlockRLP(dev::h256 const& _blockHash)
+std::shared_ptr<bytes> BlockChainImp::getBlockRLP(dev::h256 const& _blockHash, int64_t _number)
 {
     auto start_time = utcTime();
     auto record_time = utcTime();
-    auto cachedBlock = m_blockCache.get(_blockHash);
+    auto cachedBlock = m_blockCache->get(_blockHash);
     auto getCache_time_cost = utcTime() - record_time;
     record_time = utcTime();
 
-    if (bool(cachedBlock.first))
+    if (bool(cachedBlock.second))
     {
         BLOCKCHAIN_LOG(TRACE) << LOG_DESC("[#getBlockRLP]Cache hit, read from cache");
-        std::shared_ptr<bytes> blockRLP = cachedBlock.first->rlpP();
         BLOCKCHAIN_LOG(DEBUG) << LOG_DESC("Get block RLP from cache")
                               << LOG_KV("getCacheTimeCost", getCache_time_cost)
                               << LOG_KV("totalTimeCost", utcTime() - start_time);
-        return blockRLP;
+        return cachedBlock.second;
     }
     else
     {
@@ -266,6 +278,8 @@ std::shared_ptr<bytes> BlockChainImp::getBlockRLP(dev::h256 const& _blockHash)
 
                 auto blockRLP = std::make_shared<bytes>(fromHex(strBlock.c_str()));
                 auto blockRLP_time_cost = utcTime() - record_time;
+                /// the RLP is cached without decoding, sync responses only need the bytes
+                m_blockCache->add(_number, _blockHash, blockRLP);
 
                 BLOCKCHAIN_LOG(DEBUG) << LOG_DESC("Get block RLP from leveldb")
                                       << LOG_KV("getCacheTimeCost", getCache_time_cost)
@@ -823,10 +837,10 @@ TransactionReceipt BlockChainImp::getTransactionReceiptByHash(dev::h256 const& _
             {
                 return TransactionReceipt();
             }
-            std::vector<TransactionReceipt> receipts = pblock->transactionReceipts();
-            if (receipts.size() > lexical_cast<uint>(txIndex))
+            /// only the receipt of the transaction is decoded
+            if (pblock->receiptsSize() > lexical_cast<uint>(txIndex))
             {
-                return receipts[lexical_cast<uint>(txIndex)];
+                return pblock->transactionReceipt(lexical_cast<uint>(txIndex));
             }
         }
     }
@@ -854,11 +868,10 @@ LocalisedTransactionReceipt BlockChainImp::getLocalisedTxReceiptByHash(dev::h256
                     TransactionReceipt(), h256(0), h256(0), -1, Address(), Address(), -1, 0);
             }
             const Transactions& txs = pblock->transactions();
-            const TransactionReceipts& receipts = pblock->transactionReceipts();
-            if (receipts.size() > txIndex && txs.size() > txIndex)
+            if (pblock->receiptsSize() > txIndex && txs.size() > txIndex)
             {
                 auto& tx = txs[txIndex];
-                auto& receipt = receipts[txIndex];
+                auto receipt = pblock->transactionReceipt(txIndex);
 
                 return LocalisedTransactionReceipt(receipt, _txHash, pblock->headerHash(),
                     pblock->header().number(), tx.from(), tx.to(), txIndex, receipt.gasUsed(),
@@ -985,6 +998,182 @@ void BlockChainImp::writeTxToBlock(const Block& block, std::shared_ptr<Executive
     }
 }
 
+namespace
+{
+std::string logIndexKey(std::string const& _value, int64_t _number)
+{
+    return _value + "_" + lexical_cast<std::string>(_number / BlockChainImp::c_logIndexBlocks);
+}
+}  // namespace
+
+const int64_t BlockChainImp::c_logIndexBlocks;
+
+void BlockChainImp::writeLogIndex(const Block& block, std::shared_ptr<ExecutiveContext> context)
+{
+    if (g_BCOSConfig.version() < V2_1_0)
+    {
+        return;
+    }
+    auto number = block.blockHeader().number();
+    LogBloom bloom;
+    /// the addresses and the topics of the block, a key gets one posting of the block
+    std::set<std::string> keys;
+    for (auto const& receipt : block.transactionReceipts())
+    {
+        bloom |= receipt.bloom();
+        for (auto const& log : receipt.log())
+        {
+            keys.insert(logIndexKey(log.address.hex(), number));
+            for (auto const& topic : log.topics)
+            {
+                keys.insert(logIndexKey(topic.hex(), number));
+            }
+        }
+    }
+    if (keys.empty())
+    {
+        return;
+    }
+    Table::Ptr tb_bloom = context->getMemoryTableFactory()->openTable(SYS_BLOCK_2_BLOOM, false);
+    Table::Ptr tb_index = context->getMemoryTableFactory()->openTable(SYS_LOG_INDEX, false, true);
+    if (!tb_bloom || !tb_index)
+    {
+        BOOST_THROW_EXCEPTION(OpenSysTableFailed() << errinfo_comment(SYS_LOG_INDEX));
+    }
+    Entry::Ptr bloomEntry = std::make_shared<Entry>();
+    bloomEntry->setField(SYS_VALUE, toHex(bloom));
+    bloomEntry->setForce(true);
+    tb_bloom->insert(lexical_cast<std::string>(number), bloomEntry);
+    for (auto const& key : keys)
+    {
+        Entry::Ptr entry = std::make_shared<Entry>();
+        entry->setField(SYS_VALUE, lexical_cast<std::string>(number));
+        entry->setForce(true);
+        tb_index->insert(key, entry, std::make_shared<dev::storage::AccessOptions>(), false);
+    }
+}
+
+std::set<int64_t> BlockChainImp::logIndexBlocks(
+    Table::Ptr _table, std::string const& _value, int64_t _from, int64_t _to)
+{
+    std::set<int64_t> blocks;
+    for (int64_t segment = _from / c_logIndexBlocks; segment <= _to / c_logIndexBlocks; ++segment)
+    {
+        auto entries = _table->select(
+            logIndexKey(_value, segment * c_logIndexBlocks), _table->newCondition());
+        for (size_t i = 0; i < entries->size(); ++i)
+        {
+            auto number = lexical_cast<int64_t>(entries->get(i)->getField(SYS_VALUE));
+            if (number >= _from && number <= _to)
+            {
+                blocks.insert(number);
+            }
+        }
+    }
+    return blocks;
+}
+
+LocalisedLogEntries BlockChainImp::getLogs(LogFilter const& _filter)
+{
+    LocalisedLogEntries logs;
+    int64_t from = std::max(_filter.fromBlock(), (BlockNumber)0);
+    int64_t to = std::min(_filter.toBlock(), (BlockNumber)number());
+    if (from > to)
+    {
+        return logs;
+    }
+    std::vector<int64_t> blocks;
+    if (g_BCOSConfig.version() < V2_1_0)
+    {
+        /// no index, the receipt blooms skip the receipts without a matched log
+        for (int64_t i = from; i <= to; ++i)
+        {
+            blocks.push_back(i);
+        }
+    }
+    else
+    {
+        Table::Ptr tb_bloom = getMemoryTableFactory()->openTable(SYS_BLOCK_2_BLOOM, false, true);
+        Table::Ptr tb_index = getMemoryTableFactory()->openTable(SYS_LOG_INDEX, false, true);
+        if (!tb_bloom || !tb_index)
+        {
+            BOOST_THROW_EXCEPTION(OpenSysTableFailed() << errinfo_comment(SYS_LOG_INDEX));
+        }
+        /// the postings of the values of a position are united, the positions are intersected
+        bool indexed = false;
+        std::set<int64_t> candidates;
+        auto intersect = [&](std::vector<std::string> const& _values) {
+            std::set<int64_t> united;
+            for (auto const& value : _values)
+            {
+                auto postings = logIndexBlocks(tb_index, value, from, to);
+                united.insert(postings.begin(), postings.end());
+            }
+            if (!indexed)
+            {
+                candidates.swap(united);
+                indexed = true;
+                return;
+            }
+            std::set<int64_t> intersection;
+            std::set_intersection(candidates.begin(), candidates.end(), united.begin(),
+                united.end(), std::inserter(intersection, intersection.begin()));
+            candidates.swap(intersection);
+        };
+        std::vector<std::string> values;
+        for (auto const& address : _filter.addresses())
+        {
+            values.push_back(address.hex());
+        }
+        if (!values.empty())
+        {
+            intersect(values);
+        }
+        for (auto const& topics : _filter.topics())
+        {
+            if (topics.empty())
+            {
+                continue;
+            }
+            values.clear();
+            for (auto const& topic : topics)
+            {
+                values.push_back(topic.hex());
+            }
+            intersect(values);
+        }
+        if (!indexed)
+        {
+            for (int64_t i = from; i <= to; ++i)
+            {
+                candidates.insert(i);
+            }
+        }
+        /// the bloom of a block rejects the candidates without a log of all the positions
+        for (auto i : candidates)
+        {
+            auto entries = tb_bloom->select(lexical_cast<std::string>(i), tb_bloom->newCondition());
+            if (entries->size() == 0 ||
+                !_filter.matches(LogBloom(fromHex(entries->get(0)->getField(SYS_VALUE)))))
+            {
+                continue;
+            }
+            blocks.push_back(i);
+        }
+    }
+    for (auto i : blocks)
+    {
+        auto block = getBlockByNumber(i);
+        if (!block)
+        {
+            continue;
+        }
+        auto matched = _filter.matches(*block);
+        logs.insert(logs.end(), matched.begin(), matched.end());
+    }
+    return logs;
+}
+
 void BlockChainImp::writeNumber2Hash(const Block& block, std::shared_ptr<ExecutiveContext> context)
 {
     Table::Ptr tb = context->getMemoryTableFactory()->openTable(SYS_NUMBER_2_HASH, false);
@@ -1001,17 +1190,19 @@ void BlockChainImp::writeNumber2Hash(const Block& block, std::shared_ptr<Executi
     }
 }
 
-void BlockChainImp::writeHash2Block(Block& block, std::shared_ptr<ExecutiveContext> context)
+std::shared_ptr<bytes> BlockChainImp::writeHash2Block(
+    Block& block, std::shared_ptr<ExecutiveContext> context)
 {
     Table::Ptr tb = context->getMemoryTableFactory()->openTable(SYS_HASH_2_BLOCK, false);
     if (tb)
     {
         Entry::Ptr entry = std::make_shared<Entry>();
-        bytes out;
-        block.encode(out);
-        entry->setField(SYS_VALUE, toHexPrefixed(out));
+        auto out = std::make_shared<bytes>();
+        block.encode(*out);
+        entry->setField(SYS_VALUE, toHexPrefixed(*out));
         entry->setForce(true);
         tb->insert(block.blockHeader().hash().hex(), entry);
+        return out;
     }
     else
     {
@@ -1042,6 +1233,8 @@ CommitResult BlockChainImp::commitBlock(Block& block, std::shared_ptr<ExecutiveC
 {
     auto start_time = utcTime();
     auto record_time = utcTime();
+    TRACE_SPAN("commitBlock", "blockchain", m_stateStorage ? m_stateStorage->groupID() : 0,
+        block.blockHeader().number());
     if (!isBlockShouldCommit(block.blockHeader().number()))
     {
         return CommitResult::ERROR_NUMBER;
@@ -1059,6 +1252,7 @@ CommitResult BlockChainImp::commitBlock(Block& block, std::shared_ptr<ExecutiveC
 
     try
     {
+        std::shared_ptr<bytes> blockRLP;
         auto before_write_time_cost = utcTime() - record_time;
         record_time = utcTime();
         {
@@ -1069,7 +1263,7 @@ CommitResult BlockChainImp::commitBlock(Block& block, std::shared_ptr<ExecutiveC
             }
             auto write_record_time = utcTime();
             // writeBlockInfo(block, context);
-            writeHash2Block(block, context);
+            blockRLP = writeHash2Block(block, context);
             auto writeHash2Block_time_cost = utcTime() - write_record_time;
             write_record_time = utcTime();
 
@@ -1089,6 +1283,10 @@ CommitResult BlockChainImp::commitBlock(Block& block, std::shared_ptr<ExecutiveC
             auto writeTxToBlock_time_cost = utcTime() - write_record_time;
             write_record_time = utcTime();
 
+            writeLogIndex(block, context);
+            auto writeLogIndex_time_cost = utcTime() - write_record_time;
+            write_record_time = utcTime();
+
             context->dbCommit(block);
             auto dbCommit_time_cost = utcTime() - write_record_time;
             write_record_time = utcTime();
@@ -1106,6 +1304,7 @@ CommitResult BlockChainImp::commitBlock(Block& block, std::shared_ptr<ExecutiveC
                                   << LOG_KV("writeTotalTransactionCountTimeCost",
                                          writeTotalTransactionCount_time_cost)
                                   << LOG_KV("writeTxToBlockTimeCost", writeTxToBlock_time_cost)
+                                  << LOG_KV("writeLogIndexTimeCost", writeLogIndex_time_cost)
                                   << LOG_KV("dbCommitTimeCost", dbCommit_time_cost)
                                   << LOG_KV(
                                          "updateBlockNumberTimeCost", updateBlockNumber_time_cost);
@@ -1113,9 +1312,10 @@ CommitResult BlockChainImp::commitBlock(Block& block, std::shared_ptr<ExecutiveC
         auto writeBlock_time_cost = utcTime() - record_time;
         record_time = utcTime();
 
-        m_blockCache.add(block);
+        m_blockCache->add(block, blockRLP);
         auto addBlockCache_time_cost = utcTime() - record_time;
         record_time = utcTime();
+        m_onBlockCommitted(block);
         m_onReady(m_blockNumber);
         auto noteReady_time_cost = utcTime() - record_time;
         record_time = utcTime();
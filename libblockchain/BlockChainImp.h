@@ -22,6 +22,7 @@
  */
 #pragma once
 
+#include "BlockCache.h"
 #include "BlockChainInterface.h"
 #include <libdevcore/Exceptions.h>
 #include <libdevcore/easylog.h>
@@ -41,6 +42,7 @@
 #include <map>
 #include <memory>
 #include <mutex>
+#include <set>
 
 #define BLOCKCHAIN_LOG(LEVEL) LOG(LEVEL) << LOG_BADGE("BLOCKCHAIN")
 
@@ -57,27 +59,12 @@ class MemoryTableFactory;
 
 namespace blockchain
 {
-class BlockChainImp;
-
-class BlockCache
-{
-public:
-    BlockCache(){};
-    std::shared_ptr<dev::eth::Block> add(dev::eth::Block const& _block);
-    std::pair<std::shared_ptr<dev::eth::Block>, dev::h256> get(h256 const& _hash);
-
-private:
-    mutable boost::shared_mutex m_sharedMutex;
-    mutable std::map<dev::h256, std::shared_ptr<dev::eth::Block>> m_blockCache;
-    mutable std::deque<dev::h256> m_blockCacheFIFO;  // insert queue log for m_blockCache
-    const unsigned c_blockCacheSize = 10;            // m_blockCache size, default set 10
-};
 DEV_SIMPLE_EXCEPTION(OpenSysTableFailed);
 
 class BlockChainImp : public BlockChainInterface
 {
 public:
-    BlockChainImp() {}
+    BlockChainImp() : m_blockCache(std::make_shared<BlockCache>()) {}
     virtual ~BlockChainImp(){};
     int64_t number() override;
     dev::h256 numberHash(int64_t _i) override;
@@ -105,17 +92,26 @@ public:
     std::string getSystemConfigByKey(std::string const& key, int64_t num = -1) override;
     void getNonces(
         std::vector<dev::eth::NonceKeyType>& _nonceVector, int64_t _blockNumber) override;
+    dev::eth::LocalisedLogEntries getLogs(dev::eth::LogFilter const& _filter) override;
+    void reload() override;
+
+    /// the blocks of an address or a topic are indexed by the segments of c_logIndexBlocks blocks
+    static const int64_t c_logIndexBlocks = 1000;
 
     void setTableFactoryFactory(dev::storage::TableFactoryFactory::Ptr tableFactoryFactory)
     {
         m_tableFactoryFactory = tableFactoryFactory;
     }
 
+    BlockCache::Ptr blockCache() { return m_blockCache; }
+
 private:
     std::shared_ptr<dev::eth::Block> getBlock(int64_t _i);
     std::shared_ptr<dev::eth::Block> getBlock(dev::h256 const& _blockHash);
     std::shared_ptr<dev::bytes> getBlockRLP(int64_t _i);
-    std::shared_ptr<dev::bytes> getBlockRLP(dev::h256 const& _blockHash);
+    /// _number is only used to index the cached RLP, -1 if unknown
+    std::shared_ptr<dev::bytes> getBlockRLP(dev::h256 const& _blockHash, int64_t _number = -1);
+    std::shared_ptr<dev::eth::Block> decodeCachedBlock(std::shared_ptr<dev::bytes> _blockRLP);
     int64_t obtainNumber();
     void writeNumber(const dev::eth::Block& block,
         std::shared_ptr<dev::blockverifier::ExecutiveContext> context);
@@ -127,7 +123,14 @@ private:
         dev::eth::Block& block, std::shared_ptr<dev::blockverifier::ExecutiveContext> context);
     void writeNumber2Hash(const dev::eth::Block& block,
         std::shared_ptr<dev::blockverifier::ExecutiveContext> context);
-    void writeHash2Block(
+    /// index the logs of the block since V2_1_0
+    void writeLogIndex(const dev::eth::Block& block,
+        std::shared_ptr<dev::blockverifier::ExecutiveContext> context);
+    /// the blocks in [_from, _to] with the logs of the address or the topic in hex
+    std::set<int64_t> logIndexBlocks(
+        dev::storage::Table::Ptr _table, std::string const& _value, int64_t _from, int64_t _to);
+    /// return the RLP written to the storage
+    std::shared_ptr<dev::bytes> writeHash2Block(
         dev::eth::Block& block, std::shared_ptr<dev::blockverifier::ExecutiveContext> context);
 
     bool isBlockShouldCommit(int64_t const& _blockNumber);
@@ -154,7 +157,7 @@ private:
     };
     std::map<std::string, SystemConfigRecord> m_systemConfigRecord;
     mutable SharedMutex m_systemConfigMutex;
-    BlockCache m_blockCache;
+    BlockCache::Ptr m_blockCache;
 
     /// cache the block number
     mutable SharedMutex m_blockNumberMutex;
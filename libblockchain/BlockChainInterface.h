@@ -3,6 +3,7 @@
 #include <libdevcore/FixedHash.h>
 #include <libethcore/Block.h>
 #include <libethcore/Common.h>
+#include <libethcore/LogFilter.h>
 #include <libethcore/Transaction.h>
 #include <libethcore/TransactionReceipt.h>
 namespace dev
@@ -65,6 +66,10 @@ public:
     virtual dev::h512s observerList() = 0;
     /// get system config
     virtual std::string getSystemConfigByKey(std::string const& key, int64_t number = -1) = 0;
+    /// get the logs of the committed blocks matching the filter, in the order of the blocks
+    virtual dev::eth::LocalisedLogEntries getLogs(dev::eth::LogFilter const& _filter) = 0;
+    /// drop all cached chain state, called after the storage has been replaced underneath
+    virtual void reload() {}
 
     /// Register a handler that will be called once there is a new transaction imported
     template <class T>
@@ -73,10 +78,28 @@ public:
         return m_onReady.add(_t);
     }
 
+    /// Register a handler called with the new block number once the chain has been reloaded
+    template <class T>
+    dev::eth::Handler<int64_t> onReload(T const& _t)
+    {
+        return m_onReload.add(_t);
+    }
+
+    /// Register a handler called with every committed block, before the onReady handlers
+    template <class T>
+    dev::eth::Handler<dev::eth::Block const&> onBlockCommitted(T const& _t)
+    {
+        return m_onBlockCommitted.add(_t);
+    }
+
 protected:
     ///< Called when a subsequent call to import transactions will return a non-empty container. Be
     ///< nice and exit fast.
     dev::eth::Signal<int64_t> m_onReady;
+    /// pass the block by reference, avoid copying it for every handler
+    dev::eth::Signal<dev::eth::Block const&> m_onBlockCommitted;
+    /// the chain head has been replaced underneath, the state cached elsewhere is stale
+    dev::eth::Signal<int64_t> m_onReload;
 };
 }  // namespace blockchain
 }  // namespace dev
@@ -21,6 +21,7 @@
 #include "BlockVerifier.h"
 #include "ExecutiveContext.h"
 #include "TxDAG.h"
+#include <libdevcore/Tracer.h>
 #include <libethcore/Exceptions.h>
 #include <libethcore/PrecompiledContract.h>
 #include <libethcore/TransactionReceipt.h>
@@ -28,7 +29,9 @@
 #include <libexecutive/Executive.h>
 #include <libstorage/Table.h>
 #include <tbb/parallel_for.h>
+#include <atomic>
 #include <exception>
+#include <future>
 #include <thread>
 
 using namespace dev;
@@ -40,14 +43,23 @@ using namespace dev::storage;
 
 ExecutiveContext::Ptr BlockVerifier::executeBlock(Block& block, BlockInfo const& parentBlockInfo)
 {
+    auto startTime = utcTimeUs();
+    TRACE_SPAN("executeBlock", "execute", m_groupId, block.blockHeader().number());
+    ExecutiveContext::Ptr executiveContext;
     if (g_BCOSConfig.version() >= RC2_VERSION && m_enableParallel)
     {
-        return parallelExecuteBlock(block, parentBlockInfo);
+        executiveContext = parallelExecuteBlock(block, parentBlockInfo);
     }
     else
     {
-        return serialExecuteBlock(block, parentBlockInfo);
+        executiveContext = serialExecuteBlock(block, parentBlockInfo);
+    }
+    if (executiveContext && m_executeBlockTime)
+    {
+        m_executeBlockTime->observe(utcTimeUs() - startTime);
+        m_executedTxs->inc(block.transactions().size());
     }
+    return executiveContext;
 }
 
 ExecutiveContext::Ptr BlockVerifier::serialExecuteBlock(
@@ -206,13 +218,37 @@ ExecutiveContext::Ptr BlockVerifier::parallelExecuteBlock(
     record_time = utcTime();
 
     shared_ptr<TxDAG> txDag = make_shared<TxDAG>();
-    txDag->init(executiveContext, block.transactions(), block.blockHeader().number());
+    txDag->init(executiveContext, block.transactions(), block.blockHeader().number(),
+        m_conflictPredictor);
 
+    // the parallel configs are trusted to declare all the conflicts unless a transaction of
+    // the block is predicted
+    bool checkConfigured = txDag->predictedTxs() > 0;
+    std::atomic_bool mispredicted(false);
     txDag->setTxExecuteFunc([&](Transaction const& _tr, ID _txId) {
+        TRACE_SPAN("executeTx", "execute", m_groupId, block.blockHeader().number());
         EnvInfo envInfo(block.blockHeader(), m_pNumberHash, 0);
         envInfo.setPrecompiledEngine(executiveContext);
+        StorageAccesses::Ptr accesses;
+        if (m_conflictPredictor)
+        {
+            accesses = std::make_shared<StorageAccesses>();
+            envInfo.setStorageAccesses(accesses);
+        }
         std::pair<ExecutionResult, TransactionReceipt> resultReceipt =
             execute(envInfo, _tr, OnOpFunc(), executiveContext);
+        if (accesses && txDag->configured(_txId))
+        {
+            if (checkConfigured && !ConflictPredictor::withinContract(_tr, *accesses))
+            {
+                mispredicted = true;
+            }
+        }
+        else if (accesses &&
+                 !m_conflictPredictor->observe(_tr, *accesses, txDag->predictedSlots(_txId)))
+        {
+            mispredicted = true;
+        }
         block.setTransactionReceipt(_txId, resultReceipt.second);
         executiveContext->getState()->commit();
         return true;
@@ -256,6 +292,28 @@ ExecutiveContext::Ptr BlockVerifier::parallelExecuteBlock(
             BlockExecutionFailed() << errinfo_comment("Error during parallel block execution"));
     }
 
+    if (mispredicted)
+    {
+        BLOCKVERIFIER_LOG(WARNING)
+            << LOG_BADGE("executeBlock")
+            << LOG_DESC("A transaction accessed the slots not predicted, execute serially")
+            << LOG_KV("blockNumber", block.blockHeader().number())
+            << LOG_KV("predictedTxs", txDag->predictedTxs());
+        if (m_mispredictedBlocks)
+        {
+            m_mispredictedBlocks->inc();
+        }
+        return serialExecuteBlock(block, parentBlockInfo);
+    }
+    if (m_predictedTxs)
+    {
+        m_predictedTxs->inc(txDag->predictedTxs());
+        if (txDag->depth() > 0)
+        {
+            m_dagParallelism->set(block.transactions().size() * 100 / txDag->depth());
+        }
+    }
+
     auto exe_time_cost = utcTime() - record_time;
     record_time = utcTime();
 
@@ -316,15 +374,81 @@ ExecutiveContext::Ptr BlockVerifier::parallelExecuteBlock(
     return executiveContext;
 }
 
+Json::Value BlockVerifier::conflictPredictions()
+{
+    Json::Value predictions;
+    predictions["enabled"] = (m_conflictPredictor != nullptr);
+    predictions["parallelism"] =
+        m_dagParallelism ? double(m_dagParallelism->value()) / 100 : double(0);
+    predictions["functions"] =
+        m_conflictPredictor ? m_conflictPredictor->status() : Json::Value(Json::arrayValue);
+    return predictions;
+}
+
 std::pair<ExecutionResult, TransactionReceipt> BlockVerifier::executeTransaction(
     const BlockHeader& blockHeader, dev::eth::Transaction const& _t)
 {
+    std::shared_ptr<dev::ThreadPool> callExecutor;
+    {
+        Guard l(x_callContexts);
+        if (!m_callExecutor)
+        {
+            m_callExecutor = std::make_shared<dev::ThreadPool>("call", m_callThreads);
+        }
+        callExecutor = m_callExecutor;
+    }
+    // the calls never wait for the block execution threads
+    typedef std::pair<ExecutionResult, TransactionReceipt> CallResult;
+    auto self = shared_from_this();
+    auto task = std::make_shared<std::packaged_task<CallResult()>>(
+        [self, blockHeader, _t]() { return self->executeCall(blockHeader, _t); });
+    auto result = task->get_future();
+    callExecutor->enqueue([task]() { (*task)(); });
+    return result.get();
+}
+
+std::pair<ExecutionResult, TransactionReceipt> BlockVerifier::executeCall(
+    const BlockHeader& _blockHeader, dev::eth::Transaction const& _t)
+{
+    auto executiveContext = borrowCallContext(_blockHeader);
+    EnvInfo envInfo(_blockHeader, m_pNumberHash, 0);
+    envInfo.setPrecompiledEngine(executiveContext);
+    // the change log of the table factory is thread specific, the savepoints are taken and rolled
+    // back by the thread executing the call
+    auto state = executiveContext->getState();
+    auto tableFactory = executiveContext->getMemoryTableFactory();
+    size_t stateSavepoint = state->savepoint();
+    size_t tableSavepoint = tableFactory->savepoint();
+    auto result = execute(envInfo, _t, OnOpFunc(), executiveContext);
+    state->rollback(stateSavepoint);
+    tableFactory->rollback(tableSavepoint);
+    returnCallContext(_blockHeader.hash(), executiveContext);
+    return result;
+}
+
+ExecutiveContext::Ptr BlockVerifier::borrowCallContext(const BlockHeader& _blockHeader)
+{
+    {
+        Guard l(x_callContexts);
+        if (m_callContextsBlock != _blockHeader.hash())
+        {
+            // the contexts of the previous block read stale states
+            m_callContexts.clear();
+            m_callContextsBlock = _blockHeader.hash();
+        }
+        if (!m_callContexts.empty())
+        {
+            auto executiveContext = m_callContexts.back();
+            m_callContexts.pop_back();
+            return executiveContext;
+        }
+    }
     ExecutiveContext::Ptr executiveContext = std::make_shared<ExecutiveContext>();
-    BlockInfo blockInfo{blockHeader.hash(), blockHeader.number(), blockHeader.stateRoot()};
+    BlockInfo blockInfo{_blockHeader.hash(), _blockHeader.number(), _blockHeader.stateRoot()};
     try
     {
         m_executiveContextFactory->initExecutiveContext(
-            blockInfo, blockHeader.stateRoot(), executiveContext);
+            blockInfo, _blockHeader.stateRoot(), executiveContext);
     }
     catch (exception& e)
     {
@@ -332,10 +456,16 @@ std::pair<ExecutionResult, TransactionReceipt> BlockVerifier::executeTransaction
             << LOG_DESC("[executeTransaction] Error during execute initExecutiveContext")
             << LOG_KV("errorMsg", boost::diagnostic_information(e));
     }
+    return executiveContext;
+}
 
-    EnvInfo envInfo(blockHeader, m_pNumberHash, 0);
-    envInfo.setPrecompiledEngine(executiveContext);
-    return execute(envInfo, _t, OnOpFunc(), executiveContext);
+void BlockVerifier::returnCallContext(h256 const& _blockHash, ExecutiveContext::Ptr _context)
+{
+    Guard l(x_callContexts);
+    if (m_callContextsBlock == _blockHash && m_callContexts.size() < m_callThreads)
+    {
+        m_callContexts.push_back(_context);
+    }
 }
 
 std::pair<ExecutionResult, TransactionReceipt> BlockVerifier::execute(EnvInfo const& _envInfo,
@@ -21,12 +21,16 @@
 #pragma once
 
 #include "BlockVerifierInterface.h"
+#include "ConflictPredictor.h"
 #include "ExecutiveContext.h"
 #include "ExecutiveContextFactory.h"
 #include "Precompiled.h"
 #include <libdevcore/FixedHash.h>
 #include <libdevcore/easylog.h>
 #include <libdevcrypto/Common.h>
+#include <libdevcore/Guards.h>
+#include <libdevcore/Metrics.h>
+#include <libdevcore/ThreadPool.h>
 #include <libethcore/Block.h>
 #include <libethcore/Protocol.h>
 #include <libethcore/Transaction.h>
@@ -76,6 +80,7 @@ public:
     ExecutiveContext::Ptr parallelExecuteBlock(
         dev::eth::Block& block, BlockInfo const& parentBlockInfo);
 
+    /// execute a call on the state of the block, the writes of the call are discarded
     std::pair<dev::executive::ExecutionResult, dev::eth::TransactionReceipt> executeTransaction(
         const dev::eth::BlockHeader& blockHeader, dev::eth::Transaction const& _t);
 
@@ -93,12 +98,62 @@ public:
     {
         m_pNumberHash = _pNumberHash;
     }
+    /// register the execution metrics of the group
+    void setGroupId(int _groupId)
+    {
+        m_groupId = _groupId;
+        auto& registry = dev::metrics::MetricsRegistry::instance();
+        auto labels = dev::metrics::groupLabels(_groupId);
+        m_executeBlockTime =
+            &registry.histogram("block_execute_us", "time to execute a block", labels);
+        m_executedTxs = &registry.counter(
+            "block_executed_txs_total", "transactions executed in blocks", labels);
+        m_predictedTxs = &registry.counter("block_dag_predicted_txs_total",
+            "transactions executed in parallel by the predicted conflicts", labels);
+        m_mispredictedBlocks = &registry.counter("block_dag_mispredicted_total",
+            "blocks executed again serially for a violated prediction", labels);
+        m_dagParallelism = &registry.gauge("block_dag_parallelism",
+            "transactions of the latest parallel block per transaction on the longest path of "
+            "its DAG, multiplied by 100",
+            labels);
+    }
+    /// predict the conflicts of the transactions without parallel configs, parallel only
+    void setEnableConflictPrediction(bool _enable)
+    {
+        m_conflictPredictor =
+            (_enable && m_enableParallel) ? std::make_shared<ConflictPredictor>() : nullptr;
+    }
+    Json::Value conflictPredictions() override;
+    /// the calls are executed by a thread pool of their own, separate from block execution
+    void setCallThreads(size_t _callThreads) { m_callThreads = std::max(_callThreads, (size_t)1); }
+
+protected:
+    std::pair<dev::executive::ExecutionResult, dev::eth::TransactionReceipt> executeCall(
+        const dev::eth::BlockHeader& _blockHeader, dev::eth::Transaction const& _t);
+    ExecutiveContext::Ptr borrowCallContext(const dev::eth::BlockHeader& _blockHeader);
+    void returnCallContext(h256 const& _blockHash, ExecutiveContext::Ptr _context);
 
 private:
     ExecutiveContextFactory::Ptr m_executiveContextFactory;
     NumberHashCallBackFunction m_pNumberHash;
     bool m_enableParallel;
     unsigned int m_threadNum = -1;
+
+    int m_groupId = 0;
+    dev::metrics::Histogram* m_executeBlockTime = nullptr;
+    dev::metrics::Counter* m_executedTxs = nullptr;
+    dev::metrics::Counter* m_predictedTxs = nullptr;
+    dev::metrics::Counter* m_mispredictedBlocks = nullptr;
+    dev::metrics::Gauge* m_dagParallelism = nullptr;
+
+    ConflictPredictor::Ptr m_conflictPredictor;
+
+    size_t m_callThreads = 4;
+    std::shared_ptr<dev::ThreadPool> m_callExecutor;
+    /// the idle contexts of the latest block called, a context serves a call at a time
+    h256 m_callContextsBlock;
+    std::vector<ExecutiveContext::Ptr> m_callContexts;
+    Mutex x_callContexts;
 };
 
 }  // namespace blockverifier
@@ -30,6 +30,7 @@
 #include <libethcore/TransactionReceipt.h>
 #include <libevm/ExtVMFace.h>
 #include <libexecutive/ExecutionResult.h>
+#include <json/json.h>
 #include <libmptstate/State.h>
 #include <memory>
 
@@ -54,6 +55,8 @@ public:
     virtual std::pair<dev::executive::ExecutionResult, dev::eth::TransactionReceipt>
     executeTransaction(
         const dev::eth::BlockHeader& blockHeader, dev::eth::Transaction const& _t) = 0;
+    /// the conflicts predicted for the parallel execution of the functions
+    virtual Json::Value conflictPredictions() = 0;
 };
 }  // namespace blockverifier
 }  // namespace dev
@@ -0,0 +1,304 @@
+/*
+ * @CopyRight:
+ * FISCO-BCOS is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * FISCO-BCOS is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with FISCO-BCOS.  If not, see <http://www.gnu.org/licenses/>
+ * (c) 2016-2018 fisco-dev contributors.
+ */
+/**
+ * @brief : predict the storage slots accessed by the transactions of the contracts without
+ *          parallel configs, by the slots accessed by their former transactions
+ * @file: ConflictPredictor.cpp
+ */
+
+#include "ConflictPredictor.h"
+#include <libconfig/GlobalConfigure.h>
+#include <libdevcrypto/Hash.h>
+#include <algorithm>
+#include <cstring>
+
+using namespace std;
+using namespace dev;
+using namespace dev::eth;
+using namespace dev::blockverifier;
+
+namespace
+{
+bool argumentOf(Transaction const& _tx, size_t _index, h256& _word)
+{
+    size_t offset = 4 + _index * h256::size;
+    if (_tx.data().size() < offset + h256::size)
+    {
+        return false;
+    }
+    memcpy(_word.data(), _tx.data().data() + offset, h256::size);
+    return true;
+}
+
+h256 senderOf(Transaction const& _tx)
+{
+    h256 word;
+    memcpy(word.data() + h256::size - Address::size, _tx.sender().data(), Address::size);
+    return word;
+}
+
+/// the slot of the element of a solidity mapping, sha3(key . mappingSlot)
+u256 mappingSlot(h256 const& _key, u256 const& _base)
+{
+    h512 input;
+    memcpy(input.data(), _key.data(), h256::size);
+    memcpy(input.data() + h256::size, h256(_base).data(), h256::size);
+    return u256(sha3(bytesConstRef(input.data(), h512::size)));
+}
+}  // namespace
+
+const size_t ConflictPredictor::c_maxArgs;
+const size_t ConflictPredictor::c_maxMappingSlot;
+const size_t ConflictPredictor::c_maxOffset;
+const size_t ConflictPredictor::c_maxRules;
+const size_t ConflictPredictor::c_confirmations;
+const size_t ConflictPredictor::c_maxViolations;
+const size_t ConflictPredictor::c_maxFunctions;
+
+std::shared_ptr<ConflictPredictor::Slots const> ConflictPredictor::predict(
+    Transaction const& _tx) const
+{
+    // the nonces and the balances are changed out of the storage before RC2
+    Key key;
+    if (g_BCOSConfig.version() < RC2_VERSION || !keyOf(_tx, key))
+    {
+        return nullptr;
+    }
+    std::set<Rule> rules;
+    {
+        ReadGuard l(x_functions);
+        auto it = m_functions.find(key);
+        if (it == m_functions.end() || it->second.unpredictable ||
+            it->second.confirmations < c_confirmations)
+        {
+            return nullptr;
+        }
+        rules = it->second.rules;
+    }
+    auto slots = std::make_shared<Slots>();
+    slots->reserve(rules.size());
+    for (auto const& rule : rules)
+    {
+        u256 slot;
+        if (!slotOf(_tx, rule, slot))
+        {
+            return nullptr;
+        }
+        slots->emplace_back(_tx.receiveAddress(), slot);
+    }
+    return slots;
+}
+
+bool ConflictPredictor::observe(Transaction const& _tx, StorageAccesses const& _accesses,
+    std::shared_ptr<Slots const> _predicted)
+{
+    bool violated = false;
+    if (_predicted)
+    {
+        std::set<std::pair<Address, u256>> predicted(_predicted->begin(), _predicted->end());
+        violated = _accesses.opaque;
+        for (auto const& access : _accesses.slots)
+        {
+            if (!predicted.count(access))
+            {
+                violated = true;
+                break;
+            }
+        }
+    }
+    Key key;
+    if (!keyOf(_tx, key))
+    {
+        return !violated;
+    }
+
+    bool learn = false;
+    {
+        ReadGuard l(x_functions);
+        auto it = m_functions.find(key);
+        if (it == m_functions.end())
+        {
+            learn = m_functions.size() < c_maxFunctions;
+        }
+        else
+        {
+            learn = !it->second.unpredictable &&
+                    (it->second.confirmations < c_confirmations || violated);
+        }
+    }
+    // the slots are explained until the rules are confirmed, then only the predictions are checked
+    if (!learn && !_predicted)
+    {
+        return true;
+    }
+    std::set<Rule> rules;
+    bool explained = learn && explain(_tx, _accesses, rules);
+
+    WriteGuard l(x_functions);
+    auto& function = m_functions[key];
+    if (_predicted)
+    {
+        ++function.predicted;
+    }
+    if (violated)
+    {
+        ++function.violations;
+        function.confirmations = 0;
+        function.unpredictable = function.unpredictable || function.violations >= c_maxViolations;
+    }
+    if (!learn)
+    {
+        return !violated;
+    }
+    if (!explained)
+    {
+        function.unpredictable = true;
+    }
+    else if (std::includes(
+                 function.rules.begin(), function.rules.end(), rules.begin(), rules.end()))
+    {
+        ++function.confirmations;
+    }
+    else
+    {
+        // a branch of the function accessed other slots
+        function.rules.insert(rules.begin(), rules.end());
+        function.confirmations = 1;
+        function.unpredictable = function.rules.size() > c_maxRules;
+    }
+    return !violated;
+}
+
+bool ConflictPredictor::withinContract(Transaction const& _tx, StorageAccesses const& _accesses)
+{
+    for (auto const& access : _accesses.slots)
+    {
+        if (access.first != _tx.receiveAddress())
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+Json::Value ConflictPredictor::status() const
+{
+    Json::Value functions(Json::arrayValue);
+    ReadGuard l(x_functions);
+    for (auto const& it : m_functions)
+    {
+        Json::Value function;
+        function["contract"] = toHexPrefixed(it.first.first);
+        bytes selector(4);
+        toBigEndian(it.first.second, selector);
+        function["selector"] = toHexPrefixed(selector);
+        function["rules"] = (Json::UInt64)it.second.rules.size();
+        function["confirmed"] =
+            !it.second.unpredictable && it.second.confirmations >= c_confirmations;
+        function["predictable"] = !it.second.unpredictable;
+        function["predicted"] = (Json::UInt64)it.second.predicted;
+        function["violations"] = (Json::UInt64)it.second.violations;
+        if (it.second.predicted > 0)
+        {
+            function["accuracy"] = double(it.second.predicted - it.second.violations) /
+                                   double(it.second.predicted);
+        }
+        functions.append(function);
+    }
+    return functions;
+}
+
+bool ConflictPredictor::keyOf(Transaction const& _tx, Key& _key)
+{
+    if (_tx.isCreation() || _tx.data().size() < 4)
+    {
+        return false;
+    }
+    _key.first = _tx.receiveAddress();
+    _key.second = fromBigEndian<uint32_t>(bytesConstRef(_tx.data().data(), 4));
+    return true;
+}
+
+bool ConflictPredictor::explain(
+    Transaction const& _tx, StorageAccesses const& _accesses, std::set<Rule>& _rules)
+{
+    if (_accesses.opaque)
+    {
+        return false;
+    }
+    std::vector<std::pair<u256, Rule>> mappings;
+    auto addMappings = [&](h256 const& _key, RuleKind _kind, size_t _arg) {
+        for (size_t base = 0; base < c_maxMappingSlot; ++base)
+        {
+            mappings.emplace_back(mappingSlot(_key, base), Rule{_kind, _arg, base, 0});
+        }
+    };
+    for (auto const& access : _accesses.slots)
+    {
+        if (access.first != _tx.receiveAddress())
+        {
+            return false;
+        }
+        if (mappings.empty())
+        {
+            h256 word;
+            for (size_t arg = 0; arg < c_maxArgs && argumentOf(_tx, arg, word); ++arg)
+            {
+                addMappings(word, RuleKind::Argument, arg);
+            }
+            addMappings(senderOf(_tx), RuleKind::Sender, 0);
+        }
+        Rule rule{RuleKind::Constant, 0, access.second, 0};
+        for (auto const& mapping : mappings)
+        {
+            if (access.second >= mapping.first && access.second - mapping.first < c_maxOffset)
+            {
+                rule = mapping.second;
+                rule.offset = access.second - mapping.first;
+                break;
+            }
+        }
+        _rules.insert(rule);
+        if (_rules.size() > c_maxRules)
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+bool ConflictPredictor::slotOf(Transaction const& _tx, Rule const& _rule, u256& _slot)
+{
+    h256 key;
+    switch (_rule.kind)
+    {
+    case RuleKind::Constant:
+        _slot = _rule.base;
+        return true;
+    case RuleKind::Argument:
+        if (!argumentOf(_tx, _rule.arg, key))
+        {
+            return false;
+        }
+        break;
+    case RuleKind::Sender:
+        key = senderOf(_tx);
+        break;
+    }
+    _slot = mappingSlot(key, _rule.base) + _rule.offset;
+    return true;
+}
@@ -0,0 +1,119 @@
+/*
+ * @CopyRight:
+ * FISCO-BCOS is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * FISCO-BCOS is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with FISCO-BCOS.  If not, see <http://www.gnu.org/licenses/>
+ * (c) 2016-2018 fisco-dev contributors.
+ */
+/**
+ * @brief : predict the storage slots accessed by the transactions of the contracts without
+ *          parallel configs, by the slots accessed by their former transactions
+ * @file: ConflictPredictor.h
+ */
+
+#pragma once
+#include <json/json.h>
+#include <libdevcore/Guards.h>
+#include <libethcore/Transaction.h>
+#include <libevm/ExtVMFace.h>
+#include <map>
+#include <memory>
+#include <set>
+#include <tuple>
+#include <vector>
+
+namespace dev
+{
+namespace blockverifier
+{
+/**
+ * A slot accessed by a function of a contract is learned as a rule: a constant slot, or an element
+ * of a solidity mapping keyed by an argument of the call or by the sender, which is
+ * sha3(key . mappingSlot) + offset. Once the rules of a function explained c_confirmations
+ * transactions in a row, the slots of its transactions are predicted by the rules. A predicted
+ * transaction is checked against the slots it actually accessed, the block is executed again
+ * serially if a prediction is violated.
+ */
+class ConflictPredictor
+{
+public:
+    typedef std::shared_ptr<ConflictPredictor> Ptr;
+    typedef std::vector<std::pair<Address, u256>> Slots;
+
+    /// the arguments and the mapping slots tried to explain a slot
+    static const size_t c_maxArgs = 8;
+    static const size_t c_maxMappingSlot = 16;
+    static const size_t c_maxOffset = 8;
+    /// the functions accessing more slots are not predicted
+    static const size_t c_maxRules = 16;
+    static const size_t c_confirmations = 3;
+    /// the functions mispredicted more times are never predicted again
+    static const size_t c_maxViolations = 3;
+    static const size_t c_maxFunctions = 10000;
+
+    /// @returns the slots the transaction is predicted to access, nullptr if not predictable
+    std::shared_ptr<Slots const> predict(dev::eth::Transaction const& _tx) const;
+
+    /// learn the slots accessed by the transaction
+    /// @returns false if the transaction is predicted and accessed a slot not predicted
+    bool observe(dev::eth::Transaction const& _tx, dev::eth::StorageAccesses const& _accesses,
+        std::shared_ptr<Slots const> _predicted);
+
+    /// @returns true if the transaction accessed the storage of its contract only
+    static bool withinContract(
+        dev::eth::Transaction const& _tx, dev::eth::StorageAccesses const& _accesses);
+
+    /// the rules, the predictions and the violations of the functions
+    Json::Value status() const;
+
+private:
+    enum class RuleKind
+    {
+        Constant,
+        Argument,
+        Sender
+    };
+    struct Rule
+    {
+        RuleKind kind;
+        size_t arg;
+        /// the constant slot or the slot of the mapping
+        u256 base;
+        u256 offset;
+        bool operator<(Rule const& _rhs) const
+        {
+            return std::tie(kind, arg, base, offset) <
+                   std::tie(_rhs.kind, _rhs.arg, _rhs.base, _rhs.offset);
+        }
+    };
+    struct Function
+    {
+        std::set<Rule> rules;
+        size_t confirmations = 0;
+        uint64_t predicted = 0;
+        uint64_t violations = 0;
+        bool unpredictable = false;
+    };
+    /// the contract and the selector
+    typedef std::pair<Address, uint32_t> Key;
+
+    static bool keyOf(dev::eth::Transaction const& _tx, Key& _key);
+    /// @returns the rules of the slots accessed, false if they can not be explained
+    static bool explain(dev::eth::Transaction const& _tx,
+        dev::eth::StorageAccesses const& _accesses, std::set<Rule>& _rules);
+    static bool slotOf(dev::eth::Transaction const& _tx, Rule const& _rule, u256& _slot);
+
+    std::map<Key, Function> m_functions;
+    mutable SharedMutex x_functions;
+};
+}  // namespace blockverifier
+}  // namespace dev
@@ -169,37 +169,11 @@ std::shared_ptr<std::vector<std::string>> ExecutiveContext::getTxCriticals(const
         }
         else
         {
-            {  // Testing code
-                // bytesConstRef data = parallelConfigPrecompiled->getParamData(ref(_tx.data()));
+            {
                 auto res = make_shared<vector<string>>();
-
-                ABIFunc af;
-                bool isOk = af.parser(config->functionName);
-                if (!isOk)
-                {
-                    EXECUTIVECONTEXT_LOG(DEBUG)
-                        << LOG_DESC("[getTxCriticals] parser function signature failed, ")
-                        << LOG_KV("func signature", config->functionName);
-
-                    return nullptr;
-                }
-
-                auto paramTypes = af.getParamsType();
-                if (paramTypes.size() < (size_t)config->criticalSize)
-                {
-                    EXECUTIVECONTEXT_LOG(DEBUG)
-                        << LOG_DESC("[getTxCriticals] params type less than  criticalSize")
-                        << LOG_KV("func signature", config->functionName)
-                        << LOG_KV("func criticalSize", config->criticalSize)
-                        << LOG_KV("input data", toHex(_tx.data()));
-
-                    return nullptr;
-                }
-
-                paramTypes.resize((size_t)config->criticalSize);
-
                 ContractABI abi;
-                isOk = abi.abiOutByFuncSelector(ref(_tx.data()).cropped(4), paramTypes, *res);
+                bool isOk = abi.abiOutByFuncSelector(
+                    ref(_tx.data()).cropped(4), config->criticalTypes, *res);
                 if (!isOk)
                 {
                     EXECUTIVECONTEXT_LOG(DEBUG) << LOG_DESC("[getTxCriticals] abiout failed, ")
@@ -64,8 +64,10 @@ void ExecutiveContextFactory::initExecutiveContext(
         Address(0x1004), std::make_shared<dev::precompiled::CNSPrecompiled>());
     context->setAddress2Precompiled(
         Address(0x1005), std::make_shared<dev::precompiled::PermissionPrecompiled>());
-    context->setAddress2Precompiled(
-        Address(0x1006), std::make_shared<dev::precompiled::ParallelConfigPrecompiled>());
+    auto parallelConfigPrecompiled =
+        std::make_shared<dev::precompiled::ParallelConfigPrecompiled>();
+    parallelConfigPrecompiled->setParallelConfigCache(m_parallelConfigCache);
+    context->setAddress2Precompiled(Address(0x1006), parallelConfigPrecompiled);
     // register User developed Precompiled contract
     registerUserPrecompiled(context);
     context->setMemoryTableFactory(memoryTableFactory);
@@ -23,6 +23,7 @@
 #include "ExecutiveContext.h"
 #include <libdevcore/OverlayDB.h>
 #include <libexecutive/StateFactoryInterface.h>
+#include <libprecompiled/ParallelConfigPrecompiled.h>
 #include <libstorage/Storage.h>
 #include <libstorage/Table.h>
 
@@ -64,11 +65,17 @@ public:
         m_tableFactoryFactory = tableFactoryFactory;
     }
 
+    /// called when the chain state is replaced, e.g. a snapshot is installed
+    virtual void clearParallelConfigCache() { m_parallelConfigCache->clear(); }
+
 private:
     dev::storage::TableFactoryFactory::Ptr m_tableFactoryFactory;
     dev::storage::Storage::Ptr m_stateStorage;
     std::shared_ptr<dev::executive::StateFactoryInterface> m_stateFactoryInterface;
     std::unordered_map<Address, dev::eth::PrecompiledContract> m_precompiledContract;
+    /// the parallel configs read by the contexts of the group
+    dev::precompiled::ParallelConfigCache::Ptr m_parallelConfigCache =
+        std::make_shared<dev::precompiled::ParallelConfigCache>();
 
     void setTxGasLimitToContext(ExecutiveContext::Ptr context);
     void registerUserPrecompiled(ExecutiveContext::Ptr context);
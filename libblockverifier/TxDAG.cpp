@@ -22,7 +22,10 @@
 
 #include "TxDAG.h"
 #include "Common.h"
+#include <tbb/parallel_for.h>
+#include <algorithm>
 #include <map>
+#include <set>
 
 using namespace std;
 using namespace dev;
@@ -32,7 +35,8 @@ using namespace dev::blockverifier;
 #define DAG_LOG(LEVEL) LOG(LEVEL) << LOG_BADGE("DAG")
 
 // Generate DAG according with given transactions
-void TxDAG::init(ExecutiveContext::Ptr _ctx, Transactions const& _txs, int64_t _blockHeight)
+void TxDAG::init(ExecutiveContext::Ptr _ctx, Transactions const& _txs, int64_t _blockHeight,
+    ConflictPredictor::Ptr _predictor)
 {
     DAG_LOG(TRACE) << LOG_DESC("Begin init transaction DAG") << LOG_KV("blockHeight", _blockHeight)
                    << LOG_KV("transactionNum", _txs.size());
@@ -40,14 +44,70 @@ void TxDAG::init(ExecutiveContext::Ptr _ctx, Transactions const& _txs, int64_t _
     m_txs = make_shared<Transactions const>(_txs);
     m_dag.init(_txs.size());
 
+    // the criticals are read from the state in parallel and the edges are added in order
+    std::vector<std::shared_ptr<std::vector<std::string>>> txsCriticals(_txs.size());
+    m_predictedSlots.assign(_txs.size(), nullptr);
+    m_configured.assign(_txs.size(), false);
+    tbb::parallel_for(
+        tbb::blocked_range<ID>(0, _txs.size()), [&](const tbb::blocked_range<ID>& _range) {
+            for (ID id = _range.begin(); id != _range.end(); ++id)
+            {
+                auto const& tx = _txs[id];
+                txsCriticals[id] = _ctx->getTxCriticals(tx);
+                m_configured[id] = (txsCriticals[id] != nullptr);
+                if (txsCriticals[id] || !_predictor || tx.isCreation() ||
+                    _ctx->isPrecompiled(tx.receiveAddress()))
+                {
+                    continue;
+                }
+                auto slots = _predictor->predict(tx);
+                if (slots)
+                {
+                    // the slots are prefixed apart from the params of the parallel configs
+                    auto criticals = make_shared<vector<string>>();
+                    for (auto const& slot : *slots)
+                    {
+                        criticals->push_back("#" + toHex(h256(slot.second)) + slot.first.hex());
+                    }
+                    txsCriticals[id] = criticals;
+                    m_predictedSlots[id] = slots;
+                }
+            }
+        });
+    // The parallel configs only declare the conflicts between the configured transactions, a
+    // predicted transaction accessing a contract called by a configured one of the block falls
+    // back to conflict with all the others
+    std::set<Address> configuredContracts;
+    for (ID id = 0; id < _txs.size(); ++id)
+    {
+        if (m_configured[id])
+        {
+            configuredContracts.insert(_txs[id].receiveAddress());
+        }
+    }
+    for (ID id = 0; id < _txs.size() && !configuredContracts.empty(); ++id)
+    {
+        auto const& slots = m_predictedSlots[id];
+        if (slots && std::any_of(slots->begin(), slots->end(),
+                         [&](std::pair<Address, u256> const& _slot) {
+                             return configuredContracts.count(_slot.first) > 0;
+                         }))
+        {
+            m_predictedSlots[id] = nullptr;
+            txsCriticals[id] = nullptr;
+        }
+    }
+    m_predictedTxs = std::count_if(m_predictedSlots.begin(), m_predictedSlots.end(),
+        [](std::shared_ptr<ConflictPredictor::Slots const> const& _slots) { return !!_slots; });
+
     CriticalField<string> latestCriticals;
+    // the level of a transaction in the DAG, the edges are from the former transactions
+    std::vector<ID> levels(_txs.size(), 0);
 
     for (ID id = 0; id < _txs.size(); ++id)
     {
-        auto& tx = _txs[id];
-
         // Is para transaction?
-        auto criticals = _ctx->getTxCriticals(tx);
+        auto& criticals = txsCriticals[id];
         if (criticals)
         {
             // DAG transaction: Conflict with certain critical fields
@@ -62,6 +122,7 @@ void TxDAG::init(ExecutiveContext::Ptr _ctx, Transactions const& _txs, int64_t _
                     DAG_LOG(TRACE)
                         << LOG_DESC("Add edge") << LOG_KV("from", pId) << LOG_KV("to", id);
                     m_dag.addEdge(pId, id);  // add DAG edge
+                    levels[id] = std::max(levels[id], levels[pId] + 1);
                 }
             }
 
@@ -77,6 +138,7 @@ void TxDAG::init(ExecutiveContext::Ptr _ctx, Transactions const& _txs, int64_t _
                 ID pId = _fieldAndId.second;
                 // Add edge from all critical transaction
                 m_dag.addEdge(pId, id);
+                levels[id] = std::max(levels[id], levels[pId] + 1);
                 return true;
             });
 
@@ -89,6 +151,7 @@ void TxDAG::init(ExecutiveContext::Ptr _ctx, Transactions const& _txs, int64_t _
     m_dag.generate();
 
     m_totalParaTxs = _txs.size();
+    m_depth = levels.empty() ? 0 : *std::max_element(levels.begin(), levels.end()) + 1;
 
     DAG_LOG(TRACE) << LOG_DESC("End init transaction DAG") << LOG_KV("blockHeight", _blockHeight);
 }
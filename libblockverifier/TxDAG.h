@@ -21,6 +21,7 @@
  */
 
 #pragma once
+#include "ConflictPredictor.h"
 #include "DAG.h"
 #include "ExecutiveContext.h"
 #include <libethcore/Block.h>
@@ -56,8 +57,10 @@ public:
     TxDAG() : m_dag() {}
     virtual ~TxDAG() {}
 
-    // Generate DAG according with given transactions
-    void init(ExecutiveContext::Ptr _ctx, dev::eth::Transactions const& _txs, int64_t _blockHeight);
+    // Generate DAG according with given transactions, the criticals of the transactions without
+    // parallel configs are predicted by _predictor if set
+    void init(ExecutiveContext::Ptr _ctx, dev::eth::Transactions const& _txs, int64_t _blockHeight,
+        ConflictPredictor::Ptr _predictor = nullptr);
 
     // Set transaction execution function
     void setTxExecuteFunc(ExecuteTxFunc const& _f);
@@ -75,6 +78,17 @@ public:
 
     ID haveExecuteNumber() { return m_exeCnt; }
 
+    /// the slots predicted for the transaction, nullptr if not predicted
+    std::shared_ptr<ConflictPredictor::Slots const> predictedSlots(ID _id) const
+    {
+        return m_predictedSlots[_id];
+    }
+    /// the transaction is parallel by a parallel config or a parallel precompiled
+    bool configured(ID _id) const { return m_configured[_id]; }
+    ID predictedTxs() const { return m_predictedTxs; }
+    /// the transactions on the longest path of the DAG
+    ID depth() const { return m_depth; }
+
 private:
     ExecuteTxFunc f_executeTx;
     std::shared_ptr<dev::eth::Transactions const> m_txs;
@@ -84,6 +98,11 @@ private:
     ID m_exeCnt = 0;
     ID m_totalParaTxs = 0;
 
+    std::vector<std::shared_ptr<ConflictPredictor::Slots const>> m_predictedSlots;
+    std::vector<char> m_configured;
+    ID m_predictedTxs = 0;
+    ID m_depth = 0;
+
     mutable std::mutex x_exeCnt;
 };
 
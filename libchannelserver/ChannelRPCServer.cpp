@@ -29,6 +29,8 @@
 #include <fcntl.h>
 #include <json/json.h>
 #include <libdevcore/easylog.h>
+#include <libethcore/Exceptions.h>
+#include <librpc/JsonHelper.h>
 #include <libp2p/P2PMessage.h>
 #include <libp2p/Service.h>
 #include <netinet/in.h>
@@ -37,12 +39,15 @@
 #include <boost/algorithm/string/classification.hpp>
 #include <boost/asio.hpp>
 #include <boost/asio/ssl.hpp>
+#include <boost/lexical_cast.hpp>
 #include <boost/random.hpp>
 #include <boost/range/algorithm/remove_if.hpp>
 #include <boost/uuid/uuid_generators.hpp>
 #include <boost/uuid/uuid_io.hpp>
+#include <algorithm>
 #include <cstdio>
 #include <cstdlib>
+#include <limits>
 #include <string>
 
 using namespace std;
@@ -241,6 +246,19 @@ void ChannelRPCServer::onDisconnect(
         }
     }
 
+    {
+        std::lock_guard<std::mutex> l(x_logSubscriptions);
+        for (auto& it : m_logSubscriptions)
+        {
+            auto& subscriptions = it.second;
+            subscriptions.erase(std::remove_if(subscriptions.begin(), subscriptions.end(),
+                                    [&](LogSubscription const& _subscription) {
+                                        return _subscription.session == session;
+                                    }),
+                subscriptions.end());
+        }
+    }
+
     updateHostTopics();
 }
 
@@ -277,6 +295,9 @@ void dev::ChannelRPCServer::onClientRequest(dev::channel::ChannelSession::Ptr se
         case 0x32:
             onClientTopicRequest(session, message);
             break;
+        case 0x15:
+            onClientRegisterEventLogRequest(session, message);
+            break;
         default:
             CHANNEL_LOG(ERROR) << "unknown client message" << LOG_KV("type", message->type());
             break;
@@ -814,6 +835,154 @@ dev::channel::TopicChannelMessage::Ptr ChannelRPCServer::pushChannelMessage(
     return dev::channel::TopicChannelMessage::Ptr();
 }
 
+const size_t ChannelRPCServer::c_maxLogSubscriptions;
+const size_t ChannelRPCServer::c_maxPendingEventLogBlocks;
+
+void dev::ChannelRPCServer::onClientRegisterEventLogRequest(
+    dev::channel::ChannelSession::Ptr session, dev::channel::Message::Ptr message)
+{
+    std::string body(message->data(), message->data() + message->dataSize());
+    CHANNEL_LOG(DEBUG) << "SDK register event log"
+                       << LOG_KV("seq", message->seq().substr(0, c_seqAbridgedLen))
+                       << LOG_KV("message", body);
+
+    Json::Value response;
+    response["result"] = 0;
+    try
+    {
+        std::stringstream ss;
+        ss << body;
+        Json::Value root;
+        ss >> root;
+        if (!root.isObject())
+        {
+            BOOST_THROW_EXCEPTION(InvalidLogFilter() << errinfo_comment("invalid json"));
+        }
+        LogSubscription subscription;
+        subscription.session = session;
+        subscription.filterID = root["filterID"].asString();
+        response["filterID"] = subscription.filterID;
+        /// the logs of the blocks committed from now on by default
+        auto const c_lastBlock = std::numeric_limits<BlockNumber>::max();
+        subscription.filter = dev::rpc::toLogFilter(root, c_lastBlock);
+        if (subscription.filter.fromBlock() == c_lastBlock)
+        {
+            subscription.filter.setRange(0, subscription.filter.toBlock());
+        }
+        int groupID = boost::lexical_cast<int>(root["groupID"].asString());
+
+        std::lock_guard<std::mutex> l(x_logSubscriptions);
+        size_t sessionSubscriptions = 0;
+        for (auto const& it : m_logSubscriptions)
+        {
+            sessionSubscriptions += std::count_if(it.second.begin(), it.second.end(),
+                [&](LogSubscription const& _subscription) {
+                    return _subscription.session == session;
+                });
+        }
+        if (sessionSubscriptions >= c_maxLogSubscriptions)
+        {
+            BOOST_THROW_EXCEPTION(
+                InvalidLogFilter() << errinfo_comment("too many subscriptions of the session"));
+        }
+        m_logSubscriptions[groupID].push_back(subscription);
+    }
+    catch (std::exception& e)
+    {
+        CHANNEL_LOG(WARNING) << "onClientRegisterEventLogRequest error"
+                             << LOG_KV("what", boost::diagnostic_information(e));
+        response["result"] = -1;
+    }
+
+    std::string data = response.toStyledString();
+    message->setResult(0);
+    message->setData((const byte*)data.data(), data.size());
+    session->asyncSendMessage(message, dev::channel::ChannelSession::CallbackType(), 0);
+}
+
+void dev::ChannelRPCServer::pushEventLogs(int _groupID, dev::eth::Block const& _block)
+{
+    {
+        std::lock_guard<std::mutex> l(x_logSubscriptions);
+        auto it = m_logSubscriptions.find(_groupID);
+        if (it == m_logSubscriptions.end() || it->second.empty())
+        {
+            return;
+        }
+    }
+    // the subscribers are slower than the chain, don't queue the blocks without bound
+    if (m_pendingEventLogBlocks.fetch_add(1) >= c_maxPendingEventLogBlocks)
+    {
+        --m_pendingEventLogBlocks;
+        CHANNEL_LOG(WARNING) << LOG_DESC("Too many blocks waiting for pushing logs, drop the logs")
+                             << LOG_KV("group", _groupID)
+                             << LOG_KV("number", _block.blockHeader().number());
+        return;
+    }
+    // called on the commit path, only the block is copied here
+    auto block = std::make_shared<dev::eth::Block const>(_block);
+    m_eventLogPool->enqueue([this, _groupID, block]() {
+        --m_pendingEventLogBlocks;
+        doPushEventLogs(_groupID, block);
+    });
+}
+
+void dev::ChannelRPCServer::doPushEventLogs(
+    int _groupID, std::shared_ptr<dev::eth::Block const> _block)
+{
+    auto number = _block->blockHeader().number();
+    std::vector<LogSubscription> subscriptions;
+    {
+        std::lock_guard<std::mutex> l(x_logSubscriptions);
+        auto it = m_logSubscriptions.find(_groupID);
+        if (it == m_logSubscriptions.end() || it->second.empty())
+        {
+            return;
+        }
+        /// the subscriptions to the blocks committed are done
+        auto& groupSubscriptions = it->second;
+        groupSubscriptions.erase(std::remove_if(groupSubscriptions.begin(),
+                                     groupSubscriptions.end(),
+                                     [&](LogSubscription const& _subscription) {
+                                         return _subscription.filter.toBlock() < number;
+                                     }),
+            groupSubscriptions.end());
+        subscriptions = groupSubscriptions;
+    }
+
+    for (auto const& subscription : subscriptions)
+    {
+        if (subscription.filter.fromBlock() > number)
+        {
+            continue;
+        }
+        auto logs = subscription.filter.matches(*_block);
+        if (logs.empty())
+        {
+            continue;
+        }
+        Json::Value content;
+        content["filterID"] = subscription.filterID;
+        content["result"] = 0;
+        content["logs"] = Json::Value(Json::arrayValue);
+        for (auto const& log : logs)
+        {
+            content["logs"].append(dev::rpc::toJson(log));
+        }
+        std::string data = content.toStyledString();
+        auto message = subscription.session->messageFactory()->buildMessage();
+        message->setSeq(newSeq());
+        message->setResult(0);
+        message->setType(0x1002);
+        message->setData((const byte*)data.data(), data.size());
+        subscription.session->asyncSendMessage(
+            message, dev::channel::ChannelSession::CallbackType(), 0);
+        CHANNEL_LOG(TRACE) << "push event logs" << LOG_KV("group", _groupID)
+                           << LOG_KV("number", number) << LOG_KV("logs", logs.size())
+                           << LOG_KV("filterID", subscription.filterID);
+    }
+}
+
 std::string ChannelRPCServer::newSeq()
 {
 #if 0
@@ -33,7 +33,9 @@
 #include "libdevcore/ThreadPool.h"
 #include <jsonrpccpp/server/abstractserverconnector.h>
 #include <libdevcore/FixedHash.h>
+#include <libethcore/Block.h>
 #include <libethcore/Common.h>
+#include <libethcore/LogFilter.h>
 #include <libp2p/Service.h>
 #include <netinet/in.h>
 #include <sys/socket.h>
@@ -65,7 +67,10 @@ public:
     typedef std::shared_ptr<ChannelRPCServer> Ptr;
 
     ChannelRPCServer(std::string listenAddr = "", int listenPort = 0)
-      : jsonrpc::AbstractServerConnector(), _listenAddr(listenAddr), _listenPort(listenPort){};
+      : jsonrpc::AbstractServerConnector(),
+        _listenAddr(listenAddr),
+        _listenPort(listenPort),
+        m_eventLogPool(std::make_shared<dev::ThreadPool>("EventLog", 1)){};
     virtual ~ChannelRPCServer();
     virtual bool StartListening() override;
     virtual bool StopListening() override;
@@ -92,6 +97,14 @@ public:
     virtual void onClientChannelRequest(
         dev::channel::ChannelSession::Ptr session, dev::channel::Message::Ptr message);
 
+    /// subscribe the logs matching a filter of a group, pushed as the blocks commit
+    virtual void onClientRegisterEventLogRequest(
+        dev::channel::ChannelSession::Ptr session, dev::channel::Message::Ptr message);
+
+    /// push the matched logs of the committed block to the subscriptions of the group, the
+    /// logs are matched and sent in m_eventLogPool
+    void pushEventLogs(int _groupID, dev::eth::Block const& _block);
+
     void setListenAddr(const std::string& listenAddr);
 
     void setListenPort(int listenPort);
@@ -127,6 +140,15 @@ public:
     };
 
     void addHandler(const dev::eth::Handler<int64_t>& handler) { m_handlers.push_back(handler); }
+    void addBlockHandler(const dev::eth::Handler<dev::eth::Block const&>& handler)
+    {
+        m_blockHandlers.push_back(handler);
+    }
+
+    /// the max log subscriptions of a session
+    static const size_t c_maxLogSubscriptions = 100;
+    /// the blocks waiting for their logs to be pushed, the logs of the blocks beyond are dropped
+    static const size_t c_maxPendingEventLogBlocks = 1000;
 
 private:
     void initSSLContext();
@@ -139,6 +161,8 @@ private:
 
     std::vector<dev::channel::ChannelSession::Ptr> getSessionByTopic(const std::string& topic);
 
+    void doPushEventLogs(int _groupID, std::shared_ptr<dev::eth::Block const> _block);
+
     bool _running = false;
 
     std::string _listenAddr;
@@ -163,6 +187,21 @@ private:
 
     std::function<void(std::function<void(const std::string& receiptContext)>*)> m_callbackSetter;
     std::vector<dev::eth::Handler<int64_t> > m_handlers;
+    std::vector<dev::eth::Handler<dev::eth::Block const&> > m_blockHandlers;
+
+    struct LogSubscription
+    {
+        dev::channel::ChannelSession::Ptr session;
+        std::string filterID;
+        dev::eth::LogFilter filter;
+    };
+    /// group ID to the log subscriptions of the group, removed with the sessions
+    std::map<int, std::vector<LogSubscription> > m_logSubscriptions;
+    std::mutex x_logSubscriptions;
+    std::atomic<size_t> m_pendingEventLogBlocks{0};
+
+    /// one thread keeps the logs in the order of the blocks, declared last to stop first
+    dev::ThreadPool::Ptr m_eventLogPool;
 };
 
 }  // namespace dev
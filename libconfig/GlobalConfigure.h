@@ -30,7 +30,9 @@ enum VERSION : uint32_t
 {
     RC1_VERSION = 1,
     RC2_VERSION = 2,
-    RC3_VERSION = 3
+    RC3_VERSION = 3,
+    /// the tx and receipt roots are the roots of binary Merkle trees
+    V2_1_0 = 0x02010000
 };
 class GlobalConfigure
 {
@@ -45,6 +45,7 @@ enum PBFTPacketType : byte
     PBFTPacketCount
 };
 
+struct PBFTMsg;
 /// PBFT message
 struct PBFTMsgPacket
 {
@@ -63,6 +64,10 @@ struct PBFTMsgPacket
     u256 timestamp;
     /// endpoint
     std::string endpoint;
+    /// the sealer whose signatures have been verified on receipt, never sent to the network
+    h512 verifiedSigner = h512();
+    /// the request decoded on receipt, saves decoding it again in the consensus thread
+    std::shared_ptr<PBFTMsg> decodedReq;
     /// default constructor
     PBFTMsgPacket()
       : node_idx(0), node_id(h512(0)), packet_id(0), ttl(MAXTTL), timestamp(u256(utcTime()))
@@ -147,6 +152,8 @@ struct PBFTMsg
     Signature sig = Signature();
     /// signature to the hash of other fields except block_hash, sig and sig2
     Signature sig2 = Signature();
+    /// the sealer whose signatures have been verified on receipt, never sent to the network
+    h512 verifiedSigner = h512();
     PBFTMsg() = default;
     PBFTMsg(KeyPair const& _keyPair, int64_t const& _height, VIEWTYPE const& _view,
         IDXTYPE const& _idx, h256 const _blockHash)
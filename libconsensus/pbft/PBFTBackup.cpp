@@ -0,0 +1,267 @@
+/*
+ * @CopyRight:
+ * FISCO-BCOS is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * FISCO-BCOS is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with FISCO-BCOS.  If not, see <http://www.gnu.org/licenses/>
+ * (c) 2016-2018 fisco-dev contributors.
+ */
+/**
+ * @brief : asynchronous writer of the pbft message backup
+ * @file: PBFTBackup.cpp
+ */
+#include "PBFTBackup.h"
+
+using namespace std;
+using namespace dev;
+using namespace dev::db;
+using namespace dev::consensus;
+
+namespace
+{
+/// the first byte of a record, never found in the hex-encoded RLP of the former backups
+char const c_recordFormat = 0x01;
+std::string const c_blockKeyPrefix = "block_";
+/// the timestamp is a u256, whose sizeof depends on the boost version, stored in 32 bytes
+size_t const c_timestampSize = 32;
+size_t const c_recordSize = 1 + sizeof(int64_t) + sizeof(VIEWTYPE) + sizeof(IDXTYPE) +
+                            c_timestampSize + h256::size + 2 * Signature::size;
+
+template <typename T>
+void appendBigEndian(std::string& _out, T _value)
+{
+    std::string bytes(sizeof(T), 0);
+    toBigEndian(_value, bytes);
+    _out += bytes;
+}
+
+template <typename T>
+T readBigEndian(std::string const& _in, size_t& _offset, size_t _size = sizeof(T))
+{
+    T value = fromBigEndian<T>(_in.substr(_offset, _size));
+    _offset += _size;
+    return value;
+}
+}  // namespace
+
+PBFTBackup::PBFTBackup(std::shared_ptr<LevelDB> _db) : m_db(_db)
+{
+    m_writer = std::thread([this]() {
+        pthread_setThreadName("pbftBackup");
+        writeLoop();
+    });
+}
+
+PBFTBackup::~PBFTBackup()
+{
+    {
+        std::lock_guard<std::mutex> l(x_pending);
+        m_stop = true;
+    }
+    m_pendingSignal.notify_all();
+    if (m_writer.joinable())
+    {
+        m_writer.join();
+    }
+}
+
+std::string PBFTBackup::encodeRecord(PBFTMsg const& _msg)
+{
+    std::string record;
+    record.reserve(c_recordSize);
+    record.push_back(c_recordFormat);
+    appendBigEndian(record, (uint64_t)_msg.height);
+    appendBigEndian(record, (uint64_t)_msg.view);
+    appendBigEndian(record, _msg.idx);
+    record += toBigEndianString(_msg.timestamp);
+    record.append((char const*)_msg.block_hash.data(), h256::size);
+    record.append((char const*)_msg.sig.data(), Signature::size);
+    record.append((char const*)_msg.sig2.data(), Signature::size);
+    return record;
+}
+
+void PBFTBackup::decodeRecord(std::string const& _record, PBFTMsg& _msg)
+{
+    if (_record.size() != c_recordSize || _record[0] != c_recordFormat)
+    {
+        BOOST_THROW_EXCEPTION(
+            DatabaseError() << errinfo_comment("invalid pbft backup record, size: " +
+                                               std::to_string(_record.size())));
+    }
+    size_t offset = 1;
+    _msg.height = (int64_t)readBigEndian<uint64_t>(_record, offset);
+    _msg.view = (VIEWTYPE)readBigEndian<uint64_t>(_record, offset);
+    _msg.idx = readBigEndian<IDXTYPE>(_record, offset);
+    _msg.timestamp = readBigEndian<u256>(_record, offset, c_timestampSize);
+    _msg.block_hash = h256((byte const*)_record.data() + offset, h256::ConstructFromPointer);
+    offset += h256::size;
+    _msg.sig = Signature((byte const*)_record.data() + offset, Signature::ConstructFromPointer);
+    offset += Signature::size;
+    _msg.sig2 = Signature((byte const*)_record.data() + offset, Signature::ConstructFromPointer);
+}
+
+std::string PBFTBackup::blockKey(h256 const& _blockHash)
+{
+    return c_blockKeyPrefix + toHex(_blockHash);
+}
+
+void PBFTBackup::stageBlock(PrepareReq const& _req)
+{
+    if (_req.block.empty() || m_stagedBlocks.count(_req.block_hash))
+    {
+        return;
+    }
+    m_stagedBlocks[_req.block_hash] = _req.height;
+    enqueue(Write{blockKey(_req.block_hash), std::string(_req.block.begin(), _req.block.end()),
+        false});
+}
+
+void PBFTBackup::backup(std::string const& _key, PrepareReq const& _req)
+{
+    stageBlock(_req);
+    // the blocks of this height or below are not needed any more, their writes are in the same
+    // batch as the record or an earlier one
+    for (auto it = m_stagedBlocks.begin(); it != m_stagedBlocks.end();)
+    {
+        if (it->first != _req.block_hash && it->second <= _req.height)
+        {
+            enqueue(Write{blockKey(it->first), std::string(), true});
+            it = m_stagedBlocks.erase(it);
+        }
+        else
+        {
+            ++it;
+        }
+    }
+    waitFlushed(enqueue(Write{_key, encodeRecord(_req), false}));
+}
+
+bool PBFTBackup::reload(std::string const& _key, PrepareReq& _req) const
+{
+    std::string record = m_db->lookup(_key);
+    if (record.empty())
+    {
+        return false;
+    }
+    if (record[0] != c_recordFormat)
+    {
+        bytes data = fromHex(record);
+        _req.decode(ref(data), 0);
+        return true;
+    }
+    decodeRecord(record, _req);
+    std::string block = m_db->lookup(blockKey(_req.block_hash));
+    if (block.empty())
+    {
+        BOOST_THROW_EXCEPTION(DatabaseError() << errinfo_comment(
+                                  "pbft backup block missing, hash: " + toHex(_req.block_hash)));
+    }
+    _req.block.assign(block.begin(), block.end());
+    return true;
+}
+
+void PBFTBackup::removeStaleBlocks(std::string const& _key)
+{
+    std::string keep;
+    PrepareReq req;
+    std::string record = m_db->lookup(_key);
+    if (!record.empty() && record[0] == c_recordFormat)
+    {
+        decodeRecord(record, req);
+        keep = blockKey(req.block_hash);
+    }
+    std::vector<std::string> staleKeys;
+    m_db->forEach([&](Slice _key, Slice) {
+        std::string key(_key.begin(), _key.end());
+        if (key.compare(0, c_blockKeyPrefix.size(), c_blockKeyPrefix) == 0 && key != keep)
+        {
+            staleKeys.push_back(std::move(key));
+        }
+        return true;
+    });
+    uint64_t seq = 0;
+    for (auto& key : staleKeys)
+    {
+        seq = enqueue(Write{std::move(key), std::string(), true});
+    }
+    waitFlushed(seq);
+}
+
+uint64_t PBFTBackup::enqueue(Write&& _write)
+{
+    uint64_t seq;
+    {
+        std::lock_guard<std::mutex> l(x_pending);
+        m_pending.push_back(std::move(_write));
+        seq = ++m_enqueued;
+    }
+    m_pendingSignal.notify_one();
+    return seq;
+}
+
+void PBFTBackup::waitFlushed(uint64_t _seq)
+{
+    std::unique_lock<std::mutex> l(x_pending);
+    m_flushedSignal.wait(l, [&]() { return m_flushed >= _seq || m_error; });
+    if (m_error)
+    {
+        std::rethrow_exception(m_error);
+    }
+}
+
+void PBFTBackup::writeLoop()
+{
+    std::vector<Write> writes;
+    while (true)
+    {
+        uint64_t seq;
+        {
+            std::unique_lock<std::mutex> l(x_pending);
+            m_pendingSignal.wait(l, [&]() { return m_stop || !m_pending.empty(); });
+            if (m_pending.empty())
+            {
+                return;
+            }
+            writes.swap(m_pending);
+            seq = m_enqueued;
+        }
+        try
+        {
+            // the writes pending since the last batch are committed together
+            auto batch = m_db->createWriteBatch();
+            for (auto const& write : writes)
+            {
+                if (write.kill)
+                {
+                    batch->kill(write.key);
+                }
+                else
+                {
+                    batch->insert(write.key, write.value);
+                }
+            }
+            m_db->commit(std::move(batch));
+        }
+        catch (std::exception const& e)
+        {
+            PBFTENGINE_LOG(ERROR) << LOG_DESC("write pbft backup failed")
+                                  << LOG_KV("EINFO", boost::diagnostic_information(e));
+            std::lock_guard<std::mutex> l(x_pending);
+            m_error = std::current_exception();
+        }
+        writes.clear();
+        {
+            std::lock_guard<std::mutex> l(x_pending);
+            m_flushed = seq;
+        }
+        m_flushedSignal.notify_all();
+    }
+}
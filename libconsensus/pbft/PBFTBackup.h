@@ -0,0 +1,94 @@
+/*
+ * @CopyRight:
+ * FISCO-BCOS is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * FISCO-BCOS is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with FISCO-BCOS.  If not, see <http://www.gnu.org/licenses/>
+ * (c) 2016-2018 fisco-dev contributors.
+ */
+/**
+ * @brief : asynchronous writer of the pbft message backup
+ * @file: PBFTBackup.h
+ */
+#pragma once
+#include <libconsensus/pbft/Common.h>
+#include <libdevcore/LevelDB.h>
+#include <condition_variable>
+#include <exception>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <thread>
+
+namespace dev
+{
+namespace consensus
+{
+/**
+ * The backup of a prepare request is a small binary record under the message key and the raw
+ * block bytes under a key derived from the block hash. The blocks are staged asynchronously as
+ * soon as the prepare requests are received, so the record of the committed prepare is the only
+ * write the consensus thread waits for. A dedicated thread group commits all the pending writes
+ * in one synced batch of the backup DB.
+ */
+class PBFTBackup
+{
+public:
+    /// _db must be opened with synced writes for the backup to survive a power failure
+    explicit PBFTBackup(std::shared_ptr<dev::db::LevelDB> _db);
+    ~PBFTBackup();
+
+    /// write the block of the prepare request in the background
+    void stageBlock(PrepareReq const& _req);
+    /// write the prepare request and its block if not staged, return when they are durable
+    /// @throws the DatabaseError of the failed write
+    void backup(std::string const& _key, PrepareReq const& _req);
+    /// @returns false if no prepare request is stored under the key, the backups of the
+    /// hex-encoded RLP format are read too
+    bool reload(std::string const& _key, PrepareReq& _req) const;
+    /// remove the staged blocks not referred to by the message stored under the key
+    void removeStaleBlocks(std::string const& _key);
+
+    /// binary record of the fields of the prepare request except the block
+    static std::string encodeRecord(PBFTMsg const& _msg);
+    static void decodeRecord(std::string const& _record, PBFTMsg& _msg);
+    static std::string blockKey(h256 const& _blockHash);
+
+private:
+    struct Write
+    {
+        std::string key;
+        std::string value;
+        bool kill;
+    };
+    /// @returns the sequence number of the write
+    uint64_t enqueue(Write&& _write);
+    void waitFlushed(uint64_t _seq);
+    void writeLoop();
+
+    std::shared_ptr<dev::db::LevelDB> m_db;
+
+    std::mutex x_pending;
+    std::condition_variable m_pendingSignal;
+    std::condition_variable m_flushedSignal;
+    std::vector<Write> m_pending;
+    uint64_t m_enqueued = 0;
+    uint64_t m_flushed = 0;
+    std::exception_ptr m_error;
+    bool m_stop = false;
+
+    /// height of the blocks staged and not removed yet, accessed by the consensus thread only
+    std::map<h256, int64_t> m_stagedBlocks;
+
+    std::thread m_writer;
+};
+}  // namespace consensus
+}  // namespace dev
@@ -24,6 +24,7 @@
 #include "PBFTEngine.h"
 #include <libconfig/GlobalConfigure.h>
 #include <libdevcore/CommonJS.h>
+#include <libdevcore/Tracer.h>
 #include <libdevcore/Worker.h>
 #include <libethcore/CommonJS.h>
 #include <libsecurity/EncryptedLevelDB.h>
@@ -172,7 +173,12 @@ void PBFTEngine::initBackupDB()
 
     LevelDB::checkStatus(status, path_handler);
 
-    m_backupDB = std::make_shared<LevelDB>(basicDB);
+    /// the committed prepare must be durable before the commit request is sent, the writes are
+    /// grouped by m_backup to amortize the sync
+    leveldb::WriteOptions writeOptions = LevelDB::defaultWriteOptions();
+    writeOptions.sync = true;
+    m_backupDB = std::make_shared<LevelDB>(basicDB, LevelDB::defaultReadOptions(), writeOptions);
+    m_backup = std::make_shared<PBFTBackup>(m_backupDB);
 
     if (!isDiskSpaceEnough(path))
     {
@@ -183,6 +189,15 @@ void PBFTEngine::initBackupDB()
     }
     // reload msg from db to commited-prepare-cache
     reloadMsg(c_backupKeyCommitted, m_reqCache->mutableCommittedPrepareCache());
+    try
+    {
+        m_backup->removeStaleBlocks(c_backupKeyCommitted);
+    }
+    catch (std::exception& e)
+    {
+        PBFTENGINE_LOG(WARNING) << LOG_DESC("remove stale blocks of the backup failed")
+                                << LOG_KV("EINFO", boost::diagnostic_information(e));
+    }
 }
 
 /**
@@ -190,23 +205,21 @@ void PBFTEngine::initBackupDB()
  * @param key: key used to index the PBFTMsg
  * @param msg: save the PBFTMsg readed from the DB
  */
-void PBFTEngine::reloadMsg(std::string const& key, PBFTMsg* msg)
+void PBFTEngine::reloadMsg(std::string const& key, PrepareReq* msg)
 {
-    if (!m_backupDB || !msg)
+    if (!m_backup || !msg)
     {
         return;
     }
     try
     {
-        bytes data = fromHex(m_backupDB->lookup(key));
-        if (data.empty())
+        if (!m_backup->reload(key, *msg))
         {
             PBFTENGINE_LOG(DEBUG) << LOG_DESC("reloadMsg: Empty message stored")
                                   << LOG_KV("nodeIdx", nodeIdx())
                                   << LOG_KV("nodeId", m_keyPair.pub().abridged());
             return;
         }
-        msg->decode(ref(data), 0);
         PBFTENGINE_LOG(DEBUG) << LOG_DESC("reloadMsg") << LOG_KV("fromIdx", msg->idx)
                               << LOG_KV("nodeId", m_keyPair.pub().abridged())
                               << LOG_KV("H", msg->height)
@@ -223,21 +236,19 @@ void PBFTEngine::reloadMsg(std::string const& key, PBFTMsg* msg)
 }
 
 /**
- * @brief: backup specified PBFTMsg with specified key into the DB
- * @param _key: key of the PBFTMsg
+ * @brief: backup specified PrepareReq with specified key into the DB, return after it is durable
+ * @param _key: key of the PrepareReq
  * @param _msg : data to backup in the DB
  */
-void PBFTEngine::backupMsg(std::string const& _key, PBFTMsg const& _msg)
+void PBFTEngine::backupMsg(std::string const& _key, PrepareReq const& _msg)
 {
-    if (!m_backupDB)
+    if (!m_backup)
     {
         return;
     }
-    bytes message_data;
-    _msg.encode(message_data);
     try
     {
-        m_backupDB->insert(_key, toHex(message_data));
+        m_backup->backup(_key, _msg);
     }
     catch (DatabaseError const& e)
     {
@@ -319,13 +330,48 @@ bool PBFTEngine::checkSign(PBFTMsg const& req) const
     h512 node_id;
     if (getNodeIDByIndex(node_id, req.idx))
     {
-        Public pub_id = jsToPublic(toJS(node_id.hex()));
-        return dev::verify(pub_id, req.sig, req.block_hash) &&
-               dev::verify(pub_id, req.sig2, req.fieldsWithoutBlock());
+        /// verified on receipt against the same sealer
+        if (req.verifiedSigner == node_id)
+        {
+            return true;
+        }
+        /// the node id is the public key itself
+        return dev::verify(node_id, req.sig, req.block_hash) &&
+               dev::verify(node_id, req.sig2, req.fieldsWithoutBlock());
     }
     return false;
 }
 
+void PBFTEngine::preVerifyMsg(std::shared_ptr<PBFTMsgPacket> _pbftMsg)
+{
+    /// sign, commit and viewchange requests share the encoding of PBFTMsg
+    auto req = std::make_shared<PBFTMsg>();
+    if (!decodeToRequests(*req, ref(_pbftMsg->data)))
+    {
+        return;
+    }
+    /// getSealerByIndex takes m_sealerListMutex itself
+    h512 node_id = getSealerByIndex(req->idx);
+    if (node_id != h512())
+    {
+        if (!dev::verify(node_id, req->sig, req->block_hash) ||
+            !dev::verify(node_id, req->sig2, req->fieldsWithoutBlock()))
+        {
+            PBFTENGINE_LOG(DEBUG) << LOG_DESC("preVerifyMsg: invalid signature")
+                                  << LOG_KV("type", std::to_string(_pbftMsg->packet_id))
+                                  << LOG_KV("reqIdx", req->idx)
+                                  << LOG_KV("fromIdx", _pbftMsg->node_idx)
+                                  << LOG_KV("fromIp", _pbftMsg->endpoint);
+            return;
+        }
+        _pbftMsg->verifiedSigner = node_id;
+    }
+    _pbftMsg->decodedReq = req;
+    /// the consensus thread checks the request from a sealer unknown here again
+    m_msgQueue.push(*_pbftMsg);
+    m_signalled.notify_all();
+}
+
 /**
  * @brief: 1. generate commitReq according to prepare req
  *         2. broadcast the commitReq
@@ -754,12 +800,18 @@ void PBFTEngine::onRecvPBFTMessage(
     {
         return;
     }
-    if (pbft_msg.packet_id <= ViewChangeReqPacket)
+    if (pbft_msg.packet_id == PrepareReqPacket)
     {
         m_msgQueue.push(pbft_msg);
         /// notify to handleMsg after push new PBFTMsgPacket into m_msgQueue
         m_signalled.notify_all();
     }
+    else if (pbft_msg.packet_id <= ViewChangeReqPacket)
+    {
+        /// the signatures are verified in parallel before entering the consensus thread
+        auto msg = std::make_shared<PBFTMsgPacket>(std::move(pbft_msg));
+        m_verifyPool->enqueue([this, msg]() { preVerifyMsg(msg); });
+    }
     else
     {
         PBFTENGINE_LOG(DEBUG) << LOG_DESC("onRecvPBFTMessage: illegal msg ")
@@ -814,8 +866,14 @@ bool PBFTEngine::handlePrepareMsg(PrepareReq const& prepareReq, std::string cons
     {
         return true;
     }
+    TRACE_SPAN("handlePrepare", "consensus", m_groupId, prepareReq.height);
     /// add raw prepare request
     m_reqCache->addRawPrepare(prepareReq);
+    /// write its block in the background, the commit only waits for the small backup record
+    if (m_backup)
+    {
+        m_backup->stageBlock(prepareReq);
+    }
 
     Sealing workingSealing;
     try
@@ -871,6 +929,7 @@ void PBFTEngine::checkAndCommit()
                               << LOG_KV("hash", m_reqCache->prepareCache().block_hash.abridged())
                               << LOG_KV("nodeIdx", nodeIdx())
                               << LOG_KV("myNode", m_keyPair.pub().abridged());
+        TRACE_SPAN("commit", "consensus", m_groupId, m_reqCache->prepareCache().height);
         if (m_reqCache->prepareCache().view != m_view)
         {
             PBFTENGINE_LOG(DEBUG) << LOG_DESC("checkAndCommit: InvalidView")
@@ -966,6 +1025,7 @@ void PBFTEngine::checkAndSave()
                     << LOG_KV("dropTxsTimeCost", dropTxs_time_cost)
                     << LOG_KV("noteSealingTimeCost", noteSealing_time_cost)
                     << LOG_KV("totalTimeCost", utcTime() - start_commit_time);
+                m_commitBlockTime->observe((utcTime() - start_commit_time) * 1000);
                 m_reqCache->delCache(m_reqCache->prepareCache().block_hash);
                 m_reqCache->removeInvalidFutureCache(m_highestBlock);
             }
@@ -1032,7 +1092,11 @@ void PBFTEngine::reportBlockWithoutLock(Block const& block)
         }
         resetConfig();
         m_reqCache->delCache(m_highestBlock.hash());
+        m_lastRoundHandleTime = m_roundHandleTime.exchange(0);
+        m_committedBlocks->inc();
+        m_committedTxs->inc(block.getTransactionSize());
         PBFTENGINE_LOG(INFO) << LOG_DESC("^^^^^^^^Report") << LOG_KV("num", m_highestBlock.number())
+                             << LOG_KV("handleMsgTimeCost", lastRoundHandleTime())
                              << LOG_KV("sealerIdx", m_highestBlock.sealer())
                              << LOG_KV("hash", m_highestBlock.hash().abridged())
                              << LOG_KV("next", m_consensusBlockNumber)
@@ -1052,11 +1116,12 @@ void PBFTEngine::reportBlockWithoutLock(Block const& block)
 bool PBFTEngine::handleSignMsg(SignReq& sign_req, PBFTMsgPacket const& pbftMsg)
 {
     Timer t;
-    bool valid = decodeToRequests(sign_req, ref(pbftMsg.data));
+    bool valid = decodePBFTReq(sign_req, pbftMsg);
     if (!valid)
     {
         return false;
     }
+    sign_req.verifiedSigner = pbftMsg.verifiedSigner;
     std::ostringstream oss;
     oss << LOG_DESC("handleSignMsg") << LOG_KV("num", sign_req.height)
         << LOG_KV("curNum", m_highestBlock.number()) << LOG_KV("GenIdx", sign_req.idx)
@@ -1075,6 +1140,8 @@ bool PBFTEngine::handleSignMsg(SignReq& sign_req, PBFTMsgPacket const& pbftMsg)
     {
         return true;
     }
+    /// traced only after the checks, far-future requests must not evict the real entries
+    TRACE_SPAN("handleSign", "consensus", m_groupId, sign_req.height);
     m_reqCache->addSignReq(sign_req);
 
     checkAndCommit();
@@ -1129,11 +1196,12 @@ CheckResult PBFTEngine::isValidSignReq(SignReq const& req, std::ostringstream& o
 bool PBFTEngine::handleCommitMsg(CommitReq& commit_req, PBFTMsgPacket const& pbftMsg)
 {
     Timer t;
-    bool valid = decodeToRequests(commit_req, ref(pbftMsg.data));
+    bool valid = decodePBFTReq(commit_req, pbftMsg);
     if (!valid)
     {
         return false;
     }
+    commit_req.verifiedSigner = pbftMsg.verifiedSigner;
     std::ostringstream oss;
     oss << LOG_DESC("handleCommitMsg") << LOG_KV("reqNum", commit_req.height)
         << LOG_KV("curNum", m_highestBlock.number()) << LOG_KV("GenIdx", commit_req.idx)
@@ -1153,6 +1221,7 @@ bool PBFTEngine::handleCommitMsg(CommitReq& commit_req, PBFTMsgPacket const& pbf
     {
         return true;
     }
+    TRACE_SPAN("handleCommit", "consensus", m_groupId, commit_req.height);
     m_reqCache->addCommitReq(commit_req);
     checkAndSave();
     PBFTENGINE_LOG(INFO) << LOG_DESC("handleCommitMsg Succ") << LOG_KV("INFO", oss.str())
@@ -1191,11 +1260,12 @@ CheckResult PBFTEngine::isValidCommitReq(CommitReq const& req, std::ostringstrea
 
 bool PBFTEngine::handleViewChangeMsg(ViewChangeReq& viewChange_req, PBFTMsgPacket const& pbftMsg)
 {
-    bool valid = decodeToRequests(viewChange_req, ref(pbftMsg.data));
+    bool valid = decodePBFTReq(viewChange_req, pbftMsg);
     if (!valid)
     {
         return false;
     }
+    viewChange_req.verifiedSigner = pbftMsg.verifiedSigner;
     std::ostringstream oss;
     oss << LOG_KV("reqNum", viewChange_req.height) << LOG_KV("curNum", m_highestBlock.number())
         << LOG_KV("GenIdx", viewChange_req.idx) << LOG_KV("Cview", viewChange_req.view)
@@ -1341,6 +1411,7 @@ void PBFTEngine::checkAndChangeView()
         m_leaderFailed = false;
         m_timeManager.m_lastConsensusTime = utcTime();
         m_view = m_toView;
+        m_viewChanges->inc();
         m_notifyNextLeaderSeal = false;
         m_reqCache->triggerViewChange(m_view);
         m_blockSync->noteSealingBlockNumber(m_blockChain->number());
@@ -1495,7 +1566,11 @@ void PBFTEngine::workLoop()
                     << LOG_KV("type", std::to_string(ret.second.packet_id))
                     << LOG_KV("fromIdx", ret.second.node_idx) << LOG_KV("nodeIdx", nodeIdx())
                     << LOG_KV("myNode", m_keyPair.pub().abridged());
+                auto handle_start = utcTimeUs();
                 handleMsg(ret.second);
+                auto handle_time = utcTimeUs() - handle_start;
+                m_roundHandleTime += handle_time;
+                m_handleMsgTime->observe(handle_time);
             }
             /// to avoid of cpu problem
             else if (m_reqCache->futurePrepareCacheSize() == 0)
@@ -1552,6 +1627,8 @@ const std::string PBFTEngine::consensusStatus()
     statusObj["toView"] = m_toView;
     /// get leader failed or not
     statusObj["leaderFailed"] = bool(m_leaderFailed);
+    /// ms spent by the consensus thread handling messages during the last block
+    statusObj["lastRoundHandleTime"] = Json::UInt64(lastRoundHandleTime());
     status.append(statusObj);
     /// get view of node id
     getAllNodesViewStatus(status);
@@ -1583,5 +1660,20 @@ void PBFTEngine::getAllNodesViewStatus(Json::Value& status)
     status.append(view_array);
 }
 
+void PBFTEngine::initMetrics()
+{
+    auto& registry = dev::metrics::MetricsRegistry::instance();
+    auto labels = dev::metrics::groupLabels(m_groupId);
+    m_handleMsgTime = &registry.histogram(
+        "pbft_handle_msg_us", "time the consensus thread spends on a message", labels);
+    m_commitBlockTime = &registry.histogram(
+        "pbft_commit_block_us", "time to commit a block after collecting the commits", labels);
+    m_committedBlocks =
+        &registry.counter("pbft_committed_blocks_total", "blocks reported by consensus", labels);
+    m_committedTxs = &registry.counter(
+        "pbft_committed_txs_total", "transactions of the blocks reported by consensus", labels);
+    m_viewChanges = &registry.counter("pbft_view_changes_total", "view changes reached", labels);
+}
+
 }  // namespace consensus
 }  // namespace dev
@@ -23,16 +23,20 @@
  */
 #pragma once
 #include "Common.h"
+#include "PBFTBackup.h"
 #include "PBFTMsgCache.h"
 #include "PBFTReqCache.h"
 #include "TimeManager.h"
 #include <libconsensus/ConsensusEngineBase.h>
 #include <libdevcore/FileSystem.h>
 #include <libdevcore/LevelDB.h>
+#include <libdevcore/Metrics.h>
+#include <libdevcore/ThreadPool.h>
 #include <libdevcore/concurrent_queue.h>
 #include <libstorage/Storage.h>
 #include <libsync/SyncStatus.h>
 #include <sstream>
+#include <thread>
 
 #include <libp2p/P2PMessageFactory.h>
 #include <libp2p/P2PSession.h>
@@ -71,6 +75,15 @@ public:
             m_protocolId, boost::bind(&PBFTEngine::onRecvPBFTMessage, this, _1, _2, _3));
         m_broadCastCache = std::make_shared<PBFTBroadcastCache>();
         m_reqCache = std::make_shared<PBFTReqCache>();
+        /// verify the signatures of sign/commit/viewchange requests out of the consensus thread
+        unsigned verifyThreadNum = std::max(1u, std::thread::hardware_concurrency());
+        if (verifyThreadNum > c_maxVerifyThreadNum)
+        {
+            verifyThreadNum = c_maxVerifyThreadNum;
+        }
+        m_verifyPool = std::make_shared<dev::ThreadPool>(
+            "PBFTVerify-" + std::to_string(m_groupId), verifyThreadNum);
+        initMetrics();
 
         /// set thread name for PBFTEngine
         std::string threadName = "PBFT-" + std::to_string(m_groupId);
@@ -195,6 +208,8 @@ public:
     }
 
     uint64_t sealingTxNumber() const { return m_sealingNumber; }
+    /// ms spent by the consensus thread handling messages during the last block
+    uint64_t lastRoundHandleTime() const { return m_lastRoundHandleTime / 1000; }
 
 protected:
     void reportBlockWithoutLock(dev::eth::Block const& block);
@@ -256,11 +271,24 @@ protected:
     /// recalculate m_nodeNum && m_f && m_cfgErr(must called after setSigList)
     void resetConfig() override;
     virtual void initBackupDB();
-    void reloadMsg(std::string const& _key, PBFTMsg* _msg);
-    void backupMsg(std::string const& _key, PBFTMsg const& _msg);
+    void reloadMsg(std::string const& _key, PrepareReq* _msg);
+    void backupMsg(std::string const& _key, PrepareReq const& _msg);
     inline std::string getBackupMsgPath() { return m_baseDir + "/" + c_backupMsgDirName; }
 
     bool checkSign(PBFTMsg const& req) const;
+    /// verify the signatures of the packet in m_verifyPool, then push it to m_msgQueue
+    void preVerifyMsg(std::shared_ptr<PBFTMsgPacket> _pbftMsg);
+    /// reuse the request decoded by preVerifyMsg, decode the packet data otherwise
+    template <class T>
+    bool decodePBFTReq(T& _req, PBFTMsgPacket const& _pbftMsg)
+    {
+        if (_pbftMsg.decodedReq)
+        {
+            static_cast<PBFTMsg&>(_req) = *_pbftMsg.decodedReq;
+            return true;
+        }
+        return decodeToRequests(_req, ref(_pbftMsg.data));
+    }
     inline bool broadcastFilter(
         dev::network::NodeID const& nodeId, unsigned const& packetType, std::string const& key)
     {
@@ -565,6 +593,8 @@ protected:
 
     // backup msg
     std::shared_ptr<dev::db::LevelDB> m_backupDB = nullptr;
+    /// writes m_backupDB off the consensus thread
+    std::shared_ptr<PBFTBackup> m_backup = nullptr;
 
     /// static vars
     static const std::string c_backupKeyCommitted;
@@ -599,6 +629,21 @@ protected:
     std::map<IDXTYPE, VIEWTYPE> m_viewMap;
 
     std::atomic<uint64_t> m_sealingNumber = {0};
+
+    /// us spent by the consensus thread handling messages since the last committed block
+    std::atomic<uint64_t> m_roundHandleTime = {0};
+    std::atomic<uint64_t> m_lastRoundHandleTime = {0};
+
+    void initMetrics();
+    dev::metrics::Histogram* m_handleMsgTime;
+    dev::metrics::Histogram* m_commitBlockTime;
+    dev::metrics::Counter* m_committedBlocks;
+    dev::metrics::Counter* m_committedTxs;
+    dev::metrics::Counter* m_viewChanges;
+
+    static const unsigned c_maxVerifyThreadNum = 4;
+    /// declared last to be destroyed first, its tasks access the other members
+    dev::ThreadPool::Ptr m_verifyPool;
 };
 }  // namespace consensus
 }  // namespace dev
@@ -28,6 +28,7 @@
  */
 #include "PBFTSealer.h"
 #include <libdevcore/CommonJS.h>
+#include <libdevcore/Tracer.h>
 #include <libdevcore/Worker.h>
 #include <libethcore/CommonJS.h>
 using namespace dev::eth;
@@ -57,6 +58,7 @@ void PBFTSealer::handleBlock()
         return;
     }
     setBlock();
+    TRACE_SPAN("seal", "seal", m_pbftEngine->groupId(), m_sealing.block.header().number());
     PBFTSEALER_LOG(INFO) << LOG_DESC("++++++++++++++++ Generating seal on")
                          << LOG_KV("blkNum", m_sealing.block.header().number())
                          << LOG_KV("tx", m_sealing.block.getTransactionSize())
@@ -49,6 +49,9 @@ enum RaftPacketType : byte
     RaftVoteRespPacket = 0x01,
     RaftHeartBeatPacket = 0x02,
     RaftHeartBeatRespPacket = 0x03,
+    /// since 2.1.0
+    RaftAppendEntriesPacket = 0x04,
+    RaftAppendEntriesRespPacket = 0x05,
     RaftPacketCount
 };
 
@@ -274,6 +277,74 @@ struct RaftHeartBeat : public RaftMsg
     }
 };
 
+/// blocks from the next index of a follower, the committed ones and at most one uncommitted,
+/// the commit index of the leader and the hash of its uncommitted block, h256() if none
+struct RaftAppendEntries : public RaftMsg
+{
+    raft::NodeIndex leader;
+    int64_t commitIndex;
+    std::vector<bytes> entries;
+    h256 uncommittedHash;
+
+    virtual void streamRLPFields(RLPStream& _s) const
+    {
+        RaftMsg::streamRLPFields(_s);
+        _s << leader << commitIndex << entries << uncommittedHash;
+    }
+
+    virtual void populate(RLP const& _rlp)
+    {
+        RaftMsg::populate(_rlp);
+        int field = 0;
+        try
+        {
+            leader = _rlp[field = 4].toInt<raft::NodeIndex>();
+            commitIndex = _rlp[field = 5].toInt<int64_t>();
+            entries = _rlp[field = 6].toVector<bytes>(RLP::VeryStrict);
+            uncommittedHash = _rlp[field = 7].toHash<h256>(RLP::VeryStrict);
+        }
+        catch (Exception const& _e)
+        {
+            _e << dev::eth::errinfo_name("invalid msg format")
+               << dev::eth::BadFieldError(field, toHex(_rlp[field].data().toBytes()));
+            throw;
+        }
+    }
+};
+
+/// the highest block the follower holds and its hash, acked without waiting for the commit,
+/// success is false if the follower misses the blocks before the entries
+struct RaftAppendEntriesResp : public RaftMsg
+{
+    int64_t matchIndex;
+    h256 matchHash;
+    bool success;
+
+    virtual void streamRLPFields(RLPStream& _s) const
+    {
+        RaftMsg::streamRLPFields(_s);
+        _s << matchIndex << static_cast<byte>(success) << matchHash;
+    }
+
+    virtual void populate(RLP const& _rlp)
+    {
+        RaftMsg::populate(_rlp);
+        int field = 0;
+        try
+        {
+            matchIndex = _rlp[field = 4].toInt<int64_t>();
+            success = _rlp[field = 5].toInt<byte>() != 0;
+            matchHash = _rlp[field = 6].toHash<h256>(RLP::VeryStrict);
+        }
+        catch (Exception const& _e)
+        {
+            _e << dev::eth::errinfo_name("invalid msg format")
+               << dev::eth::BadFieldError(field, toHex(_rlp[field].data().toBytes()));
+            throw;
+        }
+    }
+};
+
 struct RaftHeartBeatResp : public RaftMsg
 {
     h256 uncommitedBlockHash;
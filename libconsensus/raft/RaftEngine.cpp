@@ -179,6 +179,12 @@ void RaftEngine::reportBlock(dev::eth::Block const& _block)
                              << LOG_KV("next", m_consensusBlockNumber)
                              << LOG_KV("txNum", _block.getTransactionSize())
                              << LOG_KV("blockTime", m_lastBlockTime);
+
+        // the followers execute the block on the commit index while the next one is sealed
+        if (g_BCOSConfig.version() >= V2_1_0 && getState() == EN_STATE_LEADER && m_nodeNum > 1)
+        {
+            broadcastAppendEntries();
+        }
     }
 }
 
@@ -325,26 +331,7 @@ void RaftEngine::tryCommitUncommitedBlock(RaftHeartBeatResp& _resp)
                 if (m_commitFingerPrint[uncommitedBlockHash].size() + 1 >=
                     static_cast<uint64_t>(m_nodeNum - m_f))
                 {
-                    if (m_waitingForCommitting)
-                    {
-                        RAFTENGINE_LOG(TRACE) << LOG_DESC(
-                            "[#tryCommitUncommitedBlock]Some thread waiting on "
-                            "commitCV, commit by other thread");
-
-                        m_commitReady = true;
-                        ul.unlock();
-                        m_commitCV.notify_all();
-                    }
-                    else
-                    {
-                        RAFTENGINE_LOG(TRACE) << LOG_DESC(
-                            "[#tryCommitUncommitedBlock]No thread waiting on "
-                            "commitCV, commit by meself");
-
-                        checkAndExecute(m_uncommittedBlock);
-                        ul.unlock();
-                        reportBlock(m_uncommittedBlock);
-                    }
+                    commitUncommittedBlock(ul);
                 }
             }
             else
@@ -352,26 +339,7 @@ void RaftEngine::tryCommitUncommitedBlock(RaftHeartBeatResp& _resp)
                 if (_resp.uncommitedBlockHash == h256())
                 {
                     // I'm the only one in sealer list, commit block without any ack
-                    if (m_waitingForCommitting)
-                    {
-                        RAFTENGINE_LOG(TRACE) << LOG_DESC(
-                            "[#tryCommitUncommitedBlock]Some thread waiting on "
-                            "commitCV, commit by other thread");
-
-                        m_commitReady = true;
-                        ul.unlock();
-                        m_commitCV.notify_all();
-                    }
-                    else
-                    {
-                        RAFTENGINE_LOG(TRACE) << LOG_DESC(
-                            "[#tryCommitUncommitedBlock]No thread waiting on "
-                            "commitCV, commit by meself");
-
-                        checkAndExecute(m_uncommittedBlock);
-                        ul.unlock();
-                        reportBlock(m_uncommittedBlock);
-                    }
+                    commitUncommittedBlock(ul);
                 }
                 else
                 {
@@ -400,6 +368,28 @@ void RaftEngine::tryCommitUncommitedBlock(RaftHeartBeatResp& _resp)
     }
 }
 
+void RaftEngine::commitUncommittedBlock(std::unique_lock<std::mutex>& _ul)
+{
+    if (m_waitingForCommitting)
+    {
+        RAFTENGINE_LOG(TRACE) << LOG_DESC(
+            "[#commitUncommittedBlock]Some thread waiting on commitCV, commit by other thread");
+
+        m_commitReady = true;
+        _ul.unlock();
+        m_commitCV.notify_all();
+    }
+    else
+    {
+        RAFTENGINE_LOG(TRACE) << LOG_DESC(
+            "[#commitUncommittedBlock]No thread waiting on commitCV, commit by meself");
+
+        checkAndExecute(m_uncommittedBlock);
+        _ul.unlock();
+        reportBlock(m_uncommittedBlock);
+    }
+}
+
 bool RaftEngine::runAsLeaderImp(std::unordered_map<h512, unsigned>& memberHeartbeatLog)
 {
     if (m_state != RaftRole::EN_STATE_LEADER || m_accountType != NodeAccountType::SealerAccount)
@@ -524,7 +514,43 @@ bool RaftEngine::runAsLeaderImp(std::unordered_map<h512, unsigned>& memberHeartb
                 }
             }
 
-            tryCommitUncommitedBlock(resp);
+            // since 2.1.0 the blocks are acked by the append entries responses
+            if (g_BCOSConfig.version() < V2_1_0)
+            {
+                tryCommitUncommitedBlock(resp);
+            }
+            return true;
+        }
+        case RaftPacketType::RaftAppendEntriesPacket:
+        {
+            RAFTENGINE_LOG(TRACE) << LOG_DESC("[#runAsLeaderImp]Recv append entries packet");
+
+            RaftAppendEntries ae;
+            ae.populate(RLP(ref(ret.second.data))[0]);
+            if (handleAppendEntries(ret.second.nodeIdx, ret.second.nodeId, ae))
+            {
+                switchToFollower(ae.leader);
+                return false;
+            }
+            return true;
+        }
+        case RaftPacketType::RaftAppendEntriesRespPacket:
+        {
+            RaftAppendEntriesResp resp;
+            resp.populate(RLP(ref(ret.second.data))[0]);
+
+            RAFTENGINE_LOG(TRACE) << LOG_DESC("[#runAsLeaderImp]Recv append entries ack")
+                                  << LOG_KV("from", ret.second.nodeId.abridged())
+                                  << LOG_KV("matchIndex", resp.matchIndex)
+                                  << LOG_KV("success", resp.success);
+            if (resp.term != m_term)
+            {
+                RAFTENGINE_LOG(TRACE)
+                    << LOG_DESC("[#runAsLeaderImp]Append entries ack term is strange")
+                    << LOG_KV("ackTerm", resp.term) << LOG_KV("myTerm", m_term);
+                return true;
+            }
+            handleAppendEntriesResponse(ret.second.nodeId, resp);
             return true;
         }
         default:
@@ -662,6 +688,19 @@ bool RaftEngine::runAsCandidateImp(VoteState& _voteState)
             }
             return true;
         }
+        case RaftAppendEntriesPacket:
+        {
+            RAFTENGINE_LOG(TRACE) << LOG_DESC("[#runAsCandidateImp]Recv append entries packet");
+
+            RaftAppendEntries ae;
+            ae.populate(RLP(ref(ret.second.data))[0]);
+            if (handleAppendEntries(ret.second.nodeIdx, ret.second.nodeId, ae))
+            {
+                switchToFollower(ae.leader);
+                return false;
+            }
+            return true;
+        }
         default:
         {
             return true;
@@ -770,6 +809,22 @@ bool RaftEngine::runAsFollowerImp()
             }
             return true;
         }
+        case RaftAppendEntriesPacket:
+        {
+            RAFTENGINE_LOG(TRACE) << LOG_DESC("[#runAsFollowerImp]Recv append entries packet");
+
+            RaftAppendEntries ae;
+            ae.populate(RLP(ref(ret.second.data))[0]);
+            if (m_leader == Invalid256)
+            {
+                setLeader(ae.leader);
+            }
+            if (handleAppendEntries(ret.second.nodeIdx, ret.second.nodeId, ae))
+            {
+                setLeader(ae.leader);
+            }
+            return true;
+        }
         default:
         {
             return true;
@@ -818,7 +873,8 @@ P2PMessage::Ptr RaftEngine::generateHeartbeat()
     hb.leader = m_idx;
     {
         Guard guard(m_commitMutex);
-        if (bool(m_uncommittedBlock))
+        // since 2.1.0 the uncommitted block is appended once instead of every heartbeat
+        if (bool(m_uncommittedBlock) && g_BCOSConfig.version() < V2_1_0)
         {
             m_uncommittedBlock.encode(hb.uncommitedBlock);
             hb.uncommitedBlockNumber = m_consensusBlockNumber;
@@ -857,6 +913,11 @@ void RaftEngine::broadcastHeartbeat()
         m_lastHeartbeatTime = nowTime;
         auto heartbeatMsg = generateHeartbeat();
         broadcastMsg(heartbeatMsg);
+        if (g_BCOSConfig.version() >= V2_1_0)
+        {
+            // resend the blocks lost on the way to the followers
+            broadcastAppendEntries(true);
+        }
         clearFirstVoteCache();
         RAFTENGINE_LOG(DEBUG) << LOG_DESC("[#broadcastHeartbeat]Heartbeat broadcasted");
     }
@@ -955,6 +1016,181 @@ void RaftEngine::broadcastMsg(P2PMessage::Ptr _data)
     }
 }
 
+void RaftEngine::broadcastAppendEntries(bool _onlyLagging)
+{
+    int64_t lastIndex = 0;
+    {
+        Guard guard(m_mutex);
+        lastIndex = m_highestBlock.number();
+    }
+    {
+        Guard guard(m_commitMutex);
+        if (bool(m_uncommittedBlock))
+        {
+            lastIndex = m_uncommittedBlockNumber;
+        }
+    }
+    auto sessions = m_service->sessionInfosByProtocolID(m_protocolId);
+    for (auto const& session : sessions)
+    {
+        if (getIndexBySealer(session.nodeID()) < 0)
+        {
+            continue;
+        }
+        if (_onlyLagging)
+        {
+            Guard guard(m_commitMutex);
+            auto& progress = m_progress[session.nodeID()];
+            if (progress.matchIndex >= lastIndex)
+            {
+                continue;
+            }
+            // the follower answered, append from the highest block it holds
+            if (progress.matchIndex >= 0)
+            {
+                progress.nextIndex = progress.matchIndex + 1;
+            }
+        }
+        sendAppendEntries(session.nodeID());
+    }
+}
+
+void RaftEngine::sendAppendEntries(h512 const& _node)
+{
+    RaftAppendEntries ae;
+    {
+        Guard guard(m_mutex);
+        ae.idx = m_idx;
+        ae.term = m_term;
+        ae.height = m_highestBlock.number();
+        ae.blockHash = m_highestBlock.hash();
+        ae.leader = m_idx;
+    }
+    ae.commitIndex = ae.height;
+
+    int64_t nextIndex = 0;
+    {
+        Guard guard(m_commitMutex);
+        nextIndex = m_progress[_node].nextIndex;
+    }
+    if (nextIndex <= 0)
+    {
+        nextIndex = ae.commitIndex + 1;
+    }
+    // the committed blocks the follower misses, executed by the follower on arrival
+    for (; nextIndex <= ae.commitIndex && int64_t(ae.entries.size()) < c_maxAppendBlocks;
+         ++nextIndex)
+    {
+        auto block = m_blockChain->getBlockByNumber(nextIndex);
+        if (!block)
+        {
+            break;
+        }
+        ae.entries.push_back(bytes());
+        block->encode(ae.entries.back());
+    }
+    {
+        Guard guard(m_commitMutex);
+        if (bool(m_uncommittedBlock) && m_uncommittedBlockNumber == ae.commitIndex + 1)
+        {
+            ae.uncommittedHash = m_uncommittedBlock.header().hash();
+        }
+        if (nextIndex == ae.commitIndex + 1 && bool(m_uncommittedBlock) &&
+            m_uncommittedBlockNumber == nextIndex)
+        {
+            ae.entries.push_back(bytes());
+            m_uncommittedBlock.encode(ae.entries.back());
+            ++nextIndex;
+        }
+        // the next message goes on from the blocks in flight
+        m_progress[_node].nextIndex = nextIndex;
+    }
+
+    RAFTENGINE_LOG(TRACE) << LOG_DESC("[#sendAppendEntries]") << LOG_KV("to", _node.abridged())
+                          << LOG_KV("commitIndex", ae.commitIndex)
+                          << LOG_KV("entries", ae.entries.size())
+                          << LOG_KV("nextIndex", nextIndex);
+    sendResponse(getIndexBySealer(_node), _node, RaftPacketType::RaftAppendEntriesPacket, ae);
+}
+
+void RaftEngine::handleAppendEntriesResponse(h512 const& _node, RaftAppendEntriesResp const& _resp)
+{
+    int64_t highest = 0;
+    {
+        Guard guard(m_mutex);
+        m_memberBlock[_node] = BlockRef(_resp.height, _resp.blockHash);
+        highest = m_highestBlock.number();
+    }
+
+    // only the blocks the leader holds are acked, the hash of a committed one is looked up
+    // before taking m_commitMutex
+    h256 committedHash;
+    if (_resp.matchIndex >= 0 && _resp.matchIndex <= highest)
+    {
+        committedHash = m_blockChain->numberHash(_resp.matchIndex);
+    }
+
+    std::unique_lock<std::mutex> ul(m_commitMutex);
+    auto& progress = m_progress[_node];
+    h256 leaderHash = committedHash;
+    if (bool(m_uncommittedBlock) && _resp.matchIndex == m_uncommittedBlockNumber)
+    {
+        leaderHash = m_uncommittedBlock.header().hash();
+    }
+    if (_resp.matchHash != leaderHash)
+    {
+        RAFTENGINE_LOG(WARNING) << LOG_DESC("[#handleAppendEntriesResponse]Unmatched ack")
+                                << LOG_KV("from", _node.abridged())
+                                << LOG_KV("matchIndex", _resp.matchIndex)
+                                << LOG_KV("matchHash", _resp.matchHash.abridged())
+                                << LOG_KV("leaderHash", leaderHash.abridged());
+        // the follower drops its pending block on the next entries, resend the one it misses
+        if (_resp.matchIndex > highest)
+        {
+            progress.nextIndex = _resp.matchIndex;
+            ul.unlock();
+            sendAppendEntries(_node);
+        }
+        return;
+    }
+    if (_resp.matchIndex >= progress.matchIndex)
+    {
+        progress.matchIndex = _resp.matchIndex;
+        progress.matchHash = _resp.matchHash;
+    }
+    // the follower misses the blocks before the entries, or has executed a batch of the committed
+    // blocks and needs the next one
+    if (!_resp.success ||
+        (_resp.matchIndex + 1 == progress.nextIndex && progress.nextIndex <= highest))
+    {
+        progress.nextIndex = _resp.matchIndex + 1;
+        ul.unlock();
+        sendAppendEntries(_node);
+        return;
+    }
+
+    if (!bool(m_uncommittedBlock) || m_uncommittedBlockNumber != m_consensusBlockNumber ||
+        progress.matchIndex < m_uncommittedBlockNumber)
+    {
+        return;
+    }
+    // add myself, the followers count if they hold the same block
+    auto uncommittedHash = m_uncommittedBlock.header().hash();
+    auto count = 1 + std::count_if(m_progress.begin(), m_progress.end(),
+                         [&](std::pair<const h512, Progress> const& _item) {
+                             return _item.second.matchIndex > m_uncommittedBlockNumber ||
+                                    (_item.second.matchIndex == m_uncommittedBlockNumber &&
+                                        _item.second.matchHash == uncommittedHash);
+                         });
+    if (static_cast<uint64_t>(count) >= static_cast<uint64_t>(m_nodeNum - m_f))
+    {
+        RAFTENGINE_LOG(TRACE) << LOG_DESC("[#handleAppendEntriesResponse]Block acked by majority")
+                              << LOG_KV("number", m_uncommittedBlockNumber)
+                              << LOG_KV("ackCount", count);
+        commitUncommittedBlock(ul);
+    }
+}
+
 void RaftEngine::clearFirstVoteCache()
 {
     if (m_firstVote != Invalid256)
@@ -1132,49 +1368,201 @@ bool RaftEngine::handleHeartbeat(u256 const& _from, h512 const& _node, RaftHeart
     }
     sendResponse(_from, _node, RaftPacketType::RaftHeartBeatRespPacket, resp);
 
+    return updateLeaderTerm(_hb.term);
+}
+
+bool RaftEngine::handleAppendEntries(
+    u256 const& _from, h512 const& _node, RaftAppendEntries const& _ae)
+{
+    RAFTENGINE_LOG(DEBUG) << LOG_DESC("[#handleAppendEntries]") << LOG_KV("fromIdx", _from)
+                          << LOG_KV("fromId", _node.hex().substr(0, 5))
+                          << LOG_KV("aeTerm", _ae.term) << LOG_KV("aeLeader", _ae.leader)
+                          << LOG_KV("commitIndex", _ae.commitIndex)
+                          << LOG_KV("entries", _ae.entries.size());
+
+    if (_ae.term < m_term && _ae.term <= m_lastLeaderTerm)
+    {
+        RAFTENGINE_LOG(DEBUG) << LOG_DESC("[#handleAppendEntries]Discard ae for smaller term")
+                              << LOG_KV("myTerm", m_term) << LOG_KV("aeTerm", _ae.term)
+                              << LOG_KV("myLastLeaderTerm", m_lastLeaderTerm);
+        return false;
+    }
+    bool stepDown = updateLeaderTerm(_ae.term);
+
+    if (m_appending)
+    {
+        // acked with success false when the executing entries are done, the leader resends
+        m_appendDropped = true;
+        return stepDown;
+    }
+    if (_ae.commitIndex <= getHighestBlock().number())
+    {
+        applyAppendEntries(_from, _node, _ae);
+        return stepDown;
+    }
+    // the blocks committed by the leader are executed off the raft thread
+    m_appending = true;
+    auto ae = std::make_shared<RaftAppendEntries>(_ae);
+    m_appendWorker->enqueue([this, _from, _node, ae]() { applyAppendEntries(_from, _node, *ae); });
+    return stepDown;
+}
+
+void RaftEngine::applyAppendEntries(
+    u256 const& _from, h512 const& _node, RaftAppendEntries const& _ae)
+{
+    int64_t highest = getHighestBlock().number();
+    bool success = true;
+    try
+    {
+        for (auto const& entry : _ae.entries)
+        {
+            Block block(entry);
+            auto number = block.header().number();
+            if (number <= highest)
+            {
+                continue;
+            }
+            if (number > highest + 1)
+            {
+                success = false;
+                break;
+            }
+            // committed by the leader, execute it without waiting for the pending ones
+            if (number <= _ae.commitIndex)
+            {
+                if (!checkAndExecute(block))
+                {
+                    break;
+                }
+                reportBlock(block);
+                highest = number;
+                continue;
+            }
+            Guard guard(m_commitMutex);
+            m_uncommittedBlock = block;
+            m_uncommittedBlockNumber = number;
+            break;
+        }
+    }
+    catch (std::exception const& _e)
+    {
+        RAFTENGINE_LOG(WARNING) << LOG_DESC("[#handleAppendEntries]Invalid entry")
+                                << LOG_KV("EINFO", boost::diagnostic_information(_e));
+    }
+
+    // the pending block is kept only if the leader holds the same one, a block appended by a
+    // former leader is never acked nor executed
+    int64_t matchIndex = highest;
+    h256 matchHash;
+    Block committedBlock;
+    {
+        Guard guard(m_commitMutex);
+        if (bool(m_uncommittedBlock))
+        {
+            auto hash = m_uncommittedBlock.header().hash();
+            bool committed = m_uncommittedBlockNumber == _ae.commitIndex && hash == _ae.blockHash;
+            bool pending =
+                m_uncommittedBlockNumber == _ae.commitIndex + 1 && hash == _ae.uncommittedHash;
+            if (m_uncommittedBlockNumber != highest + 1 || (!committed && !pending))
+            {
+                RAFTENGINE_LOG(DEBUG) << LOG_DESC("[#handleAppendEntries]Drop unmatched block")
+                                      << LOG_KV("number", m_uncommittedBlockNumber)
+                                      << LOG_KV("hash", hash.abridged())
+                                      << LOG_KV("commitIndex", _ae.commitIndex);
+                m_uncommittedBlock = Block();
+                m_uncommittedBlockNumber = 0;
+            }
+            else
+            {
+                if (committed)
+                {
+                    committedBlock = m_uncommittedBlock;
+                }
+                matchIndex = m_uncommittedBlockNumber;
+                matchHash = hash;
+            }
+        }
+    }
+    if (bool(committedBlock) && checkAndExecute(committedBlock))
+    {
+        reportBlock(committedBlock);
+    }
+    if (_ae.commitIndex > matchIndex && _ae.entries.empty())
+    {
+        success = false;
+    }
+
+    // ack with the term of the leader
+    RaftAppendEntriesResp resp;
+    {
+        Guard guard(m_mutex);
+        resp.idx = m_idx;
+        resp.term = m_term;
+        resp.height = m_highestBlock.number();
+        resp.blockHash = m_highestBlock.hash();
+    }
+    if (matchHash == h256())
+    {
+        matchIndex = resp.height;
+        matchHash = resp.blockHash;
+    }
+    resp.matchIndex = matchIndex;
+    resp.matchHash = matchHash;
+    if (m_appending)
+    {
+        m_appending = false;
+        success = success && !m_appendDropped.exchange(false);
+    }
+    resp.success = success;
+    sendResponse(_from, _node, RaftPacketType::RaftAppendEntriesRespPacket, resp);
+}
+
+bool RaftEngine::updateLeaderTerm(size_t _term)
+{
     bool stepDown = false;
-    /// _hb.term >= m_term || _hb.lastLeaderTerm > m_lastLeaderTerm
-    /// receive larger lastLeaderTerm, recover my term to hb term, set self to next step (follower)
-    if (_hb.term > m_lastLeaderTerm)
+    /// _term >= m_term || _term > m_lastLeaderTerm
+    /// receive larger lastLeaderTerm, recover my term to the leader term, set self to next step
+    /// (follower)
+    if (_term > m_lastLeaderTerm)
     {
         RAFTENGINE_LOG(DEBUG)
             << LOG_DESC(
-                   "[#handleHeartbeat]Prepare to switch to follower due to last leader term error")
-            << LOG_KV("lastLeaderTerm", m_lastLeaderTerm) << LOG_KV("hbLastLeader", _hb.term);
+                   "[#updateLeaderTerm]Prepare to switch to follower due to last leader term error")
+            << LOG_KV("lastLeaderTerm", m_lastLeaderTerm) << LOG_KV("leaderTerm", _term);
 
-        m_term = _hb.term;
+        m_term = _term;
         m_vote = InvalidIndex;
         stepDown = true;
     }
 
-    if (_hb.term > m_term)
+    if (_term > m_term)
     {
         RAFTENGINE_LOG(DEBUG)
             << LOG_DESC(
-                   "[#handleHeartbeat]Prepare to switch to follower due to receive higher term")
-            << LOG_KV("term", m_term) << LOG_KV("hbTerm", _hb.term);
+                   "[#updateLeaderTerm]Prepare to switch to follower due to receive higher term")
+            << LOG_KV("term", m_term) << LOG_KV("leaderTerm", _term);
 
-        m_term = _hb.term;
+        m_term = _term;
         m_vote = InvalidIndex;
         stepDown = true;
     }
 
-    if (m_state == EN_STATE_CANDIDATE && _hb.term >= m_term)
+    if (m_state == EN_STATE_CANDIDATE && _term >= m_term)
     {
         RAFTENGINE_LOG(DEBUG)
             << LOG_DESC(
-                   "[#handleHeartbeat]Prepare to switch to follower due to receive "
+                   "[#updateLeaderTerm]Prepare to switch to follower due to receive "
                    "higher or equal term in candidate state")
-            << LOG_KV("myTerm", m_term) << LOG_KV("hbTerm", _hb.term);
+            << LOG_KV("myTerm", m_term) << LOG_KV("leaderTerm", _term);
 
-        m_term = _hb.term;
+        m_term = _term;
         m_vote = InvalidIndex;
         stepDown = true;
     }
 
     clearFirstVoteCache();
     // see the leader last time
-    m_lastLeaderTerm = _hb.term;
+    m_lastLeaderTerm = _term;
 
     resetElectTimeout();
 
@@ -1197,6 +1585,11 @@ void RaftEngine::switchToLeader()
         m_leader = m_idx;
         m_state = EN_STATE_LEADER;
     }
+    {
+        // the followers are probed on the next heartbeat
+        Guard guard(m_commitMutex);
+        m_progress.clear();
+    }
 
     recoverElectTime();
     RAFTENGINE_LOG(DEBUG) << LOG_DESC("[#switchToLeader]") << LOG_KV("currentTerm", m_term);
@@ -1374,6 +1767,7 @@ void RaftEngine::increaseElectTime()
 
 bool RaftEngine::shouldSeal()
 {
+    int64_t highestNumber = 0;
     {
         Guard guard(m_mutex);
         if (m_state != EN_STATE_LEADER)
@@ -1391,6 +1785,7 @@ bool RaftEngine::shouldSeal()
         }
 
         u256 count = 1;
+        highestNumber = m_highestBlock.number();
         u256 currentHeight = m_highestBlock.number();
         h256 currentBlockHash = m_highestBlock.hash();
         for (auto iter = m_memberBlock.begin(); iter != m_memberBlock.end(); ++iter)
@@ -1407,7 +1802,8 @@ bool RaftEngine::shouldSeal()
             }
         }
 
-        if (count < m_nodeNum - m_f)
+        // since 2.1.0 the followers holding the highest block are counted by the progress
+        if (count < m_nodeNum - m_f && g_BCOSConfig.version() < V2_1_0)
         {
             RAFTENGINE_LOG(INFO) << LOG_DESC("[#shouldSeal]Wait somebody to sync block")
                                  << LOG_KV("count", count) << LOG_KV("nodeNum", m_nodeNum)
@@ -1429,6 +1825,22 @@ bool RaftEngine::shouldSeal()
                                          m_uncommittedBlock.header().hash());
             return false;
         }
+
+        if (g_BCOSConfig.version() >= V2_1_0)
+        {
+            // the followers execute the highest block on the commit index
+            auto count = 1 + std::count_if(m_progress.begin(), m_progress.end(),
+                                 [highestNumber](std::pair<const h512, Progress> const& _item) {
+                                     return _item.second.matchIndex >= highestNumber;
+                                 });
+            if (static_cast<uint64_t>(count) < static_cast<uint64_t>(m_nodeNum - m_f))
+            {
+                RAFTENGINE_LOG(INFO) << LOG_DESC("[#shouldSeal]Wait somebody to ack block")
+                                     << LOG_KV("count", count) << LOG_KV("nodeNum", m_nodeNum)
+                                     << LOG_KV("f", m_f);
+                return false;
+            }
+        }
     }
 
     RAFTENGINE_LOG(TRACE) << LOG_DESC("[#shouldSeal]Seal granted");
@@ -1442,6 +1854,13 @@ bool RaftEngine::commit(Block const& _block)
     m_uncommittedBlockNumber = m_consensusBlockNumber;
     m_waitingForCommitting = true;
     m_commitReady = false;
+    if (g_BCOSConfig.version() >= V2_1_0 && m_nodeNum > 1)
+    {
+        // append the block now instead of on the next heartbeat
+        ul.unlock();
+        broadcastAppendEntries();
+        ul.lock();
+    }
     RAFTENGINE_LOG(DEBUG) << LOG_DESC("[#commit]Wait to commit block")
                           << LOG_KV("nextHeight", m_uncommittedBlockNumber);
     m_commitCV.wait(ul, [this]() { return m_commitReady; });
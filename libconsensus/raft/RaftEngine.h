@@ -27,6 +27,7 @@
 #include <libblockchain/BlockChainInterface.h>
 #include <libblockverifier/BlockVerifierInterface.h>
 #include <libconsensus/ConsensusEngineBase.h>
+#include <libdevcore/ThreadPool.h>
 #include <libethcore/Block.h>
 #include <libnetwork/Common.h>
 #include <libp2p/P2PInterface.h>
@@ -35,6 +36,7 @@
 #include <libstorage/Storage.h>
 #include <libsync/SyncInterface.h>
 #include <libtxpool/TxPoolInterface.h>
+#include <atomic>
 #include <condition_variable>
 #include <memory>
 #include <mutex>
@@ -69,11 +71,15 @@ public:
         m_service->registerHandlerByProtoclID(
             m_protocolId, boost::bind(&RaftEngine::onRecvRaftMessage, this, _1, _2, _3));
         m_blockSync->registerConsensusVerifyHandler([](dev::eth::Block const&) { return true; });
+        m_appendWorker =
+            std::make_shared<dev::ThreadPool>("RaftAppend-" + std::to_string(m_groupId), 1);
         /// set thread name for raftEngine
         std::string threadName = "Raft-" + std::to_string(m_groupId);
         setName(threadName);
     }
 
+    virtual ~RaftEngine() { stop(); }
+
     raft::NodeIndex getNodeIdx() const
     {
         Guard Guard(m_mutex);
@@ -128,12 +134,22 @@ protected:
     void broadcastVoteReq();
     void broadcastHeartbeat();
     void broadcastMsg(dev::p2p::P2PMessage::Ptr _data);
+    /// since 2.1.0 the blocks are appended to every follower from its next index, only to the
+    /// followers behind the leader if _onlyLagging
+    void broadcastAppendEntries(bool _onlyLagging = false);
+    void sendAppendEntries(h512 const& _node);
 
     // handle response
     bool handleVoteRequest(u256 const& _from, h512 const& _node, RaftVoteReq const& _req);
     HandleVoteResult handleVoteResponse(
         u256 const& _from, h512 const& _node, RaftVoteResp const& _resp, VoteState& vote);
     bool handleHeartbeat(u256 const& _from, h512 const& _node, RaftHeartBeat const& _hb);
+    bool handleAppendEntries(u256 const& _from, h512 const& _node, RaftAppendEntries const& _ae);
+    /// store and execute the entries and ack them, in m_appendWorker if blocks are committed
+    void applyAppendEntries(u256 const& _from, h512 const& _node, RaftAppendEntries const& _ae);
+    void handleAppendEntriesResponse(h512 const& _node, RaftAppendEntriesResp const& _resp);
+    /// @returns true if the term of the leader makes this node step down
+    bool updateLeaderTerm(size_t _term);
     bool sendResponse(
         u256 const& _to, h512 const& _node, RaftPacketType _packetType, RaftMsg const& _resp);
 
@@ -148,6 +164,8 @@ protected:
     bool runAsCandidateImp(dev::consensus::VoteState& _voteState);
 
     void tryCommitUncommitedBlock(dev::consensus::RaftHeartBeatResp& _resp);
+    /// commit the uncommitted block acked by the majority, _ul locks m_commitMutex
+    void commitUncommittedBlock(std::unique_lock<std::mutex>& _ul);
     virtual bool checkHeartbeatTimeout();
     virtual bool checkElectTimeout();
     ssize_t getIndexBySealer(dev::h512 const& _nodeId);
@@ -238,6 +256,26 @@ protected:
     bool m_waitingForCommitting;
     std::unordered_map<h256, std::unordered_set<dev::consensus::IDXTYPE>> m_commitFingerPrint;
 
+    struct Progress
+    {
+        /// the first block to append, 0 if unknown
+        int64_t nextIndex;
+        /// the highest block the follower holds, -1 if unknown
+        int64_t matchIndex;
+        h256 matchHash;
+        Progress() : nextIndex(0), matchIndex(-1) {}
+    };
+    /// <node_id, Progress> of the followers, guarded by m_commitMutex
+    std::unordered_map<h512, Progress> m_progress;
+    /// the committed blocks appended to a follower in one message
+    static const int64_t c_maxAppendBlocks = 8;
+    /// the entries committed by the leader are executed by m_appendWorker off the raft thread,
+    /// the entries received meanwhile are dropped and asked again in the ack
+    std::atomic_bool m_appending = {false};
+    std::atomic_bool m_appendDropped = {false};
+    /// declared last to be destroyed first, its tasks access the other members
+    dev::ThreadPool::Ptr m_appendWorker;
+
 private:
     static typename raft::NodeIndex InvalidIndex;
 };
@@ -0,0 +1,315 @@
+/*
+ * @CopyRight:
+ * FISCO-BCOS is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * FISCO-BCOS is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with FISCO-BCOS.  If not, see <http://www.gnu.org/licenses/>
+ * (c) 2016-2018 fisco-dev contributors.
+ */
+/**
+ * @brief : in-process metrics registry of counters, gauges and latency histograms
+ * @file: Metrics.cpp
+ */
+#include "Metrics.h"
+#include <cmath>
+#include <sstream>
+
+using namespace std;
+using namespace dev;
+using namespace dev::metrics;
+
+const size_t Histogram::c_subBucketBits;
+const size_t Histogram::c_subBucketNum;
+const size_t Histogram::c_maxBits;
+const size_t Histogram::c_bucketNum;
+const size_t Histogram::c_shardNum;
+
+uint64_t HistogramSnapshot::quantile(double _quantile) const
+{
+    if (count == 0)
+    {
+        return 0;
+    }
+    uint64_t rank = std::ceil(_quantile * count);
+    if (rank == 0)
+    {
+        rank = 1;
+    }
+    uint64_t seen = 0;
+    for (size_t i = 0; i < buckets.size(); ++i)
+    {
+        seen += buckets[i];
+        if (seen >= rank)
+        {
+            return Histogram::bucketUpperBound(i);
+        }
+    }
+    return Histogram::bucketUpperBound(buckets.size() - 1);
+}
+
+Histogram::Shard::Shard()
+{
+    for (auto& bucket : buckets)
+    {
+        bucket.store(0, std::memory_order_relaxed);
+    }
+    sum.store(0, std::memory_order_relaxed);
+}
+
+size_t Histogram::bucketIndex(uint64_t _value)
+{
+    if (_value < c_subBucketNum)
+    {
+        return _value;
+    }
+    size_t msb = 63 - __builtin_clzll(_value);
+    if (msb >= c_maxBits)
+    {
+        return c_bucketNum - 1;
+    }
+    size_t sub = (_value >> (msb - c_subBucketBits)) & (c_subBucketNum - 1);
+    return (msb - c_subBucketBits + 1) * c_subBucketNum + sub;
+}
+
+uint64_t Histogram::bucketUpperBound(size_t _index)
+{
+    if (_index < c_subBucketNum)
+    {
+        return _index;
+    }
+    size_t msb = _index / c_subBucketNum + c_subBucketBits - 1;
+    uint64_t sub = _index % c_subBucketNum;
+    return ((c_subBucketNum + sub + 1) << (msb - c_subBucketBits)) - 1;
+}
+
+void Histogram::observe(uint64_t _value)
+{
+    static std::atomic<size_t> s_nextShard = {0};
+    static thread_local size_t s_shard = s_nextShard.fetch_add(1) % c_shardNum;
+    auto& shard = m_shards[s_shard];
+    shard.buckets[bucketIndex(_value)].fetch_add(1, std::memory_order_relaxed);
+    shard.sum.fetch_add(_value, std::memory_order_relaxed);
+}
+
+HistogramSnapshot Histogram::snapshot() const
+{
+    HistogramSnapshot result;
+    result.buckets.resize(c_bucketNum, 0);
+    for (auto const& shard : m_shards)
+    {
+        for (size_t i = 0; i < c_bucketNum; ++i)
+        {
+            result.buckets[i] += shard.buckets[i].load(std::memory_order_relaxed);
+        }
+        result.sum += shard.sum.load(std::memory_order_relaxed);
+    }
+    // the shards are read without a lock, count the buckets so that the count matches them
+    for (auto bucket : result.buckets)
+    {
+        result.count += bucket;
+    }
+    return result;
+}
+
+MetricsRegistry& MetricsRegistry::instance()
+{
+    static MetricsRegistry registry;
+    return registry;
+}
+
+MetricsRegistry::Metric& MetricsRegistry::getOrCreate(std::string const& _name,
+    std::string const& _help, MetricLabels const& _labels, MetricType _type)
+{
+    Guard l(x_metrics);
+    auto& metric = m_metrics[std::make_pair(_name, _labels)];
+    if (!metric)
+    {
+        metric.reset(new Metric());
+        metric->name = _name;
+        metric->help = _help;
+        metric->labels = _labels;
+        metric->type = _type;
+        switch (_type)
+        {
+        case MetricType::Counter:
+            metric->counter.reset(new Counter());
+            break;
+        case MetricType::Gauge:
+            metric->gauge.reset(new Gauge());
+            break;
+        case MetricType::Histogram:
+            metric->histogram.reset(new Histogram());
+            break;
+        }
+    }
+    return *metric;
+}
+
+Counter& MetricsRegistry::counter(
+    std::string const& _name, std::string const& _help, MetricLabels const& _labels)
+{
+    return *getOrCreate(_name, _help, _labels, MetricType::Counter).counter;
+}
+
+Gauge& MetricsRegistry::gauge(
+    std::string const& _name, std::string const& _help, MetricLabels const& _labels)
+{
+    return *getOrCreate(_name, _help, _labels, MetricType::Gauge).gauge;
+}
+
+Histogram& MetricsRegistry::histogram(
+    std::string const& _name, std::string const& _help, MetricLabels const& _labels)
+{
+    return *getOrCreate(_name, _help, _labels, MetricType::Histogram).histogram;
+}
+
+std::vector<MetricSnapshot> MetricsRegistry::snapshot() const
+{
+    Guard l(x_metrics);
+    vector<MetricSnapshot> result;
+    result.reserve(m_metrics.size());
+    for (auto const& it : m_metrics)
+    {
+        auto const& metric = *it.second;
+        MetricSnapshot item;
+        item.name = metric.name;
+        item.help = metric.help;
+        item.labels = metric.labels;
+        item.type = metric.type;
+        switch (metric.type)
+        {
+        case MetricType::Counter:
+            item.value = metric.counter->value();
+            break;
+        case MetricType::Gauge:
+            item.value = metric.gauge->value();
+            break;
+        case MetricType::Histogram:
+            item.histogram = metric.histogram->snapshot();
+            break;
+        }
+        result.push_back(std::move(item));
+    }
+    return result;
+}
+
+namespace
+{
+std::string escapeLabelValue(std::string const& _value)
+{
+    std::string result;
+    for (auto c : _value)
+    {
+        if (c == '\\' || c == '"')
+        {
+            result += '\\';
+            result += c;
+        }
+        else if (c == '\n')
+        {
+            result += "\\n";
+        }
+        else
+        {
+            result += c;
+        }
+    }
+    return result;
+}
+
+std::string formatLabels(MetricLabels const& _labels, std::string const& _le = "")
+{
+    if (_labels.empty() && _le.empty())
+    {
+        return "";
+    }
+    std::string result = "{";
+    for (auto const& label : _labels)
+    {
+        if (result.size() > 1)
+        {
+            result += ",";
+        }
+        result += label.first + "=\"" + escapeLabelValue(label.second) + "\"";
+    }
+    if (!_le.empty())
+    {
+        if (result.size() > 1)
+        {
+            result += ",";
+        }
+        result += "le=\"" + _le + "\"";
+    }
+    return result + "}";
+}
+
+char const* typeName(MetricType _type)
+{
+    switch (_type)
+    {
+    case MetricType::Counter:
+        return "counter";
+    case MetricType::Gauge:
+        return "gauge";
+    default:
+        return "histogram";
+    }
+}
+}  // namespace
+
+std::string MetricsRegistry::prometheusText() const
+{
+    std::stringstream out;
+    std::string lastName;
+    for (auto const& metric : snapshot())
+    {
+        if (metric.name != lastName)
+        {
+            out << "# HELP " << metric.name << " " << metric.help << "\n";
+            out << "# TYPE " << metric.name << " " << typeName(metric.type) << "\n";
+            lastName = metric.name;
+        }
+        if (metric.type != MetricType::Histogram)
+        {
+            out << metric.name << formatLabels(metric.labels) << " " << metric.value << "\n";
+            continue;
+        }
+        // only the power of two bounds are exported, up to the last non-empty bucket
+        auto const& histogram = metric.histogram;
+        size_t last = 0;
+        for (size_t i = 0; i < histogram.buckets.size(); ++i)
+        {
+            if (histogram.buckets[i] > 0)
+            {
+                last = i;
+            }
+        }
+        uint64_t cumulative = 0;
+        for (size_t i = 0; i <= last; ++i)
+        {
+            cumulative += histogram.buckets[i];
+            if (i % Histogram::c_subBucketNum == Histogram::c_subBucketNum - 1 || i == last)
+            {
+                out << metric.name << "_bucket"
+                    << formatLabels(
+                           metric.labels, std::to_string(Histogram::bucketUpperBound(i)))
+                    << " " << cumulative << "\n";
+            }
+        }
+        out << metric.name << "_bucket" << formatLabels(metric.labels, "+Inf") << " "
+            << histogram.count << "\n";
+        out << metric.name << "_sum" << formatLabels(metric.labels) << " " << histogram.sum
+            << "\n";
+        out << metric.name << "_count" << formatLabels(metric.labels) << " " << histogram.count
+            << "\n";
+    }
+    return out.str();
+}
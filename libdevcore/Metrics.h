@@ -0,0 +1,166 @@
+/*
+ * @CopyRight:
+ * FISCO-BCOS is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * FISCO-BCOS is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with FISCO-BCOS.  If not, see <http://www.gnu.org/licenses/>
+ * (c) 2016-2018 fisco-dev contributors.
+ */
+/**
+ * @brief : in-process metrics registry of counters, gauges and latency histograms
+ * @file: Metrics.h
+ */
+#pragma once
+
+#include "Guards.h"
+#include <atomic>
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace dev
+{
+namespace metrics
+{
+/// label name => label value, e.g. {"group", "1"}
+typedef std::map<std::string, std::string> MetricLabels;
+
+enum class MetricType
+{
+    Counter,
+    Gauge,
+    Histogram
+};
+
+/// monotonically increasing value
+class Counter
+{
+public:
+    void inc(uint64_t _value = 1) { m_value.fetch_add(_value, std::memory_order_relaxed); }
+    uint64_t value() const { return m_value.load(std::memory_order_relaxed); }
+
+private:
+    std::atomic<uint64_t> m_value = {0};
+};
+
+/// value that goes up and down
+class Gauge
+{
+public:
+    void set(int64_t _value) { m_value.store(_value, std::memory_order_relaxed); }
+    void add(int64_t _value) { m_value.fetch_add(_value, std::memory_order_relaxed); }
+    int64_t value() const { return m_value.load(std::memory_order_relaxed); }
+
+private:
+    std::atomic<int64_t> m_value = {0};
+};
+
+struct HistogramSnapshot
+{
+    /// count of every bucket, the upper bound of bucket i is Histogram::bucketUpperBound(i)
+    std::vector<uint64_t> buckets;
+    uint64_t count = 0;
+    uint64_t sum = 0;
+
+    /// upper bound of the bucket the quantile falls in, _quantile in [0, 1]
+    uint64_t quantile(double _quantile) const;
+};
+
+/// Log-linear histogram: every power of two is split into 4 buckets, so the relative error of a
+/// quantile is below 25% from 1 to 2^40. Observations go to one of the shards picked by the
+/// calling thread, threads never contend on a cache line unless there are more than c_shardNum.
+class Histogram
+{
+public:
+    static const size_t c_subBucketBits = 2;
+    static const size_t c_subBucketNum = 1 << c_subBucketBits;
+    static const size_t c_maxBits = 40;
+    static const size_t c_bucketNum = c_subBucketNum * (c_maxBits - c_subBucketBits + 1);
+    static const size_t c_shardNum = 16;
+
+    void observe(uint64_t _value);
+    HistogramSnapshot snapshot() const;
+
+    static size_t bucketIndex(uint64_t _value);
+    /// the largest value in the bucket
+    static uint64_t bucketUpperBound(size_t _index);
+
+private:
+    struct alignas(64) Shard
+    {
+        std::atomic<uint64_t> buckets[c_bucketNum];
+        std::atomic<uint64_t> sum;
+        Shard();
+    };
+    Shard m_shards[c_shardNum];
+};
+
+struct MetricSnapshot
+{
+    std::string name;
+    std::string help;
+    MetricLabels labels;
+    MetricType type;
+    /// value of counter or gauge
+    int64_t value = 0;
+    HistogramSnapshot histogram;
+};
+
+/// Process-wide registry. Registration takes a lock and returns a reference that stays valid
+/// for the lifetime of the process, the hot path only touches the returned metric:
+///     static auto& s_blocks = MetricsRegistry::instance().counter("blocks_total", "...");
+///     s_blocks.inc();
+class MetricsRegistry
+{
+public:
+    static MetricsRegistry& instance();
+
+    /// return the registered metric if the name and labels have been registered
+    Counter& counter(std::string const& _name, std::string const& _help,
+        MetricLabels const& _labels = MetricLabels());
+    Gauge& gauge(std::string const& _name, std::string const& _help,
+        MetricLabels const& _labels = MetricLabels());
+    /// the unit of a latency histogram is microsecond, name it with the _us suffix
+    Histogram& histogram(std::string const& _name, std::string const& _help,
+        MetricLabels const& _labels = MetricLabels());
+
+    std::vector<MetricSnapshot> snapshot() const;
+    /// Prometheus text exposition format 0.0.4
+    std::string prometheusText() const;
+
+private:
+    struct Metric
+    {
+        std::string name;
+        std::string help;
+        MetricLabels labels;
+        MetricType type;
+        std::unique_ptr<Counter> counter;
+        std::unique_ptr<Gauge> gauge;
+        std::unique_ptr<Histogram> histogram;
+    };
+    Metric& getOrCreate(std::string const& _name, std::string const& _help,
+        MetricLabels const& _labels, MetricType _type);
+
+    mutable Mutex x_metrics;
+    /// ordered by name then labels, so that the families are printed together
+    std::map<std::pair<std::string, MetricLabels>, std::unique_ptr<Metric>> m_metrics;
+};
+
+/// group label used by the metrics of every group
+inline MetricLabels groupLabels(int _groupId)
+{
+    return MetricLabels{{"group", std::to_string(_groupId)}};
+}
+}  // namespace metrics
+}  // namespace dev
@@ -0,0 +1,161 @@
+/*
+ * @CopyRight:
+ * FISCO-BCOS is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * FISCO-BCOS is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with FISCO-BCOS.  If not, see <http://www.gnu.org/licenses/>
+ * (c) 2016-2018 fisco-dev contributors.
+ */
+/**
+ * @brief : span tracer of the block pipeline, the trace of a block is identified by its group and
+ * number
+ * @file: Tracer.cpp
+ */
+#include "Tracer.h"
+#include "Common.h"
+#include "easylog.h"
+#include <limits>
+
+using namespace std;
+using namespace dev;
+using namespace dev::trace;
+
+Tracer& Tracer::instance()
+{
+    static Tracer tracer;
+    return tracer;
+}
+
+uint64_t Tracer::threadId()
+{
+    static std::atomic<uint64_t> s_nextThreadId = {1};
+    static thread_local uint64_t s_threadId = 0;
+    if (s_threadId == 0)
+    {
+        s_threadId = s_nextThreadId.fetch_add(1);
+        auto& tracer = instance();
+        Guard l(tracer.x_threadNames);
+        tracer.m_threadNames[s_threadId] = getThreadName();
+    }
+    return s_threadId;
+}
+
+std::shared_ptr<Tracer::Trace> Tracer::getOrCreate(int _groupId, int64_t _number)
+{
+    auto key = std::make_pair(_groupId, _number);
+    {
+        ReadGuard l(x_traces);
+        auto it = m_traces.find(key);
+        if (it != m_traces.end())
+        {
+            return it->second;
+        }
+    }
+    WriteGuard l(x_traces);
+    auto& slot = m_traces[key];
+    if (slot)
+    {
+        return slot;
+    }
+    slot = std::make_shared<Trace>();
+    auto trace = slot;
+    // evict the oldest blocks of the group, a span of an evicted block is recorded into the
+    // detached trace and dropped with it
+    auto begin =
+        m_traces.lower_bound(std::make_pair(_groupId, std::numeric_limits<int64_t>::min()));
+    auto end = m_traces.upper_bound(std::make_pair(_groupId, std::numeric_limits<int64_t>::max()));
+    size_t count = std::distance(begin, end);
+    while (count > m_maxBlocks)
+    {
+        begin = m_traces.erase(begin);
+        --count;
+    }
+    return trace;
+}
+
+void Tracer::record(int _groupId, int64_t _number, Span&& _span)
+{
+    auto trace = getOrCreate(_groupId, _number);
+    Guard l(trace->lock);
+    if (trace->spans.size() < c_maxSpansPerBlock)
+    {
+        trace->spans.push_back(std::move(_span));
+    }
+}
+
+std::vector<BlockTrace> Tracer::traces(int _groupId, size_t _blockCount) const
+{
+    vector<BlockTrace> result;
+    ReadGuard l(x_traces);
+    auto begin =
+        m_traces.lower_bound(std::make_pair(_groupId, std::numeric_limits<int64_t>::min()));
+    auto end = m_traces.upper_bound(std::make_pair(_groupId, std::numeric_limits<int64_t>::max()));
+    size_t count = std::distance(begin, end);
+    for (; count > _blockCount; --count)
+    {
+        ++begin;
+    }
+    for (auto it = begin; it != end; ++it)
+    {
+        BlockTrace blockTrace;
+        blockTrace.groupId = it->first.first;
+        blockTrace.number = it->first.second;
+        {
+            Guard traceLock(it->second->lock);
+            blockTrace.spans = it->second->spans;
+        }
+        result.push_back(std::move(blockTrace));
+    }
+    return result;
+}
+
+std::map<uint64_t, std::string> Tracer::threadNames() const
+{
+    Guard l(x_threadNames);
+    return m_threadNames;
+}
+
+void Tracer::clear()
+{
+    WriteGuard l(x_traces);
+    m_traces.clear();
+}
+
+ScopedSpan::ScopedSpan(char const* _name, char const* _category, int _groupId, int64_t _number)
+  : m_name(_name), m_category(_category), m_groupId(_groupId), m_number(_number), m_startUs(0)
+{
+    if (Tracer::instance().enabled())
+    {
+        m_startUs = utcTimeUs();
+    }
+}
+
+ScopedSpan::~ScopedSpan()
+{
+    if (m_startUs == 0)
+    {
+        return;
+    }
+    try
+    {
+        Span span;
+        span.name = m_name;
+        span.category = m_category;
+        span.startUs = m_startUs;
+        span.durationUs = utcTimeUs() - m_startUs;
+        span.threadId = Tracer::threadId();
+        Tracer::instance().record(m_groupId, m_number, std::move(span));
+    }
+    catch (...)
+    {
+        // tracing never breaks the traced code
+    }
+}
@@ -0,0 +1,121 @@
+/*
+ * @CopyRight:
+ * FISCO-BCOS is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * FISCO-BCOS is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with FISCO-BCOS.  If not, see <http://www.gnu.org/licenses/>
+ * (c) 2016-2018 fisco-dev contributors.
+ */
+/**
+ * @brief : span tracer of the block pipeline, the trace of a block is identified by its group and
+ * number
+ * @file: Tracer.h
+ */
+#pragma once
+
+#include "Guards.h"
+#include <atomic>
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace dev
+{
+namespace trace
+{
+/// traces of the latest blocks kept for every group
+static size_t const c_defaultMaxTracedBlocks = 64;
+/// bound the memory of a huge block, the spans after it are dropped
+static size_t const c_maxSpansPerBlock = 100000;
+
+struct Span
+{
+    std::string name;
+    /// stage of the pipeline: seal, consensus, execute, blockchain, storage
+    std::string category;
+    uint64_t startUs;
+    uint64_t durationUs;
+    uint64_t threadId;
+};
+
+struct BlockTrace
+{
+    int groupId;
+    int64_t number;
+    std::vector<Span> spans;
+};
+
+/// Unlike TimeRecorder, spans carry their block and are kept per block instead of per thread, so
+/// they can be recorded from any thread including the TBB workers.
+class Tracer
+{
+public:
+    static Tracer& instance();
+
+    void setEnabled(bool _enabled) { m_enabled.store(_enabled, std::memory_order_relaxed); }
+    bool enabled() const { return m_enabled.load(std::memory_order_relaxed); }
+    void setMaxBlocks(size_t _maxBlocks) { m_maxBlocks = _maxBlocks; }
+
+    void record(int _groupId, int64_t _number, Span&& _span);
+    /// the traces of the latest _blockCount blocks of the group, ordered by block number
+    std::vector<BlockTrace> traces(int _groupId, size_t _blockCount) const;
+    /// thread id => thread name of the threads having recorded spans
+    std::map<uint64_t, std::string> threadNames() const;
+    void clear();
+
+    /// small sequential id of the calling thread
+    static uint64_t threadId();
+
+private:
+    struct Trace
+    {
+        Mutex lock;
+        std::vector<Span> spans;
+    };
+    std::shared_ptr<Trace> getOrCreate(int _groupId, int64_t _number);
+
+    std::atomic<bool> m_enabled = {false};
+    std::atomic<size_t> m_maxBlocks = {c_defaultMaxTracedBlocks};
+
+    mutable SharedMutex x_traces;
+    std::map<std::pair<int, int64_t>, std::shared_ptr<Trace>> m_traces;
+
+    mutable Mutex x_threadNames;
+    std::map<uint64_t, std::string> m_threadNames;
+};
+
+/// record the lifetime of the object as a span if the tracer is enabled
+class ScopedSpan
+{
+public:
+    ScopedSpan(char const* _name, char const* _category, int _groupId, int64_t _number);
+    ~ScopedSpan();
+
+private:
+    char const* m_name;
+    char const* m_category;
+    int m_groupId;
+    int64_t m_number;
+    /// 0 if the tracer was disabled when the span began
+    uint64_t m_startUs;
+};
+}  // namespace trace
+}  // namespace dev
+
+#define __TRACE_SPAN(name, category, group, number, var, line) \
+    ::dev::trace::ScopedSpan var##line(name, category, group, number)
+#define _TRACE_SPAN(name, category, group, number, line) \
+    __TRACE_SPAN(name, category, group, number, _trace_span, line)
+/// TRACE_SPAN("execute", "execute", groupId, blockNumber) traces the rest of the scope
+#define TRACE_SPAN(name, category, group, number) \
+    _TRACE_SPAN(name, category, group, number, __LINE__)
@@ -3,6 +3,7 @@
 #include <libdevcore/FixedHash.h>
 #include <libdevcore/vector_ref.h>
 #include <string>
+#include <vector>
 
 namespace dev
 {
@@ -18,6 +19,10 @@ h256 sha256(bytesConstRef _input) noexcept;
 
 h160 ripemd160(bytesConstRef _input);
 
+/// Calculate the hashes of a batch of inputs, the same as calling sha3 (SM3 for FISCO_GM) on each
+/// of them. Several inputs are hashed at once in the SIMD lanes when the CPU supports AVX2 or AVX-512.
+std::vector<h256> sha3Batch(std::vector<bytesConstRef> const& _inputs);
+
 /// Calculate SHA3-256 hash of the given input, returning as a 256-bit hash.
 inline h256 sha3(bytesConstRef _input)
 {
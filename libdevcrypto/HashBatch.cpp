@@ -0,0 +1,209 @@
+#include "HashBatch.h"
+#include <cstdint>
+#include <cstring>
+
+using namespace std;
+using namespace dev;
+using namespace dev::crypto;
+
+namespace
+{
+#if DEV_HASH_BATCH_SIMD
+/// 200 - 256 / 4 bytes absorbed per permutation
+size_t const c_keccakRate = 136;
+
+uint8_t const c_rho[24] = {
+    1, 3, 6, 10, 15, 21, 28, 36, 45, 55, 2, 14, 27, 41, 56, 8, 25, 43, 62, 18, 39, 61, 20, 44};
+uint8_t const c_pi[24] = {
+    10, 7, 11, 17, 18, 3, 5, 16, 8, 21, 24, 4, 15, 23, 19, 13, 12, 2, 20, 14, 22, 9, 6, 1};
+uint64_t const c_RC[24] = {1ULL, 0x8082ULL, 0x800000000000808aULL, 0x8000000080008000ULL,
+    0x808bULL, 0x80000001ULL, 0x8000000080008081ULL, 0x8000000000008009ULL, 0x8aULL, 0x88ULL,
+    0x80008009ULL, 0x8000000aULL, 0x8000808bULL, 0x800000000000008bULL, 0x8000000000008089ULL,
+    0x8000000000008003ULL, 0x8000000000008002ULL, 0x8000000000000080ULL, 0x800aULL,
+    0x800000008000000aULL, 0x8000000080008081ULL, 0x8000000000008080ULL, 0x80000001ULL,
+    0x8000000080008008ULL};
+
+typedef uint64_t u64x4 __attribute__((vector_size(32)));
+typedef uint64_t u64x8 __attribute__((vector_size(64)));
+
+/// Keccak-f[1600] of independent states, a[i] holds the word i of every lane. It is inlined into
+/// the target specific kernels below and compiled with their instruction set.
+template <typename V>
+inline __attribute__((always_inline)) void keccakfLanes(V* a)
+{
+    V b[5];
+    for (size_t round = 0; round < 24; ++round)
+    {
+        // Theta
+        for (size_t x = 0; x < 5; ++x)
+        {
+            b[x] = a[x] ^ a[x + 5] ^ a[x + 10] ^ a[x + 15] ^ a[x + 20];
+        }
+        for (size_t x = 0; x < 5; ++x)
+        {
+            V d = b[(x + 4) % 5] ^ ((b[(x + 1) % 5] << 1) | (b[(x + 1) % 5] >> 63));
+            for (size_t y = 0; y < 25; y += 5)
+            {
+                a[y + x] ^= d;
+            }
+        }
+        // Rho and pi, unrolled so the rotations are by constants
+        V t = a[1];
+#pragma GCC unroll 24
+        for (size_t i = 0; i < 24; ++i)
+        {
+            V next = a[c_pi[i]];
+            a[c_pi[i]] = (t << c_rho[i]) | (t >> (64 - c_rho[i]));
+            t = next;
+        }
+        // Chi
+        for (size_t y = 0; y < 25; y += 5)
+        {
+            for (size_t x = 0; x < 5; ++x)
+            {
+                b[x] = a[y + x];
+            }
+            for (size_t x = 0; x < 5; ++x)
+            {
+                a[y + x] = b[x] ^ (~b[(x + 1) % 5] & b[(x + 2) % 5]);
+            }
+        }
+        // Iota
+        a[0] ^= c_RC[round];
+    }
+}
+
+__attribute__((target("avx2"))) void keccakfAVX2(uint64_t* _state)
+{
+    u64x4 a[25];
+    memcpy(a, _state, sizeof(a));
+    keccakfLanes(a);
+    memcpy(_state, a, sizeof(a));
+}
+
+__attribute__((target("avx512f"))) void keccakfAVX512(uint64_t* _state)
+{
+    u64x8 a[25];
+    memcpy(a, _state, sizeof(a));
+    keccakfLanes(a);
+    memcpy(_state, a, sizeof(a));
+}
+
+/// Multi-buffer sponge: every lane absorbs one block of its own input per permutation and takes
+/// the next input as soon as the current one is squeezed, so inputs of different sizes keep all
+/// the lanes busy
+template <size_t Lanes>
+void keccakMultiBuffer(
+    vector<bytesConstRef> const& _inputs, h256* o_outputs, void (*_permute)(uint64_t*))
+{
+    /// the word i of the lane l is state[i * Lanes + l]
+    uint64_t state[25 * Lanes];
+    size_t input[Lanes];
+    /// bytes of the input absorbed, beyond its size once the padding is absorbed
+    size_t absorbed[Lanes];
+    bool busy[Lanes];
+    size_t next = 0;
+    size_t busyLanes = 0;
+    auto take = [&](size_t _lane) {
+        for (size_t i = 0; i < 25; ++i)
+        {
+            state[i * Lanes + _lane] = 0;
+        }
+        busy[_lane] = next < _inputs.size();
+        input[_lane] = next;
+        absorbed[_lane] = 0;
+        if (busy[_lane])
+        {
+            ++next;
+            ++busyLanes;
+        }
+    };
+    for (size_t lane = 0; lane < Lanes; ++lane)
+    {
+        take(lane);
+    }
+
+    uint8_t lastBlock[c_keccakRate];
+    while (busyLanes > 0)
+    {
+        for (size_t lane = 0; lane < Lanes; ++lane)
+        {
+            if (!busy[lane])
+            {
+                continue;
+            }
+            bytesConstRef data = _inputs[input[lane]];
+            size_t remaining = data.size() - absorbed[lane];
+            uint8_t const* block = lastBlock;
+            if (remaining >= c_keccakRate)
+            {
+                block = data.data() + absorbed[lane];
+                absorbed[lane] += c_keccakRate;
+            }
+            else
+            {
+                // pad with the same delimiter as keccak::sha3_256
+                memset(lastBlock, 0, sizeof(lastBlock));
+                if (remaining > 0)
+                {
+                    memcpy(lastBlock, data.data() + absorbed[lane], remaining);
+                }
+                lastBlock[remaining] ^= 0x01;
+                lastBlock[c_keccakRate - 1] ^= 0x80;
+                absorbed[lane] = data.size() + 1;
+            }
+            for (size_t i = 0; i < c_keccakRate / 8; ++i)
+            {
+                uint64_t word;
+                memcpy(&word, block + i * 8, 8);
+                state[i * Lanes + lane] ^= word;
+            }
+        }
+        _permute(state);
+        for (size_t lane = 0; lane < Lanes; ++lane)
+        {
+            if (busy[lane] && absorbed[lane] > _inputs[input[lane]].size())
+            {
+                for (size_t i = 0; i < 4; ++i)
+                {
+                    memcpy(o_outputs[input[lane]].data() + i * 8, &state[i * Lanes + lane], 8);
+                }
+                --busyLanes;
+                take(lane);
+            }
+        }
+    }
+}
+#endif
+}  // namespace
+
+std::vector<h256> dev::crypto::sha3Batch(
+    std::vector<bytesConstRef> const& _inputs, HashKernel _kernel)
+{
+    std::vector<h256> outputs(_inputs.size());
+#if DEV_HASH_BATCH_SIMD
+    // the idle lanes of a tail are permuted anyway, small batches go to narrower kernels
+    if (_kernel == HashKernel::AVX512 && _inputs.size() >= 8)
+    {
+        keccakMultiBuffer<8>(_inputs, outputs.data(), keccakfAVX512);
+        return outputs;
+    }
+    if (_kernel != HashKernel::Scalar && _inputs.size() >= 4)
+    {
+        keccakMultiBuffer<4>(_inputs, outputs.data(), keccakfAVX2);
+        return outputs;
+    }
+#else
+    (void)_kernel;
+#endif
+    for (size_t i = 0; i < _inputs.size(); ++i)
+    {
+        sha3(_inputs[i], outputs[i].ref());
+    }
+    return outputs;
+}
+
+std::vector<h256> dev::sha3Batch(std::vector<bytesConstRef> const& _inputs)
+{
+    return crypto::sha3Batch(_inputs, bestHashKernel());
+}
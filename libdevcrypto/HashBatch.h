@@ -0,0 +1,59 @@
+#pragma once
+
+#include "Hash.h"
+
+#if defined(__x86_64__) && defined(__GNUC__)
+/// the multi-lane kernels are compiled for x86_64 and selected at runtime
+#define DEV_HASH_BATCH_SIMD 1
+#else
+#define DEV_HASH_BATCH_SIMD 0
+#endif
+
+namespace dev
+{
+namespace crypto
+{
+enum class HashKernel
+{
+    Scalar,
+    /// 4 Keccak or 8 SM3 lanes
+    AVX2,
+    /// 8 Keccak or 16 SM3 lanes
+    AVX512
+};
+
+/// the widest kernel supported by the CPU
+inline HashKernel bestHashKernel()
+{
+#if DEV_HASH_BATCH_SIMD
+    static HashKernel const s_kernel = []() -> HashKernel {
+        __builtin_cpu_init();
+        if (__builtin_cpu_supports("avx512f"))
+        {
+            return HashKernel::AVX512;
+        }
+        return __builtin_cpu_supports("avx2") ? HashKernel::AVX2 : HashKernel::Scalar;
+    }();
+    return s_kernel;
+#else
+    return HashKernel::Scalar;
+#endif
+}
+
+inline char const* hashKernelName(HashKernel _kernel)
+{
+    switch (_kernel)
+    {
+    case HashKernel::AVX2:
+        return "AVX2";
+    case HashKernel::AVX512:
+        return "AVX-512";
+    default:
+        return "scalar";
+    }
+}
+
+/// sha3Batch with the given kernel, which must be supported by the CPU
+std::vector<h256> sha3Batch(std::vector<bytesConstRef> const& _inputs, HashKernel _kernel);
+}  // namespace crypto
+}  // namespace dev
@@ -0,0 +1,249 @@
+#include "libdevcrypto/HashBatch.h"
+#include <cstdint>
+#include <cstring>
+
+using namespace std;
+using namespace dev;
+using namespace dev::crypto;
+
+namespace
+{
+#if DEV_HASH_BATCH_SIMD
+size_t const c_sm3BlockSize = 64;
+
+uint32_t const c_sm3IV[8] = {0x7380166f, 0x4914b2b9, 0x172442d7, 0xda8a0600, 0xa96f30bc,
+    0x163138aa, 0xe38dee4d, 0xb0fb0e4e};
+
+typedef uint32_t u32x8 __attribute__((vector_size(32)));
+typedef uint32_t u32x16 __attribute__((vector_size(64)));
+
+#define SM3_ROTL(x, n) (((x) << (n)) | ((x) >> (32 - (n))))
+#define SM3_P0(x) ((x) ^ SM3_ROTL((x), 9) ^ SM3_ROTL((x), 17))
+#define SM3_P1(x) ((x) ^ SM3_ROTL((x), 15) ^ SM3_ROTL((x), 23))
+
+/// T_j rotated left by j mod 32
+struct SM3RoundConstants
+{
+    SM3RoundConstants()
+    {
+        for (size_t j = 0; j < 64; ++j)
+        {
+            uint32_t t = j < 16 ? 0x79cc4519 : 0x7a879d8a;
+            size_t shift = j % 32;
+            value[j] = shift == 0 ? t : SM3_ROTL(t, shift);
+        }
+    }
+    uint32_t value[64];
+};
+SM3RoundConstants const c_sm3T;
+
+/// SM3 compression of independent states, v[i] holds the word i of every lane and w[j] the big
+/// endian message word j of every lane. It is inlined into the target specific kernels below and
+/// compiled with their instruction set.
+template <typename V>
+inline __attribute__((always_inline)) void sm3CompressLanes(V* v, V const* _block)
+{
+    V w[68];
+    for (size_t j = 0; j < 16; ++j)
+    {
+        w[j] = _block[j];
+    }
+    for (size_t j = 16; j < 68; ++j)
+    {
+        V x = w[j - 16] ^ w[j - 9] ^ SM3_ROTL(w[j - 3], 15);
+        w[j] = SM3_P1(x) ^ SM3_ROTL(w[j - 13], 7) ^ w[j - 6];
+    }
+    V a = v[0], b = v[1], c = v[2], d = v[3], e = v[4], f = v[5], g = v[6], h = v[7];
+    for (size_t j = 0; j < 64; ++j)
+    {
+        V a12 = SM3_ROTL(a, 12);
+        V ss1 = a12 + e + c_sm3T.value[j];
+        ss1 = SM3_ROTL(ss1, 7);
+        V ss2 = ss1 ^ a12;
+        V ff, gg;
+        if (j < 16)
+        {
+            ff = a ^ b ^ c;
+            gg = e ^ f ^ g;
+        }
+        else
+        {
+            ff = (a & b) | (a & c) | (b & c);
+            gg = (e & f) | (~e & g);
+        }
+        V tt1 = ff + d + ss2 + (w[j] ^ w[j + 4]);
+        V tt2 = gg + h + ss1 + w[j];
+        d = c;
+        c = SM3_ROTL(b, 9);
+        b = a;
+        a = tt1;
+        h = g;
+        g = SM3_ROTL(f, 19);
+        f = e;
+        e = SM3_P0(tt2);
+    }
+    v[0] ^= a;
+    v[1] ^= b;
+    v[2] ^= c;
+    v[3] ^= d;
+    v[4] ^= e;
+    v[5] ^= f;
+    v[6] ^= g;
+    v[7] ^= h;
+}
+
+__attribute__((target("avx2"))) void sm3CompressAVX2(uint32_t* _state, uint32_t const* _block)
+{
+    u32x8 v[8];
+    u32x8 w[16];
+    memcpy(v, _state, sizeof(v));
+    memcpy(w, _block, sizeof(w));
+    sm3CompressLanes(v, w);
+    memcpy(_state, v, sizeof(v));
+}
+
+__attribute__((target("avx512f"))) void sm3CompressAVX512(uint32_t* _state, uint32_t const* _block)
+{
+    u32x16 v[8];
+    u32x16 w[16];
+    memcpy(v, _state, sizeof(v));
+    memcpy(w, _block, sizeof(w));
+    sm3CompressLanes(v, w);
+    memcpy(_state, v, sizeof(v));
+}
+
+/// Multi-buffer Merkle-Damgard: every lane compresses one block of its own input per call and
+/// takes the next input as soon as the current one is finished, so inputs of different sizes keep
+/// all the lanes busy
+template <size_t Lanes>
+void sm3MultiBuffer(vector<bytesConstRef> const& _inputs, h256* o_outputs,
+    void (*_compress)(uint32_t*, uint32_t const*))
+{
+    /// the word i of the lane l is state[i * Lanes + l], the same for the message words of block
+    uint32_t state[8 * Lanes];
+    uint32_t block[16 * Lanes];
+    size_t input[Lanes];
+    /// blocks of the padded input, and the blocks compressed
+    size_t blocks[Lanes];
+    size_t compressed[Lanes];
+    bool busy[Lanes];
+    size_t next = 0;
+    size_t busyLanes = 0;
+    memset(block, 0, sizeof(block));
+    auto take = [&](size_t _lane) {
+        for (size_t i = 0; i < 8; ++i)
+        {
+            state[i * Lanes + _lane] = c_sm3IV[i];
+        }
+        busy[_lane] = next < _inputs.size();
+        input[_lane] = next;
+        compressed[_lane] = 0;
+        if (busy[_lane])
+        {
+            // 0x80 and the 64 bits length are appended
+            blocks[_lane] = (_inputs[next].size() + 8) / c_sm3BlockSize + 1;
+            ++next;
+            ++busyLanes;
+        }
+    };
+    for (size_t lane = 0; lane < Lanes; ++lane)
+    {
+        take(lane);
+    }
+
+    uint8_t padded[c_sm3BlockSize];
+    while (busyLanes > 0)
+    {
+        for (size_t lane = 0; lane < Lanes; ++lane)
+        {
+            if (!busy[lane])
+            {
+                continue;
+            }
+            bytesConstRef data = _inputs[input[lane]];
+            size_t begin = compressed[lane] * c_sm3BlockSize;
+            uint8_t const* message = padded;
+            if (begin + c_sm3BlockSize <= data.size())
+            {
+                message = data.data() + begin;
+            }
+            else
+            {
+                memset(padded, 0, sizeof(padded));
+                if (begin < data.size())
+                {
+                    memcpy(padded, data.data() + begin, data.size() - begin);
+                }
+                if (data.size() >= begin)
+                {
+                    padded[data.size() - begin] = 0x80;
+                }
+                if (compressed[lane] + 1 == blocks[lane])
+                {
+                    uint64_t bits = (uint64_t)data.size() * 8;
+                    for (size_t i = 0; i < 8; ++i)
+                    {
+                        padded[c_sm3BlockSize - 1 - i] = (uint8_t)(bits >> (8 * i));
+                    }
+                }
+            }
+            for (size_t j = 0; j < 16; ++j)
+            {
+                block[j * Lanes + lane] = ((uint32_t)message[4 * j] << 24) |
+                                          ((uint32_t)message[4 * j + 1] << 16) |
+                                          ((uint32_t)message[4 * j + 2] << 8) | message[4 * j + 3];
+            }
+        }
+        _compress(state, block);
+        for (size_t lane = 0; lane < Lanes; ++lane)
+        {
+            if (busy[lane] && ++compressed[lane] == blocks[lane])
+            {
+                uint8_t* out = o_outputs[input[lane]].data();
+                for (size_t i = 0; i < 8; ++i)
+                {
+                    uint32_t word = state[i * Lanes + lane];
+                    out[4 * i] = (uint8_t)(word >> 24);
+                    out[4 * i + 1] = (uint8_t)(word >> 16);
+                    out[4 * i + 2] = (uint8_t)(word >> 8);
+                    out[4 * i + 3] = (uint8_t)word;
+                }
+                --busyLanes;
+                take(lane);
+            }
+        }
+    }
+}
+#endif
+}  // namespace
+
+std::vector<h256> dev::crypto::sha3Batch(
+    std::vector<bytesConstRef> const& _inputs, HashKernel _kernel)
+{
+    std::vector<h256> outputs(_inputs.size());
+#if DEV_HASH_BATCH_SIMD
+    // the idle lanes of a tail are compressed anyway, small batches go to narrower kernels
+    if (_kernel == HashKernel::AVX512 && _inputs.size() >= 16)
+    {
+        sm3MultiBuffer<16>(_inputs, outputs.data(), sm3CompressAVX512);
+        return outputs;
+    }
+    if (_kernel != HashKernel::Scalar && _inputs.size() >= 8)
+    {
+        sm3MultiBuffer<8>(_inputs, outputs.data(), sm3CompressAVX2);
+        return outputs;
+    }
+#else
+    (void)_kernel;
+#endif
+    for (size_t i = 0; i < _inputs.size(); ++i)
+    {
+        sha3(_inputs[i], outputs[i].ref());
+    }
+    return outputs;
+}
+
+std::vector<h256> dev::sha3Batch(std::vector<bytesConstRef> const& _inputs)
+{
+    return crypto::sha3Batch(_inputs, bestHashKernel());
+}
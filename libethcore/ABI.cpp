@@ -77,57 +77,6 @@ bool ContractABI::abiOutByFuncSelector(
     return true;
 }
 
-// unsigned integer type uint256.
-bytes ContractABI::serialise(const int& _in)
-{
-    return serialise((s256)_in);
-}
-
-// unsigned integer type uint256.
-bytes ContractABI::serialise(const u256& _in)
-{
-    return h256(_in).asBytes();
-}
-
-// two’s complement signed integer type int256.
-bytes ContractABI::serialise(const s256& _in)
-{
-    return h256(_in.convert_to<u256>()).asBytes();
-}
-
-// equivalent to uint8 restricted to the values 0 and 1. For computing the function selector,
-// bool is used
-bytes ContractABI::serialise(const bool& _in)
-{
-    return h256(u256(_in ? 1 : 0)).asBytes();
-}
-
-// equivalent to uint160, except for the assumed interpretation and language typing. For
-// computing the function selector, address is used.
-// bool is used.
-bytes ContractABI::serialise(const Address& _in)
-{
-    return bytes(12, 0) + _in.asBytes();
-}
-
-// binary type of 32 bytes
-bytes ContractABI::serialise(const string32& _in)
-{
-    bytes ret(32, 0);
-    bytesConstRef((byte const*)_in.data(), 32).populate(bytesRef(&ret));
-    return ret;
-}
-
-// dynamic sized unicode string assumed to be UTF-8 encoded.
-bytes ContractABI::serialise(const std::string& _in)
-{
-    bytes ret;
-    ret = h256(u256(_in.size())).asBytes();
-    ret.resize(ret.size() + (_in.size() + 31) / MAX_BYTE_LENGTH * MAX_BYTE_LENGTH);
-    bytesConstRef(&_in).populate(bytesRef(&ret).cropped(32));
-    return ret;
-}
-
 void ContractABI::deserialise(s256& out, std::size_t _offset)
 {
     validOffset(_offset + MAX_BYTE_LENGTH - 1);
@@ -184,3 +133,12 @@ void ContractABI::deserialise(std::string& _out, std::size_t _offset)
     auto result = data.cropped(_offset + MAX_BYTE_LENGTH, static_cast<size_t>(len));
     _out.assign((const char*)result.data(), result.size());
 }
+
+void ContractABI::deserialise(bytesConstRef& _out, std::size_t _offset)
+{
+    validOffset(_offset + MAX_BYTE_LENGTH - 1);
+
+    u256 len = fromBigEndian<u256>(data.cropped(_offset, MAX_BYTE_LENGTH));
+    validOffset(_offset + MAX_BYTE_LENGTH + (std::size_t)len - 1);
+    _out = data.cropped(_offset + MAX_BYTE_LENGTH, static_cast<size_t>(len));
+}
@@ -28,6 +28,7 @@
 #include <libdevcore/CommonData.h>
 #include <libdevcrypto/Hash.h>
 #include <boost/algorithm/string.hpp>
+#include <cstring>
 
 namespace dev
 {
@@ -71,6 +72,12 @@ struct ABIElementType<string32> : std::true_type
 {
 };
 
+// string or bytes decoded as a view of the data
+template <>
+struct ABIElementType<bytesConstRef> : std::true_type
+{
+};
+
 // check if T type of string
 template <class T>
 struct ABIStringType : std::false_type
@@ -82,6 +89,11 @@ struct ABIStringType<std::string> : std::true_type
 {
 };
 
+template <>
+struct ABIStringType<bytesConstRef> : std::true_type
+{
+};
+
 // check if type of static array
 template <class T>
 struct ABIStaticArray : std::false_type
@@ -206,11 +218,8 @@ class ContractABI
 {
 private:
     static const int MAX_BYTE_LENGTH = 32;
-    // encode or decode offset
+    // decode offset
     std::size_t offset{0};
-    // encode temp bytes
-    bytes fixed;
-    bytes dynamic;
 
     // decode data
     bytesConstRef data;
@@ -237,44 +246,119 @@ private:
         return ss.str();
     }
 
+    static std::size_t paddedLength(std::size_t _length)
+    {
+        return (_length + MAX_BYTE_LENGTH - 1) / MAX_BYTE_LENGTH * MAX_BYTE_LENGTH;
+    }
+
 public:
+    // size of the encoding of a static type
+    template <class T>
+    static typename std::enable_if<!ABIDynamicType<T>::value, std::size_t>::type encodedSize(
+        const T&)
+    {
+        return Offset<T>::value * MAX_BYTE_LENGTH;
+    }
+    static std::size_t encodedSize(const std::string& _in)
+    {
+        return MAX_BYTE_LENGTH + paddedLength(_in.size());
+    }
+    static std::size_t encodedSize(bytesConstRef _in)
+    {
+        return MAX_BYTE_LENGTH + paddedLength(_in.size());
+    }
+    template <class T, std::size_t N>
+    static typename std::enable_if<ABIDynamicType<T>::value, std::size_t>::type encodedSize(
+        const std::array<T, N>& _in)
+    {
+        return elementsSize(_in.data(), N);
+    }
     template <class T>
-    bytes serialise(const T& _t)
+    static std::size_t encodedSize(const std::vector<T>& _in)
+    {
+        return MAX_BYTE_LENGTH + elementsSize(_in.data(), _in.size());
+    }
+
+    // encode into a buffer of encodedSize(_in) bytes, returns the end of the encoding
+    template <class T>
+    static byte* encode(byte* _out, const T& _in)
     {  // unsupport type
-        (void)_t;
+        (void)_out;
+        (void)_in;
         static_assert(ABIElementType<T>::value, "ABI not support type.");
-        return bytes{};
+        return _out;
     }
-    // unsigned integer type int.
-    bytes serialise(const int& _in);
 
     // unsigned integer type uint256.
-    bytes serialise(const u256& _in);
+    static byte* encode(byte* _out, const u256& _in)
+    {
+        bytesRef out(_out, MAX_BYTE_LENGTH);
+        toBigEndian(_in, out);
+        return _out + MAX_BYTE_LENGTH;
+    }
 
     // two’s complement signed integer type int256.
-    bytes serialise(const s256& _in);
+    static byte* encode(byte* _out, const s256& _in)
+    {
+        return encode(_out, _in.convert_to<u256>());
+    }
 
-    // equivalent to uint8 restricted to the values 0 and 1. For computing the function selector,
-    // bool is used
-    bytes serialise(const bool& _in);
+    static byte* encode(byte* _out, const int& _in) { return encode(_out, (s256)_in); }
 
-    // equivalent to uint160, except for the assumed interpretation and language typing. For
-    // computing the function selector, address is used.
-    // bool is used.
-    bytes serialise(const Address& _in);
+    // equivalent to uint8 restricted to the values 0 and 1.
+    static byte* encode(byte* _out, const bool& _in) { return encode(_out, u256(_in ? 1 : 0)); }
+
+    // equivalent to uint160
+    static byte* encode(byte* _out, const Address& _in)
+    {
+        memset(_out, 0, MAX_BYTE_LENGTH - Address::size);
+        memcpy(_out + MAX_BYTE_LENGTH - Address::size, _in.data(), Address::size);
+        return _out + MAX_BYTE_LENGTH;
+    }
 
     // binary type of 32 bytes
-    bytes serialise(const string32& _in);
+    static byte* encode(byte* _out, const string32& _in)
+    {
+        memcpy(_out, _in.data(), MAX_BYTE_LENGTH);
+        return _out + MAX_BYTE_LENGTH;
+    }
 
     // dynamic sized unicode string assumed to be UTF-8 encoded.
-    bytes serialise(const std::string& _in);
+    static byte* encode(byte* _out, const std::string& _in)
+    {
+        return encode(_out, bytesConstRef((byte const*)_in.data(), _in.size()));
+    }
+
+    // dynamic sized bytes or string in the calldata
+    static byte* encode(byte* _out, bytesConstRef _in)
+    {
+        _out = encode(_out, u256(_in.size()));
+        memcpy(_out, _in.data(), _in.size());
+        memset(_out + _in.size(), 0, paddedLength(_in.size()) - _in.size());
+        return _out + paddedLength(_in.size());
+    }
 
     // static array
     template <class T, std::size_t N>
-    bytes serialise(const std::array<T, N>& _in);
+    static byte* encode(byte* _out, const std::array<T, N>& _in)
+    {
+        return encodeElements(_out, _in.data(), N);
+    }
+
     // dynamic array
     template <class T>
-    bytes serialise(const std::vector<T>& _in);
+    static byte* encode(byte* _out, const std::vector<T>& _in)
+    {
+        return encodeElements(encode(_out, u256(_in.size())), _in.data(), _in.size());
+    }
+
+    template <class T>
+    bytes serialise(const T& _in)
+    {
+        bytes out(encodedSize(_in));
+        encode(out.data(), _in);
+        return out;
+    }
 
     template <class T>
     void deserialise(const T& _t, std::size_t _offset)
@@ -296,6 +380,9 @@ public:
 
     void deserialise(std::string& _out, std::size_t _offset);
 
+    // view of the string or bytes in the decode data, valid as long as the data
+    void deserialise(bytesConstRef& _out, std::size_t _offset);
+
     // static array
     template <class T, std::size_t N>
     void deserialise(std::array<T, N>& _out, std::size_t _offset);
@@ -304,25 +391,56 @@ public:
     void deserialise(std::vector<T>& _out, std::size_t _offset);
 
 private:
-    inline void abiInAux() { return; }
+    template <class T>
+    static std::size_t elementsSize(const T* _begin, std::size_t _count)
+    {
+        std::size_t size = ABIDynamicType<T>::value ? _count * MAX_BYTE_LENGTH : 0;
+        for (std::size_t i = 0; i < _count; ++i)
+        {
+            size += encodedSize(_begin[i]);
+        }
+        return size;
+    }
+
+    // the heads of the dynamic elements are the offsets of the contents from the first head
+    template <class T>
+    static byte* encodeElements(byte* _out, const T* _begin, std::size_t _count)
+    {
+        byte* head = _out;
+        byte* content = ABIDynamicType<T>::value ? _out + _count * MAX_BYTE_LENGTH : _out;
+        for (std::size_t i = 0; i < _count; ++i)
+        {
+            if (ABIDynamicType<T>::value)
+            {
+                head = encode(head, u256(static_cast<std::size_t>(content - _out)));
+            }
+            content = encode(content, _begin[i]);
+        }
+        return content;
+    }
+
+    static std::size_t dynamicSize() { return 0; }
 
     template <class T, class... U>
-    void abiInAux(T const& _t, U const&... _u)
+    static std::size_t dynamicSize(T const& _t, U const&... _u)
     {
-        bytes out = serialise(_t);
+        return (ABIDynamicType<T>::value ? encodedSize(_t) : 0) + dynamicSize(_u...);
+    }
+
+    static void abiInAux(byte*, byte*, byte*) { return; }
 
+    template <class T, class... U>
+    static void abiInAux(byte* _start, byte* _head, byte* _content, T const& _t, U const&... _u)
+    {
         if (ABIDynamicType<T>::value)
         {  // dynamic type
-            dynamic += out;
-            fixed += serialise((u256)offset);
-            offset += out.size();
+            encode(_head, u256(static_cast<std::size_t>(_content - _start)));
+            abiInAux(_start, _head + MAX_BYTE_LENGTH, encode(_content, _t), _u...);
         }
         else
         {  // static type
-            fixed += out;
+            abiInAux(_start, encode(_head, _t), _content, _u...);
         }
-
-        abiInAux(_u...);
     }
 
     void abiOutAux() { return; }
@@ -347,6 +465,7 @@ private:
     }
 
 public:
+    // the strings may be decoded into bytesConstRef views of _data instead of copies
     template <class... T>
     bool abiOut(bytesConstRef _data, T&... _t)
     {
@@ -373,17 +492,22 @@ public:
     bool abiOutByFuncSelector(bytesConstRef _data, const std::vector<std::string>& _allTypes,
         std::vector<std::string>& _out);
 
+    // the heads of the tuple have a layout fixed at compile time, the result is encoded into a
+    // single buffer sized before encoding
     template <class... T>
     bytes abiIn(const std::string& _sig, T const&... _t)
     {
-        offset = Offset<T...>::value * MAX_BYTE_LENGTH;
-        fixed.clear();
-        dynamic.clear();
-
-        abiInAux(_t...);
-
-        return _sig.empty() ? fixed + dynamic :
-                              sha3(_sig).ref().cropped(0, 4).toBytes() + fixed + dynamic;
+        std::size_t selectorSize = _sig.empty() ? 0 : 4;
+        std::size_t headSize = Offset<T...>::value * MAX_BYTE_LENGTH;
+        bytes out(selectorSize + headSize + dynamicSize(_t...));
+        if (!_sig.empty())
+        {
+            h256 selector = sha3(_sig);
+            memcpy(out.data(), selector.data(), selectorSize);
+        }
+        byte* start = out.data() + selectorSize;
+        abiInAux(start, start, start + headSize, _t...);
+        return out;
     }
 
     template <class... T>
@@ -393,53 +517,6 @@ public:
     }
 };
 
-// a fixed-length array of elements of the given type.
-template <class T, std::size_t N>
-bytes ContractABI::serialise(const std::array<T, N>& _in)
-{
-    bytes offset_bytes;
-    bytes content;
-
-    auto length = N * MAX_BYTE_LENGTH;
-
-    for (const auto& e : _in)
-    {
-        bytes out = serialise(e);
-        content += out;
-        if (ABIDynamicType<T>::value)
-        {  // dynamic
-            offset_bytes += serialise(static_cast<u256>(length));
-            length += out.size();
-        }
-    }
-
-    return offset_bytes + content;
-}
-
-// a variable-length array of elements of the given type.
-template <class T>
-bytes ContractABI::serialise(const std::vector<T>& _in)
-{
-    bytes offset_bytes;
-    bytes content;
-
-    auto length = _in.size() * MAX_BYTE_LENGTH;
-
-    offset_bytes += serialise(static_cast<u256>(_in.size()));
-    for (const auto& t : _in)
-    {
-        bytes out = serialise(t);
-        content += out;
-        if (ABIDynamicType<T>::value)
-        {  // dynamic
-            offset_bytes += serialise(static_cast<u256>(length));
-            length += out.size();
-        }
-    }
-
-    return offset_bytes + content;
-}
-
 template <class T, std::size_t N>
 void ContractABI::deserialise(std::array<T, N>& _out, std::size_t _offset)
 {
@@ -22,6 +22,8 @@
  * @date 2018-09-20
  */
 #include "Block.h"
+#include "MerkleTree.h"
+#include "ReceiptsParallelParser.h"
 #include "TxsParallelParser.h"
 #include <libdevcore/Guards.h>
 #include <libdevcore/RLP.h>
@@ -47,13 +49,17 @@ Block::Block(
 Block::Block(Block const& _block)
   : m_blockHeader(_block.blockHeader()),
     m_transactions(_block.transactions()),
-    m_transactionReceipts(_block.transactionReceipts()),
     m_sigList(_block.sigList()),
     m_txsCache(_block.m_txsCache),
     m_tReceiptsCache(_block.m_tReceiptsCache),
     m_transRootCache(_block.m_transRootCache),
     m_receiptRootCache(_block.m_receiptRootCache)
-{}
+{
+    /// the encoded receipts are shared, each copy decodes them on its own access
+    Guard l(_block.x_receiptsData);
+    m_transactionReceipts = _block.m_transactionReceipts;
+    m_receiptsData = _block.m_receiptsData;
+}
 
 Block& Block::operator=(Block const& _block)
 {
@@ -61,7 +67,19 @@ Block& Block::operator=(Block const& _block)
     /// init transactions
     m_transactions = _block.transactions();
     /// init transactionReceipts
-    m_transactionReceipts = _block.transactionReceipts();
+    if (this != &_block)
+    {
+        TransactionReceipts receipts;
+        std::shared_ptr<bytes const> receiptsData;
+        {
+            Guard l(_block.x_receiptsData);
+            receipts = _block.m_transactionReceipts;
+            receiptsData = _block.m_receiptsData;
+        }
+        Guard l(x_receiptsData);
+        m_transactionReceipts = std::move(receipts);
+        m_receiptsData = receiptsData;
+    }
     /// init sigList
     m_sigList = _block.sigList();
     m_txsCache = _block.m_txsCache;
@@ -126,8 +144,15 @@ void Block::encodeRC2(bytes& _out) const
     block_stream.append(m_blockHeader.hash());
     // append sig_list
     block_stream.appendVector(m_sigList);
-    // append transactionReceipts list
-    block_stream.appendRaw(m_tReceiptsCache);
+    // append transactionReceipts list, encoded by ReceiptsParallelParser since V2_1_0
+    if (g_BCOSConfig.version() >= V2_1_0)
+    {
+        block_stream.append(ref(m_tReceiptsCache));
+    }
+    else
+    {
+        block_stream.appendRaw(m_tReceiptsCache);
+    }
     block_stream.swapOut(_out);
 }
 
@@ -171,7 +196,14 @@ void Block::calTransactionRootRC2(bool update) const
     if (m_txsCache == bytes())
     {
         m_txsCache = TxsParallelParser::encode(m_transactions);
-        m_transRootCache = sha3(m_txsCache);
+        if (g_BCOSConfig.version() >= V2_1_0)
+        {
+            m_transRootCache = MerkleTree(transactionHashes()).root();
+        }
+        else
+        {
+            m_transRootCache = sha3(m_txsCache);
+        }
     }
     if (update == true)
     {
@@ -187,6 +219,7 @@ void Block::calReceiptRoot(bool update) const
         calReceiptRootRC2(update);
         return;
     }
+    decodeReceipts();
     WriteGuard l(x_txReceiptsCache);
     if (m_tReceiptsCache == bytes())
     {
@@ -213,36 +246,53 @@ void Block::calReceiptRoot(bool update) const
 
 void Block::calReceiptRootRC2(bool update) const
 {
+    decodeReceipts();
     WriteGuard l(x_txReceiptsCache);
     if (m_tReceiptsCache == bytes())
     {
         size_t receiptsNum = m_transactionReceipts.size();
 
+        bool merkleRoot = g_BCOSConfig.version() >= V2_1_0;
         std::vector<dev::bytes> receiptsRLPs(receiptsNum, bytes());
+        std::vector<h256> receiptHashes(merkleRoot ? receiptsNum : 0);
         tbb::parallel_for(
             tbb::blocked_range<size_t>(0, receiptsNum), [&](const tbb::blocked_range<size_t>& _r) {
                 for (size_t i = _r.begin(); i != _r.end(); ++i)
                 {
-                    RLPStream s;
-                    s << i;
-                    dev::bytes receiptRLP;
-                    m_transactionReceipts[i].encode(receiptRLP);
-                    receiptsRLPs[i] = receiptRLP;
+                    m_transactionReceipts[i].encode(receiptsRLPs[i]);
+                    if (merkleRoot)
+                    {
+                        receiptHashes[i] = dev::sha3(receiptsRLPs[i]);
+                    }
                 }
             });
 
         // auto record_time = utcTime();
-        RLPStream txReceipts;
-        txReceipts.appendList(receiptsNum);
-        for (size_t i = 0; i < receiptsNum; ++i)
+        if (merkleRoot)
         {
-            txReceipts.appendRaw(receiptsRLPs[i]);
+            m_tReceiptsCache = ReceiptsParallelParser::encode(receiptsRLPs);
+        }
+        else
+        {
+            RLPStream txReceipts;
+            txReceipts.appendList(receiptsNum);
+            for (size_t i = 0; i < receiptsNum; ++i)
+            {
+                txReceipts.appendRaw(receiptsRLPs[i]);
+            }
+            txReceipts.swapOut(m_tReceiptsCache);
         }
-        txReceipts.swapOut(m_tReceiptsCache);
         // auto appenRLP_time_cost = utcTime() - record_time;
         // record_time = utcTime();
 
-        m_receiptRootCache = dev::sha3(ref(m_tReceiptsCache));
+        if (merkleRoot)
+        {
+            m_receiptRootCache = MerkleTree(std::move(receiptHashes)).root();
+        }
+        else
+        {
+            m_receiptRootCache = dev::sha3(ref(m_tReceiptsCache));
+        }
         // auto hashReceipts_time_cost = utcTime() - record_time;
         /*
         LOG(DEBUG) << LOG_BADGE("Receipt") << LOG_DESC("Calculate receipt root cost")
@@ -257,6 +307,33 @@ void Block::calReceiptRootRC2(bool update) const
     }
 }
 
+std::vector<h256> Block::transactionHashes() const
+{
+    std::vector<h256> hashes(m_transactions.size());
+    tbb::parallel_for(tbb::blocked_range<size_t>(0, m_transactions.size()),
+        [&](const tbb::blocked_range<size_t>& _r) {
+            for (size_t i = _r.begin(); i != _r.end(); ++i)
+            {
+                hashes[i] = m_transactions[i].sha3();
+            }
+        });
+    return hashes;
+}
+
+std::vector<h256> Block::receiptHashes() const
+{
+    decodeReceipts();
+    std::vector<h256> hashes(m_transactionReceipts.size());
+    tbb::parallel_for(tbb::blocked_range<size_t>(0, m_transactionReceipts.size()),
+        [&](const tbb::blocked_range<size_t>& _r) {
+            for (size_t i = _r.begin(); i != _r.end(); ++i)
+            {
+                hashes[i] = dev::sha3(m_transactionReceipts[i].rlp());
+            }
+        });
+    return hashes;
+}
+
 /**
  * @brief : decode specified data of block into Block class
  * @param _block : the specified data of block
@@ -331,7 +408,17 @@ void Block::decodeRC2(
     m_sigList = block_rlp[3].toVector<std::pair<u256, Signature>>();
 
     /// get transactionReceipt list
-    if (_withReceipt)
+    discardReceiptsData();
+    if (_withReceipt && g_BCOSConfig.version() >= V2_1_0)
+    {
+        /// the offsets are checked here, the receipts are decoded when accessed
+        auto receiptsData = std::make_shared<bytes const>(block_rlp[4].toBytes());
+        ReceiptsParallelParser::split(ref(*receiptsData));
+        m_transactionReceipts.clear();
+        Guard l(x_receiptsData);
+        m_receiptsData = receiptsData;
+    }
+    else if (_withReceipt)
     {
         RLP transactionReceipts_rlp = block_rlp[4];
         m_transactionReceipts.resize(transactionReceipts_rlp.itemCount());
@@ -342,5 +429,38 @@ void Block::decodeRC2(
     }
 }
 
+void Block::decodeReceipts() const
+{
+    Guard l(x_receiptsData);
+    if (!m_receiptsData)
+    {
+        return;
+    }
+    ReceiptsParallelParser::decode(m_transactionReceipts, ref(*m_receiptsData));
+    m_receiptsData.reset();
+}
+
+TransactionReceipt Block::transactionReceipt(size_t _index) const
+{
+    {
+        Guard l(x_receiptsData);
+        if (m_receiptsData)
+        {
+            return ReceiptsParallelParser::decode(ref(*m_receiptsData), _index);
+        }
+    }
+    return m_transactionReceipts.at(_index);
+}
+
+size_t Block::receiptsSize() const
+{
+    Guard l(x_receiptsData);
+    if (m_receiptsData)
+    {
+        return ReceiptsParallelParser::count(ref(*m_receiptsData));
+    }
+    return m_transactionReceipts.size();
+}
+
 }  // namespace eth
 }  // namespace dev
@@ -95,7 +95,15 @@ public:
 
     ///-----get interfaces
     Transactions const& transactions() const { return m_transactions; }
-    TransactionReceipts const& transactionReceipts() const { return m_transactionReceipts; }
+    /// the receipts decoded from the block data are materialized on the first access
+    TransactionReceipts const& transactionReceipts() const
+    {
+        decodeReceipts();
+        return m_transactionReceipts;
+    }
+    /// @returns the receipt of the index, the other receipts are left encoded
+    TransactionReceipt transactionReceipt(size_t _index) const;
+    size_t receiptsSize() const;
     Transaction const& transaction(size_t const _index) const { return m_transactions[_index]; }
     BlockHeader const& blockHeader() const { return m_blockHeader; }
     BlockHeader& header() { return m_blockHeader; }
@@ -122,6 +130,7 @@ public:
     /// set m_transactionReceipts
     void setTransactionReceipts(TransactionReceipts const& transReceipt)
     {
+        discardReceiptsData();
         m_transactionReceipts = transReceipt;
         noteReceiptChange();
     }
@@ -171,6 +180,7 @@ public:
         /// sealer must be reseted since it's used to decide a block is valid or not
         m_blockHeader.setSealer(Invalid256);
         m_transactions.clear();
+        discardReceiptsData();
         m_transactionReceipts.clear();
         m_sigList.clear();
         m_txsCache.clear();
@@ -191,24 +201,28 @@ public:
 
     void appendTransactionReceipt(TransactionReceipt const& _tran)
     {
+        decodeReceipts();
         m_transactionReceipts.push_back(_tran);
         noteReceiptChange();
     }
 
     void resizeTransactionReceipt(size_t _totalReceipt)
     {
+        decodeReceipts();
         m_transactionReceipts.resize(_totalReceipt);
         noteReceiptChange();
     }
 
     void setTransactionReceipt(size_t _receiptId, TransactionReceipt const& _tran)
     {
+        decodeReceipts();
         m_transactionReceipts[_receiptId] = _tran;
         noteReceiptChange();
     }
 
     void updateSequenceReceiptGas()
     {
+        decodeReceipts();
         u256 totalGas = 0;
         for (auto& receipt : m_transactionReceipts)
         {
@@ -219,6 +233,7 @@ public:
 
     void setStateRootToAllReceipt(h256 const& _stateRoot)
     {
+        decodeReceipts();
         for (auto& receipt : m_transactionReceipts)
             receipt.setStateRoot(_stateRoot);
         noteReceiptChange();
@@ -226,15 +241,20 @@ public:
 
     void clearAllReceipts()
     {
+        discardReceiptsData();
         m_transactionReceipts.clear();
         noteReceiptChange();
     }
 
-    const TransactionReceipts& getTransactionReceipts() const { return m_transactionReceipts; }
+    const TransactionReceipts& getTransactionReceipts() const { return transactionReceipts(); }
     void calTransactionRoot(bool update = true) const;
     void calTransactionRootRC2(bool update = true) const;
     void calReceiptRoot(bool update = true) const;
     void calReceiptRootRC2(bool update = true) const;
+    /// the hashes of the transactions, leaves of the transaction Merkle tree since V2_1_0
+    std::vector<h256> transactionHashes() const;
+    /// the hashes of the encoded receipts, leaves of the receipt Merkle tree since V2_1_0
+    std::vector<h256> receiptHashes() const;
 
     /**
      * @brief: set sender for specified transaction, if the sender hasn't been set, then recover
@@ -271,12 +291,20 @@ private:
         m_tReceiptsCache = bytes();
     }
 
+    /// decode the receipts kept encoded by decodeRC2 since V2_1_0
+    void decodeReceipts() const;
+    void discardReceiptsData()
+    {
+        Guard l(x_receiptsData);
+        m_receiptsData.reset();
+    }
+
 private:
     /// block header of the block (field 0)
     mutable BlockHeader m_blockHeader;
     /// transaction list (field 1)
     mutable Transactions m_transactions;
-    TransactionReceipts m_transactionReceipts;
+    mutable TransactionReceipts m_transactionReceipts;
     /// sig list (field 3)
     std::vector<std::pair<u256, Signature>> m_sigList;
     /// m_transactions converted bytes, when m_transactions changed,
@@ -290,6 +318,11 @@ private:
 
     mutable dev::h256 m_transRootCache;
     mutable dev::h256 m_receiptRootCache;
+
+    /// the receipts encoded by ReceiptsParallelParser, m_transactionReceipts is decoded from it
+    /// when a receipt is accessed, nullptr if the receipts are decoded
+    mutable std::shared_ptr<bytes const> m_receiptsData;
+    mutable Mutex x_receiptsData;
 };
 }  // namespace eth
 }  // namespace dev
@@ -0,0 +1,136 @@
+/*
+ * @CopyRight:
+ * FISCO-BCOS is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * FISCO-BCOS is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with FISCO-BCOS.  If not, see <http://www.gnu.org/licenses/>
+ * (c) 2016-2018 fisco-dev contributors.
+ */
+/**
+ * @brief the filter of the event logs of getLogs and the log subscriptions
+ *
+ * @file LogFilter.cpp
+ */
+#include "LogFilter.h"
+#include "Exceptions.h"
+#include <libdevcrypto/Hash.h>
+
+using namespace dev;
+using namespace dev::eth;
+
+const size_t LogFilter::c_maxTopics;
+
+namespace
+{
+LogBloom bloomOf(bytesConstRef _value)
+{
+    LogBloom bloom;
+    bloom.shiftBloom<3>(sha3(_value));
+    return bloom;
+}
+}  // namespace
+
+void LogFilter::addTopic(size_t _position, h256 const& _topic)
+{
+    if (_position >= c_maxTopics)
+    {
+        BOOST_THROW_EXCEPTION(
+            InvalidLogFilter() << errinfo_comment("the position of the topic is out of range"));
+    }
+    m_topics[_position].insert(_topic);
+}
+
+bool LogFilter::matches(LogEntry const& _log) const
+{
+    if (!m_addresses.empty() && !m_addresses.count(_log.address))
+    {
+        return false;
+    }
+    for (size_t i = 0; i < c_maxTopics; ++i)
+    {
+        if (m_topics[i].empty())
+        {
+            continue;
+        }
+        if (i >= _log.topics.size() || !m_topics[i].count(_log.topics[i]))
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+bool LogFilter::matches(LogBloom const& _bloom) const
+{
+    auto containsAny = [&](std::vector<bytesConstRef> const& _values) {
+        if (_values.empty())
+        {
+            return true;
+        }
+        for (auto const& value : _values)
+        {
+            if (_bloom.contains(bloomOf(value)))
+            {
+                return true;
+            }
+        }
+        return false;
+    };
+    std::vector<bytesConstRef> values;
+    for (auto const& address : m_addresses)
+    {
+        values.push_back(address.ref());
+    }
+    if (!containsAny(values))
+    {
+        return false;
+    }
+    for (auto const& topics : m_topics)
+    {
+        values.clear();
+        for (auto const& topic : topics)
+        {
+            values.push_back(topic.ref());
+        }
+        if (!containsAny(values))
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+LocalisedLogEntries LogFilter::matches(Block const& _block) const
+{
+    LocalisedLogEntries logs;
+    auto const& receipts = _block.transactionReceipts();
+    auto const& txs = _block.transactions();
+    unsigned logIndex = 0;
+    for (size_t i = 0; i < receipts.size(); ++i)
+    {
+        // the bloom of a receipt skips most of the receipts without a matched log
+        if (!matches(receipts[i].bloom()))
+        {
+            logIndex += receipts[i].log().size();
+            continue;
+        }
+        for (auto const& log : receipts[i].log())
+        {
+            if (matches(log))
+            {
+                logs.emplace_back(log, _block.headerHash(), _block.blockHeader().number(),
+                    i < txs.size() ? txs[i].sha3() : h256(), i, logIndex);
+            }
+            ++logIndex;
+        }
+    }
+    return logs;
+}
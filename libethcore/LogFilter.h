@@ -0,0 +1,74 @@
+/*
+ * @CopyRight:
+ * FISCO-BCOS is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * FISCO-BCOS is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with FISCO-BCOS.  If not, see <http://www.gnu.org/licenses/>
+ * (c) 2016-2018 fisco-dev contributors.
+ */
+/**
+ * @brief the filter of the event logs of getLogs and the log subscriptions
+ *
+ * @file LogFilter.h
+ */
+#pragma once
+#include "Block.h"
+#include "LogEntry.h"
+#include <set>
+
+namespace dev
+{
+namespace eth
+{
+/**
+ * A log matches the filter if it is emitted by one of the addresses and, for every position of
+ * the topics, its topic of the position is one of the topics of the position. An empty set of
+ * addresses or topics matches anything.
+ */
+class LogFilter
+{
+public:
+    /// the max topics of a log, LOG0 ~ LOG4
+    static const size_t c_maxTopics = 4;
+
+    LogFilter(BlockNumber _fromBlock = 0, BlockNumber _toBlock = 0)
+      : m_fromBlock(_fromBlock), m_toBlock(_toBlock), m_topics(c_maxTopics)
+    {}
+
+    BlockNumber fromBlock() const { return m_fromBlock; }
+    BlockNumber toBlock() const { return m_toBlock; }
+    void setRange(BlockNumber _fromBlock, BlockNumber _toBlock)
+    {
+        m_fromBlock = _fromBlock;
+        m_toBlock = _toBlock;
+    }
+
+    std::set<Address> const& addresses() const { return m_addresses; }
+    std::vector<std::set<h256>> const& topics() const { return m_topics; }
+    void addAddress(Address const& _address) { m_addresses.insert(_address); }
+    /// the topics of a position are or-ed, the positions are and-ed
+    void addTopic(size_t _position, h256 const& _topic);
+
+    bool matches(LogEntry const& _log) const;
+    /// @returns false if no log of the bloom matches the filter
+    bool matches(LogBloom const& _bloom) const;
+    /// @returns the matched logs of the block, the block number is not checked
+    LocalisedLogEntries matches(Block const& _block) const;
+
+private:
+    BlockNumber m_fromBlock;
+    BlockNumber m_toBlock;
+    std::set<Address> m_addresses;
+    std::vector<std::set<h256>> m_topics;
+};
+
+}  // namespace eth
+}  // namespace dev
@@ -0,0 +1,134 @@
+/*
+ * @CopyRight:
+ * FISCO-BCOS is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * FISCO-BCOS is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with FISCO-BCOS.  If not, see <http://www.gnu.org/licenses/>
+ * (c) 2016-2018 fisco-dev contributors.
+ */
+/**
+ * @brief binary Merkle tree of the transaction and receipt hashes of a block
+ *
+ * @file MerkleTree.cpp
+ */
+#include "MerkleTree.h"
+#include "Exceptions.h"
+#include <libdevcrypto/Hash.h>
+#include <tbb/parallel_for.h>
+#include <cstring>
+
+using namespace std;
+using namespace dev;
+using namespace dev::eth;
+
+namespace
+{
+/// inputs hashed by a task, smaller levels are hashed by the calling thread
+size_t const c_pairsPerTask = 256;
+/// the prefixes of RFC 6962
+byte const c_leafPrefix = 0;
+byte const c_nodePrefix = 1;
+
+/// _hashes[i] = hash(_prefix || _nodes[_width * i] ... _nodes[_width * i + _width - 1])
+void hashPrefixed(
+    byte _prefix, std::vector<h256> const& _nodes, size_t _width, std::vector<h256>& _hashes)
+{
+    size_t inputSize = 1 + _width * h256::size;
+    tbb::parallel_for(tbb::blocked_range<size_t>(0, _nodes.size() / _width, c_pairsPerTask),
+        [&](tbb::blocked_range<size_t> const& _r) {
+            // the nodes are contiguous, an input is the prefix and a slice of them
+            bytes buffer(_r.size() * inputSize);
+            std::vector<bytesConstRef> inputs;
+            inputs.reserve(_r.size());
+            for (size_t i = _r.begin(); i != _r.end(); ++i)
+            {
+                byte* input = buffer.data() + (i - _r.begin()) * inputSize;
+                input[0] = _prefix;
+                memcpy(input + 1, _nodes[_width * i].data(), _width * h256::size);
+                inputs.emplace_back(input, inputSize);
+            }
+            auto hashes = sha3Batch(inputs);
+            std::copy(hashes.begin(), hashes.end(), _hashes.begin() + _r.begin());
+        });
+}
+
+h256 hashLeaf(h256 const& _leaf)
+{
+    byte input[1 + h256::size] = {c_leafPrefix};
+    memcpy(input + 1, _leaf.data(), h256::size);
+    return sha3(bytesConstRef(input, sizeof(input)));
+}
+
+h256 hashPair(h256 const& _left, h256 const& _right)
+{
+    byte input[1 + 2 * h256::size] = {c_nodePrefix};
+    memcpy(input + 1, _left.data(), h256::size);
+    memcpy(input + 1 + h256::size, _right.data(), h256::size);
+    return sha3(bytesConstRef(input, sizeof(input)));
+}
+}  // namespace
+
+MerkleTree::MerkleTree(std::vector<h256> const& _leaves)
+{
+    std::vector<h256> leafHashes(_leaves.size());
+    hashPrefixed(c_leafPrefix, _leaves, 1, leafHashes);
+    m_levels.push_back(std::move(leafHashes));
+    while (m_levels.back().size() > 1)
+    {
+        auto const& level = m_levels.back();
+        std::vector<h256> parents(level.size() / 2 + level.size() % 2);
+        hashPrefixed(c_nodePrefix, level, 2, parents);
+        if (level.size() % 2)
+        {
+            parents.back() = level.back();
+        }
+        m_levels.push_back(std::move(parents));
+    }
+}
+
+h256 MerkleTree::root() const
+{
+    if (m_levels[0].empty())
+    {
+        return sha3(bytesConstRef());
+    }
+    return m_levels.back()[0];
+}
+
+MerkleProof MerkleTree::proof(size_t _index) const
+{
+    if (_index >= leafCount())
+    {
+        BOOST_THROW_EXCEPTION(
+            InvalidBlockFormat() << errinfo_comment("merkle proof of a leaf out of range"));
+    }
+    MerkleProof proof;
+    for (size_t level = 0; level + 1 < m_levels.size(); ++level, _index /= 2)
+    {
+        size_t sibling = _index ^ 1;
+        // the last node of an odd level has no sibling and is moved up
+        if (sibling < m_levels[level].size())
+        {
+            proof.push_back(MerkleProofNode{m_levels[level][sibling], sibling < _index});
+        }
+    }
+    return proof;
+}
+
+bool MerkleTree::verify(h256 const& _leaf, MerkleProof const& _proof, h256 const& _root)
+{
+    h256 node = hashLeaf(_leaf);
+    for (auto const& step : _proof)
+    {
+        node = step.siblingIsLeft ? hashPair(step.sibling, node) : hashPair(node, step.sibling);
+    }
+    return node == _root;
+}
@@ -0,0 +1,62 @@
+/*
+ * @CopyRight:
+ * FISCO-BCOS is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * FISCO-BCOS is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with FISCO-BCOS.  If not, see <http://www.gnu.org/licenses/>
+ * (c) 2016-2018 fisco-dev contributors.
+ */
+/**
+ * @brief binary Merkle tree of the transaction and receipt hashes of a block
+ *
+ * @file MerkleTree.h
+ */
+#pragma once
+#include <libdevcore/FixedHash.h>
+#include <vector>
+
+namespace dev
+{
+namespace eth
+{
+/// the sibling of a node on the path from a leaf to the root
+struct MerkleProofNode
+{
+    h256 sibling;
+    /// the parent is hash(sibling || node) if true, hash(node || sibling) otherwise
+    bool siblingIsLeft;
+};
+using MerkleProof = std::vector<MerkleProofNode>;
+
+/**
+ * The nodes are domain separated as in RFC 6962: a leaf is hashed as hash(0x00 || leaf) and the
+ * parent of two nodes is hash(0x01 || left || right), so a leaf can't be passed off as a node.
+ * The last node of a level with an odd number of nodes is moved up unchanged. The root of no leaf
+ * is the hash of empty bytes. The nodes of a level are hashed in parallel with the batch hash API.
+ */
+class MerkleTree
+{
+public:
+    explicit MerkleTree(std::vector<h256> const& _leaves);
+
+    h256 root() const;
+    size_t leafCount() const { return m_levels[0].size(); }
+    /// @returns the siblings from the leaf to the root
+    MerkleProof proof(size_t _index) const;
+
+    static bool verify(h256 const& _leaf, MerkleProof const& _proof, h256 const& _root);
+
+private:
+    /// the hashes of the leaves first, the root last
+    std::vector<std::vector<h256>> m_levels;
+};
+}  // namespace eth
+}  // namespace dev
@@ -40,6 +40,8 @@ enum ProtocolID
 {
     AMOP = 1,
     Topic = 2,
+    /// the frames of a large message of another protocol, from 2.1.0
+    Stream = 3,
     PBFT = 8,
     BlockSync = 9,
     TxPool = 10,
@@ -0,0 +1,121 @@
+/*
+ * @CopyRight:
+ * FISCO-BCOS is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * FISCO-BCOS is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with FISCO-BCOS.  If not, see <http://www.gnu.org/licenses/>
+ * (c) 2016-2018 fisco-dev contributors.
+ */
+/**
+ * @brief encode and decode the receipts of a block parallel
+ *
+ * @file ReceiptsParallelParser.cpp
+ */
+
+#include "ReceiptsParallelParser.h"
+#include "Exceptions.h"
+#include "TxsParallelParser.h"
+#include <tbb/parallel_for.h>
+
+using namespace dev;
+using namespace dev::eth;
+
+namespace
+{
+inline void throwInvalidReceipts(const std::string& _reason)
+{
+    BOOST_THROW_EXCEPTION(
+        InvalidBlockFormat() << errinfo_comment("Block receipts bytes is invalid: " + _reason));
+}
+}  // namespace
+
+bytes ReceiptsParallelParser::encode(std::vector<bytes> const& _receiptRLPs)
+{
+    return TxsParallelParser::encode(_receiptRLPs);
+}
+
+std::vector<bytesConstRef> ReceiptsParallelParser::split(bytesConstRef _bytes)
+{
+    std::vector<bytesConstRef> receipts;
+    if (_bytes.size() == 0)
+    {
+        return receipts;
+    }
+    if (_bytes.size() < sizeof(Offset_t))
+    {
+        throwInvalidReceipts("no receipt number");
+    }
+    Offset_t receiptNum = fromBytes(_bytes.cropped(0));
+    size_t objectStart = sizeof(Offset_t) * (size_t(receiptNum) + 2);
+    if (objectStart > _bytes.size())
+    {
+        throwInvalidReceipts("objectStart > bytesSize");
+    }
+    bytesConstRef objects = _bytes.cropped(objectStart);
+    receipts.reserve(receiptNum);
+    Offset_t offset = fromBytes(_bytes.cropped(sizeof(Offset_t)));
+    if (offset != 0)
+    {
+        throwInvalidReceipts("offset start != 0");
+    }
+    for (size_t i = 0; i < receiptNum; ++i)
+    {
+        Offset_t next = fromBytes(_bytes.cropped(sizeof(Offset_t) * (i + 2)));
+        if (next < offset || next > objects.size())
+        {
+            throwInvalidReceipts("offset out of range");
+        }
+        receipts.push_back(objects.cropped(offset, next - offset));
+        offset = next;
+    }
+    if (offset != objects.size())
+    {
+        throwInvalidReceipts("offset end != bytesSize");
+    }
+    return receipts;
+}
+
+void ReceiptsParallelParser::decode(TransactionReceipts& _receipts, bytesConstRef _bytes)
+{
+    auto receiptRLPs = split(_bytes);
+    _receipts.resize(receiptRLPs.size());
+    tbb::parallel_for(tbb::blocked_range<size_t>(0, receiptRLPs.size()),
+        [&](const tbb::blocked_range<size_t>& _r) {
+            for (size_t i = _r.begin(); i != _r.end(); ++i)
+            {
+                _receipts[i].decode(receiptRLPs[i]);
+            }
+        });
+}
+
+TransactionReceipt ReceiptsParallelParser::decode(bytesConstRef _bytes, size_t _index)
+{
+    if (_index >= count(_bytes))
+    {
+        throwInvalidReceipts("receipt index out of range");
+    }
+    // the offsets of the receipt and the next one, without walking the others
+    size_t objectStart = sizeof(Offset_t) * (count(_bytes) + 2);
+    Offset_t offset = fromBytes(_bytes.cropped(sizeof(Offset_t) * (_index + 1)));
+    Offset_t next = fromBytes(_bytes.cropped(sizeof(Offset_t) * (_index + 2)));
+    TransactionReceipt receipt;
+    receipt.decode(_bytes.cropped(objectStart + offset, next - offset));
+    return receipt;
+}
+
+size_t ReceiptsParallelParser::count(bytesConstRef _bytes)
+{
+    if (_bytes.size() < sizeof(Offset_t))
+    {
+        return 0;
+    }
+    return fromBytes(_bytes.cropped(0));
+}
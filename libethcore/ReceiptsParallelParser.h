@@ -0,0 +1,55 @@
+/*
+ * @CopyRight:
+ * FISCO-BCOS is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * FISCO-BCOS is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with FISCO-BCOS.  If not, see <http://www.gnu.org/licenses/>
+ * (c) 2016-2018 fisco-dev contributors.
+ */
+/**
+ * @brief encode and decode the receipts of a block parallel
+ *
+ * @file ReceiptsParallelParser.h
+ */
+#pragma once
+#include "Common.h"
+#include "TransactionReceipt.h"
+#include <libdevcore/RLP.h>
+
+namespace dev
+{
+namespace eth
+{
+class ReceiptsParallelParser
+{
+    /*
+        The receipts of a block since V2_1_0, the same protocol as TxsParallelParser
+        [receiptNum] [[0], [offset1], [offset2] ...] [[receipt0], [receipt1], [receipt2] ...]
+        The offsets locate a receipt without decoding the others.
+    */
+    using Offset_t = uint32_t;
+
+public:
+    static bytes encode(std::vector<bytes> const& _receiptRLPs);
+    /// @returns the RLP of the receipts, throws InvalidBlockFormat if the offsets are invalid
+    static std::vector<bytesConstRef> split(bytesConstRef _bytes);
+    /// decode all the receipts in parallel
+    static void decode(TransactionReceipts& _receipts, bytesConstRef _bytes);
+    /// decode the receipt of the index only, the bytes must have been checked by split
+    static TransactionReceipt decode(bytesConstRef _bytes, size_t _index);
+    static size_t count(bytesConstRef _bytes);
+
+private:
+    static inline Offset_t fromBytes(bytesConstRef _bs) { return Offset_t(*(Offset_t*)_bs.data()); }
+};
+
+}  // namespace eth
+}  // namespace dev
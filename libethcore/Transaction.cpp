@@ -39,13 +39,16 @@ Transaction::Transaction(bytesConstRef _rlpData, CheckTransaction _checkSig)
 
 void Transaction::decode(bytesConstRef tx_bytes, CheckTransaction _checkSig)
 {
-    m_rlpBuffer.assign(tx_bytes.data(), tx_bytes.data() + tx_bytes.size());
     RLP const rlp(tx_bytes);
     decode(rlp, _checkSig);
 }
 
 void Transaction::decode(RLP const& rlp, CheckTransaction _checkSig)
 {
+    // copied once, the copies of the tx share the buffer
+    std::atomic_store(&m_rlpBuffer, std::make_shared<bytes const>(rlp.data().toBytes()));
+    m_hashWith = h256(0);
+    m_sender = Address();
     if (g_BCOSConfig.version() >= RC2_VERSION)
     {
         decodeRC2(rlp, _checkSig);
@@ -187,6 +190,15 @@ SignatureStruct const& Transaction::signature() const
 /// encode the transaction to bytes
 void Transaction::encode(bytes& _trans, IncludeSignature _sig) const
 {
+    if (_sig == WithSignature)
+    {
+        auto buffer = std::atomic_load(&m_rlpBuffer);
+        if (buffer)
+        {
+            _trans = *buffer;
+            return;
+        }
+    }
     if (g_BCOSConfig.version() >= RC2_VERSION)
     {
         encodeRC2(_trans, _sig);
@@ -273,13 +285,28 @@ h256 Transaction::sha3(IncludeSignature _sig) const
     if (_sig == WithSignature && m_hashWith)
         return m_hashWith;
 
+    if (_sig == WithSignature)
+    {
+        m_hashWith = dev::sha3(ref(*rlpBuffer()));
+        return m_hashWith;
+    }
+
     bytes s;
     encode(s, _sig);
+    return dev::sha3(s);
+}
 
-    auto ret = dev::sha3(s);
-    if (_sig == WithSignature)
-        m_hashWith = ret;
-    return ret;
+std::shared_ptr<bytes const> Transaction::rlpBuffer() const
+{
+    auto buffer = std::atomic_load(&m_rlpBuffer);
+    if (!buffer)
+    {
+        bytes out;
+        encode(out, WithSignature);
+        buffer = std::make_shared<bytes const>(std::move(out));
+        std::atomic_store(&m_rlpBuffer, buffer);
+    }
+    return buffer;
 }
 
 void Transaction::updateTransactionHashWithSig(dev::h256 const& txHash)
@@ -24,6 +24,7 @@
 #include <libdevcrypto/Hash.h>
 #include <libethcore/Common.h>
 #include <boost/optional.hpp>
+#include <memory>
 
 
 namespace dev
@@ -76,7 +77,6 @@ public:
         m_gas(_gas),
         m_data(_data),
         m_rpcCallback(nullptr),
-        m_rlpBuffer(bytes()),
         m_chainId(_chainId),
         m_groupId(_groupId)
     {}
@@ -91,7 +91,6 @@ public:
         m_gas(_gas),
         m_data(_data),
         m_rpcCallback(nullptr),
-        m_rlpBuffer(bytes()),
         m_chainId(_chainId),
         m_groupId(_groupId)
     {}
@@ -144,14 +143,17 @@ public:
     /// @returns the RLP serialisation of this transaction.
     bytes rlp(IncludeSignature _sig = WithSignature) const
     {
-        if (m_rlpBuffer != bytes())
+        if (_sig == WithSignature)
         {
-            return m_rlpBuffer;
+            return *rlpBuffer();
         }
         bytes out;
         encode(out, _sig);
         return out;
     }
+    /// @returns the RLP serialisation with signature, encoded at most once and shared by the
+    /// copies of this transaction until it is modified
+    std::shared_ptr<bytes const> rlpBuffer() const;
 
     /// @returns the SHA3 hash of the RLP serialisation of this transaction.
     h256 sha3(IncludeSignature _sig = WithSignature) const;
@@ -190,7 +192,7 @@ public:
         clearSignature();
         m_nonce = _n;
         m_hashWith = h256(0);
-        m_rlpBuffer = bytes();
+        m_rlpBuffer.reset();
     }
 
     void setBlockLimit(u256 const& _blockLimit)
@@ -198,7 +200,7 @@ public:
         clearSignature();
         m_blockLimit = _blockLimit;
         m_hashWith = h256(0);
-        m_rlpBuffer = bytes();
+        m_rlpBuffer.reset();
     }
 
     /// @returns the latest block number to be packaged for transaction.
@@ -225,7 +227,7 @@ public:
         m_vrs = sig;
         m_hashWith = h256(0);
         m_sender = Address();
-        m_rlpBuffer = bytes();
+        m_rlpBuffer.reset();
     }
     /// @returns amount of gas required for the basic payment.
     int64_t baseGasRequired(EVMSchedule const& _es) const
@@ -294,8 +296,10 @@ protected:
 
     RPCCallback m_rpcCallback;
 
-    bytes m_rlpBuffer;  /// < The buffer to cache origin RLP sequence. It will be reused when the tx
-                        /// < needs to be encocoded again;
+    /// < The origin RLP sequence, or the first encoding of the tx with signature. It is immutable
+    /// < and reused by the hash, the block encoding and the broadcast, the copies of the tx share
+    /// < it. Accessed with std::atomic_load/atomic_store since it is filled by const methods.
+    mutable std::shared_ptr<bytes const> m_rlpBuffer;
 
     u256 m_chainId;     /// < The scenario to which the transaction belongs.
     u256 m_groupId;     /// < The group to which the transaction belongs.
@@ -24,6 +24,7 @@
 
 #include "TxsParallelParser.h"
 #include "Exceptions.h"
+#include <libdevcrypto/Hash.h>
 #include <tbb/parallel_for.h>
 
 namespace dev
@@ -36,70 +37,59 @@ bytes TxsParallelParser::encode(Transactions& _txs)
     if (txNum == 0)
         return bytes();
 
-    std::vector<Offset_t> offsets(txNum + 1, 0);
-    std::vector<bytes> txRLPs(txNum, bytes());
-
-    // encode tx and caculate offset
+    // the txs decoded from the network or the storage keep their origin RLP, the others are
+    // encoded here in parallel and keep the result
+    std::vector<std::shared_ptr<bytes const>> txRLPs(txNum);
     tbb::parallel_for(
         tbb::blocked_range<size_t>(0, txNum), [&](const tbb::blocked_range<size_t>& _r) {
             for (Offset_t i = _r.begin(); i < _r.end(); ++i)
             {
-                bytes txByte = _txs[i].rlp(WithSignature);
-
-                // record bytes size in offsets for caculating real offset
-                offsets[i + 1] = txByte.size();
-
-                // record bytes in txRLPs for caculating all transaction bytes
-                txRLPs[i] = txByte;
+                txRLPs[i] = _txs[i].rlpBuffer();
             }
         });
 
-    // caculate real offset
-    for (size_t i = 0; i < txNum; ++i)
-    {
-        offsets[i + 1] += offsets[i];
-    }
-
-    // encode according with this protocol
-    bytes ret;
-    ret += toBytes(Offset_t(txNum));
-    for (size_t i = 0; i < offsets.size(); ++i)
-        ret += toBytes(offsets[i]);
-
-    for (size_t i = 0; i < txNum; ++i)
-        ret += txRLPs[i];
-
-    // std::cout << "tx encode:" << toHex(ret) << std::endl;
-    return ret;
+    std::vector<bytesConstRef> txRefs;
+    txRefs.reserve(txNum);
+    for (auto const& txRLP : txRLPs)
+        txRefs.push_back(ref(*txRLP));
+    return encode(txRefs);
 }
 
 bytes TxsParallelParser::encode(std::vector<bytes> const& _txs)
+{
+    std::vector<bytesConstRef> txRefs;
+    txRefs.reserve(_txs.size());
+    for (auto const& tx : _txs)
+        txRefs.push_back(ref(tx));
+    return encode(txRefs);
+}
+
+bytes TxsParallelParser::encode(std::vector<bytesConstRef> const& _txs)
 {
     Offset_t txNum = _txs.size();
     if (txNum == 0)
         return bytes();
 
-    bytes txBytes;
     std::vector<Offset_t> offsets(txNum + 1, 0);
     Offset_t offset = 0;
 
-    // encode tx and caculate offset
+    // caculate offset
     for (Offset_t i = 0; i < txNum; ++i)
     {
-        bytes const& txByte = _txs[i];
         offsets[i] = offset;
-        offset += txByte.size();
-        txBytes += txByte;
+        offset += _txs[i].size();
     }
     offsets[txNum] = offset;  // write the end
 
-    // encode according with this protocol
+    // encode according with this protocol, the tx bytes are copied once into the result
     bytes ret;
+    ret.reserve(sizeof(Offset_t) * (txNum + 2) + offset);
     ret += toBytes(Offset_t(txNum));
     for (size_t i = 0; i < offsets.size(); ++i)
         ret += toBytes(offsets[i]);
 
-    ret += txBytes;
+    for (auto const& tx : _txs)
+        ret.insert(ret.end(), tx.begin(), tx.end());
 
     // std::cout << "tx encode:" << toHex(ret) << std::endl;
     return ret;
@@ -148,6 +138,7 @@ void TxsParallelParser::decode(
         {
             tbb::parallel_for(tbb::blocked_range<Offset_t>(0, txNum),
                 [&](const tbb::blocked_range<Offset_t>& _r) {
+                    std::vector<bytesConstRef> txsToHash;
                     for (Offset_t i = _r.begin(); i != _r.end(); ++i)
                     {
                         Offset_t offset = offsets[i];
@@ -159,8 +150,7 @@ void TxsParallelParser::decode(
                         _txs[i].decode(txBytes.cropped(offset, size), _checkSig);
                         if (_withHash)
                         {
-                            dev::h256 txHash = dev::sha3(txBytes.cropped(offset, size));
-                            _txs[i].updateTransactionHashWithSig(txHash);
+                            txsToHash.push_back(txBytes.cropped(offset, size));
                         } /*
                          LOG(DEBUG) << LOG_BADGE("DECODE") << LOG_DESC("decode tx:") << LOG_KV("i",
                          i)
@@ -168,6 +158,15 @@ void TxsParallelParser::decode(
                                     << LOG_KV("code", toHex(txBytes.cropped(offset, size)));
                                     */
                     }
+                    // hash the transactions of the range in the SIMD lanes
+                    if (_withHash)
+                    {
+                        auto txHashes = dev::sha3Batch(txsToHash);
+                        for (Offset_t i = _r.begin(); i != _r.end(); ++i)
+                        {
+                            _txs[i].updateTransactionHashWithSig(txHashes[i - _r.begin()]);
+                        }
+                    }
                 });
         }
         catch (...)
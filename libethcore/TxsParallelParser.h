@@ -45,6 +45,7 @@ class TxsParallelParser
 public:
     static bytes encode(Transactions& _txs);
     static bytes encode(std::vector<bytes> const& _txs);
+    static bytes encode(std::vector<bytesConstRef> const& _txs);
     static void decode(Transactions& _txs, bytesConstRef _bytes,
         CheckTransaction _checkSig = CheckTransaction::Everything, bool _withHash = false);
 
@@ -106,6 +106,16 @@ struct CallParameters
     OnOpFunc onOp;
 };
 
+/// the storage slots accessed by a transaction, recorded for the conflict prediction
+struct StorageAccesses
+{
+    typedef std::shared_ptr<StorageAccesses> Ptr;
+    std::vector<std::pair<Address, u256>> slots;
+    /// the transaction changed the state out of the storage of the contracts, by a precompiled
+    /// contract, a contract creation or a suicide
+    bool opaque = false;
+};
+
 /// the information related to the EVM
 class EnvInfo
 {
@@ -149,12 +159,16 @@ public:
     void setPrecompiledEngine(
         std::shared_ptr<dev::blockverifier::ExecutiveContext> executiveEngine);
 
+    /// the accesses of the transaction are recorded if set, the nested calls share the EnvInfo
+    StorageAccesses::Ptr storageAccesses() const { return m_storageAccesses; }
+    void setStorageAccesses(StorageAccesses::Ptr _accesses) { m_storageAccesses = _accesses; }
 
 private:
     BlockHeader m_headerInfo;
     CallBackFunction m_numberHash;
     u256 m_gasUsed;
     std::shared_ptr<dev::blockverifier::ExecutiveContext> m_executiveEngine;
+    StorageAccesses::Ptr m_storageAccesses;
 };
 
 /// Represents a call result.
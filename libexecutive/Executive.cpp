@@ -209,6 +209,10 @@ bool Executive::callRC2(CallParameters const& _p, u256 const& _gasPrice, Address
     else if (m_envInfo.precompiledEngine() &&
              m_envInfo.precompiledEngine()->isPrecompiled(_p.codeAddress))
     {
+        if (auto accesses = m_envInfo.storageAccesses())
+        {
+            accesses->opaque = true;
+        }
         try
         {
             auto result = m_envInfo.precompiledEngine()->call(_origin, _p.codeAddress, _p.data);
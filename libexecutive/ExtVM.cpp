@@ -220,12 +220,20 @@ void ExtVM::setStore(u256 const& _n, u256 const& _v)
     if (!m_s->checkAuthority(origin(), myAddress()))
         BOOST_THROW_EXCEPTION(PermissionDenied());
 
+    if (auto accesses = envInfo().storageAccesses())
+    {
+        accesses->slots.emplace_back(myAddress(), _n);
+    }
     m_s->setStorage(myAddress(), _n, _v);
 }
 
 evmc_result ExtVM::create(u256 const& _endowment, u256& io_gas, bytesConstRef _code,
     Instruction _op, u256 _salt, OnOpFunc const& _onOp)
 {
+    if (auto accesses = envInfo().storageAccesses())
+    {
+        accesses->opaque = true;
+    }
     Executive e{m_s, envInfo(), depth() + 1};
     bool result = false;
     if (_op == Instruction::CREATE)
@@ -257,6 +265,10 @@ void ExtVM::suicide(Address const& _a)
     // witnessing the current consensus
     // 'GeneralStateTests/stSystemOperationsTest/suicideSendEtherPostDeath.json'.
 
+    if (auto accesses = envInfo().storageAccesses())
+    {
+        accesses->opaque = true;
+    }
     if (g_BCOSConfig.version() >= RC2_VERSION)
     {
         // No balance here in BCOS. Balance has data racing in parallel suicide.
@@ -60,7 +60,14 @@ public:
     }
 
     /// Read storage location.
-    u256 store(u256 const& _n) final { return m_s->storage(myAddress(), _n); }
+    u256 store(u256 const& _n) final
+    {
+        if (auto accesses = envInfo().storageAccesses())
+        {
+            accesses->slots.emplace_back(myAddress(), _n);
+        }
+        return m_s->storage(myAddress(), _n);
+    }
 
     /// Write a value in storage.
     void setStore(u256 const& _n, u256 const& _v) final;
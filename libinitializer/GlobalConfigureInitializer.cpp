@@ -22,6 +22,7 @@
 
 
 #include "GlobalConfigureInitializer.h"
+#include <libdevcore/Tracer.h>
 #include <boost/algorithm/string.hpp>
 #include <boost/algorithm/string/classification.hpp>
 #include <boost/algorithm/string/split.hpp>
@@ -117,6 +118,10 @@ void dev::initializer::initGlobalConfig(const boost::property_tree::ptree& _pt)
     }
     g_BCOSConfig.setChainId(chainId);
 
+    /// block pipeline tracing, default disable
+    bool enableBlockTrace = _pt.get<bool>("log.enable_block_trace", false);
+    dev::trace::Tracer::instance().setEnabled(enableBlockTrace);
+
     if (g_BCOSConfig.diskEncryption.enable)
     {
         INITIALIZER_LOG(INFO) << LOG_BADGE("initKeyManager")
@@ -130,5 +135,6 @@ void dev::initializer::initGlobalConfig(const boost::property_tree::ptree& _pt)
                           << LOG_KV("enableCompress", g_BCOSConfig.compressEnabled())
                           << LOG_KV("compatibilityVersion", version)
                           << LOG_KV("versionNumber", g_BCOSConfig.version())
-                          << LOG_KV("chainId", g_BCOSConfig.chainId());
+                          << LOG_KV("chainId", g_BCOSConfig.chainId())
+                          << LOG_KV("enableBlockTrace", enableBlockTrace);
 }
@@ -69,6 +69,7 @@ void Initializer::init(std::string const& _path)
 
         m_rpcInitializer->setLedgerManager(m_ledgerInitializer->ledgerManager());
         m_rpcInitializer->initConfig(pt);
+        m_rpcInitializer->initMetricsServer(pt);
         m_ledgerInitializer->startAll();
     }
     catch (std::exception& e)
@@ -38,6 +38,18 @@ void LedgerInitializer::initConfig(boost::property_tree::ptree const& _pt)
     auto groupConfigPath = _pt.get<string>("group.group_config_path", "conf/");
     assert(m_p2pService);
     m_ledgerManager = make_shared<LedgerManager>();
+    // MB, shared by the caches of all groups; 0 means every group uses its storage.max_capacity
+    auto memoryBudget = _pt.get<int64_t>("group.memory_budget", 0);
+    if (memoryBudget < 0)
+    {
+        BOOST_THROW_EXCEPTION(
+            InvalidConfig() << errinfo_comment("Please set group.memory_budget to positive !"));
+    }
+    if (memoryBudget > 0)
+    {
+        m_memoryArbiter =
+            make_shared<dev::storage::MemoryArbiter>(memoryBudget * 1024 * 1024);  // Bytes
+    }
     map<GROUP_ID, h512s> groudID2NodeList;
     bool succ = true;
     try
@@ -116,6 +128,7 @@ bool LedgerInitializer::initLedger(
         std::make_shared<Ledger>(m_p2pService, _groupId, m_keyPair, _dataDir);
     INITIALIZER_LOG(INFO) << "[initSingleLedger] [GroupId]:  " << std::to_string(_groupId);
     ledger->setChannelRPCServer(m_channelRPCServer);
+    ledger->setMemoryArbiter(m_memoryArbiter);
     bool succ = ledger->initLedger(configFileName);
     if (!succ)
         return false;
@@ -58,10 +58,14 @@ public:
     {
         if (m_ledgerManager)
             m_ledgerManager->startAll();
+        if (m_memoryArbiter)
+            m_memoryArbiter->start();
     }
 
     void stopAll()
     {
+        if (m_memoryArbiter)
+            m_memoryArbiter->stop();
         if (m_ledgerManager)
             m_ledgerManager->stopAll();
     }
@@ -74,6 +78,7 @@ private:
     ChannelRPCServer::Ptr m_channelRPCServer;
     KeyPair m_keyPair;
     std::string m_groupDataDir;
+    dev::storage::MemoryArbiter::Ptr m_memoryArbiter;
 };
 
 }  // namespace initializer
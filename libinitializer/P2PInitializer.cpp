@@ -44,6 +44,13 @@ void P2PInitializer::initConfig(boost::property_tree::ptree const& _pt)
             InvalidPort() << errinfo_comment(
                 "P2PInitializer:  initConfig for P2PInitializer failed! Invalid ListenPort!"));
     }
+    /// every group handles its p2p requests in a pool of this size
+    int dispatchThreads = _pt.get<int>("p2p.dispatch_threads", 4);
+    if (dispatchThreads <= 0)
+    {
+        BOOST_THROW_EXCEPTION(InvalidConfig() << errinfo_comment(
+                                  "P2PInitializer: p2p.dispatch_threads must be positive"));
+    }
     std::string certBlacklistSection = "crl";
     if (_pt.get_child_optional("certificate_blacklist"))
     {
@@ -150,6 +157,7 @@ void P2PInitializer::initConfig(boost::property_tree::ptree const& _pt)
         m_p2pService->setStaticNodes(nodes);
         m_p2pService->setKeyPair(m_keyPair);
         m_p2pService->setP2PMessageFactory(messageFactory);
+        m_p2pService->setDispatchThreads(dispatchThreads);
         m_p2pService->start();
     }
     catch (std::exception& e)
@@ -141,6 +141,17 @@ void RPCInitializer::initConfig(boost::property_tree::ptree const& _pt)
             });
 
             m_channelRPCServer->addHandler(handler);
+
+            /// push the logs of the committed blocks to the event log subscriptions
+            auto blockHandler = blockChain->onBlockCommitted(
+                [groupID, channelRPCServer](dev::eth::Block const& _block) {
+                    auto c = channelRPCServer.lock();
+                    if (c)
+                    {
+                        c->pushEventLogs(groupID, _block);
+                    }
+                });
+            m_channelRPCServer->addBlockHandler(blockHandler);
         }
 
         /// init httpListenPort
@@ -178,3 +189,31 @@ void RPCInitializer::initConfig(boost::property_tree::ptree const& _pt)
         exit(1);
     }
 }
+
+void RPCInitializer::initMetricsServer(boost::property_tree::ptree const& _pt)
+{
+    int metricsListenPort = _pt.get<int>("rpc.metrics_listen_port", 0);
+    if (metricsListenPort == 0)
+    {
+        return;
+    }
+    if (!isValidPort(metricsListenPort))
+    {
+        ERROR_OUTPUT << LOG_BADGE("RPCInitializer")
+                     << LOG_DESC("initMetricsServer failed! Invalid metrics_listen_port!")
+                     << std::endl;
+        exit(1);
+    }
+    /// the metrics are not authenticated, only processes on this host can scrape them
+    m_metricsHttpServer = std::make_shared<dev::MetricsHttpServer>("127.0.0.1", metricsListenPort);
+    if (!m_metricsHttpServer->StartListening())
+    {
+        INITIALIZER_LOG(ERROR) << LOG_BADGE("RPCInitializer")
+                               << LOG_KV("check metrics_listen_port", metricsListenPort);
+        ERROR_OUTPUT << LOG_BADGE("RPCInitializer")
+                     << LOG_KV("check metrics_listen_port", metricsListenPort) << std::endl;
+        exit(1);
+    }
+    INITIALIZER_LOG(INFO) << LOG_BADGE("RPCInitializer") << LOG_DESC("MetricsHttpServer started.")
+                          << LOG_KV("port", metricsListenPort);
+}
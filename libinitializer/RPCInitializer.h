@@ -26,6 +26,7 @@
 #include <libchannelserver/ChannelRPCServer.h>
 #include <libledger/LedgerManager.h>
 #include <libp2p/P2PInterface.h>
+#include <librpc/MetricsHttpServer.h>
 #include <librpc/Rpc.h>
 #include <librpc/SafeHttpServer.h>
 
@@ -57,11 +58,17 @@ public:
             m_jsonrpcHttpServer = nullptr;
             INITIALIZER_LOG(INFO) << "JsonrpcHttpServer deleted.";
         }
+        if (m_metricsHttpServer)
+        {
+            m_metricsHttpServer->StopListening();
+        }
     }
 
     void initChannelRPCServer(boost::property_tree::ptree const& _pt);
 
     void initConfig(boost::property_tree::ptree const& _pt);
+    /// serve the metrics to Prometheus on localhost if rpc.metrics_listen_port is set
+    void initMetricsServer(boost::property_tree::ptree const& _pt);
     void setP2PService(std::shared_ptr<p2p::P2PInterface> _p2pService)
     {
         m_p2pService = _p2pService;
@@ -82,6 +89,7 @@ private:
     std::shared_ptr<ledger::LedgerManager> m_ledgerManager;
     std::shared_ptr<boost::asio::ssl::context> m_sslContext;
     std::shared_ptr<dev::SafeHttpServer> m_safeHttpServer;
+    dev::MetricsHttpServer::Ptr m_metricsHttpServer;
     ChannelRPCServer::Ptr m_channelRPCServer;
     ModularServer<>* m_channelRPCHttpServer;
     ModularServer<>* m_jsonrpcHttpServer;
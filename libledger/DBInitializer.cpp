@@ -25,6 +25,7 @@
 #include "LedgerParam.h"
 #include "rocksdb/db.h"
 #include "rocksdb/options.h"
+#include "rocksdb/table.h"
 #include <libconfig/GlobalConfigure.h>
 #include <libdevcore/Common.h>
 #include <libmptstate/MPTStateFactory.h>
@@ -184,6 +185,15 @@ void DBInitializer::initRocksDBStorage()
         options.create_if_missing = true;
         options.max_open_files = 1000;
         options.compression = rocksdb::kSnappyCompression;
+        if (m_memoryArbiter)
+        {
+            // share block cache and memtable memory with the other groups of the node
+            rocksdb::BlockBasedTableOptions tableOptions;
+            tableOptions.block_cache = m_memoryArbiter->blockCache();
+            tableOptions.cache_index_and_filter_blocks = true;
+            options.table_factory.reset(rocksdb::NewBlockBasedTableFactory(tableOptions));
+            options.write_buffer_manager = m_memoryArbiter->writeBufferManager();
+        }
         rocksdb::Status status;
 
         // Not to use disk encryption
@@ -200,6 +210,8 @@ void DBInitializer::initRocksDBStorage()
         rocksDB.reset(db);
 
         rocksdbStorage->setDB(rocksDB);
+        rocksdbStorage->setSnapshotStagingPath(
+            m_param->mutableStorageParam().path + ".snapshot");
         initTableFactory2(rocksdbStorage);
     }
     catch (std::exception& e)
@@ -29,6 +29,7 @@
 #include <libdevcore/OverlayDB.h>
 #include <libexecutive/StateFactoryInterface.h>
 #include <libstorage/MemoryTableFactory.h>
+#include <libstorage/MemoryArbiter.h>
 #include <libstorage/MemoryTableFactory2.h>
 #include <libstorage/Storage.h>
 #include <memory>
@@ -69,6 +70,12 @@ public:
         m_channelRPCServer = channelRPCServer;
     }
 
+    /// share the RocksDB caches of the node, must be set before initStorageDB
+    void setMemoryArbiter(dev::storage::MemoryArbiter::Ptr _memoryArbiter)
+    {
+        m_memoryArbiter = _memoryArbiter;
+    }
+
 protected:
     /// create stateStorage (mpt or storageState options)
     virtual void createStateFactory(dev::h256 const& genesisHash);
@@ -94,6 +101,7 @@ private:
     dev::storage::Storage::Ptr m_storage = nullptr;
     std::shared_ptr<dev::blockverifier::ExecutiveContextFactory> m_executiveContextFactory;
     std::shared_ptr<ChannelRPCServer> m_channelRPCServer;
+    dev::storage::MemoryArbiter::Ptr m_memoryArbiter;
 
     dev::storage::TableFactoryFactory::Ptr m_tableFactoryFactory;
 };
@@ -78,12 +78,23 @@ bool Ledger::initLedger(const std::string& _configFilePath)
     Ledger_LOG(INFO) << LOG_BADGE("initLedger") << LOG_BADGE("DBInitializer");
     m_dbInitializer = std::make_shared<dev::ledger::DBInitializer>(m_param);
     m_dbInitializer->setChannelRPCServer(m_channelRPCServer);
+    m_dbInitializer->setMemoryArbiter(m_memoryArbiter);
     // m_dbInitializer
     if (!m_dbInitializer)
         return false;
     m_dbInitializer->initStorageDB();
     /// set group ID for storage
     m_dbInitializer->storage()->setGroupID(m_groupId);
+    /// the cache capacity of the group is assigned by the node-wide arbiter
+    auto cacheConsumer =
+        std::dynamic_pointer_cast<dev::storage::CacheConsumer>(m_dbInitializer->storage());
+    if (m_memoryArbiter && cacheConsumer)
+    {
+        auto labels = dev::metrics::groupLabels(m_groupId);
+        labels["cache"] = "storage";
+        m_memoryArbiter->registerConsumer(
+            "storage-" + std::to_string(m_groupId), cacheConsumer, labels);
+    }
     /// init the DB
     bool ret = initBlockChain(genesisParam);
     if (!ret)
@@ -176,8 +187,15 @@ void Ledger::initTxExecuteConfig(ptree const& pt)
     {
         m_param->mutableTxParam().enableParallel = false;
     }
+    m_param->mutableTxParam().callThreads =
+        std::max(pt.get<uint32_t>("tx_execute.call_threads", 4), (uint32_t)1);
+    m_param->mutableTxParam().enableConflictPrediction =
+        pt.get<bool>("tx_execute.enable_conflict_prediction", false);
     Ledger_LOG(DEBUG) << LOG_BADGE("InitTxExecuteConfig")
-                      << LOG_KV("enableParallel", m_param->mutableTxParam().enableParallel);
+                      << LOG_KV("enableParallel", m_param->mutableTxParam().enableParallel)
+                      << LOG_KV("callThreads", m_param->mutableTxParam().callThreads)
+                      << LOG_KV("enableConflictPrediction",
+                             m_param->mutableTxParam().enableConflictPrediction);
 }
 
 void Ledger::initTxPoolConfig(ptree const& pt)
@@ -310,6 +328,7 @@ void Ledger::initConsensusConfig(ptree const& pt)
 
 /// init sync related configurations
 /// 1. idleWaitMs: default is 30ms
+/// 2. enableSnapshotSync: default is false
 void Ledger::initSyncConfig(ptree const& pt)
 {
     try
@@ -321,9 +340,13 @@ void Ledger::initSyncConfig(ptree const& pt)
             BOOST_THROW_EXCEPTION(ForbidNegativeValue()
                                   << errinfo_comment("Please set sync.idle_wait_ms to positive !"));
         }
+        m_param->mutableSyncParam().enableSnapshotSync =
+            pt.get<bool>("sync.enable_snapshot_sync", false);
 
         Ledger_LOG(DEBUG) << LOG_BADGE("initSyncConfig")
-                          << LOG_KV("idleWaitMs", m_param->mutableSyncParam().idleWaitMs);
+                          << LOG_KV("idleWaitMs", m_param->mutableSyncParam().idleWaitMs)
+                          << LOG_KV("enableSnapshotSync",
+                                 m_param->mutableSyncParam().enableSnapshotSync);
     }
     catch (std::exception& e)
     {
@@ -470,10 +493,18 @@ bool Ledger::initBlockVerifier()
     }
     std::shared_ptr<BlockVerifier> blockVerifier = std::make_shared<BlockVerifier>(enableParallel);
     /// set params for blockverifier
-    blockVerifier->setExecutiveContextFactory(m_dbInitializer->executiveContextFactory());
+    auto executiveContextFactory = m_dbInitializer->executiveContextFactory();
+    blockVerifier->setExecutiveContextFactory(executiveContextFactory);
+    /// the cached parallel configs are read from the state replaced by the reload
+    m_reloadHandler = m_blockChain->onReload([executiveContextFactory](int64_t) {
+        executiveContextFactory->clearParallelConfigCache();
+    });
     std::shared_ptr<BlockChainImp> blockChain =
         std::dynamic_pointer_cast<BlockChainImp>(m_blockChain);
     blockVerifier->setNumberHash(boost::bind(&BlockChainImp::numberHash, blockChain, _1));
+    blockVerifier->setGroupId(m_groupId);
+    blockVerifier->setCallThreads(m_param->mutableTxParam().callThreads);
+    blockVerifier->setEnableConflictPrediction(m_param->mutableTxParam().enableConflictPrediction);
     m_blockVerifier = blockVerifier;
     Ledger_LOG(DEBUG) << LOG_BADGE("initLedger") << LOG_BADGE("initBlockVerifier SUCC");
     return true;
@@ -491,6 +522,13 @@ bool Ledger::initBlockChain(GenesisBlockParam& _genesisParam)
     std::shared_ptr<BlockChainImp> blockChain = std::make_shared<BlockChainImp>();
     blockChain->setStateStorage(m_dbInitializer->storage());
     blockChain->setTableFactoryFactory(m_dbInitializer->tableFactoryFactory());
+    if (m_memoryArbiter)
+    {
+        auto labels = dev::metrics::groupLabels(m_groupId);
+        labels["cache"] = "block";
+        m_memoryArbiter->registerConsumer(
+            "blockCache-" + std::to_string(m_groupId), blockChain->blockCache(), labels);
+    }
     m_blockChain = blockChain;
     bool ret = m_blockChain->checkAndBuildGenesisBlock(_genesisParam);
     if (!ret)
@@ -618,8 +656,14 @@ bool Ledger::initSync()
     }
     dev::PROTOCOL_ID protocol_id = getGroupProtoclID(m_groupId, ProtocolID::BlockSync);
     dev::h256 genesisHash = m_blockChain->getBlockByNumber(int64_t(0))->headerHash();
-    m_sync = std::make_shared<SyncMaster>(m_service, m_txPool, m_blockChain, m_blockVerifier,
-        protocol_id, m_keyPair.pub(), genesisHash, m_param->mutableSyncParam().idleWaitMs);
+    auto syncMaster = std::make_shared<SyncMaster>(m_service, m_txPool, m_blockChain,
+        m_blockVerifier, protocol_id, m_keyPair.pub(), genesisHash,
+        m_param->mutableSyncParam().idleWaitMs);
+    // nullptr if the storage can't export snapshots
+    syncMaster->setSnapshotStorage(
+        std::dynamic_pointer_cast<dev::storage::StorageSnapshot>(m_dbInitializer->storage()),
+        m_param->mutableSyncParam().enableSnapshotSync);
+    m_sync = syncMaster;
     Ledger_LOG(DEBUG) << LOG_BADGE("initLedger") << LOG_DESC("initSync SUCC");
     return true;
 }
@@ -126,6 +126,11 @@ public:
         m_channelRPCServer = channelRPCServer;
     }
 
+    void setMemoryArbiter(dev::storage::MemoryArbiter::Ptr _memoryArbiter) override
+    {
+        m_memoryArbiter = _memoryArbiter;
+    }
+
 protected:
     /// load genesis config of group
     void initGenesisConfig(std::string const& configPath) override;
@@ -175,6 +180,8 @@ protected:
 
     std::shared_ptr<dev::ledger::DBInitializer> m_dbInitializer = nullptr;
     ChannelRPCServer::Ptr m_channelRPCServer;
+    dev::storage::MemoryArbiter::Ptr m_memoryArbiter;
+    dev::eth::Handler<int64_t> m_reloadHandler;
 };
 }  // namespace ledger
 }  // namespace dev
@@ -28,6 +28,7 @@
 #include <libchannelserver/ChannelRPCServer.h>
 #include <libconsensus/ConsensusInterface.h>
 #include <libethcore/Protocol.h>
+#include <libstorage/MemoryArbiter.h>
 #include <libsync/SyncInterface.h>
 #include <libtxpool/TxPoolInterface.h>
 #include <memory>
@@ -59,6 +60,11 @@ public:
     {
         (void)channelRPCServer;
     };
+    /// share the memory budget of the node between groups
+    virtual void setMemoryArbiter(dev::storage::MemoryArbiter::Ptr _memoryArbiter)
+    {
+        (void)_memoryArbiter;
+    }
 
 protected:
     dev::KeyPair m_keyPair;
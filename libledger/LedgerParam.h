@@ -67,6 +67,8 @@ struct SyncParam
 {
     /// TODO: syncParam related
     signed idleWaitMs = SYNC_IDLE_WAIT_DEFAULT;
+    /// download a storage snapshot instead of blocks when far behind
+    bool enableSnapshotSync = false;
 };
 
 /// modification 2019.03.20: add timeStamp field to GenesisParam
@@ -108,6 +110,10 @@ struct TxParam
 {
     int64_t txGasLimit;
     bool enableParallel = false;
+    /// threads executing the call requests
+    uint32_t callThreads = 4;
+    /// predict the conflicts of the contracts without parallel configs
+    bool enableConflictPrediction = false;
 };
 class LedgerParam : public LedgerParamInterface
 {
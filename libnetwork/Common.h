@@ -27,6 +27,7 @@
 
 #pragma once
 
+#include <array>
 #include <set>
 #include <string>
 #include <vector>
@@ -94,9 +95,36 @@ enum P2PExceptionType
     P2PExceptionTypeCnt,
     ConnectError,
     DuplicateSession,
+    WriteQueueFull,
     ALL,
 };
 
+/// the write queue of a session sends the packets of a lower value first
+enum PacketPriority
+{
+    ConsensusPriority = 0,
+    BlockSyncPriority,
+    TxGossipPriority,
+    AMOPPriority,
+    PriorityCount,
+    /// derived from the protocol of the packet by p2p::Service
+    DefaultPriority = PriorityCount
+};
+
+/// the packets queued to a peer and the packets dropped since the session started, by priority
+struct WriteQueueStats
+{
+    std::array<uint64_t, PriorityCount> packets = {{0, 0, 0, 0}};
+    std::array<uint64_t, PriorityCount> bytes = {{0, 0, 0, 0}};
+    std::array<uint64_t, PriorityCount> dropped = {{0, 0, 0, 0}};
+};
+
+inline std::string priorityName(PacketPriority _priority)
+{
+    static std::string const names[] = {"consensus", "blockSync", "txGossip", "AMOP"};
+    return _priority < PriorityCount ? names[_priority] : "default";
+}
+
 enum PacketDecodeStatus
 {
     PACKET_ERROR = -1,
@@ -110,6 +138,7 @@ struct Options
     uint32_t subTimeout = 0;  ///< The timeout value of every node, used in send message to topic,
                               ///< in milliseconds.
     uint32_t timeout = 0;     ///< The timeout value of async function, in milliseconds.
+    PacketPriority priority = DefaultPriority;
 };
 
 /// node info obtained from the certificate
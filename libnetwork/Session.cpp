@@ -31,12 +31,33 @@
 #include <libdevcore/CommonIO.h>
 #include <libdevcore/CommonJS.h>
 #include <libdevcore/Exceptions.h>
+#include <libdevcore/Metrics.h>
 #include <libdevcore/easylog.h>
+#include <algorithm>
 #include <chrono>
 
 using namespace dev;
 using namespace dev::network;
 
+namespace
+{
+/// the traffic of all sessions, the groups share the connections
+dev::metrics::Counter& s_sentMessages = dev::metrics::MetricsRegistry::instance().counter(
+    "p2p_sent_messages_total", "messages queued to the peers");
+dev::metrics::Counter& s_sentBytes = dev::metrics::MetricsRegistry::instance().counter(
+    "p2p_sent_bytes_total", "bytes queued to the peers");
+dev::metrics::Counter& s_receivedMessages = dev::metrics::MetricsRegistry::instance().counter(
+    "p2p_received_messages_total", "messages decoded from the peers");
+dev::metrics::Counter& s_receivedBytes = dev::metrics::MetricsRegistry::instance().counter(
+    "p2p_received_bytes_total", "bytes decoded from the peers");
+dev::metrics::Counter& s_droppedMessages = dev::metrics::MetricsRegistry::instance().counter(
+    "p2p_dropped_messages_total", "messages dropped for the write queue of the peer is full");
+
+/// the bytes queued to a peer per priority, the packets over the budget are dropped
+std::array<uint64_t, PriorityCount> const c_writeQueueBudgets = {
+    {128 * 1024 * 1024, 64 * 1024 * 1024, 16 * 1024 * 1024, 16 * 1024 * 1024}};
+}  // namespace
+
 Session::Session(size_t _bufferSize) : bufferSize(_bufferSize)
 {
     m_recvBuffer.resize(bufferSize);
@@ -75,6 +96,18 @@ bool Session::actived() const
     return m_actived && server && server->haveNetwork() && m_socket && m_socket->isConnected();
 }
 
+bool Session::congested(PacketPriority _priority) const
+{
+    Guard l(x_writeQueue);
+    return m_writeQueueStats.bytes[_priority] > c_writeQueueBudgets[_priority] / 2;
+}
+
+WriteQueueStats Session::writeQueueStats() const
+{
+    Guard l(x_writeQueue);
+    return m_writeQueueStats;
+}
+
 void Session::asyncSendMessage(Message::Ptr message, Options options, CallbackFunc callback)
 {
     auto server = m_server.lock();
@@ -111,27 +144,81 @@ void Session::asyncSendMessage(Message::Ptr message, Options options, CallbackFu
                        << LOG_KV("seq2Callback.size", m_seq2Callback->size());
     std::shared_ptr<bytes> p_buffer = std::make_shared<bytes>();
     message->encode(*p_buffer);
-    send(p_buffer);
+    // the packets not classified by the sender are sent last
+    PacketPriority priority =
+        options.priority < PriorityCount ? options.priority : AMOPPriority;
+    if (!send(std::vector<std::shared_ptr<bytes>>{p_buffer}, priority) && callback)
+    {
+        auto handler = getCallbackBySeq(message->seq());
+        removeSeqCallback(message->seq());
+        if (handler && handler->timeoutHandler)
+        {
+            handler->timeoutHandler->cancel();
+        }
+        server->threadPool()->enqueue([callback] {
+            callback(NetworkException(WriteQueueFull, "WriteQueueFull"), Message::Ptr());
+        });
+    }
 }
 
-void Session::send(std::shared_ptr<bytes> _msg)
+bool Session::asyncSendMessages(std::vector<Message::Ptr> const& _messages, Options _options)
 {
     if (!actived())
     {
-        return;
+        SESSION_LOG(WARNING) << "Session inactived";
+        return false;
+    }
+    std::vector<std::shared_ptr<bytes>> buffers;
+    buffers.reserve(_messages.size());
+    for (auto const& message : _messages)
+    {
+        buffers.push_back(std::make_shared<bytes>());
+        message->encode(*buffers.back());
+    }
+    PacketPriority priority =
+        _options.priority < PriorityCount ? _options.priority : AMOPPriority;
+    return send(buffers, priority);
+}
+
+bool Session::send(std::vector<std::shared_ptr<bytes>> const& _msgs, PacketPriority _priority)
+{
+    if (!actived())
+    {
+        return true;
     }
 
     if (!m_socket->isConnected())
-        return;
+        return true;
 
-    SESSION_LOG(TRACE) << "send" << LOG_KV("writeQueue size", m_writeQueue.size());
+    uint64_t size = 0;
+    for (auto const& msg : _msgs)
+    {
+        size += msg->size();
+    }
     {
         Guard l(x_writeQueue);
-
-        m_writeQueue.push(make_pair(_msg, u256(utcTime())));
+        if (m_writeQueueStats.bytes[_priority] + size > c_writeQueueBudgets[_priority])
+        {
+            m_writeQueueStats.dropped[_priority] += _msgs.size();
+            s_droppedMessages.inc(_msgs.size());
+            SESSION_LOG(WARNING) << LOG_DESC("write queue full, drop the packet")
+                                 << LOG_KV("priority", priorityName(_priority))
+                                 << LOG_KV("packets", _msgs.size()) << LOG_KV("size", size)
+                                 << LOG_KV("queuedBytes", m_writeQueueStats.bytes[_priority])
+                                 << LOG_KV("endpoint", nodeIPEndpoint().name());
+            return false;
+        }
+        SESSION_LOG(TRACE) << "send" << LOG_KV("priority", priorityName(_priority))
+                           << LOG_KV("writeQueue size", m_writeQueueStats.packets[_priority]);
+        m_writeQueues[_priority].insert(m_writeQueues[_priority].end(), _msgs.begin(), _msgs.end());
+        m_writeQueueStats.packets[_priority] += _msgs.size();
+        m_writeQueueStats.bytes[_priority] += size;
     }
+    s_sentMessages.inc(_msgs.size());
+    s_sentBytes.inc(size);
 
     write();
+    return true;
 }
 
 void Session::onWrite(boost::system::error_code ec, std::size_t, std::shared_ptr<bytes>)
@@ -188,21 +275,20 @@ void Session::write()
 
         m_writing = true;
 
-        std::pair<std::shared_ptr<bytes>, u256> task;
-        u256 enter_time = u256(0);
-
-        if (m_writeQueue.empty())
+        auto queue = std::find_if(m_writeQueues.begin(), m_writeQueues.end(),
+            [](std::deque<std::shared_ptr<bytes>> const& _queue) { return !_queue.empty(); });
+        if (queue == m_writeQueues.end())
         {
             m_writing = false;
             return;
         }
 
-        task = m_writeQueue.top();
-        m_writeQueue.pop();
-
-        enter_time = task.second;
+        auto buffer = queue->front();
+        queue->pop_front();
+        size_t priority = queue - m_writeQueues.begin();
+        --m_writeQueueStats.packets[priority];
+        m_writeQueueStats.bytes[priority] -= buffer->size();
         auto session = shared_from_this();
-        auto buffer = task.first;
 
         auto server = m_server.lock();
         if (server && server->haveNetwork())
@@ -403,19 +489,25 @@ void Session::doRead()
                 s->m_data.insert(s->m_data.end(), s->m_recvBuffer.begin(),
                     s->m_recvBuffer.begin() + bytesTransferred);
 
+                // the decoded messages are erased together after the loop
+                size_t decoded = 0;
                 while (true)
                 {
                     Message::Ptr message = s->m_messageFactory->buildMessage();
-                    ssize_t result = message->decode(s->m_data.data(), s->m_data.size());
+                    ssize_t result = message->decode(
+                        s->m_data.data() + decoded, s->m_data.size() - decoded);
                     if (result > 0)
                     {
                         /// SESSION_LOG(TRACE) << "Decode success: " << result;
+                        s_receivedMessages.inc();
+                        s_receivedBytes.inc(result);
                         NetworkException e(P2PExceptionType::Success, "Success");
                         s->onMessage(e, message);
-                        s->m_data.erase(s->m_data.begin(), s->m_data.begin() + result);
+                        decoded += result;
                     }
                     else if (result == 0)
                     {
+                        s->m_data.erase(s->m_data.begin(), s->m_data.begin() + decoded);
                         s->doRead();
                         break;
                     }
@@ -24,7 +24,6 @@
 #include <libdevcore/Common.h>
 #include <libdevcore/Guards.h>
 #include <libdevcore/RLP.h>
-#include <boost/heap/priority_queue.hpp>
 #include <array>
 #include <deque>
 #include <memory>
@@ -56,11 +55,15 @@ public:
 
     virtual void asyncSendMessage(
         Message::Ptr, Options = Options(), CallbackFunc = CallbackFunc()) override;
+    bool asyncSendMessages(std::vector<Message::Ptr> const& _messages, Options _options) override;
 
     virtual NodeIPEndpoint nodeIPEndpoint() const override;
 
     virtual bool actived() const override;
 
+    bool congested(PacketPriority _priority) const override;
+    WriteQueueStats writeQueueStats() const override;
+
     virtual std::weak_ptr<Host> host() { return m_server; }
     virtual void setHost(std::weak_ptr<Host> host) { m_server = host; }
 
@@ -115,7 +118,9 @@ public:
     }
 
 private:
-    void send(std::shared_ptr<bytes> _msg);
+    /// @returns false if the packets are dropped for the queue of their priority is over the
+    /// budget, the packets are queued all or none
+    bool send(std::vector<std::shared_ptr<bytes>> const& _msgs, PacketPriority _priority);
 
     void doRead();
     std::vector<byte> m_data;  ///< Buffer for ingress packet data.
@@ -143,21 +148,11 @@ private:
 
     MessageFactory::Ptr m_messageFactory;
 
-    class QueueCompare
-    {
-    public:
-        bool operator()(const std::pair<std::shared_ptr<bytes>, u256>&,
-            const std::pair<std::shared_ptr<bytes>, u256>&) const
-        {
-            return false;
-        }
-    };
-
-    boost::heap::priority_queue<std::pair<std::shared_ptr<bytes>, u256>,
-        boost::heap::compare<QueueCompare>, boost::heap::stable<true>>
-        m_writeQueue;
+    /// one queue per priority, the packets of the first non-empty queue are written first
+    std::array<std::deque<std::shared_ptr<bytes>>, PriorityCount> m_writeQueues;
+    WriteQueueStats m_writeQueueStats;
     bool m_writing = false;
-    Mutex x_writeQueue;
+    mutable Mutex x_writeQueue;
 
     mutable Mutex x_info;
 
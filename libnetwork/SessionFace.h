@@ -58,6 +58,10 @@ public:
 
     virtual void asyncSendMessage(
         Message::Ptr, Options = Options(), CallbackFunc = CallbackFunc()) = 0;
+    /// queue the frames of a stream, all of them or none if the budget of the priority can't take
+    /// them all, @returns false if they are dropped
+    virtual bool asyncSendMessages(
+        std::vector<Message::Ptr> const& _messages, Options _options) = 0;
 
     virtual std::shared_ptr<SocketFace> socket() = 0;
 
@@ -68,6 +72,10 @@ public:
     virtual NodeIPEndpoint nodeIPEndpoint() const = 0;
 
     virtual bool actived() const = 0;
+
+    /// the queued bytes of the priority are over half of its budget, the sender should slow down
+    virtual bool congested(PacketPriority _priority) const = 0;
+    virtual WriteQueueStats writeQueueStats() const = 0;
 };
 }  // namespace network
 }  // namespace dev
@@ -33,6 +33,7 @@ struct P2PSessionInfo
     dev::network::NodeInfo nodeInfo;
     dev::network::NodeIPEndpoint nodeIPEndpoint;
     std::set<std::string> topics;
+    dev::network::WriteQueueStats writeQueue;
     P2PSessionInfo(dev::network::NodeInfo const& _nodeInfo,
         dev::network::NodeIPEndpoint const& _nodeIPEndpoint, std::set<std::string> const& _topics)
     {
@@ -0,0 +1,203 @@
+/*
+ * @CopyRight:
+ * FISCO-BCOS is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * FISCO-BCOS is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with FISCO-BCOS.  If not, see <http://www.gnu.org/licenses/>
+ * (c) 2016-2018 fisco-dev contributors.
+ */
+/** @file MessageStream.cpp
+ *  @brief split a large message into the frames of a stream and reassemble them
+ */
+
+#include "MessageStream.h"
+#include "Common.h"
+#include <libconfig/GlobalConfigure.h>
+
+using namespace dev;
+using namespace dev::p2p;
+
+namespace
+{
+size_t const c_startHeaderLength = 4 + 4 + 2 + 4;
+size_t const c_dataHeaderLength = 4;
+
+void appendUint32(bytes& _out, uint32_t _value)
+{
+    uint32_t value = htonl(_value);
+    _out.insert(_out.end(), (byte*)&value, (byte*)&value + sizeof(value));
+}
+
+uint32_t readUint32(byte const* _in)
+{
+    return ntohl(*((uint32_t*)_in));
+}
+}  // namespace
+
+const size_t MessageStream::c_chunkSize;
+const size_t MessageStream::c_maxLength;
+const size_t MessageStream::c_maxStreams;
+const size_t MessageStream::c_maxPendingBytes;
+
+bool MessageStream::shouldSplit(P2PMessage::Ptr _message)
+{
+    // the AMOP messages are answered by seq and never split
+    return g_BCOSConfig.version() >= V2_1_0 && _message->buffer()->size() > c_chunkSize &&
+           dev::eth::getGroupAndProtocol(abs(_message->protocolID())).first > 0;
+}
+
+std::vector<P2PMessage::Ptr> MessageStream::split(
+    P2PMessage::Ptr _message, uint32_t _streamID, P2PMessageFactory::Ptr _factory)
+{
+    auto const& payload = *_message->buffer();
+    std::vector<P2PMessage::Ptr> frames;
+    frames.reserve((payload.size() + c_chunkSize - 1) / c_chunkSize);
+    for (size_t offset = 0, index = 0; offset < payload.size(); offset += c_chunkSize, ++index)
+    {
+        size_t size = std::min(c_chunkSize, payload.size() - offset);
+        auto data = std::make_shared<bytes>();
+        auto frame = std::dynamic_pointer_cast<P2PMessage>(_factory->buildMessage());
+        if (index == 0)
+        {
+            data->reserve(c_startHeaderLength + size);
+            appendUint32(*data, payload.size());
+            appendUint32(*data, _message->protocolID());
+            PACKET_TYPE packetType = htons(_message->packetType());
+            data->insert(data->end(), (byte*)&packetType, (byte*)&packetType + sizeof(packetType));
+            appendUint32(*data, _message->seq());
+            frame->setPacketType(StreamStart);
+        }
+        else
+        {
+            data->reserve(c_dataHeaderLength + size);
+            appendUint32(*data, index);
+            frame->setPacketType(StreamData);
+        }
+        data->insert(data->end(), payload.begin() + offset, payload.begin() + offset + size);
+        frame->setProtocolID(dev::eth::ProtocolID::Stream);
+        frame->setSeq(_streamID);
+        frame->setBuffer(data);
+        frames.push_back(frame);
+    }
+    return frames;
+}
+
+P2PMessage::Ptr MessageStream::onFrame(P2PMessage::Ptr _frame, P2PMessageFactory::Ptr _factory)
+{
+    auto const& data = *_frame->buffer();
+    std::lock_guard<std::mutex> l(x_streams);
+    if (_frame->packetType() == StreamStart)
+    {
+        if (data.size() < c_startHeaderLength)
+        {
+            P2PMSG_LOG(WARNING) << LOG_DESC("invalid stream start frame")
+                                << LOG_KV("stream", _frame->seq());
+            return nullptr;
+        }
+        Stream stream;
+        stream.length = readUint32(data.data());
+        if (stream.length > c_maxLength)
+        {
+            P2PMSG_LOG(WARNING) << LOG_DESC("stream too long") << LOG_KV("stream", _frame->seq())
+                                << LOG_KV("length", stream.length);
+            return nullptr;
+        }
+        stream.message = std::dynamic_pointer_cast<P2PMessage>(_factory->buildMessage());
+        stream.message->setProtocolID(readUint32(data.data() + 4));
+        stream.message->setPacketType(ntohs(*((PACKET_TYPE*)(data.data() + 8))));
+        stream.message->setSeq(readUint32(data.data() + 10));
+        // the declared length comes from the peer, the payload grows with the frames instead
+        stream.payload = std::make_shared<bytes>();
+        stream.nextIndex = 0;
+        auto existing = m_streams.find(_frame->seq());
+        if (existing != m_streams.end())
+        {
+            dropStream(existing);
+        }
+        if (m_streams.size() >= c_maxStreams)
+        {
+            P2PMSG_LOG(WARNING) << LOG_DESC("too many streams, drop the oldest")
+                                << LOG_KV("stream", m_streams.begin()->first);
+            dropStream(m_streams.begin());
+        }
+        m_streams[_frame->seq()] = stream;
+    }
+    else if (data.size() < c_dataHeaderLength)
+    {
+        P2PMSG_LOG(WARNING) << LOG_DESC("invalid stream data frame")
+                            << LOG_KV("stream", _frame->seq());
+        return nullptr;
+    }
+
+    auto it = m_streams.find(_frame->seq());
+    if (it == m_streams.end())
+    {
+        P2PMSG_LOG(DEBUG) << LOG_DESC("frame of an unknown stream")
+                          << LOG_KV("stream", _frame->seq());
+        return nullptr;
+    }
+    auto& stream = it->second;
+    size_t headerLength = c_startHeaderLength;
+    if (_frame->packetType() != StreamStart)
+    {
+        headerLength = c_dataHeaderLength;
+        // a frame is missing when the write queue of the sender is full
+        if (readUint32(data.data()) != stream.nextIndex)
+        {
+            P2PMSG_LOG(WARNING) << LOG_DESC("stream frame missing, drop the stream")
+                                << LOG_KV("stream", _frame->seq())
+                                << LOG_KV("expected", stream.nextIndex)
+                                << LOG_KV("index", readUint32(data.data()));
+            dropStream(it);
+            return nullptr;
+        }
+    }
+    size_t frameLength = data.size() - headerLength;
+    auto& payload = *stream.payload;
+    if (payload.size() + frameLength > stream.length)
+    {
+        P2PMSG_LOG(WARNING) << LOG_DESC("stream longer than declared, drop the stream")
+                            << LOG_KV("stream", _frame->seq());
+        dropStream(it);
+        return nullptr;
+    }
+    // the other streams of the peer give way to the one making progress
+    while (m_pendingBytes + frameLength > c_maxPendingBytes && m_streams.begin() != it)
+    {
+        P2PMSG_LOG(WARNING) << LOG_DESC("too many pending bytes, drop the oldest stream")
+                            << LOG_KV("stream", m_streams.begin()->first)
+                            << LOG_KV("pendingBytes", m_pendingBytes);
+        dropStream(m_streams.begin());
+    }
+    if (payload.capacity() < payload.size() + frameLength)
+    {
+        // double the buffer, but never beyond the declared length
+        payload.reserve(std::min<size_t>(
+            stream.length, std::max(2 * payload.capacity(), payload.size() + frameLength)));
+    }
+    payload.insert(payload.end(), data.begin() + headerLength, data.end());
+    m_pendingBytes += frameLength;
+    ++stream.nextIndex;
+    if (payload.size() < stream.length)
+    {
+        return nullptr;
+    }
+    auto message = stream.message;
+    message->setBuffer(stream.payload);
+    dropStream(it);
+    return message;
+}
+
+void MessageStream::dropStream(StreamMap::iterator _it)
+{
+    m_pendingBytes -= _it->second.payload->size();
+    m_streams.erase(_it);
+}
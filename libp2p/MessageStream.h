@@ -0,0 +1,98 @@
+/*
+ * @CopyRight:
+ * FISCO-BCOS is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * FISCO-BCOS is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with FISCO-BCOS.  If not, see <http://www.gnu.org/licenses/>
+ * (c) 2016-2018 fisco-dev contributors.
+ */
+/** @file MessageStream.h
+ *  @brief split a large message into the frames of a stream and reassemble them
+ */
+
+#pragma once
+
+#include "P2PMessage.h"
+#include "P2PMessageFactory.h"
+#include <map>
+#include <mutex>
+#include <vector>
+
+namespace dev
+{
+namespace p2p
+{
+/// the packet type of the frames of protocol dev::eth::ProtocolID::Stream
+enum StreamPacketType
+{
+    /// length(4bytes) + protocolID(4bytes) + packetType(2bytes) + seq(4bytes) + data
+    StreamStart = 1,
+    /// index(4bytes) + data
+    StreamData = 2
+};
+
+/**
+ * A message larger than c_chunkSize is sent as a stream of frames with the same seq, the stream
+ * ID. The frames are queued all or none, the packets of a higher priority are still written
+ * between them for the queues are drained by priority. The receiver appends the frames into a
+ * buffer growing with the frames received, the declared length is only an upper bound, and hands
+ * the buffer to the message when the last frame arrives.
+ */
+class MessageStream
+{
+public:
+    typedef std::shared_ptr<MessageStream> Ptr;
+
+    static const size_t c_chunkSize = 256 * 1024;
+    /// the longest message accepted, the frames of a longer one are dropped
+    static const size_t c_maxLength = 128 * 1024 * 1024;
+    /// the streams of a peer being received, the oldest is dropped when a new one starts
+    static const size_t c_maxStreams = 16;
+    /// the bytes received of the pending streams of a peer, the oldest are dropped beyond it
+    static const size_t c_maxPendingBytes = 256 * 1024 * 1024;
+
+    /// @returns true if the message is sent as a stream, the peers must support 2.1.0
+    static bool shouldSplit(P2PMessage::Ptr _message);
+    static std::vector<P2PMessage::Ptr> split(
+        P2PMessage::Ptr _message, uint32_t _streamID, P2PMessageFactory::Ptr _factory);
+
+    /// @returns the message of the stream if the frame is the last one, nullptr otherwise
+    P2PMessage::Ptr onFrame(P2PMessage::Ptr _frame, P2PMessageFactory::Ptr _factory);
+
+    size_t pendingStreams() const
+    {
+        std::lock_guard<std::mutex> l(x_streams);
+        return m_streams.size();
+    }
+    size_t pendingBytes() const
+    {
+        std::lock_guard<std::mutex> l(x_streams);
+        return m_pendingBytes;
+    }
+
+private:
+    struct Stream
+    {
+        P2PMessage::Ptr message;
+        std::shared_ptr<bytes> payload;
+        uint32_t length;
+        uint32_t nextIndex;
+    };
+    typedef std::map<uint32_t, Stream> StreamMap;
+    void dropStream(StreamMap::iterator _it);
+
+    /// stream ID to the stream, the stream IDs of a peer increase
+    StreamMap m_streams;
+    size_t m_pendingBytes = 0;
+    mutable std::mutex x_streams;
+};
+}  // namespace p2p
+}  // namespace dev
@@ -75,6 +75,9 @@ public:
     virtual P2PSessionInfos sessionInfosByProtocolID(PROTOCOL_ID _protocolID) const = 0;
 
     virtual bool isConnected(NodeID const& _nodeID) const = 0;
+    /// the packets of the priority queued to the node are near the budget
+    virtual bool isCongested(
+        NodeID const& _nodeID, dev::network::PacketPriority _priority) const = 0;
 
     virtual std::vector<std::string> topics() = 0;
 
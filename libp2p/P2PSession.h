@@ -21,6 +21,7 @@
 
 #pragma once
 
+#include "MessageStream.h"
 #include <libnetwork/Common.h>
 #include <libnetwork/SessionFace.h>
 #include <libp2p/Common.h>
@@ -38,7 +39,11 @@ class P2PSession : public std::enable_shared_from_this<P2PSession>
 public:
     typedef std::shared_ptr<P2PSession> Ptr;
 
-    P2PSession() { m_topics = std::make_shared<std::set<std::string> >(); }
+    P2PSession()
+    {
+        m_topics = std::make_shared<std::set<std::string> >();
+        m_inboundStreams = std::make_shared<MessageStream>();
+    }
 
     virtual ~P2PSession(){};
 
@@ -69,6 +74,9 @@ public:
 
     virtual void onTopicMessage(std::shared_ptr<P2PMessage> message);
 
+    /// the large messages being received from the peer
+    MessageStream::Ptr inboundStreams() { return m_inboundStreams; }
+
     virtual void setTopics(uint32_t seq, std::shared_ptr<std::set<std::string> > topics)
     {
         std::lock_guard<std::mutex> lock(x_topic);
@@ -86,6 +94,7 @@ private:
     std::shared_ptr<std::set<std::string> > m_topics;
     std::weak_ptr<Service> m_service;
     std::shared_ptr<boost::asio::deadline_timer> m_timer;
+    MessageStream::Ptr m_inboundStreams;
     bool m_run = false;
 
     const uint32_t HEARTBEAT_INTERVEL = 5000;
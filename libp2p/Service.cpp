@@ -36,10 +36,27 @@ using namespace dev::p2p;
 
 static const uint32_t CHECK_INTERVEL = 10000;
 
+/// the priority of the packets not classified by the sender
+static dev::network::PacketPriority priorityOf(PROTOCOL_ID _protocolID)
+{
+    switch (dev::eth::getGroupAndProtocol(abs(_protocolID)).second)
+    {
+    case dev::eth::ProtocolID::PBFT:
+    case dev::eth::ProtocolID::Raft:
+        return dev::network::ConsensusPriority;
+    case dev::eth::ProtocolID::BlockSync:
+        return dev::network::BlockSyncPriority;
+    case dev::eth::ProtocolID::TxPool:
+        return dev::network::TxGossipPriority;
+    default:
+        return dev::network::AMOPPriority;
+    }
+}
+
 Service::Service()
 {
-    m_protocolID2Handler =
-        std::make_shared<std::unordered_map<uint32_t, CallbackFuncWithSession>>();
+    m_sessions = std::make_shared<Sessions const>();
+    m_protocolID2Handler = std::make_shared<ProtocolHandlers const>();
     m_topic2Handler = std::make_shared<std::unordered_map<std::string, CallbackFuncWithSession>>();
     m_topics = std::make_shared<std::vector<std::string>>();
 }
@@ -79,17 +96,42 @@ void Service::stop()
         /// disconnect sessions
 
         RecursiveGuard l(x_sessions);
-        for (auto session : m_sessions)
+        for (auto session : *m_sessions)
         {
             session.second->stop(dev::network::ClientQuit);
         }
 
 
         /// clear sessions
-        m_sessions.clear();
+        std::atomic_store(&m_sessions, std::make_shared<Sessions const>());
+
+        RecursiveGuard dispatcherLock(x_protocolID2Handler);
+        for (auto& dispatcher : m_groupDispatchers)
+        {
+            dispatcher.second->stop();
+        }
     }
 }
 
+void Service::updateSessions(std::function<void(Sessions&)> const& _update)
+{
+    auto sessions = std::make_shared<Sessions>(*m_sessions);
+    _update(*sessions);
+    std::atomic_store(&m_sessions, std::shared_ptr<Sessions const>(std::move(sessions)));
+}
+
+dev::ThreadPool::Ptr Service::groupDispatcher(GROUP_ID _groupID)
+{
+    RecursiveGuard l(x_protocolID2Handler);
+    auto& dispatcher = m_groupDispatchers[_groupID];
+    if (!dispatcher)
+    {
+        dispatcher = std::make_shared<dev::ThreadPool>(
+            "p2p-g" + std::to_string(_groupID), m_dispatchThreads);
+    }
+    return dispatcher;
+}
+
 void Service::heartBeat()
 {
     if (!m_run)
@@ -131,10 +173,7 @@ void Service::heartBeat()
             it.first, std::bind(&Service::onConnect, shared_from_this(), std::placeholders::_1,
                           std::placeholders::_2, std::placeholders::_3));
     }
-    {
-        RecursiveGuard l(x_sessions);
-        SERVICE_LOG(INFO) << LOG_DESC("heartBeat") << LOG_KV("connected count", m_sessions.size());
-    }
+    SERVICE_LOG(INFO) << LOG_DESC("heartBeat") << LOG_KV("connected count", sessions()->size());
 
     auto self = std::weak_ptr<Service>(shared_from_this());
     m_timer = m_host->asioInterface()->newTimer(CHECK_INTERVEL);
@@ -186,8 +225,8 @@ void Service::onConnect(dev::network::NetworkException e, dev::network::NodeInfo
     SERVICE_LOG(TRACE) << LOG_DESC("Service onConnect") << LOG_KV("nodeID", nodeID.abridged());
 
     RecursiveGuard l(x_sessions);
-    auto it = m_sessions.find(nodeID);
-    if (it != m_sessions.end() && it->second->actived())
+    auto it = m_sessions->find(nodeID);
+    if (it != m_sessions->end() && it->second->actived())
     {
         SERVICE_LOG(TRACE) << "Disconnect duplicate peer" << LOG_KV("nodeID", nodeID.abridged());
         updateStaticNodes(session->socket(), nodeID);
@@ -211,14 +250,7 @@ void Service::onConnect(dev::network::NetworkException e, dev::network::NodeInfo
         std::placeholders::_1, std::placeholders::_2, std::placeholders::_3, p2pSession));
     p2pSession->start();
     updateStaticNodes(session->socket(), nodeID);
-    if (it != m_sessions.end())
-    {
-        it->second = p2pSession;
-    }
-    else
-    {
-        m_sessions.insert(std::make_pair(nodeID, p2pSession));
-    }
+    updateSessions([&](Sessions& _sessions) { _sessions[nodeID] = p2pSession; });
     SERVICE_LOG(INFO) << LOG_DESC("Connection established") << LOG_KV("nodeID", nodeID.abridged())
                       << LOG_KV("endpoint", session->nodeIPEndpoint().name());
 }
@@ -226,14 +258,14 @@ void Service::onConnect(dev::network::NetworkException e, dev::network::NodeInfo
 void Service::onDisconnect(dev::network::NetworkException e, P2PSession::Ptr p2pSession)
 {
     RecursiveGuard l(x_sessions);
-    auto it = m_sessions.find(p2pSession->nodeID());
-    if (it != m_sessions.end() && it->second == p2pSession)
+    auto it = m_sessions->find(p2pSession->nodeID());
+    if (it != m_sessions->end() && it->second == p2pSession)
     {
         SERVICE_LOG(TRACE) << "Service onDisconnect and remove from m_sessions"
                            << LOG_KV("nodeID", p2pSession->nodeID().abridged())
                            << LOG_KV("endpoint", p2pSession->session()->nodeIPEndpoint().name());
 
-        m_sessions.erase(it);
+        updateSessions([&](Sessions& _sessions) { _sessions.erase(p2pSession->nodeID()); });
         if (e.errorCode() == dev::network::P2PExceptionType::DuplicateSession)
             return;
         SERVICE_LOG(WARNING) << LOG_DESC("onDisconnect") << LOG_KV("errorCode", e.errorCode())
@@ -271,6 +303,16 @@ void Service::onMessage(dev::network::NetworkException e, dev::network::SessionF
 
         auto p2pMessage = std::dynamic_pointer_cast<P2PMessage>(message);
 
+        // a frame of a large message, handled as the message when its last frame arrives
+        if (p2pMessage->protocolID() == dev::eth::ProtocolID::Stream)
+        {
+            p2pMessage = p2pSession->inboundStreams()->onFrame(p2pMessage, m_p2pMessageFactory);
+            if (!p2pMessage)
+            {
+                return;
+            }
+        }
+
         // AMOP topic message, redirect to p2psession
         if (abs(p2pMessage->protocolID()) == dev::eth::ProtocolID::Topic)
         {
@@ -280,19 +322,12 @@ void Service::onMessage(dev::network::NetworkException e, dev::network::SessionF
 
         if (p2pMessage->isRequestPacket())
         {
-            CallbackFuncWithSession callback;
+            auto handlers = std::atomic_load(&m_protocolID2Handler);
+            auto it = handlers->find(p2pMessage->protocolID());
+            if (it != handlers->end())
             {
-                RecursiveGuard lock(x_protocolID2Handler);
-                auto it = m_protocolID2Handler->find(p2pMessage->protocolID());
-                if (it != m_protocolID2Handler->end())
-                {
-                    callback = it->second;
-                }
-            }
-
-            if (callback)
-            {
-                m_host->threadPool()->enqueue([callback, p2pSession, p2pMessage, e]() {
+                auto callback = it->second.callback;
+                it->second.dispatcher->enqueue([callback, p2pSession, p2pMessage, e]() {
                     callback(e, p2pSession, p2pMessage);
                 });
             }
@@ -380,10 +415,14 @@ void Service::asyncSendMessageByNodeID(NodeID nodeID, P2PMessage::Ptr message,
             // exclude myself
             return;
         }
-        RecursiveGuard l(x_sessions);
-        auto it = m_sessions.find(nodeID);
+        if (options.priority == dev::network::DefaultPriority)
+        {
+            options.priority = priorityOf(message->protocolID());
+        }
+        auto sessions = this->sessions();
+        auto it = sessions->find(nodeID);
 
-        if (it != m_sessions.end() && it->second->actived())
+        if (it != sessions->end() && it->second->actived())
         {
             if (message->seq() == 0)
             {
@@ -402,6 +441,20 @@ void Service::asyncSendMessageByNodeID(NodeID nodeID, P2PMessage::Ptr message,
                         }
                     });
             }
+            else if (MessageStream::shouldSplit(message))
+            {
+                // the frames of a stream are queued all or none, a partial stream is never sent
+                auto frames = MessageStream::split(
+                    message, m_p2pMessageFactory->newSeq(), m_p2pMessageFactory);
+                if (!session->session()->asyncSendMessages(
+                        std::vector<dev::network::Message::Ptr>(frames.begin(), frames.end()),
+                        options))
+                {
+                    SERVICE_LOG(WARNING) << LOG_DESC("Drop the stream for the peer is congested")
+                                         << LOG_KV("nodeID", nodeID.abridged())
+                                         << LOG_KV("size", message->buffer()->size());
+                }
+            }
             else
             {
                 session->session()->asyncSendMessage(message, options, nullptr);
@@ -609,13 +662,8 @@ void Service::asyncBroadcastMessage(P2PMessage::Ptr message, dev::network::Optio
 {
     try
     {
-        std::unordered_map<NodeID, P2PSession::Ptr> sessions;
-        {
-            RecursiveGuard l(x_sessions);
-            sessions = m_sessions;
-        }
-
-        for (auto s : sessions)
+        auto sessions = this->sessions();
+        for (auto const& s : *sessions)
         {
             asyncSendMessageByNodeID(s.first, message, CallbackFuncWithSession(), options);
         }
@@ -640,15 +688,11 @@ bool Service::isSessionInNodeIDList(NodeID const& targetNodeID, NodeIDs const& n
 void Service::registerHandlerByProtoclID(PROTOCOL_ID protocolID, CallbackFuncWithSession handler)
 {
     RecursiveGuard l(x_protocolID2Handler);
-    auto it = m_protocolID2Handler->find(protocolID);
-    if (it == m_protocolID2Handler->end())
-    {
-        m_protocolID2Handler->insert(std::make_pair(protocolID, handler));
-    }
-    else
-    {
-        it->second = handler;
-    }
+    auto handlers = std::make_shared<ProtocolHandlers>(*m_protocolID2Handler);
+    (*handlers)[protocolID] =
+        ProtocolHandler{handler, groupDispatcher(dev::eth::getGroupAndProtocol(protocolID).first)};
+    std::atomic_store(
+        &m_protocolID2Handler, std::shared_ptr<ProtocolHandlers const>(std::move(handlers)));
 }
 
 void Service::registerHandlerByTopic(std::string topic, CallbackFuncWithSession handler)
@@ -670,12 +714,12 @@ P2PSessionInfos Service::sessionInfos()
     P2PSessionInfos infos;
     try
     {
-        RecursiveGuard l(x_sessions);
-        auto s = m_sessions;
-        for (auto const& i : s)
+        auto s = sessions();
+        for (auto const& i : *s)
         {
             infos.push_back(P2PSessionInfo(
                 i.second->nodeInfo(), i.second->session()->nodeIPEndpoint(), (i.second->topics())));
+            infos.back().writeQueue = i.second->session()->writeQueueStats();
         }
     }
     catch (std::exception& e)
@@ -701,8 +745,8 @@ P2PSessionInfos Service::sessionInfosByProtocolID(PROTOCOL_ID _protocolID) const
     }
     try
     {
-        RecursiveGuard l(x_sessions);
-        for (auto const& i : m_sessions)
+        auto s = sessions();
+        for (auto const& i : *s)
         {
             /// ignore the node self and the inactived session
             if (i.first == id() || false == i.second->actived())
@@ -729,9 +773,8 @@ NodeIDs Service::getPeersByTopic(std::string const& topic)
     NodeIDs nodeList;
     try
     {
-        RecursiveGuard l(x_sessions);
-        auto s = m_sessions;
-        for (auto const& it : s)
+        auto s = sessions();
+        for (auto const& it : *s)
         {
             for (auto& j : it.second->topics())
             {
@@ -752,12 +795,19 @@ NodeIDs Service::getPeersByTopic(std::string const& topic)
     return nodeList;
 }
 
+bool Service::isCongested(NodeID const& _nodeID, dev::network::PacketPriority _priority) const
+{
+    auto s = sessions();
+    auto it = s->find(_nodeID);
+    return it != s->end() && it->second->actived() && it->second->session()->congested(_priority);
+}
+
 bool Service::isConnected(NodeID const& nodeID) const
 {
-    RecursiveGuard l(x_sessions);
-    auto it = m_sessions.find(nodeID);
+    auto s = sessions();
+    auto it = s->find(nodeID);
 
-    if (it != m_sessions.end() && it->second->actived())
+    if (it != s->end() && it->second->actived())
     {
         return true;
     }
@@ -30,6 +30,7 @@
 #include <libdevcore/Common.h>
 #include <libdevcore/Exceptions.h>
 #include <libdevcore/FixedHash.h>
+#include <libdevcore/ThreadPool.h>
 #include <libnetwork/Host.h>
 #include <map>
 #include <memory>
@@ -47,6 +48,7 @@ public:
     virtual ~Service() { stop(); }
 
     typedef std::shared_ptr<Service> Ptr;
+    typedef std::unordered_map<NodeID, P2PSession::Ptr> Sessions;
 
     virtual void start();
     virtual void stop();
@@ -94,6 +96,8 @@ public:
     P2PSessionInfos sessionInfosByProtocolID(PROTOCOL_ID _protocolID) const override;
 
     bool isConnected(NodeID const& nodeID) const override;
+    bool isCongested(
+        NodeID const& _nodeID, dev::network::PacketPriority _priority) const override;
 
     h512s getNodeListByGroupID(GROUP_ID groupID) override { return m_groupID2NodeList[groupID]; }
     void setGroupID2NodeList(std::map<GROUP_ID, h512s> _groupID2NodeList) override
@@ -137,8 +141,27 @@ public:
     void updateStaticNodes(
         std::shared_ptr<dev::network::SocketFace> const& _s, NodeID const& nodeId);
 
+    /// the threads of the dispatcher of a group, the requests of a group are handled by them
+    virtual void setDispatchThreads(size_t _dispatchThreads)
+    {
+        m_dispatchThreads = _dispatchThreads;
+    }
+
 private:
+    /// a handler and the dispatcher of the group of its protocol
+    struct ProtocolHandler
+    {
+        CallbackFuncWithSession callback;
+        dev::ThreadPool::Ptr dispatcher;
+    };
+    typedef std::unordered_map<PROTOCOL_ID, ProtocolHandler> ProtocolHandlers;
+
     NodeIDs getPeersByTopic(std::string const& topic);
+    /// the snapshot of the sessions, never modified after it is published
+    std::shared_ptr<Sessions const> sessions() const { return std::atomic_load(&m_sessions); }
+    /// copy the sessions, modify the copy and publish it, must be called with x_sessions held
+    void updateSessions(std::function<void(Sessions&)> const& _update);
+    dev::ThreadPool::Ptr groupDispatcher(GROUP_ID _groupID);
 
     bool isSessionInNodeIDList(NodeID const& targetNodeID, NodeIDs const& nodeIDs);
 
@@ -147,8 +170,10 @@ private:
 
     std::shared_ptr<dev::network::Host> m_host;
 
-    std::unordered_map<NodeID, P2PSession::Ptr> m_sessions;
-    mutable RecursiveMutex x_sessions;
+    /// read without lock by the senders, replaced by the connect and disconnect handlers
+    std::shared_ptr<Sessions const> m_sessions;
+    /// serializes the updates of m_sessions
+    RecursiveMutex x_sessions;
 
     std::atomic<uint32_t> m_topicSeq = {0};
     std::shared_ptr<std::vector<std::string>> m_topics;
@@ -160,8 +185,12 @@ private:
     mutable RecursiveMutex x_nodeList;
     std::map<GROUP_ID, h512s> m_groupID2NodeList;
 
-    std::shared_ptr<std::unordered_map<uint32_t, CallbackFuncWithSession>> m_protocolID2Handler;
+    /// read without lock by onMessage, replaced when a handler is registered
+    std::shared_ptr<ProtocolHandlers const> m_protocolID2Handler;
     RecursiveMutex x_protocolID2Handler;
+    ///< one dispatcher per group, so the flood of a group doesn't delay the messages of the others
+    std::map<GROUP_ID, dev::ThreadPool::Ptr> m_groupDispatchers;
+    size_t m_dispatchThreads = 4;
 
     ///< A call B, the function to call after the request is received by B in topic.
     std::shared_ptr<std::unordered_map<std::string, CallbackFuncWithSession>> m_topic2Handler;
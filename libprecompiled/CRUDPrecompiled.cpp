@@ -24,7 +24,9 @@
 #include "libstorage/EntriesPrecompiled.h"
 #include "libstorage/TableFactoryPrecompiled.h"
 #include <json/json.h>
+#include <libconfig/GlobalConfigure.h>
 #include <libdevcore/Common.h>
+#include <libdevcore/RLP.h>
 #include <libdevcore/easylog.h>
 #include <libdevcrypto/Hash.h>
 #include <libethcore/ABI.h>
@@ -34,10 +36,13 @@ using namespace dev::blockverifier;
 using namespace dev::storage;
 using namespace dev::precompiled;
 
-const char* const CRUD_METHOD_INSERT_STR = "insert(string,string,string,string)";
-const char* const CRUD_METHOD_REMOVE_STR = "remove(string,string,string,string)";
-const char* const CRUD_METHOD_UPDATE_STR = "update(string,string,string,string,string)";
-const char* const CRUD_METHOD_SELECT_STR = "select(string,string,string,string)";
+const std::string CRUD_METHOD_INSERT_STR = "insert(string,string,string,string)";
+const std::string CRUD_METHOD_REMOVE_STR = "remove(string,string,string,string)";
+const std::string CRUD_METHOD_UPDATE_STR = "update(string,string,string,string,string)";
+const std::string CRUD_METHOD_SELECT_STR = "select(string,string,string,string)";
+const std::string CRUD_METHOD_SELECT_BIN_STR = "selectBinary(string,string,bytes,string)";
+
+const unsigned CRUDPrecompiled::c_limitOp;
 
 CRUDPrecompiled::CRUDPrecompiled()
 {
@@ -45,6 +50,7 @@ CRUDPrecompiled::CRUDPrecompiled()
     name2Selector[CRUD_METHOD_REMOVE_STR] = getFuncSelector(CRUD_METHOD_REMOVE_STR);
     name2Selector[CRUD_METHOD_UPDATE_STR] = getFuncSelector(CRUD_METHOD_UPDATE_STR);
     name2Selector[CRUD_METHOD_SELECT_STR] = getFuncSelector(CRUD_METHOD_SELECT_STR);
+    name2Selector[CRUD_METHOD_SELECT_BIN_STR] = getFuncSelector(CRUD_METHOD_SELECT_BIN_STR);
 }
 
 std::string CRUDPrecompiled::toString()
@@ -66,8 +72,9 @@ bytes CRUDPrecompiled::call(
 
     if (func == name2Selector[CRUD_METHOD_INSERT_STR])
     {  // insert(string tableName, string key, string entry, string optional)
-        std::string tableName, key, entryStr, optional;
-        abi.abiOut(data, tableName, key, entryStr, optional);
+        std::string tableName, key;
+        bytesConstRef entryStr;
+        abi.abiOut(data, tableName, key, entryStr);
         tableName = storage::USER_TABLE_PREFIX + tableName;
         Table::Ptr table = openTable(context, tableName);
         if (table)
@@ -94,8 +101,9 @@ bytes CRUDPrecompiled::call(
     }
     if (func == name2Selector[CRUD_METHOD_UPDATE_STR])
     {  // update(string tableName, string key, string entry, string condition, string optional)
-        std::string tableName, key, entryStr, conditionStr, optional;
-        abi.abiOut(data, tableName, key, entryStr, conditionStr, optional);
+        std::string tableName, key;
+        bytesConstRef entryStr, conditionStr;
+        abi.abiOut(data, tableName, key, entryStr, conditionStr);
         tableName = storage::USER_TABLE_PREFIX + tableName;
         Table::Ptr table = openTable(context, tableName);
         if (table)
@@ -129,8 +137,9 @@ bytes CRUDPrecompiled::call(
     }
     if (func == name2Selector[CRUD_METHOD_REMOVE_STR])
     {  // remove(string tableName, string key, string condition, string optional)
-        std::string tableName, key, conditionStr, optional;
-        abi.abiOut(data, tableName, key, conditionStr, optional);
+        std::string tableName, key;
+        bytesConstRef conditionStr;
+        abi.abiOut(data, tableName, key, conditionStr);
         tableName = storage::USER_TABLE_PREFIX + tableName;
         Table::Ptr table = openTable(context, tableName);
         if (table)
@@ -156,8 +165,9 @@ bytes CRUDPrecompiled::call(
     }
     if (func == name2Selector[CRUD_METHOD_SELECT_STR])
     {  // select(string tableName, string key, string condition, string optional)
-        std::string tableName, key, conditionStr, optional;
-        abi.abiOut(data, tableName, key, conditionStr, optional);
+        std::string tableName, key;
+        bytesConstRef conditionStr;
+        abi.abiOut(data, tableName, key, conditionStr);
         if (tableName != storage::SYS_TABLES)
         {
             tableName = storage::USER_TABLE_PREFIX + tableName;
@@ -188,8 +198,48 @@ bytes CRUDPrecompiled::call(
                 }
             }
 
-            auto str = records.toStyledString();
-            out = abi.abiIn("", str);
+            if (g_BCOSConfig.version() >= V2_1_0)
+            {
+                Json::FastWriter fastWriter;
+                fastWriter.omitEndingLineFeed();
+                out = abi.abiIn("", fastWriter.write(records));
+            }
+            else
+            {
+                auto str = records.toStyledString();
+                out = abi.abiIn("", str);
+            }
+        }
+        else
+        {
+            PRECOMPILED_LOG(ERROR) << LOG_BADGE("CRUDPrecompiled") << LOG_DESC("table open error")
+                                   << LOG_KV("tableName", tableName);
+            out = abi.abiIn("", u256(CODE_TABLE_NOT_EXIST));
+        }
+
+        return out;
+    }
+    if (g_BCOSConfig.version() >= V2_1_0 && func == name2Selector[CRUD_METHOD_SELECT_BIN_STR])
+    {  // selectBinary(string tableName, string key, bytes condition, string optional)
+        std::string tableName, key;
+        bytesConstRef conditionData;
+        abi.abiOut(data, tableName, key, conditionData);
+        if (tableName != storage::SYS_TABLES)
+        {
+            tableName = storage::USER_TABLE_PREFIX + tableName;
+        }
+        Table::Ptr table = openTable(context, tableName);
+        if (table)
+        {
+            Condition::Ptr condition = table->newCondition();
+            int parseConditionResult = parseBinaryCondition(conditionData, condition);
+            if (parseConditionResult != CODE_SUCCESS)
+            {
+                out = abi.abiIn("", u256(parseConditionResult));
+                return out;
+            }
+            auto rows = encodeEntries(table->select(key, condition));
+            out = abi.abiIn("", bytesConstRef(&rows));
         }
         else
         {
@@ -210,15 +260,16 @@ bytes CRUDPrecompiled::call(
     }
 }
 
-int CRUDPrecompiled::parseCondition(const std::string& conditionStr, Condition::Ptr& condition)
+int CRUDPrecompiled::parseCondition(bytesConstRef conditionStr, Condition::Ptr& condition)
 {
     Json::Reader reader;
     Json::Value conditionJson;
-    if (!reader.parse(conditionStr, conditionJson))
+    if (!reader.parse((char const*)conditionStr.begin(), (char const*)conditionStr.end(),
+            conditionJson))
     {
         PRECOMPILED_LOG(ERROR) << LOG_BADGE("CRUDPrecompiled")
                                << LOG_DESC("condition json parse error")
-                               << LOG_KV("condition", conditionStr);
+                               << LOG_KV("condition", conditionStr.toString());
 
         return CODE_PARSE_CONDITION_ERROR;
     }
@@ -284,16 +335,101 @@ int CRUDPrecompiled::parseCondition(const std::string& conditionStr, Condition::
     return CODE_SUCCESS;
 }
 
-int CRUDPrecompiled::parseEntry(const std::string& entryStr, Entry::Ptr& entry)
+int CRUDPrecompiled::parseBinaryCondition(bytesConstRef conditionData, Condition::Ptr& condition)
+{
+    try
+    {
+        RLP items(conditionData);
+        if (!items.isList())
+        {
+            PRECOMPILED_LOG(ERROR) << LOG_BADGE("CRUDPrecompiled")
+                                   << LOG_DESC("binary condition is not a list");
+            return CODE_PARSE_CONDITION_ERROR;
+        }
+        for (auto const& item : items)
+        {
+            if (!item.isList() || item.itemCount() != 3)
+            {
+                PRECOMPILED_LOG(ERROR) << LOG_BADGE("CRUDPrecompiled")
+                                       << LOG_DESC("invalid binary condition item");
+                return CODE_PARSE_CONDITION_ERROR;
+            }
+            auto op = item[0].toInt<unsigned>();
+            if (op == c_limitOp)
+            {
+                condition->limit(item[1].toInt<uint32_t>(), item[2].toInt<uint32_t>());
+                continue;
+            }
+            auto field = item[1].toString(RLP::VeryStrict);
+            if (!isHashField(field))
+            {
+                continue;
+            }
+            auto value = item[2].toString(RLP::VeryStrict);
+            switch (op)
+            {
+            case Condition::eq:
+                condition->EQ(field, value);
+                break;
+            case Condition::ne:
+                condition->NE(field, value);
+                break;
+            case Condition::gt:
+                condition->GT(field, value);
+                break;
+            case Condition::ge:
+                condition->GE(field, value);
+                break;
+            case Condition::lt:
+                condition->LT(field, value);
+                break;
+            case Condition::le:
+                condition->LE(field, value);
+                break;
+            default:
+                PRECOMPILED_LOG(ERROR)
+                    << LOG_BADGE("CRUDPrecompiled") << LOG_DESC("condition operation undefined")
+                    << LOG_KV("operation", op);
+                return CODE_CONDITION_OPERATION_UNDEFINED;
+            }
+        }
+    }
+    catch (std::exception const& e)
+    {
+        PRECOMPILED_LOG(ERROR) << LOG_BADGE("CRUDPrecompiled")
+                               << LOG_DESC("binary condition parse error")
+                               << LOG_KV("errorInfo", boost::diagnostic_information(e));
+        return CODE_PARSE_CONDITION_ERROR;
+    }
+
+    return CODE_SUCCESS;
+}
+
+bytes CRUDPrecompiled::encodeEntries(Entries::ConstPtr entries)
+{
+    RLPStream rows(entries ? entries->size() : 0);
+    for (size_t i = 0; entries && i < entries->size(); ++i)
+    {
+        auto entry = entries->get(i);
+        rows.appendList(entry->size() * 2);
+        for (auto iter = entry->begin(); iter != entry->end(); ++iter)
+        {
+            rows << iter->first << iter->second;
+        }
+    }
+    return rows.out();
+}
+
+int CRUDPrecompiled::parseEntry(bytesConstRef entryStr, Entry::Ptr& entry)
 {
     PRECOMPILED_LOG(DEBUG) << LOG_BADGE("CRUDPrecompiled") << LOG_DESC("table records")
-                           << LOG_KV("entryStr", entryStr);
+                           << LOG_KV("entryStr", entryStr.toString());
     Json::Value entryJson;
     Json::Reader reader;
-    if (!reader.parse(entryStr, entryJson))
+    if (!reader.parse((char const*)entryStr.begin(), (char const*)entryStr.end(), entryJson))
     {
         PRECOMPILED_LOG(ERROR) << LOG_BADGE("CRUDPrecompiled") << LOG_DESC("entry json parse error")
-                               << LOG_KV("entry", entryStr);
+                               << LOG_KV("entry", entryStr.toString());
 
         return CODE_PARSE_ENTRY_ERROR;
     }
@@ -38,9 +38,14 @@ contract CRUD
     function update(string tableName, string key, string entry, string condition, string optional) public returns(int);
     function remove(string tableName, string key, string condition, string optional) public returns(int);
     function select(string tableName, string key, string condition, string optional) public constant returns(string);
+    function selectBinary(string tableName, string key, bytes condition, string optional) public constant returns(bytes);
 }
 #endif
 
+/// selectBinary, since 2.1.0, takes the condition as a RLP list of [op, field, value] items, the
+/// op is a storage::Condition::Op or CRUDPrecompiled::c_limitOp with [op, offset, count], and
+/// returns the rows as a RLP list of [field0, value0, field1, value1, ...] lists
+
 class CRUDPrecompiled : public dev::blockverifier::Precompiled
 {
 public:
@@ -53,9 +58,15 @@ public:
     virtual bytes call(std::shared_ptr<dev::blockverifier::ExecutiveContext> context,
         bytesConstRef param, Address const& origin = Address());
 
+    static const unsigned c_limitOp = storage::Condition::le + 1;
+
+    static bytes encodeEntries(storage::Entries::ConstPtr entries);
+
 private:
-    int parseEntry(const std::string& entryStr, storage::Entry::Ptr& entry);
-    int parseCondition(const std::string& conditionStr, storage::Condition::Ptr& condition);
+    /// the entry and the condition are JSON strings viewed in the call param
+    int parseEntry(bytesConstRef entryStr, storage::Entry::Ptr& entry);
+    int parseCondition(bytesConstRef conditionStr, storage::Condition::Ptr& condition);
+    int parseBinaryCondition(bytesConstRef conditionData, storage::Condition::Ptr& condition);
 };
 
 }  // namespace precompiled
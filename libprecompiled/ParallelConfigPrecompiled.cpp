@@ -20,12 +20,14 @@
  */
 
 #include "ParallelConfigPrecompiled.h"
+#include <libethcore/ABIParser.h>
 #include <libstorage/EntriesPrecompiled.h>
 #include <libstorage/TableFactoryPrecompiled.h>
 
 using namespace std;
 using namespace dev;
 using namespace dev::eth;
+using namespace dev::eth::abi;
 using namespace dev::storage;
 using namespace dev::precompiled;
 using namespace dev::blockverifier;
@@ -51,6 +53,61 @@ const string PARA_CONFIG_UNREGISTER_METHOD_ADDR_STR =
 const string PARA_KEY_NAME = PARA_KEY;
 const string PARA_VALUE_NAMES = PARA_SELECTOR + "," + PARA_FUNC_NAME + "," + PARA_CRITICAL_SIZE;
 
+const size_t ParallelConfigCache::c_maxConfigs;
+
+bool ParallelConfigCache::get(Address const& _contract, uint32_t _selector, int64_t _blockNumber,
+    ParallelConfig::Ptr& _config)
+{
+    Key key(_contract, _selector);
+    ReadGuard l(x_configs);
+    auto it = m_configs.find(key);
+    if (it == m_configs.end() || writtenSince(key, _blockNumber))
+    {
+        return false;
+    }
+    _config = it->second;
+    return true;
+}
+
+void ParallelConfigCache::set(
+    Address const& _contract, uint32_t _selector, int64_t _blockNumber, ParallelConfig::Ptr _config)
+{
+    Key key(_contract, _selector);
+    WriteGuard l(x_configs);
+    if (writtenSince(key, _blockNumber))
+    {
+        // the write may be committed in the next block
+        return;
+    }
+    if (m_configs.size() >= c_maxConfigs)
+    {
+        m_configs.clear();
+    }
+    m_configs[key] = _config;
+    m_writes.erase(key);
+}
+
+void ParallelConfigCache::invalidate(Address const& _contract, uint32_t _selector, int64_t _blockNumber)
+{
+    Key key(_contract, _selector);
+    WriteGuard l(x_configs);
+    m_configs.erase(key);
+    auto it = m_writes.find(key);
+    if (it == m_writes.end())
+    {
+        m_writes[key] = _blockNumber;
+    }
+    else
+    {
+        it->second = std::max(it->second, _blockNumber);
+    }
+}
+
+bool ParallelConfigCache::writtenSince(Key const& _key, int64_t _blockNumber) const
+{
+    auto it = m_writes.find(_key);
+    return it != m_writes.end() && it->second >= _blockNumber;
+}
 
 ParallelConfigPrecompiled::ParallelConfigPrecompiled()
 {
@@ -155,6 +212,10 @@ void ParallelConfigPrecompiled::registerParallelFunction(
         {
             table->update(PARA_KEY, entry, cond, make_shared<AccessOptions>(origin));
         }
+        if (m_cache)
+        {
+            m_cache->invalidate(contractAddress, selector, context->blockInfo().number);
+        }
 
         out = abi.abiIn("", u256(CODE_SUCCESS));
         PRECOMPILED_LOG(DEBUG) << LOG_BADGE("PARA") << LOG_DESC("registerParallelFunction success")
@@ -183,6 +244,10 @@ void ParallelConfigPrecompiled::unregisterParallelFunction(
         Condition::Ptr cond = table->newCondition();
         cond->EQ(PARA_SELECTOR, to_string(selector));
         table->remove(PARA_KEY, cond, make_shared<AccessOptions>(origin));
+        if (m_cache)
+        {
+            m_cache->invalidate(contractAddress, selector, context->blockInfo().number);
+        }
     }
     out = abi.abiIn("", u256(CODE_SUCCESS));
     PRECOMPILED_LOG(DEBUG) << LOG_BADGE("PARA") << LOG_DESC("unregisterParallelFunction success")
@@ -193,6 +258,25 @@ void ParallelConfigPrecompiled::unregisterParallelFunction(
 ParallelConfig::Ptr ParallelConfigPrecompiled::getParallelConfig(
     dev::blockverifier::ExecutiveContext::Ptr context, Address const& contractAddress,
     uint32_t selector, Address const& origin)
+{
+    if (!m_cache)
+    {
+        return readParallelConfig(context, contractAddress, selector, origin);
+    }
+    int64_t blockNumber = context->blockInfo().number;
+    ParallelConfig::Ptr config;
+    if (m_cache->get(contractAddress, selector, blockNumber, config))
+    {
+        return config;
+    }
+    config = readParallelConfig(context, contractAddress, selector, origin);
+    m_cache->set(contractAddress, selector, blockNumber, config);
+    return config;
+}
+
+ParallelConfig::Ptr ParallelConfigPrecompiled::readParallelConfig(
+    dev::blockverifier::ExecutiveContext::Ptr context, Address const& contractAddress,
+    uint32_t selector, Address const& origin)
 {
     Table::Ptr table = openTable(context, contractAddress, origin, false);
     if (!table || !table.get())
@@ -211,6 +295,26 @@ ParallelConfig::Ptr ParallelConfigPrecompiled::getParallelConfig(
         auto entry = entries->get(0);
         string funtionName = entry->getField(PARA_FUNC_NAME);
         u256 criticalSize = fromBigEndian<u256, string>(entry->getField(PARA_CRITICAL_SIZE));
-        return make_shared<ParallelConfig>(ParallelConfig{funtionName, criticalSize});
+
+        // the signature is parsed once for the transactions of the function
+        ABIFunc af;
+        if (!af.parser(funtionName))
+        {
+            PRECOMPILED_LOG(DEBUG) << LOG_BADGE("PARA")
+                                   << LOG_DESC("parser function signature failed")
+                                   << LOG_KV("func signature", funtionName);
+            return nullptr;
+        }
+        auto paramTypes = af.getParamsType();
+        if (paramTypes.size() < (size_t)criticalSize)
+        {
+            PRECOMPILED_LOG(DEBUG) << LOG_BADGE("PARA")
+                                   << LOG_DESC("params type less than criticalSize")
+                                   << LOG_KV("func signature", funtionName)
+                                   << LOG_KV("func criticalSize", criticalSize);
+            return nullptr;
+        }
+        paramTypes.resize((size_t)criticalSize);
+        return make_shared<ParallelConfig>(ParallelConfig{funtionName, criticalSize, paramTypes});
     }
 }
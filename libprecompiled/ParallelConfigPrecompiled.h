@@ -24,7 +24,9 @@
 #include <libethcore/ABI.h>
 
 #include <libdevcore/Common.h>
+#include <libdevcore/Guards.h>
 #include <libethcore/Common.h>
+#include <map>
 
 namespace dev
 {
@@ -40,6 +42,52 @@ struct ParallelConfig
     typedef std::shared_ptr<ParallelConfig> Ptr;
     std::string functionName;
     u256 criticalSize;
+    /// the types of the first criticalSize params of the function
+    std::vector<std::string> criticalTypes;
+};
+
+/**
+ * The parallel configs of the contracts shared by the contexts of a group. A config read from
+ * the state of block N is valid until a register or unregister of the function is executed, the
+ * configs written on the state of block N are cached again when they are read from the state of
+ * a block after N, the write has been committed or discarded by then.
+ */
+class ParallelConfigCache
+{
+public:
+    typedef std::shared_ptr<ParallelConfigCache> Ptr;
+    /// the configs of the selectors never registered are cached too
+    static const size_t c_maxConfigs = 100000;
+
+    /// @returns true if cached, _config is nullptr if the function is not parallel
+    bool get(Address const& _contract, uint32_t _selector, int64_t _blockNumber,
+        ParallelConfig::Ptr& _config);
+    void set(Address const& _contract, uint32_t _selector, int64_t _blockNumber,
+        ParallelConfig::Ptr _config);
+    /// the config is written on the state of the block
+    void invalidate(Address const& _contract, uint32_t _selector, int64_t _blockNumber);
+    /// drop all the configs, the chain state they are read from has been replaced
+    void clear()
+    {
+        WriteGuard l(x_configs);
+        m_configs.clear();
+        m_writes.clear();
+    }
+
+    size_t size() const
+    {
+        ReadGuard l(x_configs);
+        return m_configs.size();
+    }
+
+private:
+    typedef std::pair<Address, uint32_t> Key;
+    bool writtenSince(Key const& _key, int64_t _blockNumber) const;
+
+    std::map<Key, ParallelConfig::Ptr> m_configs;
+    /// the latest block on the state of which the config is written
+    std::map<Key, int64_t> m_writes;
+    mutable SharedMutex x_configs;
 };
 
 const std::string PARA_CONFIG_TABLE_PREFIX = "_contract_parafunc_";
@@ -59,14 +107,21 @@ public:
     dev::storage::Table::Ptr openTable(dev::blockverifier::ExecutiveContext::Ptr context,
         Address const& contractAddress, Address const& origin, bool needCreate = true);
 
+    void setParallelConfigCache(ParallelConfigCache::Ptr _cache) { m_cache = _cache; }
+
 private:
     void registerParallelFunction(dev::blockverifier::ExecutiveContext::Ptr context,
         bytesConstRef data, Address const& origin, bytes& out);
     void unregisterParallelFunction(dev::blockverifier::ExecutiveContext::Ptr context,
         bytesConstRef data, Address const& origin, bytes& out);
+    ParallelConfig::Ptr readParallelConfig(dev::blockverifier::ExecutiveContext::Ptr context,
+        Address const& contractAddress, uint32_t selector, Address const& origin);
+
+    ParallelConfigCache::Ptr m_cache;
 
 public:
-    /// get paralllel config, return nullptr if not found
+    /// get paralllel config, return nullptr if not found or the signature of the function is
+    /// invalid
     ParallelConfig::Ptr getParallelConfig(dev::blockverifier::ExecutiveContext::Ptr context,
         Address const& contractAddress, uint32_t selector, Address const& origin);
 };
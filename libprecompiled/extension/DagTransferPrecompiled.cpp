@@ -41,11 +41,11 @@ contract DagTransfer{
 }
 */
 const std::string DAG_TRANSFER = "_dag_transfer_";
-const char* const DAG_TRANSFER_METHOD_ADD_STR_UINT = "userAdd(string,uint256)";
-const char* const DAG_TRANSFER_METHOD_SAV_STR_UINT = "userSave(string,uint256)";
-const char* const DAG_TRANSFER_METHOD_DRAW_STR_UINT = "userDraw(string,uint256)";
-const char* const DAG_TRANSFER_METHOD_TRS_STR2_UINT = "userTransfer(string,string,uint256)";
-const char* const DAG_TRANSFER_METHOD_BAL_STR = "userBalance(string)";
+const std::string DAG_TRANSFER_METHOD_ADD_STR_UINT = "userAdd(string,uint256)";
+const std::string DAG_TRANSFER_METHOD_SAV_STR_UINT = "userSave(string,uint256)";
+const std::string DAG_TRANSFER_METHOD_DRAW_STR_UINT = "userDraw(string,uint256)";
+const std::string DAG_TRANSFER_METHOD_TRS_STR2_UINT = "userTransfer(string,string,uint256)";
+const std::string DAG_TRANSFER_METHOD_BAL_STR = "userBalance(string)";
 
 // fields of table '_dag_transfer_'
 const std::string DAG_TRANSFER_FIELD_NAME = "user_name";
@@ -79,52 +79,30 @@ std::vector<std::string> DagTransferPrecompiled::getParallelTag(bytesConstRef pa
     std::vector<std::string> results;
     dev::eth::ContractABI abi;
     // user_name user_balance 2 fields in table, the key of table is user_name field
-    if (func == name2Selector[DAG_TRANSFER_METHOD_ADD_STR_UINT])
-    {  // userAdd(string,uint256)
-        std::string user;
-        dev::u256 amount;
-        abi.abiOut(data, user, amount);
-        // if params is invalid , parallel process can be done
-        if (!invalidUserName(user))
-        {
-            results.push_back(user);
-        }
-    }
-    else if (func == name2Selector[DAG_TRANSFER_METHOD_SAV_STR_UINT])
-    {  // userSave(string,uint256)
-        std::string user;
-        dev::u256 amount;
-
-        abi.abiOut(data, user, amount);
+    // only the leading user names are decoded, as views of the param
+    if (func == name2Selector[DAG_TRANSFER_METHOD_ADD_STR_UINT] ||
+        func == name2Selector[DAG_TRANSFER_METHOD_SAV_STR_UINT] ||
+        func == name2Selector[DAG_TRANSFER_METHOD_DRAW_STR_UINT])
+    {  // userAdd(string,uint256), userSave(string,uint256), userDraw(string,uint256)
+        bytesConstRef userRef;
+        abi.abiOut(data, userRef);
+        std::string user = userRef.toString();
         // if params is invalid , parallel process can be done
         if (!invalidUserName(user))
         {
-            results.push_back(user);
-        }
-    }
-    else if (func == name2Selector[DAG_TRANSFER_METHOD_DRAW_STR_UINT])
-    {  // userDraw(string,uint256)
-        std::string user;
-        dev::u256 amount;
-
-        abi.abiOut(data, user, amount);
-        // if params is invalid , parallel process can be done
-        if (!invalidUserName(user))
-        {
-            results.push_back(user);
+            results.push_back(std::move(user));
         }
     }
     else if (func == name2Selector[DAG_TRANSFER_METHOD_TRS_STR2_UINT])
     {  // userTransfer(string,string,uint256)
-        std::string fromUser, toUser;
-        dev::u256 amount;
-
-        abi.abiOut(data, fromUser, toUser, amount);
+        bytesConstRef fromRef, toRef;
+        abi.abiOut(data, fromRef, toRef);
+        std::string fromUser = fromRef.toString(), toUser = toRef.toString();
         // if params is invalid , parallel process can be done
         if (!invalidUserName(fromUser) && !invalidUserName(toUser))
         {
-            results.push_back(fromUser);
-            results.push_back(toUser);
+            results.push_back(std::move(fromUser));
+            results.push_back(std::move(toUser));
         }
     }
     else if (func == name2Selector[DAG_TRANSFER_METHOD_BAL_STR])
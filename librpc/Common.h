@@ -34,6 +34,8 @@ namespace rpc
 enum RPCExceptionType : int
 {
     Success = 0,
+    LogFilter = -40011,
+    MerkleProof = -40010,
     InvalidRequest = -40009,
     InvalidSystemConfig = -40008,
     NoView = -40007,
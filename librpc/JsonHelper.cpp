@@ -23,6 +23,7 @@
 #include <jsonrpccpp/common/exception.h>
 #include <libdevcore/easylog.h>
 #include <libethcore/CommonJS.h>
+#include <libethcore/Exceptions.h>
 #include <libethcore/Transaction.h>
 
 using namespace std;
@@ -92,6 +93,77 @@ TransactionSkeleton toTransactionSkeleton(Json::Value const& _json)
     return ret;
 }
 
+Json::Value toJson(LocalisedLogEntry const& _log)
+{
+    Json::Value res;
+    res["address"] = toJS(_log.address);
+    res["topics"] = Json::Value(Json::arrayValue);
+    for (auto const& topic : _log.topics)
+        res["topics"].append(toJS(topic));
+    res["data"] = toJS(_log.data);
+    res["blockNumber"] = toJS(_log.blockNumber);
+    res["blockHash"] = toJS(_log.blockHash);
+    res["transactionHash"] = toJS(_log.transactionHash);
+    res["transactionIndex"] = toJS(_log.transactionIndex);
+    res["logIndex"] = toJS(_log.logIndex);
+    return res;
+}
+
+static BlockNumber toBlockNumber(Json::Value const& _json, BlockNumber _latest)
+{
+    if (_json.isNull() || _json.asString() == "latest")
+        return _latest;
+    if (_json.asString() == "earliest")
+        return 0;
+    return jsToInt(_json.asString());
+}
+
+static h256 toTopic(Json::Value const& _json)
+{
+    if (!_json.isString() || _json.asString().size() != 66)
+        BOOST_THROW_EXCEPTION(InvalidLogFilter() << errinfo_comment("invalid topic"));
+    return jsToFixed<32>(_json.asString());
+}
+
+LogFilter toLogFilter(Json::Value const& _json, BlockNumber _latest)
+{
+    if (!_json.isObject())
+        BOOST_THROW_EXCEPTION(InvalidLogFilter() << errinfo_comment("the filter is not an object"));
+    LogFilter filter(toBlockNumber(_json["fromBlock"], _latest),
+        toBlockNumber(_json["toBlock"], _latest));
+
+    Json::Value addresses = _json["address"];
+    if (addresses.isString())
+    {
+        addresses = Json::Value(Json::arrayValue);
+        addresses.append(_json["address"]);
+    }
+    for (auto const& address : addresses)
+    {
+        if (!address.isString() || address.asString().size() != 42)
+            BOOST_THROW_EXCEPTION(InvalidLogFilter() << errinfo_comment("invalid address"));
+        filter.addAddress(jsToAddress(address.asString()));
+    }
+
+    Json::Value const& topics = _json["topics"];
+    if (!topics.isNull() && (!topics.isArray() || topics.size() > LogFilter::c_maxTopics))
+        BOOST_THROW_EXCEPTION(InvalidLogFilter() << errinfo_comment("invalid topics"));
+    for (Json::ArrayIndex i = 0; i < topics.size(); ++i)
+    {
+        /// null matches any topic of the position, an array matches one of its topics
+        if (topics[i].isArray())
+        {
+            for (auto const& topic : topics[i])
+                filter.addTopic(i, toTopic(topic));
+        }
+        else if (!topics[i].isNull())
+        {
+            filter.addTopic(i, toTopic(topics[i]));
+        }
+    }
+    return filter;
+}
+
 }  // namespace rpc
 
 }  // namespace dev
@@ -22,6 +22,7 @@
 
 #include <json/json.h>
 #include <libethcore/Common.h>
+#include <libethcore/LogFilter.h>
 
 namespace dev
 {
@@ -30,6 +31,10 @@ namespace rpc
 Json::Value toJson(dev::eth::Transaction const& _t, std::pair<h256, unsigned> _location,
     dev::eth::BlockNumber _blockNumber);
 dev::eth::TransactionSkeleton toTransactionSkeleton(Json::Value const& _json);
+Json::Value toJson(dev::eth::LocalisedLogEntry const& _log);
+/// parse {"fromBlock", "toBlock", "address", "topics"}, the block numbers default to _latest
+/// @throws InvalidLogFilter if a field is malformed
+dev::eth::LogFilter toLogFilter(Json::Value const& _json, dev::eth::BlockNumber _latest);
 
 }  // namespace rpc
 
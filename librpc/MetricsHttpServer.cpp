@@ -0,0 +1,92 @@
+/**
+ * @CopyRight:
+ * FISCO-BCOS is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * FISCO-BCOS is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with FISCO-BCOS.  If not, see <http://www.gnu.org/licenses/>
+ * (c) 2016-2018 fisco-dev contributors.
+ *
+ * @file MetricsHttpServer.cpp
+ * @brief serve the metrics registry in the Prometheus text format on GET /metrics
+ */
+
+#include "MetricsHttpServer.h"
+#include <arpa/inet.h>
+#include <libdevcore/Metrics.h>
+#include <netinet/in.h>
+#include <cstring>
+
+using namespace std;
+using namespace dev;
+
+bool MetricsHttpServer::StartListening()
+{
+    if (m_daemon)
+    {
+        return true;
+    }
+    struct sockaddr_in sock;
+    memset(&sock, 0, sizeof(sock));
+    sock.sin_family = AF_INET;
+    sock.sin_port = htons(m_port);
+    sock.sin_addr.s_addr = inet_addr(m_address.c_str());
+    // a scrape every few seconds is served by the internal select thread
+    m_daemon = MHD_start_daemon(MHD_USE_SELECT_INTERNALLY, m_port, NULL, NULL,
+        MetricsHttpServer::callback, this, MHD_OPTION_SOCK_ADDR, &sock, MHD_OPTION_END);
+    return m_daemon != NULL;
+}
+
+bool MetricsHttpServer::StopListening()
+{
+    if (m_daemon)
+    {
+        MHD_stop_daemon(m_daemon);
+        m_daemon = nullptr;
+    }
+    return true;
+}
+
+int MetricsHttpServer::callback(void*, MHD_Connection* connection, const char* url,
+    const char* method, const char*, const char*, size_t*, void** con_cls)
+{
+    // the first call only carries the headers
+    static int s_headersReceived;
+    if (*con_cls == NULL)
+    {
+        *con_cls = &s_headersReceived;
+        return MHD_YES;
+    }
+
+    int code = MHD_HTTP_OK;
+    string body;
+    string contentType = "text/plain; version=0.0.4";
+    if (string("GET") != method)
+    {
+        code = MHD_HTTP_METHOD_NOT_ALLOWED;
+        body = "Only GET is allowed\n";
+    }
+    else if (string("/metrics") != url)
+    {
+        code = MHD_HTTP_NOT_FOUND;
+        body = "Metrics are served on /metrics\n";
+    }
+    else
+    {
+        body = dev::metrics::MetricsRegistry::instance().prometheusText();
+    }
+
+    struct MHD_Response* response = MHD_create_response_from_buffer(
+        body.size(), static_cast<void*>(const_cast<char*>(body.c_str())), MHD_RESPMEM_MUST_COPY);
+    MHD_add_response_header(response, "Content-Type", contentType.c_str());
+    int ret = MHD_queue_response(connection, code, response);
+    MHD_destroy_response(response);
+    return ret;
+}
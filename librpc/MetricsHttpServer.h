@@ -0,0 +1,51 @@
+/**
+ * @CopyRight:
+ * FISCO-BCOS is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * FISCO-BCOS is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with FISCO-BCOS.  If not, see <http://www.gnu.org/licenses/>
+ * (c) 2016-2018 fisco-dev contributors.
+ *
+ * @file MetricsHttpServer.h
+ * @brief serve the metrics registry in the Prometheus text format on GET /metrics
+ */
+#pragma once
+
+#include <microhttpd.h>
+#include <memory>
+#include <string>
+
+namespace dev
+{
+class MetricsHttpServer
+{
+public:
+    typedef std::shared_ptr<MetricsHttpServer> Ptr;
+
+    MetricsHttpServer(std::string const& _address, int _port)
+      : m_address(_address), m_port(_port)
+    {}
+    virtual ~MetricsHttpServer() { StopListening(); }
+
+    bool StartListening();
+    bool StopListening();
+
+private:
+    static int callback(void* cls, struct MHD_Connection* connection, const char* url,
+        const char* method, const char* version, const char* upload_data, size_t* upload_data_size,
+        void** con_cls);
+
+    std::string m_address;
+    int m_port;
+    struct MHD_Daemon* m_daemon = nullptr;
+};
+
+}  // namespace dev
@@ -27,9 +27,13 @@
 #include <jsonrpccpp/server.h>
 #include <libconfig/GlobalConfigure.h>
 #include <libdevcore/CommonData.h>
+#include <libdevcore/Metrics.h>
+#include <libdevcore/Tracer.h>
 #include <libdevcore/easylog.h>
 #include <libethcore/Common.h>
 #include <libethcore/CommonJS.h>
+#include <libethcore/Exceptions.h>
+#include <libethcore/MerkleTree.h>
 #include <libethcore/Transaction.h>
 #include <libexecutive/ExecutionResult.h>
 #include <libsync/SyncStatus.h>
@@ -44,6 +48,8 @@ using namespace dev::ledger;
 
 static const int64_t maxTransactionGasLimit = 0x7fffffffffffffff;
 static const int64_t gasPrice = 1;
+/// the max blocks of the range of a log filter
+static const int64_t maxLogBlockRange = 10000;
 
 std::map<int, std::string> dev::rpc::RPCMsg{{RPCExceptionType::Success, "Success"},
     {RPCExceptionType::GroupID, "GroupID does not exist"},
@@ -55,7 +61,11 @@ std::map<int, std::string> dev::rpc::RPCMsg{{RPCExceptionType::Success, "Success
     {RPCExceptionType::NoView, "Only pbft consensus supports the view property"},
     {RPCExceptionType::InvalidSystemConfig, "Invalid System Config"},
     {RPCExceptionType::InvalidRequest,
-        "Don't send request to this node who doesn't belong to the group"}};
+        "Don't send request to this node who doesn't belong to the group"},
+    {RPCExceptionType::MerkleProof,
+        "Merkle proof is only supported by the blocks of supported_version 2.1.0 or above"},
+    {RPCExceptionType::LogFilter,
+        "Invalid log filter or the block range of the filter exceeds 10000 blocks"}};
 
 Rpc::Rpc(std::shared_ptr<dev::ledger::LedgerManager> _ledgerManager,
     std::shared_ptr<dev::p2p::P2PInterface> _service)
@@ -278,6 +288,27 @@ Json::Value Rpc::getConsensusStatus(int _groupID)
     }
 }
 
+Json::Value Rpc::getConflictPredictions(int _groupID)
+{
+    try
+    {
+        RPC_LOG(INFO) << LOG_BADGE("getConflictPredictions") << LOG_DESC("request")
+                      << LOG_KV("groupID", _groupID);
+
+        checkRequest(_groupID);
+        return ledgerManager()->blockVerifier(_groupID)->conflictPredictions();
+    }
+    catch (JsonRpcException& e)
+    {
+        throw e;
+    }
+    catch (std::exception& e)
+    {
+        BOOST_THROW_EXCEPTION(
+            JsonRpcException(Errors::ERROR_RPC_INTERNAL_ERROR, boost::diagnostic_information(e)));
+    }
+}
+
 Json::Value Rpc::getSyncStatus(int _groupID)
 {
     try
@@ -340,6 +371,113 @@ Json::Value Rpc::getClientVersion()
     return Json::Value();
 }
 
+Json::Value Rpc::getMetrics()
+{
+    try
+    {
+        RPC_LOG(INFO) << LOG_BADGE("getMetrics") << LOG_DESC("request");
+        Json::Value response(Json::arrayValue);
+        for (auto const& metric : dev::metrics::MetricsRegistry::instance().snapshot())
+        {
+            Json::Value metricObj;
+            metricObj["name"] = metric.name;
+            Json::Value labels(Json::objectValue);
+            for (auto const& label : metric.labels)
+            {
+                labels[label.first] = label.second;
+            }
+            metricObj["labels"] = labels;
+            switch (metric.type)
+            {
+            case dev::metrics::MetricType::Counter:
+                metricObj["type"] = "counter";
+                metricObj["value"] = Json::Int64(metric.value);
+                break;
+            case dev::metrics::MetricType::Gauge:
+                metricObj["type"] = "gauge";
+                metricObj["value"] = Json::Int64(metric.value);
+                break;
+            case dev::metrics::MetricType::Histogram:
+                metricObj["type"] = "histogram";
+                metricObj["count"] = Json::UInt64(metric.histogram.count);
+                metricObj["sum"] = Json::UInt64(metric.histogram.sum);
+                metricObj["p50"] = Json::UInt64(metric.histogram.quantile(0.5));
+                metricObj["p90"] = Json::UInt64(metric.histogram.quantile(0.9));
+                metricObj["p99"] = Json::UInt64(metric.histogram.quantile(0.99));
+                break;
+            }
+            response.append(metricObj);
+        }
+        return response;
+    }
+    catch (JsonRpcException& e)
+    {
+        throw e;
+    }
+    catch (std::exception& e)
+    {
+        BOOST_THROW_EXCEPTION(
+            JsonRpcException(Errors::ERROR_RPC_INTERNAL_ERROR, boost::diagnostic_information(e)));
+    }
+
+    return Json::Value();
+}
+
+Json::Value Rpc::getBlockTraces(int _groupID, int _blockCount)
+{
+    try
+    {
+        RPC_LOG(INFO) << LOG_BADGE("getBlockTraces") << LOG_DESC("request")
+                      << LOG_KV("groupID", _groupID) << LOG_KV("blockCount", _blockCount);
+
+        checkRequest(_groupID);
+        auto& tracer = dev::trace::Tracer::instance();
+        Json::Value events(Json::arrayValue);
+        // complete events, pid is the group and tid the tracing thread
+        for (auto const& blockTrace : tracer.traces(_groupID, std::max(_blockCount, 0)))
+        {
+            for (auto const& span : blockTrace.spans)
+            {
+                Json::Value event;
+                event["name"] = span.name;
+                event["cat"] = span.category;
+                event["ph"] = "X";
+                event["ts"] = Json::UInt64(span.startUs);
+                event["dur"] = Json::UInt64(span.durationUs);
+                event["pid"] = _groupID;
+                event["tid"] = Json::UInt64(span.threadId);
+                event["args"]["number"] = Json::Int64(blockTrace.number);
+                events.append(event);
+            }
+        }
+        for (auto const& thread : tracer.threadNames())
+        {
+            Json::Value event;
+            event["name"] = "thread_name";
+            event["ph"] = "M";
+            event["pid"] = _groupID;
+            event["tid"] = Json::UInt64(thread.first);
+            event["args"]["name"] = thread.second;
+            events.append(event);
+        }
+        Json::Value response;
+        response["traceEvents"] = events;
+        response["enabled"] = tracer.enabled();
+        return response;
+    }
+    catch (JsonRpcException& e)
+    {
+        throw e;
+    }
+    catch (std::exception& e)
+    {
+        BOOST_THROW_EXCEPTION(
+            JsonRpcException(Errors::ERROR_RPC_INTERNAL_ERROR, boost::diagnostic_information(e)));
+    }
+
+    return Json::Value();
+}
+
 Json::Value Rpc::getPeers(int _groupID)
 {
     try
@@ -361,6 +499,18 @@ Json::Value Rpc::getPeers(int _groupID)
 
             for (std::string topic : it->topics)
                 node["Topic"].append(topic);
+            /// the packets queued to the peer by priority
+            node["WriteQueue"] = Json::Value(Json::arrayValue);
+            for (size_t i = 0; i < dev::network::PriorityCount; ++i)
+            {
+                Json::Value queue;
+                queue["Priority"] =
+                    dev::network::priorityName(dev::network::PacketPriority(i));
+                queue["Packets"] = Json::UInt64(it->writeQueue.packets[i]);
+                queue["Bytes"] = Json::UInt64(it->writeQueue.bytes[i]);
+                queue["Dropped"] = Json::UInt64(it->writeQueue.dropped[i]);
+                node["WriteQueue"].append(queue);
+            }
             response.append(node);
         }
 
@@ -664,6 +814,73 @@ Json::Value Rpc::getTransactionByHash(int _groupID, const std::string& _transact
 }
 
 
+namespace
+{
+Json::Value merkleProofToJson(dev::eth::MerkleProof const& _proof)
+{
+    Json::Value proof(Json::arrayValue);
+    for (auto const& node : _proof)
+    {
+        Json::Value nodeJson;
+        nodeJson["sibling"] = toJS(node.sibling);
+        nodeJson["siblingIsLeft"] = node.siblingIsLeft;
+        proof.append(nodeJson);
+    }
+    return proof;
+}
+
+/// @returns the proof of the leaf, the root of the tree must be the given root of the block
+dev::eth::MerkleProof merkleProof(std::vector<dev::h256> _leaves, size_t _index,
+    dev::h256 const& _root, dev::h256 const& _leaf)
+{
+    if (dev::g_BCOSConfig.version() < dev::V2_1_0 || _index >= _leaves.size() ||
+        _leaves[_index] != _leaf)
+        BOOST_THROW_EXCEPTION(
+            JsonRpcException(RPCExceptionType::MerkleProof, RPCMsg[RPCExceptionType::MerkleProof]));
+    dev::eth::MerkleTree tree(std::move(_leaves));
+    if (tree.root() != _root)
+        BOOST_THROW_EXCEPTION(
+            JsonRpcException(RPCExceptionType::MerkleProof, RPCMsg[RPCExceptionType::MerkleProof]));
+    return tree.proof(_index);
+}
+}  // namespace
+
+Json::Value Rpc::getTransactionByHashWithProof(int _groupID, const std::string& _transactionHash)
+{
+    try
+    {
+        RPC_LOG(INFO) << LOG_BADGE("getTransactionByHashWithProof") << LOG_DESC("request")
+                      << LOG_KV("groupID", _groupID) << LOG_KV("transactionHash", _transactionHash);
+
+        Json::Value transaction = getTransactionByHash(_groupID, _transactionHash);
+        if (transaction.isNull())
+            return Json::nullValue;
+
+        auto blockchain = ledgerManager()->blockChain(_groupID);
+        auto block = blockchain->getBlockByNumber(jsToInt(transaction["blockNumber"].asString()));
+        if (!block)
+            BOOST_THROW_EXCEPTION(JsonRpcException(
+                RPCExceptionType::BlockNumberT, RPCMsg[RPCExceptionType::BlockNumberT]));
+
+        Json::Value response;
+        response["transaction"] = transaction;
+        response["txProof"] = merkleProofToJson(merkleProof(block->transactionHashes(),
+            jsToInt(transaction["transactionIndex"].asString()),
+            block->header().transactionsRoot(), jsToFixed<32>(_transactionHash)));
+        return response;
+    }
+    catch (JsonRpcException& e)
+    {
+        throw e;
+    }
+    catch (std::exception& e)
+    {
+        BOOST_THROW_EXCEPTION(
+            JsonRpcException(Errors::ERROR_RPC_INTERNAL_ERROR, boost::diagnostic_information(e)));
+    }
+}
+
+
 Json::Value Rpc::getTransactionByBlockHashAndIndex(
     int _groupID, const std::string& _blockHash, const std::string& _transactionIndex)
 {
@@ -824,6 +1041,88 @@ Json::Value Rpc::getTransactionReceipt(int _groupID, const std::string& _transac
 }
 
 
+Json::Value Rpc::getTransactionReceiptByHashWithProof(
+    int _groupID, const std::string& _transactionHash)
+{
+    try
+    {
+        RPC_LOG(INFO) << LOG_BADGE("getTransactionReceiptByHashWithProof") << LOG_DESC("request")
+                      << LOG_KV("groupID", _groupID) << LOG_KV("transactionHash", _transactionHash);
+
+        Json::Value receipt = getTransactionReceipt(_groupID, _transactionHash);
+        if (receipt.isNull())
+            return Json::nullValue;
+
+        auto blockchain = ledgerManager()->blockChain(_groupID);
+        auto block = blockchain->getBlockByNumber(jsToInt(receipt["blockNumber"].asString()));
+        if (!block)
+            BOOST_THROW_EXCEPTION(JsonRpcException(
+                RPCExceptionType::BlockNumberT, RPCMsg[RPCExceptionType::BlockNumberT]));
+
+        size_t index = jsToInt(receipt["transactionIndex"].asString());
+        auto const& receipts = block->transactionReceipts();
+        if (index >= receipts.size())
+            BOOST_THROW_EXCEPTION(JsonRpcException(
+                RPCExceptionType::TransactionIndex, RPCMsg[RPCExceptionType::TransactionIndex]));
+
+        Json::Value response;
+        response["transactionReceipt"] = receipt;
+        /// the proof is of the hash of the encoded receipt, it is returned for the verification
+        response["receiptRlp"] = toJS(receipts[index].rlp());
+        response["receiptProof"] = merkleProofToJson(merkleProof(block->receiptHashes(), index,
+            block->header().receiptsRoot(), dev::sha3(receipts[index].rlp())));
+        return response;
+    }
+    catch (JsonRpcException& e)
+    {
+        throw e;
+    }
+    catch (std::exception& e)
+    {
+        BOOST_THROW_EXCEPTION(
+            JsonRpcException(Errors::ERROR_RPC_INTERNAL_ERROR, boost::diagnostic_information(e)));
+    }
+}
+
+Json::Value Rpc::getLogs(int _groupID, const Json::Value& _filter)
+{
+    try
+    {
+        RPC_LOG(INFO) << LOG_BADGE("getLogs") << LOG_DESC("request") << LOG_KV("groupID", _groupID);
+
+        checkRequest(_groupID);
+        auto blockchain = ledgerManager()->blockChain(_groupID);
+        dev::eth::LogFilter filter;
+        try
+        {
+            filter = toLogFilter(_filter, blockchain->number());
+        }
+        catch (dev::eth::InvalidLogFilter const&)
+        {
+            BOOST_THROW_EXCEPTION(JsonRpcException(
+                RPCExceptionType::LogFilter, RPCMsg[RPCExceptionType::LogFilter]));
+        }
+        if (filter.toBlock() - filter.fromBlock() >= maxLogBlockRange)
+            BOOST_THROW_EXCEPTION(JsonRpcException(
+                RPCExceptionType::LogFilter, RPCMsg[RPCExceptionType::LogFilter]));
+
+        Json::Value response = Json::Value(Json::arrayValue);
+        for (auto const& log : blockchain->getLogs(filter))
+            response.append(toJson(log));
+        return response;
+    }
+    catch (JsonRpcException& e)
+    {
+        throw e;
+    }
+    catch (std::exception& e)
+    {
+        BOOST_THROW_EXCEPTION(
+            JsonRpcException(Errors::ERROR_RPC_INTERNAL_ERROR, boost::diagnostic_information(e)));
+    }
+}
+
+
 Json::Value Rpc::getPendingTransactions(int _groupID)
 {
     try
@@ -62,9 +62,12 @@ public:
 
     // sync part
     Json::Value getSyncStatus(int _groupID) override;
+    Json::Value getConflictPredictions(int _groupID) override;
 
     // p2p part
     Json::Value getClientVersion() override;
+    Json::Value getMetrics() override;
+    Json::Value getBlockTraces(int _groupID, int _blockCount) override;
     Json::Value getPeers(int _groupID) override;
     Json::Value getGroupPeers(int _groupID) override;
     Json::Value getGroupList() override;
@@ -84,6 +87,11 @@ public:
     Json::Value getTransactionByBlockNumberAndIndex(int _groupID, const std::string& _blockNumber,
         const std::string& _transactionIndex) override;
     Json::Value getTransactionReceipt(int _groupID, const std::string& _transactionHash) override;
+    Json::Value getTransactionByHashWithProof(
+        int _groupID, const std::string& _transactionHash) override;
+    Json::Value getTransactionReceiptByHashWithProof(
+        int _groupID, const std::string& _transactionHash) override;
+    Json::Value getLogs(int _groupID, const Json::Value& _filter) override;
     Json::Value getPendingTransactions(int _groupID) override;
     std::string getPendingTxSize(int _groupID) override;
     std::string getCode(int _groupID, const std::string& address) override;
@@ -57,10 +57,21 @@ public:
         this->bindAndAddMethod(jsonrpc::Procedure("getSyncStatus", jsonrpc::PARAMS_BY_POSITION,
                                    jsonrpc::JSON_OBJECT, "param1", jsonrpc::JSON_INTEGER, NULL),
             &dev::rpc::RpcFace::getSyncStatusI);
+        this->bindAndAddMethod(jsonrpc::Procedure("getConflictPredictions",
+                                   jsonrpc::PARAMS_BY_POSITION, jsonrpc::JSON_OBJECT, "param1",
+                                   jsonrpc::JSON_INTEGER, NULL),
+            &dev::rpc::RpcFace::getConflictPredictionsI);
 
         this->bindAndAddMethod(jsonrpc::Procedure("getClientVersion", jsonrpc::PARAMS_BY_POSITION,
                                    jsonrpc::JSON_OBJECT, NULL),
             &dev::rpc::RpcFace::getClientVersionI);
+        this->bindAndAddMethod(jsonrpc::Procedure("getMetrics", jsonrpc::PARAMS_BY_POSITION,
+                                   jsonrpc::JSON_OBJECT, NULL),
+            &dev::rpc::RpcFace::getMetricsI);
+        this->bindAndAddMethod(jsonrpc::Procedure("getBlockTraces", jsonrpc::PARAMS_BY_POSITION,
+                                   jsonrpc::JSON_OBJECT, "param1", jsonrpc::JSON_INTEGER,
+                                   "param2", jsonrpc::JSON_INTEGER, NULL),
+            &dev::rpc::RpcFace::getBlockTracesI);
         this->bindAndAddMethod(jsonrpc::Procedure("getPeers", jsonrpc::PARAMS_BY_POSITION,
                                    jsonrpc::JSON_OBJECT, "param1", jsonrpc::JSON_INTEGER, NULL),
             &dev::rpc::RpcFace::getPeersI);
@@ -105,6 +116,18 @@ public:
                                    jsonrpc::PARAMS_BY_POSITION, jsonrpc::JSON_OBJECT, "param1",
                                    jsonrpc::JSON_INTEGER, "param2", jsonrpc::JSON_STRING, NULL),
             &dev::rpc::RpcFace::getTransactionReceiptI);
+        this->bindAndAddMethod(jsonrpc::Procedure("getTransactionByHashWithProof",
+                                   jsonrpc::PARAMS_BY_POSITION, jsonrpc::JSON_OBJECT, "param1",
+                                   jsonrpc::JSON_INTEGER, "param2", jsonrpc::JSON_STRING, NULL),
+            &dev::rpc::RpcFace::getTransactionByHashWithProofI);
+        this->bindAndAddMethod(jsonrpc::Procedure("getTransactionReceiptByHashWithProof",
+                                   jsonrpc::PARAMS_BY_POSITION, jsonrpc::JSON_OBJECT, "param1",
+                                   jsonrpc::JSON_INTEGER, "param2", jsonrpc::JSON_STRING, NULL),
+            &dev::rpc::RpcFace::getTransactionReceiptByHashWithProofI);
+        this->bindAndAddMethod(jsonrpc::Procedure("getLogs", jsonrpc::PARAMS_BY_POSITION,
+                                   jsonrpc::JSON_ARRAY, "param1", jsonrpc::JSON_INTEGER, "param2",
+                                   jsonrpc::JSON_OBJECT, NULL),
+            &dev::rpc::RpcFace::getLogsI);
         this->bindAndAddMethod(
             jsonrpc::Procedure("getPendingTransactions", jsonrpc::PARAMS_BY_POSITION,
                 jsonrpc::JSON_OBJECT, "param1", jsonrpc::JSON_INTEGER, NULL),
@@ -162,11 +185,25 @@ public:
     {
         response = this->getSyncStatus(boost::lexical_cast<int>(request[0u].asString()));
     }
+    inline virtual void getConflictPredictionsI(const Json::Value& request, Json::Value& response)
+    {
+        response =
+            this->getConflictPredictions(boost::lexical_cast<int>(request[0u].asString()));
+    }
 
     inline virtual void getClientVersionI(const Json::Value&, Json::Value& response)
     {
         response = this->getClientVersion();
     }
+    inline virtual void getMetricsI(const Json::Value&, Json::Value& response)
+    {
+        response = this->getMetrics();
+    }
+    inline virtual void getBlockTracesI(const Json::Value& request, Json::Value& response)
+    {
+        response = this->getBlockTraces(boost::lexical_cast<int>(request[0u].asString()),
+            boost::lexical_cast<int>(request[1u].asString()));
+    }
     inline virtual void getPeersI(const Json::Value& request, Json::Value& response)
     {
         response = this->getPeers(boost::lexical_cast<int>(request[0u].asString()));
@@ -224,6 +261,22 @@ public:
         response = this->getTransactionReceipt(
             boost::lexical_cast<int>(request[0u].asString()), request[1u].asString());
     }
+    inline virtual void getTransactionByHashWithProofI(
+        const Json::Value& request, Json::Value& response)
+    {
+        response = this->getTransactionByHashWithProof(
+            boost::lexical_cast<int>(request[0u].asString()), request[1u].asString());
+    }
+    inline virtual void getTransactionReceiptByHashWithProofI(
+        const Json::Value& request, Json::Value& response)
+    {
+        response = this->getTransactionReceiptByHashWithProof(
+            boost::lexical_cast<int>(request[0u].asString()), request[1u].asString());
+    }
+    inline virtual void getLogsI(const Json::Value& request, Json::Value& response)
+    {
+        response = this->getLogs(boost::lexical_cast<int>(request[0u].asString()), request[1u]);
+    }
     inline virtual void getPendingTransactionsI(const Json::Value& request, Json::Value& response)
     {
         response = this->getPendingTransactions(boost::lexical_cast<int>(request[0u].asString()));
@@ -263,9 +316,15 @@ public:
 
     // sync part
     virtual Json::Value getSyncStatus(int param1) = 0;
+    /// @return the predicted conflicts of the functions and the parallelism of the latest block
+    virtual Json::Value getConflictPredictions(int param1) = 0;
 
     // p2p part
     virtual Json::Value getClientVersion() = 0;
+    /// @return the counters, gauges and latency histograms of the node
+    virtual Json::Value getMetrics() = 0;
+    /// @return the spans of the latest param2 blocks in the Chrome trace_event format
+    virtual Json::Value getBlockTraces(int param1, int param2) = 0;
     virtual Json::Value getPeers(int param1) = 0;
     virtual Json::Value getGroupPeers(int param1) = 0;
     virtual Json::Value getGroupList() = 0;
@@ -288,6 +347,13 @@ public:
     /// @return the receipt of a transaction by transaction hash.
     /// @note That the receipt is not available for pending transactions.
     virtual Json::Value getTransactionReceipt(int param1, const std::string& param2) = 0;
+    /// @return the transaction and the Merkle proof of its hash to the transaction root
+    virtual Json::Value getTransactionByHashWithProof(int param1, const std::string& param2) = 0;
+    /// @return the receipt, its RLP and the Merkle proof of its hash to the receipt root
+    virtual Json::Value getTransactionReceiptByHashWithProof(
+        int param1, const std::string& param2) = 0;
+    /// @return the logs of the committed blocks matching the filter, found by the log index
+    virtual Json::Value getLogs(int param1, const Json::Value& param2) = 0;
     /// @return information about PendingTransactions.
     virtual Json::Value getPendingTransactions(int param1) = 0;
     /// @return size about PendingTransactions.
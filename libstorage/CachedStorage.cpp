@@ -23,6 +23,7 @@
 #include "StorageException.h"
 #include <libdevcore/Common.h>
 #include <libdevcore/FixedHash.h>
+#include <libdevcore/Tracer.h>
 #include <libdevcore/easylog.h>
 #include <tbb/concurrent_unordered_set.h>
 #include <tbb/concurrent_vector.h>
@@ -113,6 +114,7 @@ CachedStorage::CachedStorage()
     m_syncNum.store(0);
     m_commitNum.store(0);
     m_capacity.store(0);
+    m_maxCapacity.store(256 * 1024 * 1024);
 
     m_hitTimes.store(0);
     m_queryTimes.store(0);
@@ -534,6 +536,21 @@ void CachedStorage::setBackend(Storage::Ptr backend)
 }
 
 void CachedStorage::init()
+{
+    // get id from backend
+    auto id = selectCurrentState(SYS_KEY_CURRENT_ID);
+    if (!id.empty())
+    {
+        m_ID = boost::lexical_cast<size_t>(id);
+    }
+
+    if (!disabled())
+    {
+        startClearThread();
+    }
+}
+
+std::string CachedStorage::selectCurrentState(const std::string& _key)
 {
     auto tableInfo = std::make_shared<storage::TableInfo>();
     tableInfo->name = SYS_CURRENT_STATE;
@@ -541,20 +558,107 @@ void CachedStorage::init()
     tableInfo->fields = std::vector<std::string>{"value"};
 
     auto condition = std::make_shared<Condition>();
-    condition->EQ(SYS_KEY, SYS_KEY_CURRENT_ID);
+    condition->EQ(SYS_KEY, _key);
 
-    // get id from backend
-    auto out = m_backend->select(h256(), 0, tableInfo, SYS_KEY_CURRENT_ID, condition);
+    auto out = m_backend->select(h256(), 0, tableInfo, _key, condition);
     if (out->size() > 0)
     {
-        auto entry = out->get(0);
-        auto numStr = entry->getField(SYS_VALUE);
-        m_ID = boost::lexical_cast<size_t>(numStr);
+        return out->get(0)->getField(SYS_VALUE);
     }
+    return "";
+}
 
-    if (!disabled())
+StorageSnapshot::Ptr CachedStorage::backendSnapshot()
+{
+    return std::dynamic_pointer_cast<StorageSnapshot>(m_backend);
+}
+
+void CachedStorage::setSnapshotInterval(int64_t _interval)
+{
+    auto backend = backendSnapshot();
+    if (backend)
     {
-        startClearThread();
+        // the views are pinned as the blocks are flushed to the backend
+        backend->setSnapshotInterval(_interval);
+    }
+}
+
+SnapshotInfo::Ptr CachedStorage::createSnapshot(size_t _chunkSize)
+{
+    auto backend = backendSnapshot();
+    if (!backend)
+    {
+        return nullptr;
+    }
+    return backend->createSnapshot(_chunkSize);
+}
+
+SnapshotInfo::Ptr CachedStorage::snapshot()
+{
+    auto backend = backendSnapshot();
+    return backend ? backend->snapshot() : nullptr;
+}
+
+std::shared_ptr<bytes> CachedStorage::readSnapshotChunk(size_t _index)
+{
+    auto backend = backendSnapshot();
+    return backend ? backend->readSnapshotChunk(_index) : nullptr;
+}
+
+void CachedStorage::beginSnapshotImport()
+{
+    auto backend = backendSnapshot();
+    if (!backend)
+    {
+        BOOST_THROW_EXCEPTION(StorageException(-1, "Backend doesn't support snapshot"));
+    }
+    backend->beginSnapshotImport();
+}
+
+void CachedStorage::importSnapshotChunk(bytesConstRef _chunk)
+{
+    auto backend = backendSnapshot();
+    if (!backend)
+    {
+        BOOST_THROW_EXCEPTION(StorageException(-1, "Backend doesn't support snapshot"));
+    }
+    backend->importSnapshotChunk(_chunk);
+}
+
+bool CachedStorage::finishSnapshotImport(int64_t _number, h256 const& _blockHash)
+{
+    auto backend = backendSnapshot();
+    if (!backend || !backend->finishSnapshotImport(_number, _blockHash))
+    {
+        return false;
+    }
+
+    clear();
+    m_capacity.store(0);
+
+    auto id = selectCurrentState(SYS_KEY_CURRENT_ID);
+    if (!id.empty())
+    {
+        m_ID = boost::lexical_cast<size_t>(id);
+    }
+    auto number = selectCurrentState(SYS_KEY_CURRENT_NUMBER);
+    if (!number.empty())
+    {
+        auto num = boost::lexical_cast<uint64_t>(number);
+        m_syncNum.store(num);
+        m_commitNum.store(num);
+    }
+    CACHED_STORAGE_LOG(INFO) << LOG_DESC("Snapshot imported") << LOG_KV("ID", m_ID)
+                             << LOG_KV("syncNum", m_syncNum);
+    return true;
+}
+
+void CachedStorage::abortSnapshotImport()
+{
+    auto backend = backendSnapshot();
+    if (backend)
+    {
+        backend->abortSnapshotImport();
     }
 }
 
@@ -662,6 +766,10 @@ std::tuple<std::shared_ptr<Cache::RWScoped>, Cache::Ptr, bool> CachedStorage::to
     bool hit = true;
 
     ++m_queryTimes;
+    if (m_queriesMetric)
+    {
+        m_queriesMetric->inc();
+    }
 
     auto cache = std::make_shared<Cache>();
     auto cacheKey = tableInfo->name + "_" + key;
@@ -688,6 +796,10 @@ std::tuple<std::shared_ptr<Cache::RWScoped>, Cache::Ptr, bool> CachedStorage::to
     if (hit)
     {
         ++m_hitTimes;
+        if (m_hitsMetric)
+        {
+            m_hitsMetric->inc();
+        }
     }
 
     return std::make_tuple(cacheLock, cache, true);
@@ -737,6 +849,7 @@ bool CachedStorage::disabled()
 void CachedStorage::commitBackend(Task::Ptr task)
 {
     auto now = std::chrono::system_clock::now();
+    TRACE_SPAN("flushBackend", "storage", groupID(), task->num);
 
     STORAGE_LOG(INFO) << "Start commit block: " << task->num << " to backend storage";
     try
@@ -753,6 +866,10 @@ void CachedStorage::commitBackend(Task::Ptr task)
     setSyncNum(task->num);
 
     std::chrono::duration<double> elapsed = std::chrono::system_clock::now() - now;
+    if (m_flushTimeMetric)
+    {
+        m_flushTimeMetric->observe(elapsed.count() * 1000000);
+    }
     STORAGE_LOG(INFO)
         << "[g:" << std::to_string(groupID()) << "]"
         << "\n---------------------------------------------------------------------\n"
@@ -881,6 +998,25 @@ void CachedStorage::checkAndClear()
 void CachedStorage::updateCapacity(ssize_t capacity)
 {
     m_capacity.fetch_and_add(capacity);
+    if (m_capacityMetric)
+    {
+        m_capacityMetric->set(m_capacity);
+    }
+}
+
+void CachedStorage::setGroupID(dev::GROUP_ID const& _groupID)
+{
+    Storage::setGroupID(_groupID);
+    auto& registry = dev::metrics::MetricsRegistry::instance();
+    auto labels = dev::metrics::groupLabels(_groupID);
+    m_queriesMetric =
+        &registry.counter("storage_cache_queries_total", "queries to the state cache", labels);
+    m_hitsMetric =
+        &registry.counter("storage_cache_hits_total", "queries hit in the state cache", labels);
+    m_capacityMetric =
+        &registry.gauge("storage_cache_bytes", "bytes held by the state cache", labels);
+    m_flushTimeMetric = &registry.histogram(
+        "storage_flush_us", "time to flush a block to the backend storage", labels);
 }
 
 std::string CachedStorage::readableCapacity(size_t num)
@@ -21,9 +21,12 @@
 
 #pragma once
 
+#include "MemoryArbiter.h"
 #include "Storage.h"
+#include "StorageSnapshot.h"
 #include "Table.h"
 #include <libdevcore/FixedHash.h>
+#include <libdevcore/Metrics.h>
 #include <libdevcore/ThreadPool.h>
 #include <tbb/concurrent_queue.h>
 #include <tbb/concurrent_unordered_map.h>
@@ -86,7 +89,7 @@ public:
     std::shared_ptr<std::vector<TableData::Ptr> > datas;
 };
 
-class CachedStorage : public Storage
+class CachedStorage : public Storage, public StorageSnapshot, public CacheConsumer
 {
 public:
     typedef std::shared_ptr<CachedStorage> Ptr;
@@ -126,7 +129,30 @@ public:
 
     void startClearThread();
 
+    /// snapshots are delegated to the backend, createSnapshot returns nullptr if the backend
+    /// doesn't support them
+    void setSnapshotInterval(int64_t _interval) override;
+    SnapshotInfo::Ptr createSnapshot(size_t _chunkSize) override;
+    SnapshotInfo::Ptr snapshot() override;
+    std::shared_ptr<bytes> readSnapshotChunk(size_t _index) override;
+    void beginSnapshotImport() override;
+    void importSnapshotChunk(bytesConstRef _chunk) override;
+    /// drop the caches and reload the state from the backend once it has been replaced
+    bool finishSnapshotImport(int64_t _number, h256 const& _blockHash) override;
+    void abortSnapshotImport() override;
+
+    /// the capacity is assigned by the MemoryArbiter when the node has a memory budget
+    int64_t cacheUsage() override { return m_capacity; }
+    uint64_t cacheQueries() override { return m_queryTimes; }
+    uint64_t cacheHits() override { return m_hitTimes; }
+    void setCacheCapacity(int64_t _capacity) override { setMaxCapacity(_capacity); }
+
+    /// register the cache metrics of the group as well
+    void setGroupID(dev::GROUP_ID const& _groupID) override;
+
 private:
+    StorageSnapshot::Ptr backendSnapshot();
+    std::string selectCurrentState(const std::string& _key);
     void touchMRU(const std::string& table, const std::string& key, ssize_t capacity);
     void updateMRU(const std::string& table, const std::string& key, ssize_t capacity);
     std::tuple<std::shared_ptr<Cache::RWScoped>, Cache::Ptr, bool> touchCache(
@@ -167,7 +193,7 @@ private:
 
     // config
     uint64_t m_maxForwardBlock = 10;
-    int64_t m_maxCapacity = 256 * 1024 * 1024;  // default 256MB for cache
+    tbb::atomic<int64_t> m_maxCapacity;  // default 256MB for cache
     uint64_t m_maxPopMRU = 100000;
     uint64_t m_clearInterval = 1000;
 
@@ -177,6 +203,12 @@ private:
     tbb::atomic<uint64_t> m_hitTimes;
     tbb::atomic<uint64_t> m_queryTimes;
 
+    /// registered once the group is known
+    dev::metrics::Counter* m_queriesMetric = nullptr;
+    dev::metrics::Counter* m_hitsMetric = nullptr;
+    dev::metrics::Gauge* m_capacityMetric = nullptr;
+    dev::metrics::Histogram* m_flushTimeMetric = nullptr;
+
     std::shared_ptr<tbb::atomic<bool> > m_running;
 };
 
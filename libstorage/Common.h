@@ -52,6 +52,10 @@ static const std::string SYS_CONFIG = "_sys_config_";
 static const std::string SYS_ACCESS_TABLE = "_sys_table_access_";
 static const std::string USER_TABLE_PREFIX = "_user_";
 static const std::string SYS_BLOCK_2_NONCES = "_sys_block_2_nonces_";
+/// the bloom of the logs of a block, only the blocks with logs are written
+static const std::string SYS_BLOCK_2_BLOOM = "_sys_block_2_bloom_";
+/// the blocks of the logs of an address or a topic, see BlockChainImp::writeLogIndex
+static const std::string SYS_LOG_INDEX = "_sys_log_index_";
 
 #if 0
 const char* const ID_FIELD = "_id_";
@@ -29,16 +29,16 @@ using namespace dev::blockverifier;
 using namespace dev::storage;
 
 
-const char* const CONDITION_METHOD_EQ_STR_INT = "EQ(string,int256)";
-const char* const CONDITION_METHOD_EQ_STR_STR = "EQ(string,string)";
-const char* const CONDITION_METHOD_GE_STR_INT = "GE(string,int256)";
-const char* const CONDITION_METHOD_GT_STR_INT = "GT(string,int256)";
-const char* const CONDITION_METHOD_LE_STR_INT = "LE(string,int256)";
-const char* const CONDITION_METHOD_LT_STR_INT = "LT(string,int256)";
-const char* const CONDITION_METHOD_NE_STR_INT = "NE(string,int256)";
-const char* const CONDITION_METHOD_NE_STR_STR = "NE(string,string)";
-const char* const CONDITION_METHOD_LIMIT_INT = "limit(int256)";
-const char* const CONDITION_METHOD_LIMIT_2INT = "limit(int256,int256)";
+const std::string CONDITION_METHOD_EQ_STR_INT = "EQ(string,int256)";
+const std::string CONDITION_METHOD_EQ_STR_STR = "EQ(string,string)";
+const std::string CONDITION_METHOD_GE_STR_INT = "GE(string,int256)";
+const std::string CONDITION_METHOD_GT_STR_INT = "GT(string,int256)";
+const std::string CONDITION_METHOD_LE_STR_INT = "LE(string,int256)";
+const std::string CONDITION_METHOD_LT_STR_INT = "LT(string,int256)";
+const std::string CONDITION_METHOD_NE_STR_INT = "NE(string,int256)";
+const std::string CONDITION_METHOD_NE_STR_STR = "NE(string,string)";
+const std::string CONDITION_METHOD_LIMIT_INT = "limit(int256)";
+const std::string CONDITION_METHOD_LIMIT_2INT = "limit(int256,int256)";
 
 ConditionPrecompiled::ConditionPrecompiled()
 {
@@ -27,8 +27,8 @@ using namespace dev;
 using namespace dev::blockverifier;
 using namespace dev::storage;
 
-const char* const ENTRIES_GET_INT = "get(int256)";
-const char* const ENTRIES_SIZE = "size()";
+const std::string ENTRIES_GET_INT = "get(int256)";
+const std::string ENTRIES_SIZE = "size()";
 
 EntriesPrecompiled::EntriesPrecompiled()
 {
@@ -29,16 +29,16 @@ using namespace dev;
 using namespace dev::blockverifier;
 using namespace dev::storage;
 
-const char* const ENTRY_GET_INT = "getInt(string)";
-const char* const ENTRY_GET_UINT = "getUInt(string)";
-const char* const ENTRY_SET_STR_INT = "set(string,int256)";
-const char* const ENTRY_SET_STR_UINT = "set(string,uint256)";
-const char* const ENTRY_SET_STR_ADDR = "set(string,address)";
-const char* const ENTRY_SET_STR_STR = "set(string,string)";
-const char* const ENTRY_GETA_STR = "getAddress(string)";
-const char* const ENTRY_GETB_STR = "getBytes64(string)";
-const char* const ENTRY_GETB_STR32 = "getBytes32(string)";
-const char* const ENTRY_GET_STR = "getString(string)";
+const std::string ENTRY_GET_INT = "getInt(string)";
+const std::string ENTRY_GET_UINT = "getUInt(string)";
+const std::string ENTRY_SET_STR_INT = "set(string,int256)";
+const std::string ENTRY_SET_STR_UINT = "set(string,uint256)";
+const std::string ENTRY_SET_STR_ADDR = "set(string,address)";
+const std::string ENTRY_SET_STR_STR = "set(string,string)";
+const std::string ENTRY_GETA_STR = "getAddress(string)";
+const std::string ENTRY_GETB_STR = "getBytes64(string)";
+const std::string ENTRY_GETB_STR32 = "getBytes32(string)";
+const std::string ENTRY_GET_STR = "getString(string)";
 
 std::string setInt(bytesConstRef _data, std::string& _key, bool _isUint = false)
 {
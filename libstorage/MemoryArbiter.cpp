@@ -0,0 +1,218 @@
+/*
+ * @CopyRight:
+ * FISCO-BCOS is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * FISCO-BCOS is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with FISCO-BCOS.  If not, see <http://www.gnu.org/licenses/>
+ * (c) 2016-2018 fisco-dev contributors.
+ */
+/** @file MemoryArbiter.cpp
+ *  @brief node-wide memory budget shared by the caches of all groups
+ */
+
+#include "MemoryArbiter.h"
+#include <libdevcore/easylog.h>
+#include <rocksdb/cache.h>
+#include <rocksdb/write_buffer_manager.h>
+
+using namespace std;
+using namespace dev;
+using namespace dev::storage;
+
+#define ARBITER_LOG(LEVEL) LOG(LEVEL) << "[MemoryArbiter] "
+
+static uint64_t const c_rebalanceInterval = 10000;  // ms
+/// every consumer is guaranteed this part of an even split, the rest follows the misses
+static double const c_minShareRatio = 0.25;
+/// new capacity = (old capacity + target) / 2, avoid oscillating between groups
+static double const c_smoothRatio = 0.5;
+
+MemoryArbiter::MemoryArbiter(int64_t _budget, double _rocksDBRatio)
+  : Worker("MemoryArbiter", 1000),
+    m_budget(_budget),
+    m_rocksDBUsageMetric(metrics::MetricsRegistry::instance().gauge(
+        "memory_rocksdb_usage_bytes", "bytes used by the block cache shared by all groups"))
+{
+    int64_t rocksDBBudget = m_budget * _rocksDBRatio;
+    m_cacheBudget = m_budget - rocksDBBudget;
+    // memtables are charged to the block cache, so RocksDB stays in rocksDBBudget as a whole
+    m_blockCache = rocksdb::NewLRUCache(rocksDBBudget);
+    m_writeBufferManager =
+        make_shared<rocksdb::WriteBufferManager>(rocksDBBudget / 2, m_blockCache);
+    auto& registry = metrics::MetricsRegistry::instance();
+    registry.gauge("memory_budget_bytes", "memory budget of the node").set(m_budget);
+    registry.gauge("memory_cache_budget_bytes", "part of the budget split between the caches")
+        .set(m_cacheBudget);
+    ARBITER_LOG(INFO) << LOG_DESC("Init memory budget") << LOG_KV("budget", m_budget)
+                      << LOG_KV("rocksDB", rocksDBBudget) << LOG_KV("cache", m_cacheBudget);
+}
+
+MemoryArbiter::~MemoryArbiter()
+{
+    stop();
+}
+
+void MemoryArbiter::start()
+{
+    startWorking();
+}
+
+void MemoryArbiter::stop()
+{
+    stopWorking();
+    terminate();
+}
+
+void MemoryArbiter::registerConsumer(std::string const& _name, CacheConsumer::Ptr _consumer,
+    metrics::MetricLabels const& _labels)
+{
+    auto labels = _labels;
+    if (labels.empty())
+    {
+        labels["cache"] = _name;
+    }
+    auto& registry = metrics::MetricsRegistry::instance();
+    {
+        Guard l(x_consumers);
+        Consumer c;
+        c.consumer = _consumer;
+        c.status.name = _name;
+        c.lastQueries = _consumer->cacheQueries();
+        c.lastHits = _consumer->cacheHits();
+        c.capacityMetric = &registry.gauge(
+            "memory_cache_capacity_bytes", "capacity assigned to the cache by the arbiter", labels);
+        c.usageMetric =
+            &registry.gauge("memory_cache_usage_bytes", "bytes held by the cache", labels);
+        c.missesMetric = &registry.gauge(
+            "memory_cache_misses", "cache misses of the last rebalance interval", labels);
+        m_consumers[_name] = c;
+    }
+    ARBITER_LOG(INFO) << LOG_DESC("Register cache") << LOG_KV("name", _name);
+    // share the budget with the new consumer at once
+    rebalance();
+}
+
+void MemoryArbiter::unregisterConsumer(std::string const& _name)
+{
+    Guard l(x_consumers);
+    auto it = m_consumers.find(_name);
+    if (it != m_consumers.end())
+    {
+        clearMetrics(it->second);
+        m_consumers.erase(it);
+    }
+}
+
+void MemoryArbiter::clearMetrics(Consumer& _consumer)
+{
+    _consumer.capacityMetric->set(0);
+    _consumer.usageMetric->set(0);
+    _consumer.missesMetric->set(0);
+}
+
+void MemoryArbiter::doWork()
+{
+    if (utcTime() - m_lastRebalanceTime >= c_rebalanceInterval)
+    {
+        rebalance();
+    }
+}
+
+void MemoryArbiter::rebalance()
+{
+    Guard l(x_consumers);
+    m_lastRebalanceTime = utcTime();
+
+    // collect the pressure of every consumer since last time
+    vector<pair<Consumer*, CacheConsumer::Ptr>> alive;
+    uint64_t totalMisses = 0;
+    // smoothing is only safe when the old capacities were split between the same consumers
+    bool membershipChanged = false;
+    for (auto it = m_consumers.begin(); it != m_consumers.end();)
+    {
+        auto consumer = it->second.consumer.lock();
+        if (!consumer)
+        {
+            clearMetrics(it->second);
+            it = m_consumers.erase(it);
+            membershipChanged = true;
+            continue;
+        }
+        auto& c = it->second;
+        membershipChanged = membershipChanged || c.status.capacity == 0;
+        uint64_t queries = consumer->cacheQueries();
+        uint64_t hits = consumer->cacheHits();
+        c.status.queries = queries - c.lastQueries;
+        c.status.misses = c.status.queries - (hits - c.lastHits);
+        c.status.usage = consumer->cacheUsage();
+        c.lastQueries = queries;
+        c.lastHits = hits;
+        totalMisses += c.status.misses;
+        alive.emplace_back(&c, consumer);
+        ++it;
+    }
+    m_rocksDBUsageMetric.set(rocksDBUsage());
+    if (alive.empty())
+        return;
+
+    int64_t evenShare = m_cacheBudget / alive.size();
+    int64_t minShare = evenShare * c_minShareRatio;
+    int64_t distributable = m_cacheBudget - minShare * alive.size();
+    for (auto& item : alive)
+    {
+        auto& status = item.first->status;
+        int64_t target = evenShare;
+        if (totalMisses > 0)
+        {
+            target = minShare + (int64_t)((double)distributable * status.misses / totalMisses);
+        }
+
+        int64_t capacity = target;
+        if (!membershipChanged)
+        {
+            capacity =
+                status.capacity * (1 - c_smoothRatio) + (double)target * c_smoothRatio;
+        }
+        status.capacity = capacity;
+        item.second->setCacheCapacity(capacity);
+        item.first->capacityMetric->set(status.capacity);
+        item.first->usageMetric->set(status.usage);
+        item.first->missesMetric->set(status.misses);
+
+        ARBITER_LOG(DEBUG) << LOG_DESC("Rebalance cache") << LOG_KV("name", status.name)
+                           << LOG_KV("capacity", status.capacity) << LOG_KV("usage", status.usage)
+                           << LOG_KV("queries", status.queries) << LOG_KV("misses", status.misses);
+    }
+    ARBITER_LOG(INFO) << LOG_DESC("Rebalance finished") << LOG_KV("consumers", alive.size())
+                      << LOG_KV("cacheBudget", m_cacheBudget) << LOG_KV("misses", totalMisses)
+                      << LOG_KV("rocksDBUsage", rocksDBUsage());
+}
+
+int64_t MemoryArbiter::rocksDBUsage()
+{
+    return m_blockCache->GetUsage();
+}
+
+std::vector<CacheConsumerStatus> MemoryArbiter::consumersStatus() const
+{
+    Guard l(x_consumers);
+    vector<CacheConsumerStatus> result;
+    for (auto const& it : m_consumers)
+    {
+        auto status = it.second.status;
+        if (auto consumer = it.second.consumer.lock())
+        {
+            status.usage = consumer->cacheUsage();
+        }
+        result.push_back(status);
+    }
+    return result;
+}
@@ -0,0 +1,130 @@
+/*
+ * @CopyRight:
+ * FISCO-BCOS is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * FISCO-BCOS is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with FISCO-BCOS.  If not, see <http://www.gnu.org/licenses/>
+ * (c) 2016-2018 fisco-dev contributors.
+ */
+/** @file MemoryArbiter.h
+ *  @brief node-wide memory budget shared by the caches of all groups
+ */
+#pragma once
+
+#include <libdevcore/Common.h>
+#include <libdevcore/Guards.h>
+#include <libdevcore/Metrics.h>
+#include <libdevcore/Worker.h>
+#include <map>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace rocksdb
+{
+class Cache;
+class WriteBufferManager;
+}  // namespace rocksdb
+
+namespace dev
+{
+namespace storage
+{
+/// a cache whose capacity is assigned by the MemoryArbiter
+class CacheConsumer
+{
+public:
+    typedef std::shared_ptr<CacheConsumer> Ptr;
+    virtual ~CacheConsumer() {}
+
+    /// bytes currently held by the cache
+    virtual int64_t cacheUsage() = 0;
+    /// accumulated number of queries and cache hits
+    virtual uint64_t cacheQueries() = 0;
+    virtual uint64_t cacheHits() = 0;
+    virtual void setCacheCapacity(int64_t _capacity) = 0;
+};
+
+struct CacheConsumerStatus
+{
+    std::string name;
+    int64_t capacity = 0;
+    int64_t usage = 0;
+    /// queries and misses of the last rebalance interval
+    uint64_t queries = 0;
+    uint64_t misses = 0;
+};
+
+/// The arbiter owns the memory budget of the node. RocksDB instances of all groups share one
+/// block cache and one write buffer manager, the rest of the budget is split between the
+/// registered caches according to their miss pressure.
+class MemoryArbiter : public Worker
+{
+public:
+    typedef std::shared_ptr<MemoryArbiter> Ptr;
+
+    /// _budget: bytes of the whole node, _rocksDBRatio: the part given to RocksDB
+    MemoryArbiter(int64_t _budget, double _rocksDBRatio = 0.25);
+    virtual ~MemoryArbiter();
+
+    void start();
+    void stop();
+
+    /// _labels identify the consumer in the exported metrics, {"cache": _name} if empty
+    void registerConsumer(std::string const& _name, CacheConsumer::Ptr _consumer,
+        dev::metrics::MetricLabels const& _labels = dev::metrics::MetricLabels());
+    void unregisterConsumer(std::string const& _name);
+
+    /// split the cache budget between consumers, called periodically by the worker thread
+    void rebalance();
+
+    std::shared_ptr<rocksdb::Cache> blockCache() { return m_blockCache; }
+    std::shared_ptr<rocksdb::WriteBufferManager> writeBufferManager()
+    {
+        return m_writeBufferManager;
+    }
+
+    int64_t budget() const { return m_budget; }
+    int64_t cacheBudget() const { return m_cacheBudget; }
+    /// bytes used by the shared RocksDB block cache and memtables
+    int64_t rocksDBUsage();
+    std::vector<CacheConsumerStatus> consumersStatus() const;
+
+protected:
+    void doWork() override;
+
+private:
+    struct Consumer
+    {
+        std::weak_ptr<CacheConsumer> consumer;
+        CacheConsumerStatus status;
+        uint64_t lastQueries = 0;
+        uint64_t lastHits = 0;
+        dev::metrics::Gauge* capacityMetric = nullptr;
+        dev::metrics::Gauge* usageMetric = nullptr;
+        dev::metrics::Gauge* missesMetric = nullptr;
+    };
+
+    void clearMetrics(Consumer& _consumer);
+
+    int64_t m_budget;
+    int64_t m_cacheBudget;
+    std::shared_ptr<rocksdb::Cache> m_blockCache;
+    std::shared_ptr<rocksdb::WriteBufferManager> m_writeBufferManager;
+    dev::metrics::Gauge& m_rocksDBUsageMetric;
+
+    mutable Mutex x_consumers;
+    std::map<std::string, Consumer> m_consumers;
+    uint64_t m_lastRebalanceTime = 0;
+};
+
+}  // namespace storage
+}  // namespace dev
@@ -23,10 +23,12 @@
 #include "Table.h"
 #include <arpa/inet.h>
 #include <json/json.h>
+#include <libconfig/GlobalConfigure.h>
 #include <libdevcore/FixedHash.h>
 #include <libdevcore/easylog.h>
 #include <libdevcrypto/Hash.h>
 #include <libprecompiled/Common.h>
+#include <tbb/parallel_for.h>
 #include <tbb/parallel_sort.h>
 #include <boost/exception/diagnostic_information.hpp>
 #include <boost/lexical_cast.hpp>
@@ -38,6 +40,25 @@ using namespace dev;
 using namespace dev::storage;
 using namespace dev::precompiled;
 
+namespace
+{
+void appendHashData(bytes& _data, Entry::Ptr const& _entry)
+{
+    for (auto fieldIt : *(_entry))
+    {
+        if (isHashField(fieldIt.first))
+        {
+            _data.insert(_data.end(), fieldIt.first.begin(), fieldIt.first.end());
+            _data.insert(_data.end(), fieldIt.second.begin(), fieldIt.second.end());
+        }
+    }
+    char status = (char)_entry->getStatus();
+    _data.insert(_data.end(), &status, &status + sizeof(status));
+}
+}  // namespace
+
+const size_t MemoryTable2::c_hashChunkEntries;
+
 Entries::ConstPtr MemoryTable2::select(const std::string& key, Condition::Ptr condition)
 {
     return selectNoLock(key, condition);
@@ -324,34 +345,51 @@ dev::storage::TableData::Ptr MemoryTable2::dump()
         TIME_RECORD("Sort data");
         tbb::parallel_sort(tempEntries.begin(), tempEntries.end(), EntryLessNoLock(m_tableInfo));
         TIME_RECORD("Submmit data");
-        bytes allData;
-        for (size_t i = 0; i < tempEntries.size(); ++i)
-        {
-            auto entry = tempEntries[i];
-            for (auto fieldIt : *(entry))
-            {
-                if (isHashField(fieldIt.first))
-                {
-                    allData.insert(allData.end(), fieldIt.first.begin(), fieldIt.first.end());
-                    allData.insert(allData.end(), fieldIt.second.begin(), fieldIt.second.end());
-                }
-            }
-            char status = (char)entry->getStatus();
-            allData.insert(allData.end(), &status, &status + sizeof(status));
-        }
+        m_hash = hashEntries(tempEntries);
 
-        if (allData.empty())
+        m_isDirty = false;
+    }
+
+    return m_tableData;
+}
+
+h256 MemoryTable2::hashEntries(tbb::concurrent_vector<Entry::Ptr> const& _entries)
+{
+    if (g_BCOSConfig.version() < V2_1_0)
+    {
+        bytes allData;
+        for (size_t i = 0; i < _entries.size(); ++i)
         {
-            m_hash = h256();
+            appendHashData(allData, _entries[i]);
         }
-
         bytesConstRef bR(allData.data(), allData.size());
-        m_hash = dev::sha256(bR);
-
-        m_isDirty = false;
+        return dev::sha256(bR);
     }
 
-    return m_tableData;
+    if (_entries.empty())
+    {
+        return h256();
+    }
+    // the chunks depend on the number of the entries only, so the hash does not depend on the
+    // number of the threads
+    size_t chunks = (_entries.size() + c_hashChunkEntries - 1) / c_hashChunkEntries;
+    bytes chunkHashes(chunks * h256::size);
+    tbb::parallel_for(
+        tbb::blocked_range<size_t>(0, chunks), [&](const tbb::blocked_range<size_t>& _range) {
+            bytes data;
+            for (size_t chunk = _range.begin(); chunk != _range.end(); ++chunk)
+            {
+                data.clear();
+                size_t end = std::min(_entries.size(), (chunk + 1) * c_hashChunkEntries);
+                for (size_t i = chunk * c_hashChunkEntries; i < end; ++i)
+                {
+                    appendHashData(data, _entries[i]);
+                }
+                h256 hash = dev::sha256(bytesConstRef(data.data(), data.size()));
+                memcpy(chunkHashes.data() + chunk * h256::size, hash.data(), h256::size);
+            }
+        });
+    return dev::sha256(bytesConstRef(chunkHashes.data(), chunkHashes.size()));
 }
 
 void MemoryTable2::rollback(const Change& _change)
@@ -29,6 +29,7 @@
 #include <libdevcrypto/Hash.h>
 #include <libprecompiled/Common.h>
 #include <tbb/concurrent_unordered_map.h>
+#include <tbb/concurrent_vector.h>
 #include <boost/exception/diagnostic_information.hpp>
 #include <boost/lexical_cast.hpp>
 #include <type_traits>
@@ -57,6 +58,10 @@ public:
         AccessOptions::Ptr options = std::make_shared<AccessOptions>()) override;
 
     h256 hash() override;
+    /// the dbHash of the sorted entries of a table, since 2.1.0 the entries are hashed in chunks
+    /// of c_hashChunkEntries in parallel and the hash of the table is the hash of the chunk hashes
+    static h256 hashEntries(tbb::concurrent_vector<Entry::Ptr> const& _entries);
+    static const size_t c_hashChunkEntries = 1024;
 
     void clear() override { m_dirty.clear(); }
     bool empty() override
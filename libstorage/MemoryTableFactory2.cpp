@@ -53,6 +53,8 @@ MemoryTableFactory2::MemoryTableFactory2() : m_blockHash(h256(0)), m_blockNum(0)
     m_sysTables.push_back(SYS_CNS);
     m_sysTables.push_back(SYS_CONFIG);
     m_sysTables.push_back(SYS_BLOCK_2_NONCES);
+    m_sysTables.push_back(SYS_BLOCK_2_BLOOM);
+    m_sysTables.push_back(SYS_LOG_INDEX);
 }
 
 
@@ -334,6 +336,16 @@ storage::TableInfo::Ptr MemoryTableFactory2::getSysTableInfo(const std::string&
         tableInfo->key = "number";
         tableInfo->fields = std::vector<std::string>{SYS_VALUE};
     }
+    else if (tableName == SYS_BLOCK_2_BLOOM)
+    {
+        tableInfo->key = "number";
+        tableInfo->fields = std::vector<std::string>{SYS_VALUE};
+    }
+    else if (tableName == SYS_LOG_INDEX)
+    {
+        tableInfo->key = SYS_KEY;
+        tableInfo->fields = std::vector<std::string>{SYS_VALUE};
+    }
     return tableInfo;
 }
 
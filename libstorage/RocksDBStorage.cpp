@@ -36,7 +36,9 @@
 #include <libdevcore/Guards.h>
 #include <libdevcore/RLP.h>
 #include <libdevcore/easylog.h>
+#include <libdevcrypto/Hash.h>
 #include <tbb/parallel_for.h>
+#include <boost/filesystem.hpp>
 #include <memory>
 #include <thread>
 
@@ -147,6 +149,7 @@ size_t RocksDBStorage::commit(h256 hash, int64_t num, const vector<TableData::Pt
         WriteOptions options;
         options.sync = false;
         m_db->Write(options, &batch);
+        pinSnapshot(num);
         auto writeDB_time_cost = utcTime();
         STORAGE_ROCKSDB_LOG(DEBUG)
             << LOG_BADGE("Commit") << LOG_DESC("Write to db")
@@ -166,6 +169,16 @@ size_t RocksDBStorage::commit(h256 hash, int64_t num, const vector<TableData::Pt
     return 0;
 }
 
+RocksDBStorage::~RocksDBStorage()
+{
+    std::lock_guard<std::mutex> l(m_snapshotMutex);
+    releaseSnapshot();
+    if (m_pinnedSnapshot)
+    {
+        m_db->ReleaseSnapshot(m_pinnedSnapshot);
+    }
+}
+
 bool RocksDBStorage::onlyDirty()
 {
     return false;
@@ -262,3 +275,379 @@ void RocksDBStorage::processDirtyEntries(int64_t num,
         it->second.push_back(value);
     }
 }
+
+namespace
+{
+/// written to the live db while it is replaced by the staged snapshot
+const std::string c_snapshotReplacingKey = "_sys_snapshot_replacing_";
+/// bytes of one write batch when the live db is replaced
+const size_t c_replaceBatchSize = 4 * 1024 * 1024;
+}  // namespace
+
+void RocksDBStorage::setSnapshotInterval(int64_t _interval)
+{
+    std::lock_guard<std::mutex> l(m_snapshotMutex);
+    m_snapshotInterval = _interval;
+}
+
+void RocksDBStorage::pinSnapshot(int64_t _number)
+{
+    std::lock_guard<std::mutex> l(m_snapshotMutex);
+    if (m_snapshotInterval <= 0 || _number % m_snapshotInterval != 0)
+    {
+        return;
+    }
+    if (m_pinnedSnapshot)
+    {
+        m_db->ReleaseSnapshot(m_pinnedSnapshot);
+    }
+    m_pinnedSnapshot = m_db->GetSnapshot();
+}
+
+SnapshotInfo::Ptr RocksDBStorage::createSnapshot(size_t _chunkSize)
+{
+    auto start_time = utcTime();
+    const rocksdb::Snapshot* snapshot = nullptr;
+    {
+        // the chunks are hashed out of the lock, the old snapshot is served meanwhile
+        std::lock_guard<std::mutex> l(m_snapshotMutex);
+        std::swap(snapshot, m_pinnedSnapshot);
+        if (!snapshot)
+        {
+            return m_snapshotInfo;
+        }
+    }
+    ReadOptions options;
+    options.snapshot = snapshot;
+    auto info = make_shared<SnapshotInfo>();
+    auto number = sysValue(m_db.get(), options, SYS_CURRENT_STATE, SYS_KEY_CURRENT_NUMBER);
+    info->number = number.empty() ? 0 : boost::lexical_cast<int64_t>(number);
+
+    SnapshotKVs kvs;
+    size_t chunkSize = 0;
+    unique_ptr<Iterator> it(m_db->NewIterator(options));
+    for (it->SeekToFirst(); it->Valid(); it->Next())
+    {
+        // close the chunk before the row overflows it, a row larger than _chunkSize is a chunk
+        // alone and is sent as a stream
+        size_t rowSize = it->key().size() + it->value().size();
+        if (!kvs.empty() && chunkSize + rowSize > _chunkSize)
+        {
+            info->chunkHashes.push_back(sha3(encodeSnapshotChunk(kvs)));
+            kvs.clear();
+            chunkSize = 0;
+        }
+        if (kvs.empty())
+        {
+            info->beginKeys.push_back(it->key().ToString());
+        }
+        kvs.emplace_back(it->key().ToString(), it->value().ToString());
+        chunkSize += rowSize;
+        if (chunkSize >= _chunkSize)
+        {
+            info->chunkHashes.push_back(sha3(encodeSnapshotChunk(kvs)));
+            kvs.clear();
+            chunkSize = 0;
+        }
+    }
+    if (!kvs.empty())
+    {
+        info->chunkHashes.push_back(sha3(encodeSnapshotChunk(kvs)));
+    }
+
+    if (!it->status().ok())
+    {
+        STORAGE_ROCKSDB_LOG(ERROR) << LOG_DESC("Create snapshot failed")
+                                   << LOG_KV("status", it->status().ToString());
+        m_db->ReleaseSnapshot(snapshot);
+        BOOST_THROW_EXCEPTION(
+            StorageException(-1, "Create snapshot exception:" + it->status().ToString()));
+    }
+    it.reset();
+
+    info->timestamp = utcTime();
+    {
+        std::lock_guard<std::mutex> l(m_snapshotMutex);
+        releaseSnapshot();
+        m_snapshot = snapshot;
+        m_snapshotInfo = info;
+    }
+    STORAGE_ROCKSDB_LOG(INFO) << LOG_BADGE("Snapshot") << LOG_DESC("Create snapshot")
+                              << LOG_KV("number", info->number)
+                              << LOG_KV("chunks", info->chunkHashes.size())
+                              << LOG_KV("timeCost", utcTime() - start_time);
+    return info;
+}
+
+SnapshotInfo::Ptr RocksDBStorage::snapshot()
+{
+    std::lock_guard<std::mutex> l(m_snapshotMutex);
+    return m_snapshotInfo;
+}
+
+std::shared_ptr<bytes> RocksDBStorage::readSnapshotChunk(size_t _index)
+{
+    std::lock_guard<std::mutex> l(m_snapshotMutex);
+    if (!m_snapshotInfo || _index >= m_snapshotInfo->beginKeys.size())
+    {
+        return nullptr;
+    }
+
+    ReadOptions options;
+    options.snapshot = m_snapshot;
+    bool lastChunk = (_index + 1 == m_snapshotInfo->beginKeys.size());
+
+    SnapshotKVs kvs;
+    unique_ptr<Iterator> it(m_db->NewIterator(options));
+    for (it->Seek(Slice(m_snapshotInfo->beginKeys[_index])); it->Valid(); it->Next())
+    {
+        if (!lastChunk && it->key() == Slice(m_snapshotInfo->beginKeys[_index + 1]))
+        {
+            break;
+        }
+        kvs.emplace_back(it->key().ToString(), it->value().ToString());
+    }
+    return make_shared<bytes>(encodeSnapshotChunk(kvs));
+}
+
+void RocksDBStorage::setSnapshotStagingPath(std::string const& _path)
+{
+    WriteGuard l(x_stagingDB);
+    m_stagingPath = _path;
+
+    string replacing;
+    auto s = m_db->Get(ReadOptions(), Slice(c_snapshotReplacingKey), &replacing);
+    if (s.ok())
+    {
+        // the staged snapshot has been verified before the replacement began
+        STORAGE_ROCKSDB_LOG(WARNING) << LOG_BADGE("Snapshot")
+                                     << LOG_DESC("Resume the replacement by the staged snapshot")
+                                     << LOG_KV("path", m_stagingPath);
+        openStagingDB(false);
+        replaceWithStagingDB();
+    }
+    else if (boost::filesystem::exists(m_stagingPath))
+    {
+        STORAGE_ROCKSDB_LOG(INFO) << LOG_BADGE("Snapshot")
+                                  << LOG_DESC("Discard the unfinished snapshot import")
+                                  << LOG_KV("path", m_stagingPath);
+        destroyStagingDB();
+    }
+}
+
+void RocksDBStorage::beginSnapshotImport()
+{
+    WriteGuard l(x_stagingDB);
+    destroyStagingDB();
+    openStagingDB(true);
+}
+
+void RocksDBStorage::importSnapshotChunk(bytesConstRef _chunk)
+{
+    auto kvs = decodeSnapshotChunk(_chunk);
+    WriteBatch batch;
+    for (auto const& kv : kvs)
+    {
+        batch.Put(Slice(kv.first), Slice(kv.second));
+    }
+
+    // the chunks are written in parallel
+    ReadGuard l(x_stagingDB);
+    if (!m_stagingDB)
+    {
+        BOOST_THROW_EXCEPTION(StorageException(-1, "No snapshot import in progress"));
+    }
+    WriteOptions options;
+    options.sync = false;
+    auto s = m_stagingDB->Write(options, &batch);
+    if (!s.ok())
+    {
+        STORAGE_ROCKSDB_LOG(ERROR) << LOG_DESC("Import snapshot chunk failed")
+                                   << LOG_KV("status", s.ToString());
+        BOOST_THROW_EXCEPTION(StorageException(-1, "Import snapshot exception:" + s.ToString()));
+    }
+}
+
+bool RocksDBStorage::finishSnapshotImport(int64_t _number, h256 const& _blockHash)
+{
+    WriteGuard l(x_stagingDB);
+    if (!m_stagingDB)
+    {
+        BOOST_THROW_EXCEPTION(StorageException(-1, "No snapshot import in progress"));
+    }
+    auto s = m_stagingDB->Flush(FlushOptions());
+    if (!s.ok())
+    {
+        STORAGE_ROCKSDB_LOG(ERROR) << LOG_DESC("Flush imported snapshot failed")
+                                   << LOG_KV("status", s.ToString());
+        BOOST_THROW_EXCEPTION(StorageException(-1, "Flush snapshot exception:" + s.ToString()));
+    }
+
+    auto number = sysValue(m_stagingDB.get(), ReadOptions(), SYS_CURRENT_STATE,
+        SYS_KEY_CURRENT_NUMBER);
+    auto hash = sysValue(m_stagingDB.get(), ReadOptions(), SYS_NUMBER_2_HASH,
+        boost::lexical_cast<string>(_number));
+    if (number != boost::lexical_cast<string>(_number) || hash != _blockHash.hex())
+    {
+        STORAGE_ROCKSDB_LOG(ERROR) << LOG_BADGE("Snapshot")
+                                   << LOG_DESC("The staged snapshot doesn't match the block")
+                                   << LOG_KV("number", number) << LOG_KV("hash", hash)
+                                   << LOG_KV("expectedNumber", _number)
+                                   << LOG_KV("expectedHash", _blockHash.hex());
+        destroyStagingDB();
+        return false;
+    }
+    replaceWithStagingDB();
+    return true;
+}
+
+void RocksDBStorage::abortSnapshotImport()
+{
+    WriteGuard l(x_stagingDB);
+    destroyStagingDB();
+}
+
+std::string RocksDBStorage::sysValue(rocksdb::DB* _db, ReadOptions const& _options,
+    std::string const& _tableName, std::string const& _key)
+{
+    string entryKey = _tableName;
+    entryKey.append("_").append(_key);
+
+    string value;
+    auto s = _db->Get(_options, Slice(entryKey), &value);
+    if (!s.ok())
+    {
+        return "";
+    }
+
+    vector<map<string, string>> res;
+    stringstream ss(value);
+    boost::archive::binary_iarchive ia(ss);
+    ia >> res;
+
+    string sysValue;
+    for (auto const& it : res)
+    {
+        auto valueIt = it.find(SYS_VALUE);
+        if (valueIt != it.end())
+        {
+            sysValue = valueIt->second;
+        }
+    }
+    return sysValue;
+}
+
+void RocksDBStorage::releaseSnapshot()
+{
+    if (m_snapshot)
+    {
+        m_db->ReleaseSnapshot(m_snapshot);
+        m_snapshot = nullptr;
+    }
+    m_snapshotInfo.reset();
+}
+
+void RocksDBStorage::openStagingDB(bool _create)
+{
+    if (m_stagingPath.empty())
+    {
+        BOOST_THROW_EXCEPTION(StorageException(-1, "The snapshot staging path is not set"));
+    }
+    Options options;
+    options.IncreaseParallelism();
+    options.create_if_missing = _create;
+    options.compression = rocksdb::kSnappyCompression;
+    rocksdb::DB* db = nullptr;
+    auto s = rocksdb::DB::Open(options, m_stagingPath, &db);
+    if (!s.ok())
+    {
+        STORAGE_ROCKSDB_LOG(ERROR) << LOG_DESC("Open snapshot staging db failed")
+                                   << LOG_KV("path", m_stagingPath)
+                                   << LOG_KV("status", s.ToString());
+        BOOST_THROW_EXCEPTION(StorageException(-1, "Open staging db exception:" + s.ToString()));
+    }
+    m_stagingDB.reset(db);
+}
+
+void RocksDBStorage::destroyStagingDB()
+{
+    m_stagingDB.reset();
+    if (!m_stagingPath.empty() && boost::filesystem::exists(m_stagingPath))
+    {
+        auto s = rocksdb::DestroyDB(m_stagingPath, Options());
+        if (!s.ok())
+        {
+            STORAGE_ROCKSDB_LOG(WARNING) << LOG_DESC("Destroy snapshot staging db failed")
+                                         << LOG_KV("path", m_stagingPath)
+                                         << LOG_KV("status", s.ToString());
+        }
+    }
+}
+
+void RocksDBStorage::replaceWithStagingDB()
+{
+    auto start_time = utcTime();
+    WriteOptions syncOptions;
+    syncOptions.sync = true;
+    // a restart before the key is removed resumes the replacement
+    auto s = m_db->Put(syncOptions, Slice(c_snapshotReplacingKey), Slice("1"));
+
+    auto writeBatch = [&](WriteBatch& _batch) {
+        if (s.ok() && _batch.Count() > 0)
+        {
+            s = m_db->Write(WriteOptions(), &_batch);
+        }
+        _batch.Clear();
+    };
+    WriteBatch batch;
+    unique_ptr<Iterator> it(m_db->NewIterator(ReadOptions()));
+    for (it->SeekToFirst(); s.ok() && it->Valid(); it->Next())
+    {
+        if (it->key() != Slice(c_snapshotReplacingKey))
+        {
+            batch.Delete(it->key());
+        }
+        if (batch.GetDataSize() >= c_replaceBatchSize)
+        {
+            writeBatch(batch);
+        }
+    }
+    writeBatch(batch);
+    if (s.ok())
+    {
+        s = it->status();
+    }
+    it.reset(m_stagingDB->NewIterator(ReadOptions()));
+    for (it->SeekToFirst(); s.ok() && it->Valid(); it->Next())
+    {
+        batch.Put(it->key(), it->value());
+        if (batch.GetDataSize() >= c_replaceBatchSize)
+        {
+            writeBatch(batch);
+        }
+    }
+    writeBatch(batch);
+    if (s.ok())
+    {
+        s = it->status();
+    }
+    it.reset();
+    if (s.ok())
+    {
+        s = m_db->Flush(FlushOptions());
+    }
+    if (s.ok())
+    {
+        s = m_db->Delete(syncOptions, Slice(c_snapshotReplacingKey));
+    }
+    if (!s.ok())
+    {
+        STORAGE_ROCKSDB_LOG(ERROR) << LOG_DESC("Replace by the staged snapshot failed")
+                                   << LOG_KV("status", s.ToString());
+        BOOST_THROW_EXCEPTION(StorageException(-1, "Replace snapshot exception:" + s.ToString()));
+    }
+    destroyStagingDB();
+    STORAGE_ROCKSDB_LOG(INFO) << LOG_BADGE("Snapshot")
+                              << LOG_DESC("Replace the live db by the staged snapshot")
+                              << LOG_KV("timeCost", utcTime() - start_time);
+}
@@ -21,26 +21,30 @@
 #pragma once
 
 #include "Storage.h"
+#include "StorageSnapshot.h"
 #include <json/json.h>
 #include <libdevcore/FixedHash.h>
 #include <libdevcore/Guards.h>
 #include <tbb/spin_mutex.h>
 #include <map>
+#include <mutex>
 
 namespace rocksdb
 {
 class DB;
+class Snapshot;
+struct ReadOptions;
 }
 namespace dev
 {
 namespace storage
 {
-class RocksDBStorage : public Storage
+class RocksDBStorage : public Storage, public StorageSnapshot
 {
 public:
     typedef std::shared_ptr<RocksDBStorage> Ptr;
 
-    virtual ~RocksDBStorage(){};
+    virtual ~RocksDBStorage();
 
     Entries::Ptr select(h256 hash, int64_t num, TableInfo::Ptr tableInfo, const std::string& key,
         Condition::Ptr condition) override;
@@ -48,8 +52,30 @@ public:
     bool onlyDirty() override;
 
     void setDB(std::shared_ptr<rocksdb::DB> db);
+    /// the db the snapshot chunks are imported into, a replacement of the live data interrupted
+    /// by a restart is resumed from it and an unfinished import is discarded
+    void setSnapshotStagingPath(std::string const& _path);
+
+    void setSnapshotInterval(int64_t _interval) override;
+    SnapshotInfo::Ptr createSnapshot(size_t _chunkSize) override;
+    SnapshotInfo::Ptr snapshot() override;
+    std::shared_ptr<bytes> readSnapshotChunk(size_t _index) override;
+    void beginSnapshotImport() override;
+    void importSnapshotChunk(bytesConstRef _chunk) override;
+    bool finishSnapshotImport(int64_t _number, h256 const& _blockHash) override;
+    void abortSnapshotImport() override;
 
 private:
+    /// the SYS_VALUE of the last row of _key in the table _tableName, empty if there is none
+    std::string sysValue(rocksdb::DB* _db, rocksdb::ReadOptions const& _options,
+        std::string const& _tableName, std::string const& _key);
+    /// pin the view of block _number if it is a snapshot block
+    void pinSnapshot(int64_t _number);
+    void releaseSnapshot();
+    void openStagingDB(bool _create);
+    void destroyStagingDB();
+    void replaceWithStagingDB();
+
     void processNewEntries(int64_t num,
         std::shared_ptr<std::map<std::string, std::vector<std::map<std::string, std::string>>>>
             key2value,
@@ -62,6 +88,19 @@ private:
 
     std::shared_ptr<rocksdb::DB> m_db;
     tbb::spin_mutex m_writeBatchMutex;
+
+    /// the pinned view of the latest snapshot
+    const rocksdb::Snapshot* m_snapshot = nullptr;
+    SnapshotInfo::Ptr m_snapshotInfo;
+    int64_t m_snapshotInterval = 0;
+    /// the view of the latest snapshot block, not split into chunks yet
+    const rocksdb::Snapshot* m_pinnedSnapshot = nullptr;
+    std::mutex m_snapshotMutex;
+
+    /// the chunks of the snapshot being imported
+    std::string m_stagingPath;
+    std::shared_ptr<rocksdb::DB> m_stagingDB;
+    mutable SharedMutex x_stagingDB;
 };
 
 }  // namespace storage
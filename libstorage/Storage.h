@@ -41,7 +41,7 @@ public:
 
     virtual bool onlyDirty() = 0;
 
-    void setGroupID(dev::GROUP_ID const& groupID) { m_groupID = groupID; }
+    virtual void setGroupID(dev::GROUP_ID const& groupID) { m_groupID = groupID; }
     dev::GROUP_ID groupID() const { return m_groupID; }
 
     virtual void stop() {}
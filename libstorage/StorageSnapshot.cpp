@@ -0,0 +1,52 @@
+/*
+ * @CopyRight:
+ * FISCO-BCOS is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * FISCO-BCOS is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with FISCO-BCOS.  If not, see <http://www.gnu.org/licenses/>
+ * (c) 2016-2018 fisco-dev contributors.
+ */
+/** @file StorageSnapshot.cpp
+ *  @brief chunked snapshot of the whole storage, used by snapshot sync
+ */
+
+#include "StorageSnapshot.h"
+#include <libdevcore/RLP.h>
+
+using namespace std;
+using namespace dev;
+using namespace dev::storage;
+
+bytes dev::storage::encodeSnapshotChunk(SnapshotKVs const& _kvs)
+{
+    RLPStream s(_kvs.size());
+    for (auto const& kv : _kvs)
+    {
+        s.appendList(2) << kv.first << kv.second;
+    }
+    return s.out();
+}
+
+SnapshotKVs dev::storage::decodeSnapshotChunk(bytesConstRef _chunk)
+{
+    RLP rlp(_chunk, RLP::VeryStrict);
+    SnapshotKVs kvs;
+    kvs.reserve(rlp.itemCount());
+    for (auto const& item : rlp)
+    {
+        if (item.itemCount() != 2)
+        {
+            BOOST_THROW_EXCEPTION(BadRLP() << errinfo_comment("invalid snapshot chunk item"));
+        }
+        kvs.emplace_back(item[0].toString(RLP::VeryStrict), item[1].toString(RLP::VeryStrict));
+    }
+    return kvs;
+}
@@ -0,0 +1,84 @@
+/*
+ * @CopyRight:
+ * FISCO-BCOS is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * FISCO-BCOS is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with FISCO-BCOS.  If not, see <http://www.gnu.org/licenses/>
+ * (c) 2016-2018 fisco-dev contributors.
+ */
+/** @file StorageSnapshot.h
+ *  @brief chunked snapshot of the whole storage, used by snapshot sync
+ */
+#pragma once
+
+#include <libdevcore/Common.h>
+#include <libdevcore/FixedHash.h>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace dev
+{
+namespace storage
+{
+/// raw key-value pairs of the storage backend, in key order
+using SnapshotKVs = std::vector<std::pair<std::string, std::string>>;
+
+struct SnapshotInfo
+{
+    typedef std::shared_ptr<SnapshotInfo> Ptr;
+    /// the block number the snapshot is consistent with
+    int64_t number = -1;
+    /// the first key of every chunk
+    std::vector<std::string> beginKeys;
+    /// sha3 of every encoded chunk
+    std::vector<h256> chunkHashes;
+    /// utc time the snapshot was created
+    uint64_t timestamp = 0;
+};
+
+class StorageSnapshot
+{
+public:
+    typedef std::shared_ptr<StorageSnapshot> Ptr;
+    virtual ~StorageSnapshot() {}
+
+    /// pin a view of the storage when the blocks whose number is a multiple of _interval are
+    /// committed, the nodes of a group pin identical views, 0 to pin none
+    virtual void setSnapshotInterval(int64_t _interval) = 0;
+    /// split the latest pinned view into chunks of about _chunkSize bytes and serve it, the
+    /// previous snapshot is released, the current one is returned if no newer view is pinned
+    virtual SnapshotInfo::Ptr createSnapshot(size_t _chunkSize) = 0;
+    /// the latest snapshot created by createSnapshot, nullptr if there is none
+    virtual SnapshotInfo::Ptr snapshot() = 0;
+    /// read the encoded chunk _index of the pinned snapshot
+    virtual std::shared_ptr<bytes> readSnapshotChunk(size_t _index) = 0;
+    /// discard the chunks of an earlier import and start a new one, the chunks are staged apart
+    /// from the live data until finishSnapshotImport
+    virtual void beginSnapshotImport() = 0;
+    /// write an encoded and verified chunk into the staging area
+    virtual void importSnapshotChunk(bytesConstRef _chunk) = 0;
+    /// replace the storage with the staged chunks if their head is block _number with hash
+    /// _blockHash, otherwise discard them and return false
+    virtual bool finishSnapshotImport(int64_t _number, h256 const& _blockHash) = 0;
+    /// discard the staged chunks, the live data is untouched
+    virtual void abortSnapshotImport() = 0;
+};
+
+/// encode key-value pairs into a snapshot chunk
+bytes encodeSnapshotChunk(SnapshotKVs const& _kvs);
+/// decode a snapshot chunk, throw if the chunk is malformed
+SnapshotKVs decodeSnapshotChunk(bytesConstRef _chunk);
+
+}  // namespace storage
+
+}  // namespace dev
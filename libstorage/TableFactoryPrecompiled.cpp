@@ -38,8 +38,8 @@ using namespace dev::blockverifier;
 using namespace std;
 using namespace dev::storage;
 
-const char* const TABLE_METHOD_OPT_STR = "openTable(string)";
-const char* const TABLE_METHOD_CRT_STR_STR = "createTable(string,string,string)";
+const std::string TABLE_METHOD_OPT_STR = "openTable(string)";
+const std::string TABLE_METHOD_CRT_STR_STR = "createTable(string,string,string)";
 
 TableFactoryPrecompiled::TableFactoryPrecompiled()
 {
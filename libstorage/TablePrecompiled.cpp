@@ -31,12 +31,12 @@ using namespace dev;
 using namespace dev::blockverifier;
 using namespace dev::storage;
 
-const char* const TABLE_METHOD_SLT_STR_ADD = "select(string,address)";
-const char* const TABLE_METHOD_INS_STR_ADD = "insert(string,address)";
-const char* const TABLE_METHOD_NEWCOND = "newCondition()";
-const char* const TABLE_METHOD_NEWENT = "newEntry()";
-const char* const TABLE_METHOD_RE_STR_ADD = "remove(string,address)";
-const char* const TABLE_METHOD_UP_STR_2ADD = "update(string,address,address)";
+const std::string TABLE_METHOD_SLT_STR_ADD = "select(string,address)";
+const std::string TABLE_METHOD_INS_STR_ADD = "insert(string,address)";
+const std::string TABLE_METHOD_NEWCOND = "newCondition()";
+const std::string TABLE_METHOD_NEWENT = "newEntry()";
+const std::string TABLE_METHOD_RE_STR_ADD = "remove(string,address)";
+const std::string TABLE_METHOD_UP_STR_2ADD = "update(string,address,address)";
 
 
 TablePrecompiled::TablePrecompiled()
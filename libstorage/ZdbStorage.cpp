@@ -132,6 +132,8 @@ void ZdbStorage::initSysTables()
     createCnsTables();
     createSysConfigTables();
     createSysBlock2NoncesTables();
+    createSysBlock2BloomTables();
+    createSysLogIndexTables();
     insertSysTables();
 }
 void ZdbStorage::createSysTables()
@@ -304,6 +306,38 @@ void ZdbStorage::createSysBlock2NoncesTables()
     string sql = ss.str();
     m_sqlBasicAcc->ExecuteSql(sql);
 }
+void ZdbStorage::createSysBlock2BloomTables()
+{
+    stringstream ss;
+    ss << "CREATE TABLE IF NOT EXISTS `_sys_block_2_bloom_` (\n";
+    ss << "`_id_` int(10) unsigned NOT NULL AUTO_INCREMENT,\n";
+    ss << "`_hash_` varchar(128) DEFAULT NULL,\n";
+    ss << "`_num_` int(11) DEFAULT NULL,\n";
+    ss << "`_status_` int(11) DEFAULT NULL,\n";
+    ss << "`number` varchar(128) DEFAULT NULL,\n";
+    ss << " `value` longtext,\n";
+    ss << "PRIMARY KEY (`_id_`),";
+    ss << "KEY `number` (`number`)";
+    ss << ") ENGINE=InnoDB DEFAULT CHARSET=utf8mb4;";
+    string sql = ss.str();
+    m_sqlBasicAcc->ExecuteSql(sql);
+}
+void ZdbStorage::createSysLogIndexTables()
+{
+    stringstream ss;
+    ss << "CREATE TABLE IF NOT EXISTS `_sys_log_index_` (\n";
+    ss << "`_id_` int(10) unsigned NOT NULL AUTO_INCREMENT,\n";
+    ss << "`_hash_` varchar(128) DEFAULT NULL,\n";
+    ss << "`_num_` int(11) DEFAULT NULL,\n";
+    ss << "`_status_` int(11) DEFAULT NULL,\n";
+    ss << "`key` varchar(128) DEFAULT NULL,\n";
+    ss << " `value` varchar(128) DEFAULT NULL,\n";
+    ss << "PRIMARY KEY (`_id_`),";
+    ss << "KEY `key` (`key`)";
+    ss << ") ENGINE=InnoDB DEFAULT CHARSET=utf8mb4;";
+    string sql = ss.str();
+    m_sqlBasicAcc->ExecuteSql(sql);
+}
 void ZdbStorage::insertSysTables()
 {
     stringstream ss;
@@ -319,7 +353,9 @@ void ZdbStorage::insertSysTables()
     ss << "	('_sys_hash_2_block_', 'hash','value'),\n";
     ss << "	('_sys_cns_', 'name','version,address,abi'),\n";
     ss << "	('_sys_config_', 'key','value,enable_num'),\n";
-    ss << "	('_sys_block_2_nonces_', 'number','value');";
+    ss << "	('_sys_block_2_nonces_', 'number','value'),\n";
+    ss << "	('_sys_block_2_bloom_', 'number','value'),\n";
+    ss << "	('_sys_log_index_', 'key','value');";
     string sql = ss.str();
     m_sqlBasicAcc->ExecuteSql(sql);
 }
@@ -72,6 +72,8 @@ private:
     void createCnsTables();
     void createSysConfigTables();
     void createSysBlock2NoncesTables();
+    void createSysBlock2BloomTables();
+    void createSysLogIndexTables();
     void insertSysTables();
 };
 
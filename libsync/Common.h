@@ -55,6 +55,7 @@ static size_t const c_maxDownloadingBlockQueueBufferSize = c_maxDownloadingBlock
 
 static size_t const c_maxReceivedDownloadRequestPerPeer = 8;
 static uint64_t const c_respondDownloadRequestTimeout = 200;  // ms
+static uint64_t const c_catchUpSpeedWindow = 5000;            // ms
 
 static unsigned const c_syncPacketIDBase = 1;
 
@@ -77,6 +78,10 @@ enum SyncPacketType : byte
     TransactionsPacket = 0x01,
     BlocksPacket = 0x02,
     ReqBlocskPacket = 0x03,
+    ReqSnapshotManifestPacket = 0x04,
+    SnapshotManifestPacket = 0x05,
+    ReqSnapshotChunkPacket = 0x06,
+    SnapshotChunkPacket = 0x07,
     PacketCount
 };
 
@@ -84,6 +89,7 @@ enum class SyncState
 {
     Idle,         ///< Initial chain sync complete. Waiting for new packets
     Downloading,  ///< Downloading blocks
+    Snapshot,     ///< Downloading state snapshot
     Size          /// Must be kept last
 };
 
@@ -23,6 +23,7 @@
 #include "DownloadingBlockQueue.h"
 #include "Common.h"
 #include <libdevcore/easylog.h>
+#include <tbb/parallel_for.h>
 
 using namespace std;
 using namespace dev;
@@ -119,10 +120,13 @@ void DownloadingBlockQueue::clearQueue()
     WriteGuard l(x_blocks);
     std::priority_queue<BlockPtr, BlockPtrVec, BlockQueueCmp> emptyQueue;
     swap(m_blocks, emptyQueue);  // Does memory leak here ?
+    ++m_clearSeq;
 }
 
 void DownloadingBlockQueue::flushBufferToQueue()
 {
+    // read before the buffer is taken, a clear in between drops what is decoded here
+    uint64_t clearSeq = m_clearSeq;
     shared_ptr<ShardPtrVec> localBuffer;
     {
         WriteGuard l(x_buffer);
@@ -130,47 +134,64 @@ void DownloadingBlockQueue::flushBufferToQueue()
         m_buffer = make_shared<ShardPtrVec>();  // m_buffer point to a new vector
     }
 
-    // pop buffer into queue
-    WriteGuard l(x_blocks);
-
     for (ShardPtr blocksShard : *localBuffer)
     {
-        if (m_blocks.size() >= c_maxDownloadingBlockQueueSize)  // TODO not to use size to control
-                                                                // insert
         {
-            SYNC_LOG(TRACE) << LOG_BADGE("Download") << LOG_BADGE("BlockSync")
-                            << LOG_DESC("DownloadingBlockQueueBuffer is full")
-                            << LOG_KV("queueSize", m_blocks.size());
+            ReadGuard l(x_blocks);
+            if (m_blocks.size() >= c_maxDownloadingBlockQueueSize)  // TODO not to use size to
+                                                                    // control insert
+            {
+                SYNC_LOG(TRACE) << LOG_BADGE("Download") << LOG_BADGE("BlockSync")
+                                << LOG_DESC("DownloadingBlockQueueBuffer is full")
+                                << LOG_KV("queueSize", m_blocks.size());
 
-            break;
+                break;
+            }
         }
 
         SYNC_LOG(TRACE) << LOG_BADGE("Download") << LOG_BADGE("BlockSync")
                         << LOG_DESC("Decoding block buffer")
                         << LOG_KV("blocksShardSize", blocksShard->blocksBytes.size());
 
-
+        // decode blocks and recover tx senders out of the lock, so that the queue top can be
+        // executed at the same time
         RLP const& rlps = RLP(ref(blocksShard->blocksBytes));
         unsigned itemCount = rlps.itemCount();
-        size_t successCnt = 0;
-        for (unsigned i = 0; i < itemCount; ++i)
-        {
-            try
-            {
-                shared_ptr<Block> block =
-                    make_shared<Block>(rlps[i].toBytes(), CheckTransaction::Everything, false);
-                if (isNewerBlock(block))
+        BlockPtrVec blocks(itemCount);
+        tbb::parallel_for(
+            tbb::blocked_range<unsigned>(0, itemCount), [&](tbb::blocked_range<unsigned> const& _r) {
+                for (unsigned i = _r.begin(); i != _r.end(); ++i)
                 {
-                    successCnt++;
-                    m_blocks.push(block);
+                    try
+                    {
+                        blocks[i] = make_shared<Block>(
+                            rlps[i].toBytesConstRef(), CheckTransaction::Everything, false);
+                    }
+                    catch (std::exception& e)
+                    {
+                        SYNC_LOG(WARNING)
+                            << LOG_BADGE("Download") << LOG_BADGE("BlockSync")
+                            << LOG_DESC("Invalid block RLP") << LOG_KV("reason", e.what())
+                            << LOG_KV("RLPDataSize", rlps.data().size());
+                    }
                 }
-            }
-            catch (std::exception& e)
+            });
+
+        size_t successCnt = 0;
+        WriteGuard l(x_blocks);
+        if (clearSeq != m_clearSeq)
+        {
+            SYNC_LOG(DEBUG) << LOG_BADGE("Download") << LOG_BADGE("BlockSync")
+                            << LOG_DESC("Drop blocks decoded before the queue was cleared")
+                            << LOG_KV("rcv", itemCount);
+            break;
+        }
+        for (auto const& block : blocks)
+        {
+            if (block && isNewerBlock(block))
             {
-                SYNC_LOG(WARNING) << LOG_BADGE("Download") << LOG_BADGE("BlockSync")
-                                  << LOG_DESC("Invalid block RLP") << LOG_KV("reason", e.what())
-                                  << LOG_KV("RLPDataSize", rlps.data().size());
-                continue;
+                successCnt++;
+                m_blocks.push(block);
             }
         }
 
@@ -25,6 +25,7 @@
 #include <libblockchain/BlockChainInterface.h>
 #include <libdevcore/Guards.h>
 #include <libethcore/Block.h>
+#include <atomic>
 #include <climits>
 #include <queue>
 #include <set>
@@ -108,6 +109,8 @@ private:
 
     mutable SharedMutex x_blocks;
     mutable SharedMutex x_buffer;
+    /// increased under x_blocks by every clear, the blocks decoded before are not pushed
+    std::atomic<uint64_t> m_clearSeq{0};
 
 private:
     bool isNewerBlock(std::shared_ptr<dev::eth::Block> _block);
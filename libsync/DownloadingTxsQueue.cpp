@@ -151,6 +151,9 @@ void DownloadingTxsQueue::pop2TxPool(
         auto getPendingSize_time_cost = utcTime() - record_time;
         record_time = utcTime();
 
+        m_receivedTxs->inc(txs.size());
+        m_importTxsTime->observe((utcTime() - maintainBuffer_start_time) * 1000);
+
         SYNC_LOG(DEBUG) << LOG_BADGE("Tx") << LOG_DESC("Import peer transactions")
                         << LOG_KV("import", successCnt) << LOG_KV("rcv", txs.size())
                         << LOG_KV("txPool", pengdingSize) << LOG_KV("peer", fromPeer.abridged())
@@ -24,6 +24,7 @@
 #include "Common.h"
 
 #include <libdevcore/Guards.h>
+#include <libdevcore/Metrics.h>
 #include <libethcore/Transaction.h>
 #include <libethcore/TxsParallelParser.h>
 #include <libtxpool/TxPoolInterface.h>
@@ -46,9 +47,16 @@ public:
 class DownloadingTxsQueue
 {
 public:
-    DownloadingTxsQueue(PROTOCOL_ID const&, NodeID const& _nodeId)
+    DownloadingTxsQueue(PROTOCOL_ID const& _protocolId, NodeID const& _nodeId)
       : m_nodeId(_nodeId), m_buffer(std::make_shared<std::vector<DownloadTxsShard>>())
-    {}
+    {
+        auto& registry = dev::metrics::MetricsRegistry::instance();
+        auto labels = dev::metrics::groupLabels(dev::eth::getGroupAndProtocol(_protocolId).first);
+        m_receivedTxs = &registry.counter(
+            "sync_received_txs_total", "transactions received from the peers", labels);
+        m_importTxsTime = &registry.histogram(
+            "sync_import_txs_us", "time to import a packet of peer transactions", labels);
+    }
     // push txs bytes in queue
     void push(bytesConstRef _txsBytes, NodeID const& _fromPeer);
 
@@ -60,6 +68,9 @@ private:
     NodeID m_nodeId;
     std::shared_ptr<std::vector<DownloadTxsShard>> m_buffer;
     mutable SharedMutex x_buffer;
+
+    dev::metrics::Counter* m_receivedTxs;
+    dev::metrics::Histogram* m_importTxsTime;
 };
 
 }  // namespace sync
@@ -0,0 +1,521 @@
+/*
+ * @CopyRight:
+ * FISCO-BCOS is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * FISCO-BCOS is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with FISCO-BCOS.  If not, see <http://www.gnu.org/licenses/>
+ * (c) 2016-2018 fisco-dev contributors.
+ */
+/**
+ * @brief : Snapshot sync: serve and download a chunked snapshot of the storage
+ * @file: SnapshotSync.cpp
+ */
+
+#include "SnapshotSync.h"
+#include "SyncMsgPacket.h"
+#include <libdevcrypto/Hash.h>
+#include <libp2p/MessageStream.h>
+
+using namespace std;
+using namespace dev;
+using namespace dev::eth;
+using namespace dev::sync;
+using namespace dev::p2p;
+using namespace dev::storage;
+
+h256 SnapshotManifest::hash() const
+{
+    RLPStream s(3);
+    s << number << blockHash << chunkHashes;
+    return sha3(s.out());
+}
+
+bool SnapshotSync::needSnapshot(int64_t _currentNumber, int64_t _maxPeerNumber)
+{
+    if (!m_enableDownload || !m_storage)
+        return false;
+    Guard l(x_download);
+    return !m_failed && (_maxPeerNumber - _currentNumber > c_snapshotSyncThreshold);
+}
+
+bool SnapshotSync::startDownloading()
+{
+    SYNC_LOG(INFO) << LOG_BADGE("Snapshot") << LOG_DESC("Start snapshot sync")
+                   << LOG_KV("currentNumber", m_blockChain->number());
+    return restartDownloading();
+}
+
+bool SnapshotSync::restartDownloading()
+{
+    WriteGuard importGuard(x_import);
+    {
+        Guard l(x_download);
+        ++m_generation;
+        m_restart = false;
+        m_startTime = utcTime();
+        m_lastManifestRequestTime = 0;
+        m_manifestVotes.clear();
+        m_manifest = nullptr;
+        m_providers.clear();
+        m_chunks.clear();
+        m_peerRequests.clear();
+        m_importedChunks = 0;
+    }
+    try
+    {
+        m_storage->beginSnapshotImport();
+        return true;
+    }
+    catch (std::exception const& e)
+    {
+        SYNC_LOG(ERROR) << LOG_BADGE("Snapshot")
+                        << LOG_DESC("Begin snapshot import failed, fallback to block sync")
+                        << LOG_KV("EINFO", boost::diagnostic_information(e));
+        Guard l(x_download);
+        m_failed = true;
+        return false;
+    }
+}
+
+void SnapshotSync::abortDownloading()
+{
+    WriteGuard importGuard(x_import);
+    try
+    {
+        m_storage->abortSnapshotImport();
+    }
+    catch (std::exception const& e)
+    {
+        SYNC_LOG(WARNING) << LOG_BADGE("Snapshot") << LOG_DESC("Abort snapshot import failed")
+                          << LOG_KV("EINFO", boost::diagnostic_information(e));
+    }
+}
+
+bool SnapshotSync::maintainDownloading(std::shared_ptr<SyncMasterStatus> _syncStatus)
+{
+    bool failed = false;
+    bool restart = false;
+    {
+        Guard l(x_download);
+        if (m_failed)
+            return true;
+        if (!m_restart && !m_manifest && !chooseManifest(_syncStatus))
+        {
+            if (utcTime() - m_startTime <= c_snapshotManifestTimeout)
+                return false;
+            SYNC_LOG(WARNING) << LOG_BADGE("Snapshot")
+                              << LOG_DESC("No manifest reached quorum, fallback to block sync")
+                              << LOG_KV("candidates", m_manifestVotes.size());
+            m_failed = true;
+        }
+        else if (!m_restart && m_importedChunks < m_chunks.size())
+        {
+            requestChunks();
+            if (!m_restart)
+                return false;
+        }
+        failed = m_failed;
+        restart = m_restart;
+    }
+
+    if (failed)
+    {
+        abortDownloading();
+        return true;
+    }
+    // the imports hold x_import, which is taken before x_download
+    if (restart)
+        return !restartDownloading();
+    return finishDownloading();
+}
+
+bool SnapshotSync::chooseManifest(std::shared_ptr<SyncMasterStatus> _syncStatus)
+{
+    SnapshotManifest::Ptr best = nullptr;
+    NodeList bestVoters;
+    for (auto const& vote : m_manifestVotes)
+    {
+        // the chunk hashes aren't signed, f + 1 sealers of the signed block vouch for them so
+        // that at least one honest sealer agrees, however few peers are connected
+        auto const& sealers = vote.second.first->sealers;
+        size_t sealerVotes = 0;
+        for (auto const& voter : vote.second.second)
+        {
+            if (std::find(sealers.begin(), sealers.end(), voter) != sealers.end())
+                ++sealerVotes;
+        }
+        if (!sealers.empty() && sealerVotes >= (sealers.size() - 1) / 3 + 1 &&
+            (!best || vote.second.first->number > best->number))
+        {
+            best = vote.second.first;
+            bestVoters = vote.second.second;
+        }
+    }
+
+    if (best)
+    {
+        m_manifest = best;
+        m_providers.assign(bestVoters.begin(), bestVoters.end());
+        m_chunks.assign(best->chunkHashes.size(), ChunkStatus());
+        SYNC_LOG(INFO) << LOG_BADGE("Snapshot") << LOG_DESC("Choose snapshot manifest")
+                       << LOG_KV("number", best->number)
+                       << LOG_KV("blockHash", best->blockHash.abridged())
+                       << LOG_KV("chunks", best->chunkHashes.size())
+                       << LOG_KV("providers", m_providers.size());
+        return true;
+    }
+
+    // (re)broadcast the manifest request
+    if (utcTime() - m_lastManifestRequestTime > c_snapshotRequestTimeout)
+    {
+        m_lastManifestRequestTime = utcTime();
+        _syncStatus->foreachPeer([&](std::shared_ptr<SyncPeerStatus> _p) {
+            SyncReqSnapshotManifestPacket packet;
+            packet.encode();
+            m_service->asyncSendMessageByNodeID(
+                _p->nodeId, packet.toMessage(m_protocolId), CallbackFuncWithSession(), Options());
+            return true;
+        });
+        SYNC_LOG(DEBUG) << LOG_BADGE("Snapshot") << LOG_DESC("Request snapshot manifest")
+                        << LOG_KV("peers", _syncStatus->peers().size());
+    }
+    return false;
+}
+
+void SnapshotSync::requestChunks()
+{
+    if (m_providers.empty())
+    {
+        // all providers misbehaved, the chunks they gave are dropped with their votes
+        SYNC_LOG(WARNING) << LOG_BADGE("Snapshot") << LOG_DESC("No provider left, restart")
+                          << LOG_KV("number", m_manifest->number)
+                          << LOG_KV("imported", m_importedChunks);
+        m_restart = true;
+        return;
+    }
+
+    uint64_t now = utcTime();
+    size_t providerIdx = 0;
+    for (size_t i = 0; i < m_chunks.size(); ++i)
+    {
+        auto& chunk = m_chunks[i];
+        if (chunk.state == ChunkState::Imported)
+            continue;
+        if (chunk.state == ChunkState::Requesting)
+        {
+            if (now - chunk.requestTime <= c_snapshotRequestTimeout)
+                continue;
+            // timeout, hand it to another provider
+            --m_peerRequests[chunk.peer];
+            chunk.state = ChunkState::Pending;
+        }
+
+        // find a provider which has free request slot
+        size_t tried = 0;
+        for (; tried < m_providers.size(); ++tried)
+        {
+            auto const& peer = m_providers[(providerIdx + tried) % m_providers.size()];
+            if (m_peerRequests[peer] < c_maxSnapshotRequestsPerPeer)
+                break;
+        }
+        if (tried == m_providers.size())
+            return;  // all providers are busy
+
+        providerIdx = (providerIdx + tried) % m_providers.size();
+        auto const& peer = m_providers[providerIdx];
+        providerIdx = (providerIdx + 1) % m_providers.size();
+
+        chunk.state = ChunkState::Requesting;
+        chunk.peer = peer;
+        chunk.requestTime = now;
+        ++m_peerRequests[peer];
+
+        SyncReqSnapshotChunkPacket packet;
+        packet.encode(m_manifest->number, i);
+        m_service->asyncSendMessageByNodeID(
+            peer, packet.toMessage(m_protocolId), CallbackFuncWithSession(), Options());
+        SYNC_LOG(TRACE) << LOG_BADGE("Snapshot") << LOG_DESC("Request snapshot chunk")
+                        << LOG_KV("index", i) << LOG_KV("peer", peer.abridged());
+    }
+}
+
+bool SnapshotSync::finishDownloading()
+{
+    bool replaced = false;
+    {
+        WriteGuard importGuard(x_import);
+        try
+        {
+            // the staged head is checked against the signed block before the live data goes
+            replaced = m_storage->finishSnapshotImport(m_manifest->number, m_manifest->blockHash);
+        }
+        catch (std::exception const& e)
+        {
+            SYNC_LOG(ERROR) << LOG_BADGE("Snapshot") << LOG_DESC("Finish snapshot import failed")
+                            << LOG_KV("EINFO", boost::diagnostic_information(e));
+        }
+    }
+    if (!replaced)
+    {
+        SYNC_LOG(ERROR) << LOG_BADGE("Snapshot")
+                        << LOG_DESC("Imported snapshot rejected, fallback to block sync")
+                        << LOG_KV("expectedNumber", m_manifest->number)
+                        << LOG_KV("expectedHash", m_manifest->blockHash.abridged());
+        Guard l(x_download);
+        m_failed = true;
+        return true;
+    }
+    m_blockChain->reload();
+
+    int64_t number = m_blockChain->number();
+    h256 hash = m_blockChain->numberHash(number);
+
+    SYNC_LOG(INFO) << LOG_BADGE("Snapshot") << LOG_DESC("Snapshot sync finish")
+                   << LOG_KV("number", number) << LOG_KV("hash", hash.abridged())
+                   << LOG_KV("chunks", m_importedChunks)
+                   << LOG_KV("timeCost", utcTime() - m_startTime);
+    return true;
+}
+
+void SnapshotSync::onPeerManifest(NodeID const& _peer, RLP const& _rlp)
+{
+    if (_rlp.itemCount() != 3)
+    {
+        SYNC_LOG(DEBUG) << LOG_BADGE("Snapshot") << LOG_DESC("Receive invalid manifest format")
+                        << LOG_KV("peer", _peer.abridged());
+        return;
+    }
+
+    auto manifest = make_shared<SnapshotManifest>();
+    manifest->number = _rlp[0].toInt<int64_t>();
+    manifest->chunkHashes = _rlp[2].toVector<h256>();
+
+    // the block of the snapshot must be sealed by the consensus
+    Block block(_rlp[1].toBytesConstRef(), CheckTransaction::None);
+    if (block.blockHeader().number() != manifest->number ||
+        (fp_isConsensusOk && !fp_isConsensusOk(block)))
+    {
+        SYNC_LOG(WARNING) << LOG_BADGE("Snapshot") << LOG_DESC("Reject manifest")
+                          << LOG_KV("reason", "block check failed")
+                          << LOG_KV("number", manifest->number) << LOG_KV("peer", _peer.abridged());
+        return;
+    }
+    manifest->blockHash = block.headerHash();
+    manifest->sealers = block.blockHeader().sealerList();
+
+    Guard l(x_download);
+    if (m_manifest)
+        return;
+    auto& vote = m_manifestVotes[manifest->hash()];
+    vote.first = manifest;
+    vote.second.insert(_peer);
+    SYNC_LOG(DEBUG) << LOG_BADGE("Snapshot") << LOG_DESC("Receive manifest")
+                    << LOG_KV("number", manifest->number)
+                    << LOG_KV("chunks", manifest->chunkHashes.size())
+                    << LOG_KV("votes", vote.second.size()) << LOG_KV("peer", _peer.abridged());
+}
+
+void SnapshotSync::onPeerChunk(NodeID const& _peer, RLP const& _rlp)
+{
+    if (_rlp.itemCount() != 3)
+    {
+        SYNC_LOG(DEBUG) << LOG_BADGE("Snapshot") << LOG_DESC("Receive invalid chunk format")
+                        << LOG_KV("peer", _peer.abridged());
+        return;
+    }
+
+    int64_t number = _rlp[0].toInt<int64_t>();
+    size_t index = _rlp[1].toInt<unsigned>();
+    bytesConstRef chunk = _rlp[2].toBytesConstRef();
+    h256 chunkHash = sha3(chunk);
+
+    uint64_t generation = 0;
+    {
+        Guard l(x_download);
+        if (!m_manifest || number != m_manifest->number || index >= m_chunks.size() ||
+            m_chunks[index].state != ChunkState::Requesting || m_chunks[index].peer != _peer)
+            return;
+
+        --m_peerRequests[_peer];
+        if (chunkHash != m_manifest->chunkHashes[index])
+        {
+            SYNC_LOG(WARNING) << LOG_BADGE("Snapshot") << LOG_DESC("Drop provider")
+                              << LOG_KV("reason", "chunk hash mismatch") << LOG_KV("index", index)
+                              << LOG_KV("peer", _peer.abridged());
+            m_chunks[index].state = ChunkState::Pending;
+            m_providers.erase(std::remove(m_providers.begin(), m_providers.end(), _peer),
+                m_providers.end());
+            return;
+        }
+        // mark first to prevent importing the same chunk twice
+        m_chunks[index].state = ChunkState::Imported;
+        generation = m_generation;
+    }
+
+    // import out of x_download, so that chunks from different peers are written in parallel
+    bool imported = false;
+    {
+        ReadGuard importGuard(x_import);
+        // a restart waits for this import, so a chunk of the old manifest can't reach the new
+        // import
+        if (generation != m_generation)
+            return;
+        try
+        {
+            m_storage->importSnapshotChunk(chunk);
+            imported = true;
+        }
+        catch (std::exception const& e)
+        {
+            SYNC_LOG(ERROR) << LOG_BADGE("Snapshot") << LOG_DESC("Import snapshot chunk failed")
+                            << LOG_KV("index", index)
+                            << LOG_KV("EINFO", boost::diagnostic_information(e));
+        }
+    }
+
+    Guard l(x_download);
+    if (generation != m_generation)
+        return;
+    if (!imported)
+    {
+        // the staged chunks are incomplete, the sync thread starts over
+        m_restart = true;
+        return;
+    }
+    ++m_importedChunks;
+    SYNC_LOG(DEBUG) << LOG_BADGE("Snapshot") << LOG_DESC("Import snapshot chunk")
+                    << LOG_KV("index", index) << LOG_KV("imported", m_importedChunks)
+                    << LOG_KV("total", m_chunks.size()) << LOG_KV("peer", _peer.abridged());
+}
+
+void SnapshotSync::onPeerRequestManifest(NodeID const& _peer)
+{
+    if (!m_storage)
+        return;
+    pushRequest(SnapshotRequest{_peer, -1, -1});
+}
+
+void SnapshotSync::onPeerRequestChunk(NodeID const& _peer, RLP const& _rlp)
+{
+    if (!m_storage || _rlp.itemCount() != 2)
+        return;
+    pushRequest(SnapshotRequest{_peer, _rlp[0].toInt<int64_t>(), _rlp[1].toInt<unsigned>()});
+}
+
+void SnapshotSync::pushRequest(SnapshotRequest const& _req)
+{
+    Guard l(x_requests);
+    if (m_requests.size() >= c_maxPendingSnapshotRequests)
+    {
+        SYNC_LOG(DEBUG) << LOG_BADGE("Snapshot") << LOG_DESC("Drop snapshot request")
+                        << LOG_KV("reason", "too many requests")
+                        << LOG_KV("peer", _req.peer.abridged());
+        return;
+    }
+    m_requests.push_back(_req);
+}
+
+void SnapshotSync::maintainRequests()
+{
+    while (true)
+    {
+        SnapshotRequest req;
+        {
+            Guard l(x_requests);
+            if (m_requests.empty())
+                return;
+            req = m_requests.front();
+            m_requests.pop_front();
+        }
+
+        try
+        {
+            if (req.index < 0)
+                respondManifest(req.peer);
+            else
+                respondChunk(req.peer, req.number, req.index);
+        }
+        catch (std::exception const& e)
+        {
+            SYNC_LOG(WARNING) << LOG_BADGE("Snapshot") << LOG_DESC("Respond snapshot failed")
+                              << LOG_KV("peer", req.peer.abridged())
+                              << LOG_KV("EINFO", boost::diagnostic_information(e));
+        }
+    }
+}
+
+void SnapshotSync::respondManifest(NodeID const& _peer)
+{
+    auto info = m_storage->snapshot();
+    if (!info || m_blockChain->number() - info->number >= c_snapshotInterval)
+    {
+        // build the view pinned at the latest snapshot block
+        createSnapshotAsync();
+        if (!info)
+            return;  // the peer requests again after c_snapshotRequestTimeout
+    }
+
+    auto blockRLP = m_blockChain->getBlockRLPByNumber(info->number);
+    if (!blockRLP)
+        return;
+
+    SyncSnapshotManifestPacket packet;
+    packet.encode(info->number, *blockRLP, info->chunkHashes);
+    m_service->asyncSendMessageByNodeID(
+        _peer, packet.toMessage(m_protocolId), CallbackFuncWithSession(), Options());
+    SYNC_LOG(DEBUG) << LOG_BADGE("Snapshot") << LOG_DESC("Send snapshot manifest")
+                    << LOG_KV("number", info->number) << LOG_KV("chunks", info->chunkHashes.size())
+                    << LOG_KV("peer", _peer.abridged());
+}
+
+void SnapshotSync::createSnapshotAsync()
+{
+    if (m_creatingSnapshot.exchange(true))
+        return;
+    m_snapshotWorker->enqueue([this]() {
+        try
+        {
+            m_storage->createSnapshot(c_snapshotChunkSize);
+        }
+        catch (std::exception const& e)
+        {
+            SYNC_LOG(WARNING) << LOG_BADGE("Snapshot") << LOG_DESC("Create snapshot failed")
+                              << LOG_KV("EINFO", boost::diagnostic_information(e));
+        }
+        m_creatingSnapshot = false;
+    });
+}
+
+void SnapshotSync::respondChunk(NodeID const& _peer, int64_t _number, size_t _index)
+{
+    auto info = m_storage->snapshot();
+    if (!info || info->number != _number)
+        return;  // the snapshot has been rebuilt, the peer will choose the new one
+
+    auto chunk = m_storage->readSnapshotChunk(_index);
+    if (!chunk)
+        return;
+
+    SyncSnapshotChunkPacket packet;
+    packet.encode(_number, _index, *chunk);
+    auto msg = packet.toMessage(m_protocolId);
+    // the chunks of the oversized rows are sent as streams
+    size_t maxLength = dev::p2p::MessageStream::shouldSplit(msg) ?
+                           dev::p2p::MessageStream::c_maxLength :
+                           dev::p2p::P2PMessage::MAX_LENGTH;
+    if (msg->buffer()->size() > maxLength)
+    {
+        SYNC_LOG(ERROR) << LOG_BADGE("Snapshot") << LOG_DESC("Snapshot chunk is too large to send")
+                        << LOG_KV("index", _index) << LOG_KV("size", msg->buffer()->size());
+        return;
+    }
+    m_service->asyncSendMessageByNodeID(_peer, msg, CallbackFuncWithSession(), Options());
+}
@@ -0,0 +1,192 @@
+/*
+ * @CopyRight:
+ * FISCO-BCOS is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * FISCO-BCOS is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with FISCO-BCOS.  If not, see <http://www.gnu.org/licenses/>
+ * (c) 2016-2018 fisco-dev contributors.
+ */
+/**
+ * @brief : Snapshot sync: serve and download a chunked snapshot of the storage
+ * @file: SnapshotSync.h
+ */
+
+#pragma once
+#include "Common.h"
+#include "SyncStatus.h"
+#include <libblockchain/BlockChainInterface.h>
+#include <libdevcore/Guards.h>
+#include <libdevcore/RLP.h>
+#include <libdevcore/ThreadPool.h>
+#include <libp2p/P2PInterface.h>
+#include <libstorage/StorageSnapshot.h>
+#include <atomic>
+#include <deque>
+#include <map>
+#include <vector>
+
+namespace dev
+{
+namespace sync
+{
+/// a node whose number is this far behind its peers downloads a snapshot instead of blocks
+static int64_t const c_snapshotSyncThreshold = 10000;
+/// the most bytes of storage data carried by one chunk unless a row is larger, must fit in one
+/// p2p message
+static size_t const c_snapshotChunkSize = 512 * 1024;
+/// snapshots are taken at the blocks whose number is a multiple of it, the honest nodes build
+/// identical manifests and the quorum of them can form
+static int64_t const c_snapshotInterval = 1000;
+/// manifest/chunk requests without response are retried after this timeout
+static uint64_t const c_snapshotRequestTimeout = 5000;  // ms
+/// give up snapshot sync if no manifest reaches the quorum in time
+static uint64_t const c_snapshotManifestTimeout = 60000;  // ms
+static size_t const c_maxSnapshotRequestsPerPeer = 2;
+static size_t const c_maxPendingSnapshotRequests = 64;
+
+struct SnapshotManifest
+{
+    typedef std::shared_ptr<SnapshotManifest> Ptr;
+    int64_t number;
+    h256 blockHash;
+    std::vector<h256> chunkHashes;
+    /// the sealers of the block, f + 1 of them must announce the manifest
+    h512s sealers;
+
+    h256 hash() const;
+};
+
+class SnapshotSync
+{
+public:
+    typedef std::shared_ptr<SnapshotSync> Ptr;
+    SnapshotSync(std::shared_ptr<dev::p2p::P2PInterface> _service,
+        std::shared_ptr<dev::blockchain::BlockChainInterface> _blockChain,
+        PROTOCOL_ID const& _protocolId, NodeID const& _nodeId)
+      : m_service(_service),
+        m_blockChain(_blockChain),
+        m_protocolId(_protocolId),
+        m_groupId(dev::eth::getGroupAndProtocol(_protocolId).first),
+        m_nodeId(_nodeId),
+        m_snapshotWorker(std::make_shared<dev::ThreadPool>(
+            "snapshot-" + std::to_string(m_groupId), 1))
+    {}
+
+    /// _storage is nullptr when the storage can't export snapshots
+    void setStorage(dev::storage::StorageSnapshot::Ptr _storage, bool _enableDownload)
+    {
+        m_storage = _storage;
+        m_enableDownload = _enableDownload;
+        if (m_storage)
+        {
+            m_storage->setSnapshotInterval(c_snapshotInterval);
+        }
+    }
+
+    void setConsensusVerifyHandler(std::function<bool(dev::eth::Block const&)> _handler)
+    {
+        fp_isConsensusOk = _handler;
+    }
+
+    /// whether to download a snapshot rather than replaying blocks
+    bool needSnapshot(int64_t _currentNumber, int64_t _maxPeerNumber);
+    /// reset downloading state and begin to request manifests, false if the import can't begin
+    bool startDownloading();
+    /// drive the downloading, return true when it finished or has been given up
+    bool maintainDownloading(std::shared_ptr<SyncMasterStatus> _syncStatus);
+    /// respond to the requests of peers
+    void maintainRequests();
+
+    /// packet handlers called by SyncMsgEngine
+    void onPeerRequestManifest(NodeID const& _peer);
+    void onPeerRequestChunk(NodeID const& _peer, RLP const& _rlp);
+    void onPeerManifest(NodeID const& _peer, RLP const& _rlp);
+    void onPeerChunk(NodeID const& _peer, RLP const& _rlp);
+
+    size_t importedChunks() const
+    {
+        Guard l(x_download);
+        return m_importedChunks;
+    }
+
+private:
+    enum class ChunkState
+    {
+        Pending,
+        Requesting,
+        Imported
+    };
+    struct ChunkStatus
+    {
+        ChunkState state = ChunkState::Pending;
+        NodeID peer;
+        uint64_t requestTime = 0;
+    };
+    struct SnapshotRequest
+    {
+        NodeID peer;
+        int64_t number;
+        /// -1 for manifest request
+        int64_t index;
+    };
+
+    void pushRequest(SnapshotRequest const& _req);
+    void respondManifest(NodeID const& _peer);
+    void respondChunk(NodeID const& _peer, int64_t _number, size_t _index);
+    /// build a new snapshot on the worker, the sync thread keeps serving the current one
+    void createSnapshotAsync();
+    bool chooseManifest(std::shared_ptr<SyncMasterStatus> _syncStatus);
+    void requestChunks();
+    /// drop the downloaded chunks and the manifests, and begin a new import
+    bool restartDownloading();
+    void abortDownloading();
+    bool finishDownloading();
+
+private:
+    std::shared_ptr<dev::p2p::P2PInterface> m_service;
+    std::shared_ptr<dev::blockchain::BlockChainInterface> m_blockChain;
+    dev::storage::StorageSnapshot::Ptr m_storage;
+    PROTOCOL_ID m_protocolId;
+    GROUP_ID m_groupId;
+    NodeID m_nodeId;
+    bool m_enableDownload = false;
+    std::function<bool(dev::eth::Block const&)> fp_isConsensusOk = nullptr;
+
+    /// requests from peers
+    mutable Mutex x_requests;
+    std::deque<SnapshotRequest> m_requests;
+
+    /// held shared by the chunk imports and exclusively to begin, finish or abort an import,
+    /// taken before x_download
+    mutable SharedMutex x_import;
+    /// downloading state
+    mutable Mutex x_download;
+    /// increased by every restart, the chunks requested before are dropped
+    uint64_t m_generation = 0;
+    /// set when the download must start over, handled by the sync thread
+    bool m_restart = false;
+    bool m_failed = false;
+    uint64_t m_startTime = 0;
+    uint64_t m_lastManifestRequestTime = 0;
+    std::map<h256, std::pair<SnapshotManifest::Ptr, NodeList>> m_manifestVotes;
+    SnapshotManifest::Ptr m_manifest;
+    NodeIDs m_providers;
+    std::vector<ChunkStatus> m_chunks;
+    std::map<NodeID, size_t> m_peerRequests;
+    size_t m_importedChunks = 0;
+
+    std::atomic_bool m_creatingSnapshot{false};
+    /// declared last to be stopped before the members its task uses are destroyed
+    dev::ThreadPool::Ptr m_snapshotWorker;
+};
+
+}  // namespace sync
+}  // namespace dev
@@ -51,6 +51,8 @@ void SyncMaster::printSyncInfo()
                     << m_blockChain->numberHash(m_blockChain->number()) << "\n"
                     << "            Genesis hash: " << m_syncStatus->genesisHash.abridged() << "\n"
                     << "            TxPool size:  " << pendingSize << "\n"
+                    << "            Catch-up:     " << m_syncStatus->catchUpBlocksPerSecond()
+                    << " blocks/s\n"
                     << "            Peers size:   " << m_syncStatus->peers().size() << "\n"
                     << "[Peer Info] --------------------------------------------\n"
                     << "    Host: " << m_nodeId.abridged() << "\n"
@@ -83,6 +85,7 @@ string const SyncMaster::syncInfo() const
     syncInfo["knownHighestNumber"] = m_syncStatus->knownHighestNumber;
     syncInfo["knownLatestHash"] = toHex(m_syncStatus->knownLatestHash);
     syncInfo["txPoolSize"] = std::to_string(m_txPool->pendingSize());
+    syncInfo["catchUpBlocksPerSecond"] = m_syncStatus->catchUpBlocksPerSecond();
 
     Json::Value peersInfo(Json::arrayValue);
     m_syncStatus->foreachPeer([&](shared_ptr<SyncPeerStatus> _p) {
@@ -150,6 +153,10 @@ void SyncMaster::doWork()
     auto maintainBlocks_time_cost = utcTime() - record_time;
     record_time = utcTime();
 
+    m_snapshotSync->maintainRequests();
+    auto maintainSnapshotRequests_time_cost = utcTime() - record_time;
+    record_time = utcTime();
+
     auto maintainTransactions_time_cost = 0;
     auto maintainBlockRequest_time_cost = 0;
     // Idle do
@@ -179,6 +186,12 @@ void SyncMaster::doWork()
             if (finished)
                 noteDownloadingFinish();
         }
+        else if (m_syncStatus->state == SyncState::Snapshot)
+        {
+            bool finished = m_snapshotSync->maintainDownloading(m_syncStatus);
+            if (finished)
+                m_syncStatus->state = SyncState::Idle;
+        }
         maintainDownloadingQueue_time_cost = utcTime() - record_time;
         record_time = utcTime();
     }
@@ -190,6 +203,8 @@ void SyncMaster::doWork()
                            maintainDownloadingQueueBuffer_time_cost)
                     << LOG_KV("maintainPeersStatusTimeCost", maintainPeersStatus_time_cost)
                     << LOG_KV("maintainBlocksTimeCost", maintainBlocks_time_cost)
+                    << LOG_KV("maintainSnapshotRequestsTimeCost",
+                           maintainSnapshotRequests_time_cost)
                     << LOG_KV("maintainDownloadingTransactionsTimeCost",
                            maintainDownloadingTransactions_time_cost)
                     << LOG_KV("maintainTransactionsTimeCost", maintainTransactions_time_cost)
@@ -242,6 +257,16 @@ void SyncMaster::maintainTransactions()
 
     SYNC_LOG(TRACE) << LOG_BADGE("Tx") << LOG_DESC("Transaction need to send ")
                     << LOG_KV("txs", txSize) << LOG_KV("totalTxs", pendingSize);
+    // the peers whose gossip queue is near full miss this round, the txs are not marked known
+    // by them
+    std::set<NodeID> congestedPeers;
+    m_syncStatus->foreachPeer([&](shared_ptr<SyncPeerStatus> _p) {
+        if (m_service->isCongested(_p->nodeId, dev::network::TxGossipPriority))
+        {
+            congestedPeers.insert(_p->nodeId);
+        }
+        return true;
+    });
     UpgradableGuard l(m_txPool->xtransactionKnownBy());
     for (size_t i = 0; i < ts.size(); ++i)
     {
@@ -252,7 +277,8 @@ void SyncMaster::maintainTransactions()
         peers = m_syncStatus->randomSelection(_percent, [&](std::shared_ptr<SyncPeerStatus> _p) {
             bool unsent = !m_txPool->isTransactionKnownBy(t.sha3(), m_nodeId);
             bool isSealer = _p->isSealer;
-            return isSealer && unsent && !m_txPool->isTransactionKnownBy(t.sha3(), _p->nodeId);
+            return isSealer && unsent && !congestedPeers.count(_p->nodeId) &&
+                   !m_txPool->isTransactionKnownBy(t.sha3(), _p->nodeId);
         });
         if (0 == peers.size())
             return;
@@ -266,19 +292,22 @@ void SyncMaster::maintainTransactions()
     }
 
     m_syncStatus->foreachPeerRandom([&](shared_ptr<SyncPeerStatus> _p) {
-        std::vector<bytes> txRLPs;
+        // refer to the RLP kept by the txs instead of copying it for every peer
+        std::vector<bytesConstRef> txRLPs;
         unsigned txsSize = peerTransactions[_p->nodeId].size();
         if (0 == txsSize)
             return true;  // No need to send
 
         for (auto const& i : peerTransactions[_p->nodeId])
-            txRLPs.emplace_back(ts[i].rlp(WithSignature));
+            txRLPs.emplace_back(ref(*ts[i].rlpBuffer()));
 
         SyncTransactionsPacket packet;
         packet.encode(txRLPs);
 
         auto msg = packet.toMessage(m_protocolId);
-        m_service->asyncSendMessageByNodeID(_p->nodeId, msg, CallbackFuncWithSession(), Options());
+        Options options;
+        options.priority = dev::network::TxGossipPriority;
+        m_service->asyncSendMessageByNodeID(_p->nodeId, msg, CallbackFuncWithSession(), options);
 
         SYNC_LOG(DEBUG) << LOG_BADGE("Tx") << LOG_DESC("Send transaction to peer")
                         << LOG_KV("txNum", int(txsSize))
@@ -370,6 +399,18 @@ void SyncMaster::maintainPeersStatus()
         }
     }
 
+    // Blocks are not requested until the snapshot is imported
+    if (m_syncStatus->state == SyncState::Snapshot)
+        return;
+
+    if (m_syncStatus->state == SyncState::Idle &&
+        m_snapshotSync->needSnapshot(currentNumber, maxPeerNumber) &&
+        m_snapshotSync->startDownloading())
+    {
+        m_syncStatus->state = SyncState::Snapshot;
+        return;
+    }
+
     // Skip downloading if last if not timeout
 
     uint64_t currentTime = utcTime();
@@ -474,20 +515,18 @@ bool SyncMaster::maintainDownloadingQueue()
     BlockPtr topBlock = bq.top();
     while (topBlock != nullptr && topBlock->header().number() <= (m_blockChain->number() + 1))
     {
+        // let the decoder prepare the following blocks while this one is executing
+        asyncFlushBufferToQueue();
         try
         {
             if (isNewBlock(topBlock))
             {
                 auto record_time = utcTime();
-                auto parentBlock =
-                    m_blockChain->getBlockByNumber(topBlock->blockHeader().number() - 1);
-                BlockInfo parentBlockInfo{parentBlock->header().hash(),
-                    parentBlock->header().number(), parentBlock->header().stateRoot()};
-                auto getBlockByNumber_time_cost = utcTime() - record_time;
+                BlockInfo parentInfo = parentBlockInfo(topBlock);
+                auto getParent_time_cost = utcTime() - record_time;
                 record_time = utcTime();
 
-                ExecutiveContext::Ptr exeCtx =
-                    m_blockVerifier->executeBlock(*topBlock, parentBlockInfo);
+                ExecutiveContext::Ptr exeCtx = m_blockVerifier->executeBlock(*topBlock, parentInfo);
                 auto executeBlock_time_cost = utcTime() - record_time;
                 record_time = utcTime();
 
@@ -496,6 +535,10 @@ bool SyncMaster::maintainDownloadingQueue()
                 record_time = utcTime();
                 if (ret == CommitResult::OK)
                 {
+                    m_lastCommittedBlockInfo = BlockInfo{topBlock->header().hash(),
+                        topBlock->header().number(), topBlock->header().stateRoot()};
+                    m_syncStatus->noteDownloadedBlockCommitted();
+                    m_downloadedBlocks->inc();
                     m_txPool->dropBlockTrans(*topBlock);
                     auto dropBlockTrans_time_cost = utcTime() - record_time;
                     SYNC_LOG(INFO) << LOG_BADGE("Download") << LOG_BADGE("BlockSync")
@@ -503,7 +546,7 @@ bool SyncMaster::maintainDownloadingQueue()
                                    << LOG_KV("number", topBlock->header().number())
                                    << LOG_KV("txs", topBlock->transactions().size())
                                    << LOG_KV("hash", topBlock->headerHash().abridged())
-                                   << LOG_KV("getBlockByNumberTimeCost", getBlockByNumber_time_cost)
+                                   << LOG_KV("getParentTimeCost", getParent_time_cost)
                                    << LOG_KV("executeBlockTimeCost", executeBlock_time_cost)
                                    << LOG_KV("commitBlockTimeCost", commitBlock_time_cost)
                                    << LOG_KV("dropBlockTransTimeCost", dropBlockTrans_time_cost);
@@ -660,12 +703,43 @@ void SyncMaster::maintainDownloadingQueueBuffer()
     if (m_syncStatus->state == SyncState::Downloading)
     {
         m_syncStatus->bq().clearFullQueueIfNotHas(m_blockChain->number() + 1);
-        m_syncStatus->bq().flushBufferToQueue();
+        asyncFlushBufferToQueue();
     }
     else
         m_syncStatus->bq().clear();
 }
 
+void SyncMaster::asyncFlushBufferToQueue()
+{
+    // only one decoding task at a time, the next one picks up what arrives meanwhile
+    if (m_decodingBuffer.exchange(true))
+        return;
+    m_decodeThread->enqueue([this]() {
+        try
+        {
+            m_syncStatus->bq().flushBufferToQueue();
+        }
+        catch (std::exception const& e)
+        {
+            SYNC_LOG(WARNING) << LOG_BADGE("Download") << LOG_DESC("Decode downloaded blocks failed")
+                              << LOG_KV("EINFO", boost::diagnostic_information(e));
+        }
+        m_decodingBuffer = false;
+    });
+}
+
+BlockInfo SyncMaster::parentBlockInfo(BlockPtr _block)
+{
+    // the parent is usually the block committed just before, no need to load it again
+    if (m_lastCommittedBlockInfo.number == _block->header().number() - 1 &&
+        m_lastCommittedBlockInfo.hash == _block->header().parentHash())
+        return m_lastCommittedBlockInfo;
+
+    auto parentBlock = m_blockChain->getBlockByNumber(_block->header().number() - 1);
+    return BlockInfo{parentBlock->header().hash(), parentBlock->header().number(),
+        parentBlock->header().stateRoot()};
+}
+
 void SyncMaster::maintainBlockRequest()
 {
     uint64_t timeout = utcTime() + c_respondDownloadRequestTimeout;
@@ -673,6 +747,9 @@ void SyncMaster::maintainBlockRequest()
         DownloadRequestQueue& reqQueue = _p->reqQueue;
         if (reqQueue.empty())
             return true;  // no need to respeond
+        // respond when the blocks sent before are written
+        if (m_service->isCongested(_p->nodeId, dev::network::BlockSyncPriority))
+            return true;
 
         // Just select one peer per maintain
         reqQueue.disablePush();  // drop push at this time
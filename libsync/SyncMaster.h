@@ -24,12 +24,15 @@
 #include "Common.h"
 #include "DownloadingTxsQueue.h"
 #include "RspBlockReq.h"
+#include "SnapshotSync.h"
 #include "SyncInterface.h"
 #include "SyncMsgEngine.h"
 #include "SyncStatus.h"
 #include <libblockchain/BlockChainInterface.h>
 #include <libblockverifier/BlockVerifierInterface.h>
 #include <libdevcore/FixedHash.h>
+#include <libdevcore/Metrics.h>
+#include <libdevcore/ThreadPool.h>
 #include <libdevcore/Worker.h>
 #include <libethcore/Common.h>
 #include <libethcore/Exceptions.h>
@@ -69,6 +72,14 @@ public:
             std::make_shared<SyncMasterStatus>(_blockChain, _protocolId, _genesisHash, _nodeId);
         m_msgEngine = std::make_shared<SyncMsgEngine>(_service, _txPool, _blockChain, m_syncStatus,
             m_txQueue, _protocolId, _nodeId, _genesisHash);
+        m_snapshotSync =
+            std::make_shared<SnapshotSync>(_service, _blockChain, _protocolId, _nodeId);
+        m_msgEngine->setSnapshotSync(m_snapshotSync);
+        m_decodeThread = std::make_shared<dev::ThreadPool>(
+            "SyncDecode-" + std::to_string(m_groupId), 1);
+        m_downloadedBlocks = &dev::metrics::MetricsRegistry::instance().counter(
+            "sync_committed_blocks_total", "downloaded blocks committed by sync",
+            dev::metrics::groupLabels(m_groupId));
 
         // signal registration
         m_tqReady = m_txPool->onReady([&]() { this->noteNewTransactions(); });
@@ -108,8 +119,15 @@ public:
         std::function<bool(dev::eth::Block const&)> _handler) override
     {
         fp_isConsensusOk = _handler;
+        m_snapshotSync->setConsensusVerifyHandler(_handler);
     };
 
+    /// serve snapshots to peers, and download one when far behind if _enableDownload
+    void setSnapshotStorage(dev::storage::StorageSnapshot::Ptr _storage, bool _enableDownload)
+    {
+        m_snapshotSync->setStorage(_storage, _enableDownload);
+    }
+
     void noteNewTransactions()
     {
         m_newTransactions = true;
@@ -159,6 +177,8 @@ private:
     std::shared_ptr<SyncMsgEngine> m_msgEngine;
     /// Downloading txs queue
     std::shared_ptr<DownloadingTxsQueue> m_txQueue;
+    /// Serve and download storage snapshots
+    std::shared_ptr<SnapshotSync> m_snapshotSync;
 
     // Internal data
     PROTOCOL_ID m_protocolId;
@@ -193,6 +213,14 @@ private:
     // verify handler to check downloading block
     std::function<bool(dev::eth::Block const&)> fp_isConsensusOk = nullptr;
 
+    /// decode the downloaded blocks while the queue top is executing
+    dev::ThreadPool::Ptr m_decodeThread;
+    std::atomic_bool m_decodingBuffer = {false};
+    /// info of the last committed downloaded block, used as parent of the next one
+    dev::blockverifier::BlockInfo m_lastCommittedBlockInfo = {dev::h256(), -1, dev::h256()};
+
+    dev::metrics::Counter* m_downloadedBlocks;
+
 public:
     void maintainTransactions();
     void maintainDownloadingTransactions();
@@ -205,6 +233,8 @@ public:
 
 private:
     bool isNewBlock(BlockPtr _block);
+    void asyncFlushBufferToQueue();
+    dev::blockverifier::BlockInfo parentBlockInfo(BlockPtr _block);
     void printSyncInfo();
 };
 
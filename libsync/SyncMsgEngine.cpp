@@ -115,6 +115,12 @@ bool SyncMsgEngine::interpret(SyncMsgPacket const& _packet)
         case ReqBlocskPacket:
             onPeerRequestBlocks(_packet);
             break;
+        case ReqSnapshotManifestPacket:
+        case SnapshotManifestPacket:
+        case ReqSnapshotChunkPacket:
+        case SnapshotChunkPacket:
+            onPeerSnapshot(_packet);
+            break;
         default:
             return false;
         }
@@ -175,9 +181,36 @@ void SyncMsgEngine::onPeerStatus(SyncMsgPacket const& _packet)
     }
 }
 
+void SyncMsgEngine::onPeerSnapshot(SyncMsgPacket const& _packet)
+{
+    if (!m_snapshotSync)
+        return;
+
+    switch (_packet.packetType)
+    {
+    case ReqSnapshotManifestPacket:
+        m_snapshotSync->onPeerRequestManifest(_packet.nodeId);
+        break;
+    case SnapshotManifestPacket:
+        if (m_syncStatus->state == SyncState::Snapshot)
+            m_snapshotSync->onPeerManifest(_packet.nodeId, _packet.rlp());
+        break;
+    case ReqSnapshotChunkPacket:
+        m_snapshotSync->onPeerRequestChunk(_packet.nodeId, _packet.rlp());
+        break;
+    case SnapshotChunkPacket:
+        if (m_syncStatus->state == SyncState::Snapshot)
+            m_snapshotSync->onPeerChunk(_packet.nodeId, _packet.rlp());
+        break;
+    default:
+        break;
+    }
+}
+
 void SyncMsgEngine::onPeerTransactions(SyncMsgPacket const& _packet)
 {
-    if (m_syncStatus->state == SyncState::Downloading)
+    if (m_syncStatus->state == SyncState::Downloading ||
+        m_syncStatus->state == SyncState::Snapshot)
     {
         SYNC_ENGINE_LOG(TRACE) << LOG_BADGE("Tx")
                                << LOG_DESC("Drop peer transactions when dowloading blocks")
@@ -24,6 +24,7 @@
 #include "Common.h"
 #include "DownloadingTxsQueue.h"
 #include "RspBlockReq.h"
+#include "SnapshotSync.h"
 #include "SyncMsgPacket.h"
 #include "SyncStatus.h"
 #include <libblockchain/BlockChainInterface.h>
@@ -66,6 +67,11 @@ public:
     void messageHandler(dev::p2p::NetworkException _e,
         std::shared_ptr<dev::p2p::P2PSession> _session, dev::p2p::P2PMessage::Ptr _msg);
 
+    void setSnapshotSync(std::shared_ptr<SnapshotSync> _snapshotSync)
+    {
+        m_snapshotSync = _snapshotSync;
+    }
+
 public:
     bool needCheckPacketInGroup = true;
 
@@ -79,6 +85,7 @@ private:
     void onPeerTransactions(SyncMsgPacket const& _packet);
     void onPeerBlocks(SyncMsgPacket const& _packet);
     void onPeerRequestBlocks(SyncMsgPacket const& _packet);
+    void onPeerSnapshot(SyncMsgPacket const& _packet);
 
 private:
     // Outside data
@@ -87,6 +94,7 @@ private:
     std::shared_ptr<dev::blockchain::BlockChainInterface> m_blockChain;
     std::shared_ptr<SyncMasterStatus> m_syncStatus;
     std::shared_ptr<DownloadingTxsQueue> m_txQueue;
+    std::shared_ptr<SnapshotSync> m_snapshotSync;
 
     // Internal data
     PROTOCOL_ID m_protocolId;
@@ -80,6 +80,15 @@ void SyncStatusPacket::encode(int64_t _number, h256 const& _genesisHash, h256 co
 }
 
 void SyncTransactionsPacket::encode(std::vector<bytes> const& _txRLPs)
+{
+    std::vector<bytesConstRef> txRefs;
+    txRefs.reserve(_txRLPs.size());
+    for (auto const& txRLP : _txRLPs)
+        txRefs.push_back(ref(txRLP));
+    encode(txRefs);
+}
+
+void SyncTransactionsPacket::encode(std::vector<bytesConstRef> const& _txRLPs)
 {
     if (g_BCOSConfig.version() >= RC2_VERSION)
     {
@@ -92,12 +101,12 @@ void SyncTransactionsPacket::encode(std::vector<bytes> const& _txRLPs)
     unsigned txsSize = unsigned(_txRLPs.size());
     for (size_t i = 0; i < _txRLPs.size(); i++)
     {
-        txRLPS += _txRLPs[i];
+        txRLPS.insert(txRLPS.end(), _txRLPs[i].begin(), _txRLPs[i].end());
     }
     prep(m_rlpStream, TransactionsPacket, txsSize).appendRaw(txRLPS, txsSize);
 }
 
-void SyncTransactionsPacket::encodeRC2(std::vector<bytes> const& _txRLPs)
+void SyncTransactionsPacket::encodeRC2(std::vector<bytesConstRef> const& _txRLPs)
 {
     m_rlpStream.clear();
     bytes txsBytes = dev::eth::TxsParallelParser::encode(_txRLPs);
@@ -125,3 +134,28 @@ void SyncReqBlockPacket::encode(int64_t _from, unsigned _size)
     m_rlpStream.clear();
     prep(m_rlpStream, ReqBlocskPacket, 2) << _from << _size;
 }
+
+void SyncReqSnapshotManifestPacket::encode()
+{
+    m_rlpStream.clear();
+    prep(m_rlpStream, ReqSnapshotManifestPacket, 0);
+}
+
+void SyncSnapshotManifestPacket::encode(
+    int64_t _number, dev::bytes const& _blockRLP, std::vector<h256> const& _chunkHashes)
+{
+    m_rlpStream.clear();
+    prep(m_rlpStream, SnapshotManifestPacket, 3) << _number << _blockRLP << _chunkHashes;
+}
+
+void SyncReqSnapshotChunkPacket::encode(int64_t _number, unsigned _index)
+{
+    m_rlpStream.clear();
+    prep(m_rlpStream, ReqSnapshotChunkPacket, 2) << _number << _index;
+}
+
+void SyncSnapshotChunkPacket::encode(int64_t _number, unsigned _index, dev::bytes const& _chunk)
+{
+    m_rlpStream.clear();
+    prep(m_rlpStream, SnapshotChunkPacket, 3) << _number << _index << _chunk;
+}
@@ -90,7 +90,9 @@ class SyncTransactionsPacket : public SyncMsgPacket
 public:
     SyncTransactionsPacket() { packetType = TransactionsPacket; }
     void encode(std::vector<bytes> const& _txRLPs);
-    void encodeRC2(std::vector<bytes> const& _txRLPs);
+    /// the txs are referred to, not copied, until the packet is encoded
+    void encode(std::vector<bytesConstRef> const& _txRLPs);
+    void encodeRC2(std::vector<bytesConstRef> const& _txRLPs);
 };
 
 class SyncBlocksPacket : public SyncMsgPacket
@@ -108,6 +110,34 @@ public:
     void encode(int64_t _from, unsigned _size);
 };
 
+class SyncReqSnapshotManifestPacket : public SyncMsgPacket
+{
+public:
+    SyncReqSnapshotManifestPacket() { packetType = ReqSnapshotManifestPacket; }
+    void encode();
+};
+
+class SyncSnapshotManifestPacket : public SyncMsgPacket
+{
+public:
+    SyncSnapshotManifestPacket() { packetType = SnapshotManifestPacket; }
+    void encode(int64_t _number, dev::bytes const& _blockRLP, std::vector<h256> const& _chunkHashes);
+};
+
+class SyncReqSnapshotChunkPacket : public SyncMsgPacket
+{
+public:
+    SyncReqSnapshotChunkPacket() { packetType = ReqSnapshotChunkPacket; }
+    void encode(int64_t _number, unsigned _index);
+};
+
+class SyncSnapshotChunkPacket : public SyncMsgPacket
+{
+public:
+    SyncSnapshotChunkPacket() { packetType = SnapshotChunkPacket; }
+    void encode(int64_t _number, unsigned _index, dev::bytes const& _chunk);
+};
+
 
 }  // namespace sync
 }  // namespace dev
@@ -186,4 +186,42 @@ NodeIDs SyncMasterStatus::randomSelectionSize(
         allowed.erase(allowed.begin() + n);
     }
     return chosen;
+}
+
+void SyncMasterStatus::noteDownloadedBlockCommitted()
+{
+    uint64_t now = utcTime();
+    WriteGuard l(x_catchUpSpeed);
+    if (m_catchUpWindowStart == 0 || now - m_catchUpWindowStart > 2 * c_catchUpSpeedWindow)
+    {
+        // first block after an idle period, start a new window
+        m_catchUpWindowStart = now;
+        m_catchUpWindowBlocks = 0;
+    }
+    ++m_catchUpWindowBlocks;
+
+    uint64_t elapsed = now - m_catchUpWindowStart;
+    if (elapsed >= c_catchUpSpeedWindow)
+    {
+        m_catchUpBlocksPerSecond = m_catchUpWindowBlocks * 1000.0 / elapsed;
+        m_catchUpWindowStart = now;
+        m_catchUpWindowBlocks = 0;
+    }
+}
+
+double SyncMasterStatus::catchUpBlocksPerSecond() const
+{
+    ReadGuard l(x_catchUpSpeed);
+    uint64_t elapsed = utcTime() - m_catchUpWindowStart;
+    if (m_catchUpWindowStart == 0 || elapsed > 2 * c_catchUpSpeedWindow)
+    {
+        // no block committed for a whole window
+        return 0;
+    }
+    if (elapsed > c_catchUpSpeedWindow)
+    {
+        // the window is overdue, the rate decays with the blocks committed in it so far
+        return std::min(m_catchUpBlocksPerSecond, m_catchUpWindowBlocks * 1000.0 / elapsed);
+    }
+    return m_catchUpBlocksPerSecond;
 }
\ No newline at end of file
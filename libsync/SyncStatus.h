@@ -132,6 +132,12 @@ public:
 
     DownloadingBlockQueue& bq() { return m_downloadingBlockQueue; }
 
+    /// called every time a downloaded block is committed
+    void noteDownloadedBlockCommitted();
+    /// committed downloaded blocks per second, measured over c_catchUpSpeedWindow and decayed to
+    /// 0 when no block is committed
+    double catchUpBlocksPerSecond() const;
+
 public:
     h256 genesisHash;
     mutable SharedMutex x_known;
@@ -145,6 +151,11 @@ private:
     mutable SharedMutex x_peerStatus;
     std::map<NodeID, std::shared_ptr<SyncPeerStatus>> m_peersStatus;
     DownloadingBlockQueue m_downloadingBlockQueue;
+
+    mutable SharedMutex x_catchUpSpeed;
+    uint64_t m_catchUpWindowStart = 0;
+    uint64_t m_catchUpWindowBlocks = 0;
+    double m_catchUpBlocksPerSecond = 0;
 };
 
 }  // namespace sync
@@ -28,16 +28,17 @@ namespace txpool
 {
 bool CommonTransactionNonceCheck::isNonceOk(dev::eth::Transaction const& _trans, bool needInsert)
 {
-    UpgradableGuard l(m_lock);
+    auto key = this->generateKey(_trans);
+    auto& nonceShard = shard(key);
+    UpgradableGuard l(nonceShard.lock);
     {
-        auto key = this->generateKey(_trans);
-        auto iter = m_cache.find(key);
-        if (iter != m_cache.end())
+        auto iter = nonceShard.nonces.find(key);
+        if (iter != nonceShard.nonces.end())
             return false;
         if (needInsert)
         {
             UpgradeGuard ul(l);
-            m_cache.insert(key);
+            nonceShard.nonces.insert(key);
         }
         return true;
     }
@@ -47,50 +48,56 @@ bool CommonTransactionNonceCheck::isNonceOk(dev::eth::Transaction const& _trans,
 
 void CommonTransactionNonceCheck::delCache(dev::eth::NonceKeyType const& key)
 {
-    UpgradableGuard l(m_lock);
+    auto& nonceShard = shard(key);
+    UpgradableGuard l(nonceShard.lock);
     {
-        auto iter = m_cache.find(key);
-        if (iter != m_cache.end())
+        auto iter = nonceShard.nonces.find(key);
+        if (iter != nonceShard.nonces.end())
         {
             UpgradeGuard ul(l);
-            m_cache.erase(iter);
+            nonceShard.nonces.erase(iter);
         }
     }
 }
 
 void CommonTransactionNonceCheck::delCache(Transactions const& _transcations)
 {
-    UpgradableGuard l(m_lock);
+    for (unsigned i = 0; i < _transcations.size(); i++)
     {
-        std::vector<dev::eth::NonceKeyType> delList;
-        for (unsigned i = 0; i < _transcations.size(); i++)
-        {
-            auto key = this->generateKey(_transcations[i]);
-            auto iter = m_cache.find(key);
-            if (iter != m_cache.end())
-            {
-                delList.push_back(key);
-            }
-        }
-
-        if (delList.size() > 0)
-        {
-            UpgradeGuard ul(l);
-            for (auto key : delList)
-            {
-                m_cache.erase(key);
-            }
-        }
+        delCache(this->generateKey(_transcations[i]));
     }
 }
 
 void CommonTransactionNonceCheck::insertCache(dev::eth::Transaction const& _transcation)
 {
-    WriteGuard l(m_lock);
+    insertNonce(this->generateKey(_transcation));
+}
+
+bool CommonTransactionNonceCheck::insertNonce(dev::eth::NonceKeyType const& _key)
+{
+    auto& nonceShard = shard(_key);
+    WriteGuard l(nonceShard.lock);
+    return nonceShard.nonces.insert(_key).second;
+}
+
+void CommonTransactionNonceCheck::clearCache()
+{
+    for (auto& nonceShard : m_shards)
+    {
+        WriteGuard l(nonceShard.lock);
+        nonceShard.nonces.clear();
+    }
+}
+
+size_t CommonTransactionNonceCheck::cacheSize() const
+{
+    size_t size = 0;
+    for (auto const& nonceShard : m_shards)
     {
-        auto key = this->generateKey(_transcation);
-        m_cache.insert(key);
+        ReadGuard l(nonceShard.lock);
+        size += nonceShard.nonces.size();
     }
+    return size;
 }
 
 }  // namespace txpool
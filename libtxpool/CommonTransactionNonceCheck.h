@@ -28,6 +28,7 @@
 #include <libethcore/Block.h>
 #include <libethcore/Protocol.h>
 #include <libethcore/Transaction.h>
+#include <array>
 #include <unordered_set>
 namespace dev
 {
@@ -44,10 +45,25 @@ public:
     virtual bool isNonceOk(dev::eth::Transaction const& _trans, bool needInsert = false);
 
     dev::eth::NonceKeyType generateKey(dev::eth::Transaction const& _t) { return _t.nonce(); }
+    size_t cacheSize() const;
 
 protected:
-    mutable SharedMutex m_lock;
-    std::unordered_set<dev::eth::NonceKeyType> m_cache;
+    /// the nonces are split into shards, so that importing transactions and removing the nonces
+    /// of a committed block don't wait for a single lock
+    static size_t const c_nonceShards = 16;
+    struct NonceShard
+    {
+        mutable SharedMutex lock;
+        std::unordered_set<dev::eth::NonceKeyType> nonces;
+    };
+    NonceShard& shard(dev::eth::NonceKeyType const& _key)
+    {
+        return m_shards[std::hash<dev::eth::NonceKeyType>()(_key) % c_nonceShards];
+    }
+    bool insertNonce(dev::eth::NonceKeyType const& _key);
+    void clearCache();
+
+    std::array<NonceShard, c_nonceShards> m_shards;
 };
 }  // namespace txpool
 }  // namespace dev
\ No newline at end of file
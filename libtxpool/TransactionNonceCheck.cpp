@@ -33,19 +33,20 @@ namespace txpool
 {
 void TransactionNonceCheck::init()
 {
-    m_startblk = 0;
-    m_endblk = 0;
+    m_blockCommittedHandler =
+        m_blockChain->onBlockCommitted([this](Block const& _block) { onBlockCommitted(_block); });
     updateCache(true);
 }
 bool TransactionNonceCheck::isBlockLimitOk(Transaction const& _tx)
 {
-    if (_tx.blockLimit() == Invalid256 || m_blockNumber >= _tx.blockLimit() ||
-        _tx.blockLimit() > (m_blockNumber + m_maxBlockLimit))
+    int64_t blockNumber = m_blockNumber;
+    if (_tx.blockLimit() == Invalid256 || blockNumber >= _tx.blockLimit() ||
+        _tx.blockLimit() > (blockNumber + m_maxBlockLimit))
     {
         NONCECHECKER_LOG(WARNING) << LOG_DESC("InvalidBlockLimit")
                                   << LOG_KV("blkLimit", _tx.blockLimit())
                                   << LOG_KV("maxBlkLimit", m_maxBlockLimit)
-                                  << LOG_KV("curBlk", m_blockNumber) << LOG_KV("tx", _tx.sha3());
+                                  << LOG_KV("curBlk", blockNumber) << LOG_KV("tx", _tx.sha3());
         return false;
     }
     return true;
@@ -58,105 +59,84 @@ bool TransactionNonceCheck::ok(Transaction const& _transaction, bool _needinsert
     return isNonceOk(_transaction, _needinsert);
 }
 
-void TransactionNonceCheck::getNonceAndUpdateCache(
-    NonceVec& nonceVec, int64_t const& blockNumber, bool const& update)
+void TransactionNonceCheck::appendBlockNonces(int64_t _blockNumber, NonceVec&& _nonces)
 {
-    if (m_blockNonceCache.count(blockNumber))
+    for (auto const& nonce : _nonces)
     {
-        nonceVec = m_blockNonceCache[blockNumber];
-        NONCECHECKER_LOG(TRACE) << LOG_DESC("updateCache: getNonceAndUpdateCache cache hit ")
-                                << LOG_KV("blockNumber", blockNumber)
-                                << LOG_KV("nonceSize", nonceVec.size())
-                                << LOG_KV("nonceCacheSize", m_blockNonceCache.size());
+        insertNonce(nonce);
     }
-    /// block cache hit
-    else if (m_blockChain->number() == blockNumber)
+    m_blockNonces[_blockNumber] = std::move(_nonces);
+}
+
+void TransactionNonceCheck::expireBlockNonces()
+{
+    /// keep the nonces of [m_blockNumber - m_maxBlockLimit, m_blockNumber]
+    int64_t startBlock = m_blockNumber - (int64_t)m_maxBlockLimit;
+    while (!m_blockNonces.empty() && m_blockNonces.begin()->first < startBlock)
     {
-        std::shared_ptr<Block> pBlock = m_blockChain->getBlockByNumber(blockNumber);
-        if (pBlock)
+        for (auto const& nonce : m_blockNonces.begin()->second)
         {
-            nonceVec = pBlock->getAllNonces();
-            NONCECHECKER_LOG(TRACE)
-                << LOG_DESC("updateCache: getNonceAndUpdateCache block cache hit ")
-                << LOG_KV("blockNumber", blockNumber) << LOG_KV("nonceSize", nonceVec.size())
-                << LOG_KV("nonceCacheSize", m_blockNonceCache.size());
+            delCache(nonce);
         }
+        m_blockNonces.erase(m_blockNonces.begin());
     }
-    else
-    {
-        m_blockChain->getNonces(nonceVec, blockNumber);
-        NONCECHECKER_LOG(TRACE) << LOG_DESC("updateCache: getNonceAndUpdateCache cache miss ")
-                                << LOG_KV("blockNumber", blockNumber)
-                                << LOG_KV("nonceSize", nonceVec.size())
-                                << LOG_KV("nonceCacheSize", m_blockNonceCache.size());
-    }
-    if (update && m_blockNonceCache.size() < m_maxBlockLimit)
+}
+
+void TransactionNonceCheck::onBlockCommitted(Block const& _block)
+{
+    Guard l(x_window);
+    auto number = _block.blockHeader().number();
+    if (number != m_blockNumber + 1)
     {
-        m_blockNonceCache[blockNumber] = nonceVec;
+        /// updateCache catches up from storage
+        NONCECHECKER_LOG(DEBUG) << LOG_DESC("onBlockCommitted: not the next block")
+                                << LOG_KV("number", number)
+                                << LOG_KV("windowNumber", m_blockNumber.load());
+        return;
     }
+    appendBlockNonces(number, _block.getAllNonces());
+    m_blockNumber = number;
+    expireBlockNonces();
+    NONCECHECKER_LOG(TRACE) << LOG_DESC("onBlockCommitted") << LOG_KV("number", number)
+                            << LOG_KV("nonceSize", _block.transactions().size())
+                            << LOG_KV("windowSize", m_blockNonces.size());
 }
 
 void TransactionNonceCheck::updateCache(bool _rebuild)
 {
-    WriteGuard l(m_lock);
+    Guard l(x_window);
     {
         try
         {
             Timer timer;
-            m_blockNumber = m_blockChain->number();
-            int64_t lastnumber = m_blockNumber;
-            int64_t prestartblk = m_startblk;
-            int64_t preendblk = m_endblk;
-
-            m_endblk = lastnumber;
-            if (lastnumber > m_maxBlockLimit)
+            int64_t chainNumber = m_blockChain->number();
+            int64_t preBlockNumber = m_blockNumber;
+            /// the chain is replaced underneath, e.g. imported from a snapshot
+            if (_rebuild || chainNumber < m_blockNumber)
             {
-                m_startblk = lastnumber - m_maxBlockLimit;
+                clearCache();
+                m_blockNonces.clear();
+                m_blockNumber = -1;
             }
-            else
+            if (chainNumber == m_blockNumber)
             {
-                m_startblk = 0;
+                return;
             }
-
-            NONCECHECKER_LOG(TRACE)
-                << LOG_DESC("updateCache") << LOG_KV("rebuild", _rebuild)
-                << LOG_KV("startBlk", m_startblk) << LOG_KV("endBlk", m_endblk)
-                << LOG_KV("prestartBlk", prestartblk) << LOG_KV("preEndBlk", preendblk);
-            if (_rebuild)
+            int64_t startBlock = std::max(m_blockNumber + 1,
+                chainNumber > m_maxBlockLimit ? chainNumber - (int64_t)m_maxBlockLimit : 0);
+            /// only the blocks missed by onBlockCommitted are read from storage
+            for (auto i = startBlock; i <= chainNumber; i++)
             {
-                m_cache.clear();
-                preendblk = 0;
+                NonceVec nonceVec;
+                m_blockChain->getNonces(nonceVec, i);
+                appendBlockNonces(i, std::move(nonceVec));
             }
-            else
-            {
-                /// erase the expired nonces
-                for (auto i = prestartblk; i < m_startblk; i++)
-                {
-                    NonceVec nonce_vec;
-                    getNonceAndUpdateCache(nonce_vec, i, false);
-                    for (auto nonce : nonce_vec)
-                    {
-                        m_cache.erase(nonce);
-                    }
-                    /// erase the expired nonces from cache since it can't be touched forever
-                    if (m_blockNonceCache.count(i))
-                    {
-                        m_blockNonceCache.erase(i);
-                    }
-                }
-            }
-            /// insert the nonces of a new block
-            for (auto i = std::max(preendblk + 1, m_startblk); i <= m_endblk; i++)
-            {
-                NonceVec nonce_vec;
-                getNonceAndUpdateCache(nonce_vec, i);
-                for (auto nonce : nonce_vec)
-                {
-                    m_cache.insert(nonce);
-                }
-            }  // for
+            m_blockNumber = chainNumber;
+            expireBlockNonces();
             NONCECHECKER_LOG(DEBUG)
-                << LOG_DESC("updateCache") << LOG_KV("cacheSize", m_cache.size())
+                << LOG_DESC("updateCache") << LOG_KV("rebuild", _rebuild)
+                << LOG_KV("preBlockNumber", preBlockNumber) << LOG_KV("startBlk", startBlock)
+                << LOG_KV("endBlk", chainNumber) << LOG_KV("cacheSize", cacheSize())
                 << LOG_KV("costTime", timer.elapsed() * 1000);
         }
         catch (...)
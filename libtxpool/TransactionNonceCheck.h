@@ -25,6 +25,7 @@
 #include "CommonTransactionNonceCheck.h"
 #include <libblockchain/BlockChainInterface.h>
 #include <boost/timer.hpp>
+#include <atomic>
 #include <thread>
 
 using namespace dev::eth;
@@ -38,6 +39,9 @@ namespace dev
 namespace txpool
 {
 using NonceVec = std::vector<dev::eth::NonceKeyType>;
+/// The nonces of the blocks in the block limit window. The window slides forward with every
+/// committed block, the storage is only read when the index is rebuilt at startup or has fallen
+/// behind the chain.
 class TransactionNonceCheck : public CommonTransactionNonceCheck
 {
 public:
@@ -49,28 +53,32 @@ public:
     ~TransactionNonceCheck() {}
     void init();
     bool ok(dev::eth::Transaction const& _transaction, bool _needinsert = false);
+    /// catch up with the chain, _rebuild: drop the index and reload the window from storage
     void updateCache(bool _rebuild = false);
     unsigned const& maxBlockLimit() const { return m_maxBlockLimit; }
     void setBlockLimit(unsigned const& limit) { m_maxBlockLimit = limit; }
 
     bool isBlockLimitOk(dev::eth::Transaction const& _trans);
 
-    void getNonceAndUpdateCache(
-        NonceVec& nonceVec, int64_t const& blockNumber, bool const& update = true);
+    /// append the nonces of a newly committed block to the window
+    void onBlockCommitted(dev::eth::Block const& _block);
+    int64_t blockNumber() const { return m_blockNumber; }
 
 private:
+    void appendBlockNonces(int64_t _blockNumber, NonceVec&& _nonces);
+    void expireBlockNonces();
+
     std::shared_ptr<dev::blockchain::BlockChainInterface> m_blockChain;
-    std::vector<NonceVec> nonce_vec;
-    /// cache the block nonce to in case of accessing the DB to get nonces of given block frequently
-    /// key: block number
-    /// value: all the nonces of a given block
-    /// we cache at most m_maxBlockLimit entries(occuppy about 32KB)
-    std::map<int64_t, NonceVec> m_blockNonceCache;
+    dev::eth::Handler<dev::eth::Block const&> m_blockCommittedHandler;
+
+    /// protect the window, the nonces themselves are protected by the shards
+    mutable Mutex x_window;
+    /// key: block number, value: all the nonces of the block
+    std::map<int64_t, NonceVec> m_blockNonces;
 
-    int64_t m_startblk;
-    int64_t m_endblk;
     unsigned m_maxBlockLimit = 1000;
-    int64_t m_blockNumber;
+    /// the latest block in the window
+    std::atomic<int64_t> m_blockNumber = {-1};
 };
 }  // namespace txpool
 }  // namespace dev
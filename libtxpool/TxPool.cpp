@@ -137,7 +137,7 @@ ImportResult TxPool::import(Transaction& _tx, IfDropped)
 
             m_callbackPool.enqueue([callback, receipt] { callback(receipt); });
         }
-
+        m_rejectedTxs->inc();
         return ImportResult::TransactionPoolIsFull;
     }
     /// check the verify result(nonce && signature check)
@@ -148,9 +148,14 @@ ImportResult TxPool::import(Transaction& _tx, IfDropped)
         if (insert(_tx))
         {
             m_commonNonceCheck->insertCache(_tx);
+            m_importedTxs->inc();
             m_onReady();
         }
     }
+    else
+    {
+        m_rejectedTxs->inc();
+    }
     return verify_ret;
 }
 
@@ -292,6 +297,7 @@ bool TxPool::removeTrans(h256 const& _txHash, bool needTriggerCallback,
     }
     m_txsQueue.erase(p_tx->second);
     m_txsHash.erase(p_tx);
+    m_pendingTxs->set(m_txsQueue.size());
     return true;
 }
 
@@ -308,6 +314,7 @@ bool TxPool::insert(Transaction const& _tx)
     }
     TransactionQueue::iterator p_tx = m_txsQueue.emplace(_tx).first;
     m_txsHash[tx_hash] = p_tx;
+    m_pendingTxs->set(m_txsQueue.size());
     return true;
 }
 
@@ -529,6 +536,7 @@ void TxPool::clear()
     WriteGuard l(m_lock);
     m_txsQueue.clear();
     m_txsHash.clear();
+    m_pendingTxs->set(0);
     m_dropped.clear();
     WriteGuard l_trans(x_transactionKnownBy);
     m_transactionKnownBy.clear();
@@ -25,6 +25,7 @@
 #include "TransactionNonceCheck.h"
 #include "TxPoolInterface.h"
 #include <libblockchain/BlockChainInterface.h>
+#include <libdevcore/Metrics.h>
 #include <libdevcore/ThreadPool.h>
 #include <libdevcore/easylog.h>
 #include <libethcore/Block.h>
@@ -79,6 +80,15 @@ public:
         m_groupId = dev::eth::getGroupAndProtocol(m_protocolId).first;
         m_txNonceCheck = std::make_shared<TransactionNonceCheck>(m_blockChain);
         m_commonNonceCheck = std::make_shared<CommonTransactionNonceCheck>();
+
+        auto& registry = dev::metrics::MetricsRegistry::instance();
+        auto labels = dev::metrics::groupLabels(m_groupId);
+        m_importedTxs = &registry.counter(
+            "txpool_imported_txs_total", "transactions imported into the txpool", labels);
+        m_rejectedTxs = &registry.counter(
+            "txpool_rejected_txs_total", "transactions rejected by the txpool", labels);
+        m_pendingTxs =
+            &registry.gauge("txpool_pending_txs", "transactions pending in the txpool", labels);
     }
     void setMaxBlockLimit(unsigned const& limit) { m_txNonceCheck->setBlockLimit(limit); }
     unsigned const& maxBlockLimit() { return m_txNonceCheck->maxBlockLimit(); }
@@ -217,6 +227,10 @@ private:
     std::unordered_map<h256, std::unordered_set<h512>> m_transactionKnownBy;
 
     dev::ThreadPool m_callbackPool;
+
+    dev::metrics::Counter* m_importedTxs;
+    dev::metrics::Counter* m_rejectedTxs;
+    dev::metrics::Gauge* m_pendingTxs;
 };
 }  // namespace txpool
 }  // namespace dev
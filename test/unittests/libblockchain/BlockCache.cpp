@@ -0,0 +1,108 @@
+/*
+ * @CopyRight:
+ * FISCO-BCOS is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * FISCO-BCOS is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with FISCO-BCOS.  If not, see <http://www.gnu.org/licenses/>
+ * (c) 2016-2018 fisco-dev contributors.
+ */
+/**
+ * @brief : unit test of the block cache
+ * @file: BlockCache.cpp
+ */
+#include <libblockchain/BlockCache.h>
+#include <test/tools/libutils/TestOutputHelper.h>
+#include <test/unittests/libethcore/FakeBlock.h>
+#include <boost/test/unit_test.hpp>
+
+using namespace dev;
+using namespace dev::eth;
+using namespace dev::blockchain;
+
+namespace dev
+{
+namespace test
+{
+BOOST_FIXTURE_TEST_SUITE(BlockCacheTest, TestOutputHelperFixture)
+
+BOOST_AUTO_TEST_CASE(getByHashAndNumber)
+{
+    BlockCache cache;
+    FakeBlock fakeBlock(5, KeyPair::create().secret(), 3);
+    auto blockRLP = std::make_shared<bytes>(fakeBlock.getBlock().rlp());
+    cache.add(fakeBlock.getBlock(), blockRLP);
+
+    auto byNumber = cache.get(int64_t(3));
+    BOOST_CHECK(byNumber.first->equalAll(fakeBlock.getBlock()));
+    BOOST_CHECK(*byNumber.second == *blockRLP);
+    auto byHash = cache.get(fakeBlock.getBlock().headerHash());
+    BOOST_CHECK(byHash.first == byNumber.first);
+    BOOST_CHECK(!cache.get(int64_t(4)).second);
+
+    BOOST_CHECK_EQUAL(cache.cacheQueries(), 3);
+    BOOST_CHECK_EQUAL(cache.cacheHits(), 2);
+    BOOST_CHECK_EQUAL(cache.cacheUsage(), blockRLP->size() * 2);
+}
+
+BOOST_AUTO_TEST_CASE(cacheRLPOnly)
+{
+    BlockCache cache;
+    FakeBlock fakeBlock(5, KeyPair::create().secret(), 1);
+    auto blockRLP = std::make_shared<bytes>(fakeBlock.getBlock().rlp());
+    cache.add(1, fakeBlock.getBlock().headerHash(), blockRLP);
+    auto cached = cache.get(int64_t(1));
+    BOOST_CHECK(!cached.first);
+    BOOST_CHECK(*cached.second == *blockRLP);
+
+    // the decoded block replaces the RLP-only entry
+    cache.add(fakeBlock.getBlock(), blockRLP);
+    BOOST_CHECK(cache.get(int64_t(1)).first);
+    BOOST_CHECK_EQUAL(cache.size(), 1);
+    // but not the other way around
+    cache.add(1, fakeBlock.getBlock().headerHash(), blockRLP);
+    BOOST_CHECK(cache.get(int64_t(1)).first);
+}
+
+BOOST_AUTO_TEST_CASE(evictLeastRecentlyUsed)
+{
+    std::vector<std::shared_ptr<FakeBlock>> blocks;
+    for (uint64_t i = 0; i < 3; ++i)
+    {
+        blocks.push_back(std::make_shared<FakeBlock>(5, KeyPair::create().secret(), i));
+    }
+    int64_t blockSize = blocks[0]->getBlock().rlp().size() * 2;
+    // room for two blocks
+    BlockCache cache(blockSize * 2 + blockSize / 2);
+    cache.add(blocks[0]->getBlock(), std::make_shared<bytes>(blocks[0]->getBlock().rlp()));
+    cache.add(blocks[1]->getBlock(), std::make_shared<bytes>(blocks[1]->getBlock().rlp()));
+    // block 0 becomes the most recently used one
+    BOOST_CHECK(cache.get(int64_t(0)).first);
+    cache.add(blocks[2]->getBlock(), std::make_shared<bytes>(blocks[2]->getBlock().rlp()));
+
+    BOOST_CHECK_EQUAL(cache.size(), 2);
+    BOOST_CHECK(cache.get(int64_t(0)).first);
+    BOOST_CHECK(!cache.get(int64_t(1)).first);
+    BOOST_CHECK(!cache.get(blocks[1]->getBlock().headerHash()).first);
+    BOOST_CHECK(cache.get(int64_t(2)).first);
+
+    // shrinking keeps the latest used block only
+    cache.setCacheCapacity(blockSize);
+    BOOST_CHECK_EQUAL(cache.size(), 1);
+    BOOST_CHECK(cache.get(int64_t(2)).first);
+
+    cache.clear();
+    BOOST_CHECK_EQUAL(cache.size(), 0);
+    BOOST_CHECK_EQUAL(cache.cacheUsage(), 0);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+}  // namespace test
+}  // namespace dev
@@ -1,8 +1,10 @@
 #include <libblockchain/BlockChainImp.h>
 #include <libblockverifier/ExecutiveContext.h>
+#include <libconfig/GlobalConfigure.h>
 #include <libdevcore/CommonData.h>
 #include <libethcore/Block.h>
 #include <libethcore/BlockHeader.h>
+#include <libethcore/LogFilter.h>
 #include <libethcore/Transaction.h>
 #include <libstorage/Common.h>
 #include <libstorage/MemoryTable.h>
@@ -75,6 +77,11 @@ public:
 
     Entries::ConstPtr select(const std::string& key, Condition::Ptr) override
     {
+        if (m_table == SYS_LOG_INDEX)
+        {
+            auto it = m_logIndex.find(key);
+            return it == m_logIndex.end() ? std::make_shared<Entries>() : it->second;
+        }
         Entries::Ptr entries = std::make_shared<Entries>();
 
         if (m_fakeStorage.find(m_table) != m_fakeStorage.end() &&
@@ -88,6 +95,17 @@ public:
 
     int insert(const std::string& key, Entry::Ptr entry, AccessOptions::Ptr, bool) override
     {
+        if (m_table == SYS_LOG_INDEX)
+        {
+            // a key of the log index has a row per block
+            auto& entries = m_logIndex[key];
+            if (!entries)
+            {
+                entries = std::make_shared<Entries>();
+            }
+            entries->addEntry(entry);
+            return 0;
+        }
         m_fakeStorage[m_table].insert(std::make_pair(key, entry));
         return 0;
     }
@@ -105,6 +123,39 @@ public:
 
     std::string m_table;
     std::unordered_map<std::string, std::unordered_map<std::string, Entry::Ptr>> m_fakeStorage;
+    std::unordered_map<std::string, Entries::Ptr> m_logIndex;
+};
+
+// a table opened by name, the tables opened at the same time don't share the name
+class MockTableView : public dev::storage::MemoryTable<Serial>
+{
+public:
+    MockTableView(std::shared_ptr<MockTable> _mockTable, const std::string& _table)
+      : m_mockTable(_mockTable), m_table(_table)
+    {}
+
+    Entries::ConstPtr select(const std::string& key, Condition::Ptr condition) override
+    {
+        m_mockTable->m_table = m_table;
+        return m_mockTable->select(key, condition);
+    }
+
+    int insert(const std::string& key, Entry::Ptr entry, AccessOptions::Ptr options,
+        bool needSelect) override
+    {
+        m_mockTable->m_table = m_table;
+        return m_mockTable->insert(key, entry, options, needSelect);
+    }
+
+    int update(const std::string& key, Entry::Ptr entry, Condition::Ptr condition,
+        AccessOptions::Ptr options) override
+    {
+        m_mockTable->m_table = m_table;
+        return m_mockTable->update(key, entry, condition, options);
+    }
+
+    std::shared_ptr<MockTable> m_mockTable;
+    std::string m_table;
 };
 
 class MockMemoryTableFactory : public dev::storage::MemoryTableFactory
@@ -115,7 +166,7 @@ public:
     Table::Ptr openTable(const std::string& _table, bool = true, bool = false) override
     {
         m_mockTable->m_table = _table;
-        return m_mockTable;
+        return std::make_shared<MockTableView>(m_mockTable, _table);
     }
 
     std::shared_ptr<MockTable> m_mockTable;
@@ -307,6 +358,104 @@ BOOST_AUTO_TEST_CASE(commitBlock)
     BOOST_CHECK_EQUAL(m_blockChainImp->totalTransactionCount().second, 2);
 }
 
+BOOST_AUTO_TEST_CASE(reload)
+{
+    int64_t reloadedNumber = -1;
+    auto handler = m_blockChainImp->onReload(
+        [&reloadedNumber](int64_t _number) { reloadedNumber = _number; });
+    m_blockChainImp->reload();
+    BOOST_CHECK_EQUAL(reloadedNumber, m_blockChainImp->number());
+    BOOST_CHECK_EQUAL(reloadedNumber, 0);
+
+    // the handler is unregistered once released
+    handler.reset();
+    reloadedNumber = -1;
+    m_blockChainImp->reload();
+    BOOST_CHECK_EQUAL(reloadedNumber, -1);
+}
+
+BOOST_AUTO_TEST_CASE(logIndex)
+{
+    auto version = g_BCOSConfig.version();
+    auto supportedVersion = g_BCOSConfig.supportedVersion();
+    g_BCOSConfig.setSupportedVersion("2.1.0", V2_1_0);
+    // the blocks 999 and 1000 are in two segments of the index
+    m_mockTable->m_fakeStorage[SYS_CURRENT_STATE][SYS_KEY_CURRENT_NUMBER]->setField(
+        "value", std::to_string(BlockChainImp::c_logIndexBlocks - 2));
+    m_blockChainImp->reload();
+
+    Address a(0xa), b(0xb);
+    h256 t1(0x1), t2(0x2);
+    auto commit = [&](std::vector<LogEntry> const& _logs) {
+        FakeBlock fakeBlock(_logs.size());
+        auto& block = fakeBlock.getBlock();
+        TransactionReceipts receipts;
+        for (auto const& log : _logs)
+        {
+            receipts.emplace_back(h256(), u256(0), LogEntries{log},
+                executive::TransactionException::None, bytes(), Address());
+        }
+        block.setTransactionReceipts(receipts);
+        block.header().setNumber(m_blockChainImp->number() + 1);
+        block.header().setParentHash(m_blockChainImp->numberHash(m_blockChainImp->number()));
+        BOOST_REQUIRE(m_blockChainImp->commitBlock(block, m_executiveContext) == CommitResult::OK);
+    };
+    // block 999, the logs of a and t1 are in two receipts, b and t1 are in different logs
+    commit({LogEntry(a, h256s{t1}, bytes()), LogEntry(b, h256s{t2}, bytes()),
+        LogEntry(a, h256s{t1}, bytes())});
+    commit({LogEntry(a, h256s{t2}, bytes())});
+    commit({LogEntry(b, h256s{t1}, bytes())});
+    BOOST_CHECK_EQUAL(m_blockChainImp->number(), BlockChainImp::c_logIndexBlocks + 1);
+
+    // a value has a posting per block in the segment of the block
+    auto postings = [&](std::string const& _key) -> std::vector<std::string> {
+        std::vector<std::string> numbers;
+        auto it = m_mockTable->m_logIndex.find(_key);
+        for (size_t i = 0; it != m_mockTable->m_logIndex.end() && i < it->second->size(); ++i)
+        {
+            numbers.push_back(it->second->get(i)->getField(SYS_VALUE));
+        }
+        return numbers;
+    };
+    BOOST_CHECK(postings(a.hex() + "_0") == std::vector<std::string>{"999"});
+    BOOST_CHECK(postings(a.hex() + "_1") == std::vector<std::string>{"1000"});
+    BOOST_CHECK(postings(t1.hex() + "_1") == std::vector<std::string>{"1001"});
+
+    auto blocksOf = [&](LogFilter const& _filter) -> std::vector<BlockNumber> {
+        std::vector<BlockNumber> blocks;
+        for (auto const& log : m_blockChainImp->getLogs(_filter))
+        {
+            blocks.push_back(log.blockNumber);
+        }
+        return blocks;
+    };
+    // the range spans the segments
+    LogFilter filter(0, 2000);
+    filter.addAddress(a);
+    BOOST_CHECK(blocksOf(filter) == (std::vector<BlockNumber>{999, 999, 1000}));
+    filter.setRange(1000, 1001);
+    BOOST_CHECK(blocksOf(filter) == std::vector<BlockNumber>{1000});
+
+    // the postings of the address and the topic are intersected, block 999 is a candidate of b
+    // and t1 but no log of it has both
+    filter = LogFilter(0, 2000);
+    filter.addAddress(b);
+    filter.addTopic(0, t1);
+    BOOST_CHECK(blocksOf(filter) == std::vector<BlockNumber>{1001});
+    filter = LogFilter(0, 2000);
+    filter.addAddress(a);
+    filter.addTopic(0, t2);
+    BOOST_CHECK(blocksOf(filter) == std::vector<BlockNumber>{1000});
+
+    // the candidates of the index are checked against the bloom of the block
+    m_mockTable->m_fakeStorage[SYS_BLOCK_2_BLOOM]["1000"]->setField(SYS_VALUE, toHex(LogBloom()));
+    filter = LogFilter(0, 2000);
+    filter.addAddress(a);
+    BOOST_CHECK(blocksOf(filter) == (std::vector<BlockNumber>{999, 999}));
+
+    g_BCOSConfig.setSupportedVersion(supportedVersion, version);
+}
+
 BOOST_AUTO_TEST_CASE(query)
 {
     dev::h512s sealerList = m_blockChainImp->sealerList();
@@ -37,8 +37,10 @@
 #include <test/unittests/libethcore/FakeBlock.h>
 #include <unistd.h>
 #include <boost/test/unit_test.hpp>
+#include <atomic>
 #include <chrono>
 #include <ctime>
+#include <thread>
 
 using namespace std;
 using namespace dev;
@@ -226,6 +228,81 @@ public:
     BlockVerifierFixture() : TestOutputHelperFixture() {}
 };
 
+/// exposes the call contexts of the verifier
+class FakeCallVerifier : public BlockVerifier
+{
+public:
+    using BlockVerifier::borrowCallContext;
+    using BlockVerifier::executeCall;
+    using BlockVerifier::returnCallContext;
+};
+
+/// a chain of the genesis block and a block saving the users of DagTransfer
+class CallContextFixture : public BlockVerifierFixture
+{
+public:
+    CallContextFixture()
+    {
+        std::shared_ptr<LedgerParamInterface> params = std::make_shared<LedgerParam>();
+        params->mutableStorageParam().type = "LevelDB";
+        params->mutableStorageParam().path =
+            "fakeBlockVerifier/LevelDB_callstate_" + to_string(utcTime());
+        params->mutableStateParam().type = "storage";
+        m_dbInitializer = std::make_shared<dev::ledger::DBInitializer>(params);
+        m_dbInitializer->initStorageDB();
+        m_blockChain = std::make_shared<BlockChainImp>();
+        m_blockChain->setStateStorage(m_dbInitializer->storage());
+        m_blockChain->setTableFactoryFactory(m_dbInitializer->tableFactoryFactory());
+        GenesisBlockParam initParam = {"", dev::h512s(), dev::h512s(), "consensusType",
+            "storageType", "stateType", 5000, 300000000, 0};
+        BOOST_REQUIRE(m_blockChain->checkAndBuildGenesisBlock(initParam));
+        m_dbInitializer->initState(m_blockChain->getBlockByNumber(0)->headerHash());
+
+        m_verifier = std::make_shared<FakeCallVerifier>();
+        m_verifier->setExecutiveContextFactory(m_dbInitializer->executiveContextFactory());
+        m_verifier->setNumberHash(boost::bind(&BlockChainImp::numberHash, m_blockChain, _1));
+        auto genesis = m_blockChain->getBlockByNumber(0);
+        FakeVerifierWithDagTransfer dagTransfer;
+        dagTransfer.initUser(c_users,
+            BlockInfo{genesis->header().hash(), genesis->header().number(),
+                genesis->header().stateRoot()},
+            m_verifier, m_blockChain);
+        m_genesisHeader = genesis->header();
+        m_header = m_blockChain->getBlockByNumber(1)->header();
+    }
+
+    Transaction callTransaction(bytes const& _data)
+    {
+        Transaction tx(u256(0), u256(0), u256(10000000), Address(0x5002), _data, u256(0));
+        tx.setBlockLimit(250);
+        tx.forceSender(Address(0x2333));
+        return tx;
+    }
+
+    /// @returns the balance of the user read by a call
+    u256 balance(std::string const& _user)
+    {
+        dev::eth::ContractABI abi;
+        auto result = m_verifier->executeTransaction(
+            m_header, callTransaction(abi.abiIn("userBalance(string)", _user)));
+        u256 ret;
+        u256 balance;
+        abi.abiOut(bytesConstRef(&result.second.outputBytes()), ret, balance);
+        BOOST_CHECK_EQUAL(ret, u256(0));
+        return balance;
+    }
+
+    static const size_t c_users = 4;
+    static const u256 c_balance;
+    std::shared_ptr<dev::ledger::DBInitializer> m_dbInitializer;
+    std::shared_ptr<BlockChainImp> m_blockChain;
+    std::shared_ptr<FakeCallVerifier> m_verifier;
+    BlockHeader m_genesisHeader;
+    BlockHeader m_header;
+};
+const size_t CallContextFixture::c_users;
+const u256 CallContextFixture::c_balance = u256(1000000000);
+
 BOOST_FIXTURE_TEST_SUITE(BlockVerifierTest, BlockVerifierFixture)
 
 
@@ -245,6 +322,123 @@ BOOST_AUTO_TEST_CASE(executeBlockTest)
 
 BOOST_AUTO_TEST_CASE(executeTransactionTest) {}
 
+BOOST_FIXTURE_TEST_CASE(callRollback, CallContextFixture)
+{
+    m_verifier->setCallThreads(1);
+    dev::eth::ContractABI abi;
+    // the table writes of a call are rolled back
+    auto result = m_verifier->executeCall(
+        m_header, callTransaction(abi.abiIn("userSave(string,uint256)", string("0"), u256(1))));
+    BOOST_CHECK(result.second.status() == TransactionException::None);
+    BOOST_CHECK_EQUAL(balance("0"), c_balance);
+
+    // the state writes of a call are rolled back, the init code returns a code of one byte
+    Transaction create(u256(0), u256(0), u256(10000000), fromHex("60016000f3"), u256(0));
+    create.setBlockLimit(250);
+    create.forceSender(Address(0x2333));
+    result = m_verifier->executeCall(m_header, create);
+    auto contract = result.second.contractAddress();
+    BOOST_CHECK(contract != Address());
+
+    // the pooled context served the calls
+    auto context = m_verifier->borrowCallContext(m_header);
+    BOOST_CHECK(!context->getState()->addressHasCode(contract));
+    auto table = context->getMemoryTableFactory()->openTable("_dag_transfer_");
+    BOOST_REQUIRE(table);
+    auto entries = table->select("0", table->newCondition());
+    BOOST_REQUIRE_EQUAL(entries->size(), 1u);
+    BOOST_CHECK_EQUAL(u256(entries->get(0)->getField("user_balance")), c_balance);
+    m_verifier->returnCallContext(m_header.hash(), context);
+}
+
+BOOST_FIXTURE_TEST_CASE(callContextPool, CallContextFixture)
+{
+    m_verifier->setCallThreads(2);
+    // a context returned is borrowed again by the calls of the block
+    auto context = m_verifier->borrowCallContext(m_header);
+    m_verifier->returnCallContext(m_header.hash(), context);
+    BOOST_CHECK_EQUAL(m_verifier->borrowCallContext(m_header), context);
+
+    // a context serves a call at a time
+    auto other = m_verifier->borrowCallContext(m_header);
+    BOOST_CHECK(other != context);
+
+    // at most a context per call thread is kept
+    auto third = m_verifier->borrowCallContext(m_header);
+    m_verifier->returnCallContext(m_header.hash(), context);
+    m_verifier->returnCallContext(m_header.hash(), other);
+    m_verifier->returnCallContext(m_header.hash(), third);
+    std::set<ExecutiveContext::Ptr> borrowed;
+    for (size_t i = 0; i < 3; ++i)
+    {
+        borrowed.insert(m_verifier->borrowCallContext(m_header));
+    }
+    BOOST_CHECK(borrowed.count(context));
+    BOOST_CHECK(borrowed.count(other));
+    BOOST_CHECK(!borrowed.count(third));
+}
+
+BOOST_FIXTURE_TEST_CASE(callContextBlockChanged, CallContextFixture)
+{
+    auto context = m_verifier->borrowCallContext(m_header);
+    m_verifier->returnCallContext(m_header.hash(), context);
+
+    // the contexts of the previous block are dropped
+    auto genesisContext = m_verifier->borrowCallContext(m_genesisHeader);
+    BOOST_CHECK(genesisContext != context);
+    auto stale = m_verifier->borrowCallContext(m_genesisHeader);
+    m_verifier->returnCallContext(m_genesisHeader.hash(), genesisContext);
+    BOOST_CHECK(m_verifier->borrowCallContext(m_header) != context);
+
+    // a context of a block no longer called is not pooled
+    m_verifier->returnCallContext(m_genesisHeader.hash(), stale);
+    BOOST_CHECK(m_verifier->borrowCallContext(m_genesisHeader) != stale);
+}
+
+BOOST_FIXTURE_TEST_CASE(concurrentCalls, CallContextFixture)
+{
+    m_verifier->setCallThreads(4);
+    dev::eth::ContractABI abi;
+    // the calls saving to the users run with the calls reading them on the call threads
+    std::atomic<size_t> mismatched(0);
+    std::vector<std::thread> threads;
+    for (size_t i = 0; i < 8; ++i)
+    {
+        threads.emplace_back([&, i]() {
+            for (size_t j = 0; j < 20; ++j)
+            {
+                auto user = to_string((i + j) % c_users);
+                if (i % 2 == 0)
+                {
+                    m_verifier->executeTransaction(m_header,
+                        callTransaction(abi.abiIn("userSave(string,uint256)", user, u256(1))));
+                }
+                else
+                {
+                    auto result = m_verifier->executeTransaction(
+                        m_header, callTransaction(abi.abiIn("userBalance(string)", user)));
+                    u256 ret;
+                    u256 balance;
+                    abi.abiOut(bytesConstRef(&result.second.outputBytes()), ret, balance);
+                    if (ret != u256(0) || balance != c_balance)
+                    {
+                        ++mismatched;
+                    }
+                }
+            }
+        });
+    }
+    for (auto& thread : threads)
+    {
+        thread.join();
+    }
+    BOOST_CHECK_EQUAL(mismatched.load(), 0u);
+    for (size_t i = 0; i < c_users; ++i)
+    {
+        BOOST_CHECK_EQUAL(balance(to_string(i)), c_balance);
+    }
+}
+
 BOOST_AUTO_TEST_SUITE_END()
 
 }  // namespace test
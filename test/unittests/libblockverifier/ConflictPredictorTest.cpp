@@ -0,0 +1,148 @@
+/*
+ * @CopyRight:
+ * FISCO-BCOS is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * FISCO-BCOS is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with FISCO-BCOS.  If not, see <http://www.gnu.org/licenses/>
+ * (c) 2016-2018 fisco-dev contributors.
+ */
+/**
+ * @brief : unitest of the conflict prediction of the parallel execution
+ * @file: ConflictPredictorTest.cpp
+ */
+
+#include <libblockverifier/ConflictPredictor.h>
+#include <libdevcrypto/Hash.h>
+#include <libethcore/ABI.h>
+#include <libethcore/Transaction.h>
+#include <test/tools/libutils/TestOutputHelper.h>
+#include <boost/test/unit_test.hpp>
+#include <set>
+
+using namespace std;
+using namespace dev;
+using namespace dev::blockverifier;
+using namespace dev::eth;
+
+namespace dev
+{
+namespace test
+{
+class ConflictPredictorFixture : TestOutputHelperFixture
+{
+public:
+    ConflictPredictorFixture() : TestOutputHelperFixture(){};
+
+    Transaction createTransferTx(Address const& _from, Address const& _to)
+    {
+        ContractABI abi;
+        bytes data = abi.abiIn("transfer(address,uint256)", _to, u256(10));
+        Transaction tx(0, 0, 10000000, contract, data, u256(utcTime() + rand()));
+        tx.forceSender(_from);
+        return tx;
+    }
+
+    /// the slot of balances[_owner] of a mapping at slot 0
+    u256 balanceSlot(Address const& _owner)
+    {
+        bytes input(64);
+        memcpy(input.data() + 12, _owner.data(), Address::size);
+        return u256(sha3(input));
+    }
+
+    /// the slots accessed by transfer: the balances of the sender and the receiver, the total
+    /// transfers at slot 3
+    StorageAccesses transferAccesses(Address const& _from, Address const& _to)
+    {
+        StorageAccesses accesses;
+        accesses.slots.emplace_back(contract, balanceSlot(_from));
+        accesses.slots.emplace_back(contract, balanceSlot(_to));
+        accesses.slots.emplace_back(contract, balanceSlot(_to));
+        accesses.slots.emplace_back(contract, u256(3));
+        return accesses;
+    }
+
+    Address contract = Address(0x23333333);
+    ConflictPredictor predictor;
+};
+
+BOOST_FIXTURE_TEST_SUITE(ConflictPredictorTest, ConflictPredictorFixture)
+
+BOOST_AUTO_TEST_CASE(learnAndPredict)
+{
+    for (size_t i = 0; i < ConflictPredictor::c_confirmations; ++i)
+    {
+        Address from(0x1000 + i);
+        Address to(0x2000 + i);
+        auto tx = createTransferTx(from, to);
+        BOOST_CHECK(predictor.predict(tx) == nullptr);
+        BOOST_CHECK(predictor.observe(tx, transferAccesses(from, to), nullptr));
+    }
+
+    Address from(0x3000);
+    Address to(0x4000);
+    auto tx = createTransferTx(from, to);
+    auto slots = predictor.predict(tx);
+    BOOST_REQUIRE(slots);
+    BOOST_CHECK_EQUAL(slots->size(), 3u);
+    std::set<u256> predicted;
+    for (auto const& slot : *slots)
+    {
+        BOOST_CHECK(slot.first == contract);
+        predicted.insert(slot.second);
+    }
+    BOOST_CHECK(predicted.count(balanceSlot(from)));
+    BOOST_CHECK(predicted.count(balanceSlot(to)));
+    BOOST_CHECK(predicted.count(u256(3)));
+    BOOST_CHECK(predictor.observe(tx, transferAccesses(from, to), slots));
+
+    // a slot not predicted is a violation, the function is learned again
+    auto accesses = transferAccesses(from, to);
+    accesses.slots.emplace_back(contract, u256(4));
+    BOOST_CHECK(!predictor.observe(tx, accesses, slots));
+    BOOST_CHECK(predictor.predict(tx) == nullptr);
+
+    auto status = predictor.status();
+    BOOST_REQUIRE_EQUAL(status.size(), 1u);
+    BOOST_CHECK_EQUAL(status[0]["selector"].asString(),
+        toHexPrefixed(sha3("transfer(address,uint256)").ref().cropped(0, 4)));
+    BOOST_CHECK_EQUAL(status[0]["predicted"].asUInt64(), 2u);
+    BOOST_CHECK_EQUAL(status[0]["violations"].asUInt64(), 1u);
+}
+
+BOOST_AUTO_TEST_CASE(unpredictable)
+{
+    Address from(0x1000);
+    Address to(0x2000);
+    auto tx = createTransferTx(from, to);
+    // the storage of another contract
+    auto accesses = transferAccesses(from, to);
+    accesses.slots.emplace_back(Address(0x5678), u256(0));
+    BOOST_CHECK(!ConflictPredictor::withinContract(tx, accesses));
+    for (size_t i = 0; i < ConflictPredictor::c_confirmations; ++i)
+    {
+        predictor.observe(tx, accesses, nullptr);
+    }
+    BOOST_CHECK(predictor.predict(tx) == nullptr);
+    BOOST_CHECK(!predictor.status()[0]["predictable"].asBool());
+
+    // a precompiled contract is called by the transfer of another contract
+    contract = Address(0x7777);
+    accesses = transferAccesses(from, to);
+    accesses.opaque = true;
+    auto otherTx = createTransferTx(from, to);
+    BOOST_CHECK(predictor.observe(otherTx, accesses, nullptr));
+    BOOST_CHECK(predictor.predict(otherTx) == nullptr);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+}  // namespace test
+}  // namespace dev
@@ -45,6 +45,7 @@ public:
         dev::eth::TransactionReceipt reciept;
         return std::make_pair(res, reciept);
     }
+    Json::Value conflictPredictions() override { return Json::Value(); }
 
 
 private:
@@ -141,6 +141,12 @@ public:
         return dev::consensus::RaftEngine::handleHeartbeat(_from, _node, _hb);
     }
 
+    bool handleAppendEntries(dev::u256 const& _from, dev::h512 const& _node,
+        dev::consensus::RaftAppendEntries const& _ae)
+    {
+        return dev::consensus::RaftEngine::handleAppendEntries(_from, _node, _ae);
+    }
+
     bool handleVoteRequest(
         dev::u256 const& _from, dev::h512 const& _node, dev::consensus::RaftVoteReq const& _req)
     {
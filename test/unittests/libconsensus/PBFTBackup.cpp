@@ -0,0 +1,142 @@
+/*
+ * @CopyRight:
+ * FISCO-BCOS is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * FISCO-BCOS is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with FISCO-BCOS.  If not, see <http://www.gnu.org/licenses/>
+ * (c) 2016-2018 fisco-dev contributors.
+ */
+
+/**
+ * @brief: unit test for libconsensus/pbft/PBFTBackup.h
+ * @file: PBFTBackup.cpp
+ */
+#include "PBFTReqCache.h"
+#include <libconsensus/pbft/PBFTBackup.h>
+#include <test/tools/libutils/TestOutputHelper.h>
+#include <boost/filesystem.hpp>
+#include <boost/test/unit_test.hpp>
+
+using namespace dev::consensus;
+using namespace dev::db;
+
+namespace dev
+{
+namespace test
+{
+struct PBFTBackupFixture : public TestOutputHelperFixture
+{
+    PBFTBackupFixture() : path("./test_pbft_backup.db")
+    {
+        boost::filesystem::remove_all(path);
+        leveldb::WriteOptions writeOptions = LevelDB::defaultWriteOptions();
+        writeOptions.sync = true;
+        db = std::make_shared<LevelDB>(
+            path, LevelDB::defaultReadOptions(), writeOptions, LevelDB::defaultDBOptions());
+        backup = std::make_shared<PBFTBackup>(db);
+    }
+    ~PBFTBackupFixture()
+    {
+        backup.reset();
+        db.reset();
+        boost::filesystem::remove_all(path);
+    }
+
+    PrepareReq fakeReq(int64_t _height, std::string const& _block)
+    {
+        KeyPair keyPair = KeyPair::create();
+        PrepareReq req(keyPair, _height, 1, 3, sha3(_block));
+        req.block = bytes(_block.begin(), _block.end());
+        return req;
+    }
+
+    size_t blockCount()
+    {
+        size_t count = 0;
+        db->forEach([&](Slice _key, Slice) {
+            if (std::string(_key.begin(), _key.end()).find("block_") == 0)
+            {
+                ++count;
+            }
+            return true;
+        });
+        return count;
+    }
+
+    boost::filesystem::path path;
+    std::shared_ptr<LevelDB> db;
+    std::shared_ptr<PBFTBackup> backup;
+};
+
+BOOST_FIXTURE_TEST_SUITE(PBFTBackupTest, PBFTBackupFixture)
+
+BOOST_AUTO_TEST_CASE(testRecordCodec)
+{
+    PrepareReq req = fakeReq(1000, "block");
+    std::string record = PBFTBackup::encodeRecord(req);
+    /// format, height, view, idx, 32 bytes timestamp, hash and two signatures
+    BOOST_CHECK_EQUAL(record.size(), 1 + 8 + 8 + 2 + 32 + h256::size + 2 * Signature::size);
+    PBFTMsg decoded;
+    BOOST_CHECK_NO_THROW(PBFTBackup::decodeRecord(record, decoded));
+    BOOST_CHECK(decoded == req);
+    BOOST_CHECK(decoded.height == req.height);
+    BOOST_CHECK(decoded.view == req.view);
+    BOOST_CHECK(decoded.sig2 == req.sig2);
+    BOOST_CHECK(decoded.idx == req.idx);
+    BOOST_CHECK(decoded.timestamp == req.timestamp);
+    /// the former backup is the hex-encoded RLP
+    bytes rlp;
+    PBFTMsg(req).encode(rlp);
+    BOOST_CHECK(record.size() < toHex(rlp).size());
+
+    BOOST_CHECK_THROW(PBFTBackup::decodeRecord(record.substr(1), decoded), DatabaseError);
+}
+
+BOOST_AUTO_TEST_CASE(testBackupAndReload)
+{
+    PrepareReq reloaded;
+    BOOST_CHECK(backup->reload("committed", reloaded) == false);
+
+    /// two prepare requests of the same height, the second is committed
+    PrepareReq stale = fakeReq(1000, "stale block");
+    PrepareReq committed = fakeReq(1000, "committed block");
+    PrepareReq future = fakeReq(1001, "future block");
+    backup->stageBlock(stale);
+    backup->stageBlock(future);
+    backup->backup("committed", committed);
+    BOOST_CHECK(backup->reload("committed", reloaded));
+    BOOST_CHECK(reloaded == committed);
+    BOOST_CHECK(reloaded.block == committed.block);
+    BOOST_CHECK_EQUAL(blockCount(), 2u);
+
+    /// the blocks not referred to are removed at startup
+    backup.reset();
+    backup = std::make_shared<PBFTBackup>(db);
+    backup->removeStaleBlocks("committed");
+    BOOST_CHECK_EQUAL(blockCount(), 1u);
+    BOOST_CHECK(backup->reload("committed", reloaded));
+    BOOST_CHECK(reloaded.block == committed.block);
+}
+
+BOOST_AUTO_TEST_CASE(testReloadFormerFormat)
+{
+    PrepareReq req = fakeReq(1000, "block");
+    bytes data;
+    req.encode(data);
+    db->insert(std::string("committed"), toHex(data));
+    PrepareReq reloaded;
+    BOOST_CHECK(backup->reload("committed", reloaded));
+    BOOST_CHECK(reloaded == req);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+}  // namespace test
+}  // namespace dev
@@ -115,6 +115,19 @@ BOOST_AUTO_TEST_CASE(testOnRecvPBFTMessage)
     CheckOnRecvPBFTMessage(fake_pbft.consensus(), session2, commit_req, CommitReqPacket, true);
     CheckOnRecvPBFTMessage(
         fake_pbft.consensus(), session2, viewChange_req, ViewChangeReqPacket, true);
+
+    /// the request signed by the sealer is verified before entering the queue
+    KeyPair sealer_keyPair(fake_pbft.m_secrets[0]);
+    SignReq sealer_req(prepare_req, sealer_keyPair, 0);
+    P2PMessage::Ptr message_ptr =
+        FakeReqMessage(fake_pbft.consensus(), sealer_req, SignReqPacket, ProtocolID::PBFT);
+    fake_pbft.consensus()->onRecvPBFTMessage(NetworkException(), session2, message_ptr);
+    std::pair<bool, PBFTMsgPacket> ret = fake_pbft.consensus()->mutableMsgQueue().tryPop(1000);
+    BOOST_CHECK(ret.first == true);
+    BOOST_CHECK(ret.second.verifiedSigner == fake_pbft.m_sealerList[0]);
+    /// the forged request is dropped
+    SignReq forged_req(prepare_req, key_pair2, 0);
+    CheckOnRecvPBFTMessage(fake_pbft.consensus(), session2, forged_req, SignReqPacket, false);
 }
 /// test broadcastMsg
 BOOST_AUTO_TEST_CASE(testBroadcastMsg)
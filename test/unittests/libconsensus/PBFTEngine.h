@@ -103,7 +103,8 @@ void CheckOnRecvPBFTMessage(std::shared_ptr<FakePBFTEngine> pbft,
 {
     P2PMessage::Ptr message_ptr = FakeReqMessage(pbft, req, packetType, ProtocolID::PBFT);
     pbft->onRecvPBFTMessage(NetworkException(), session, message_ptr);
-    std::pair<bool, PBFTMsgPacket> ret = pbft->mutableMsgQueue().tryPop(unsigned(5));
+    /// sign, commit and viewchange requests reach the queue after verified asynchronously
+    std::pair<bool, PBFTMsgPacket> ret = pbft->mutableMsgQueue().tryPop(valid ? 1000 : 5);
     if (valid == true)
     {
         BOOST_CHECK(ret.first == true);
@@ -246,12 +247,18 @@ static void checkBackupMsg(FakeConsensus<FakePBFTEngine>& fake_pbft, std::string
 {
     BOOST_CHECK(fake_pbft.consensus()->backupDB());
     /// insert succ
-    std::string data = fake_pbft.consensus()->backupDB()->lookup(key);
+    PrepareReq reloaded;
+    bool exists = fake_pbft.consensus()->backup()->reload(key, reloaded);
     if (msgData.size() == 0)
-        BOOST_CHECK(data.empty() == true);
+        BOOST_CHECK(exists == false);
     else
     {
-        BOOST_CHECK(data == toHex(msgData));
+        PrepareReq expected;
+        expected.decode(ref(msgData));
+        BOOST_CHECK(exists == true);
+        BOOST_CHECK(reloaded == expected);
+        BOOST_CHECK(reloaded.idx == expected.idx);
+        BOOST_CHECK(reloaded.timestamp == expected.timestamp);
         /// remove the key
         std::string empty = "";
         if (shouldClean)
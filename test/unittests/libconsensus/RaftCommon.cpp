@@ -173,6 +173,60 @@ BOOST_AUTO_TEST_CASE(testRaftHeartBeatResp)
     BOOST_CHECK(resp1.uncommitedBlockHash == resp2.uncommitedBlockHash);
 }
 
+BOOST_AUTO_TEST_CASE(testRaftAppendEntries)
+{
+    RaftAppendEntries ae1;
+    RaftAppendEntries ae2;
+
+    InsertBasicMsgInfo(ae1);
+    ae1.leader = raft::NodeIndex(0x2);
+    ae1.commitIndex = 0x10;
+    ae1.entries.push_back(bytes{0x01, 0x02});
+    ae1.entries.push_back(bytes());
+    ae1.uncommittedHash = h256(0x12);
+
+    RLPStream s;
+    ae1.streamRLPFields(s);
+    RLPStream l;
+    l.appendList(1).append(s.out());
+    bytes out;
+    l.swapOut(out);
+
+    RLP r(ref(out));
+    ae2.populate(r[0]);
+
+    BOOST_CHECK(BasisMsgEqual(ae1, ae2) == true);
+    BOOST_CHECK(ae1.leader == ae2.leader);
+    BOOST_CHECK(ae1.commitIndex == ae2.commitIndex);
+    BOOST_CHECK(ae1.entries == ae2.entries);
+    BOOST_CHECK(ae1.uncommittedHash == ae2.uncommittedHash);
+}
+
+BOOST_AUTO_TEST_CASE(testRaftAppendEntriesResp)
+{
+    RaftAppendEntriesResp resp1;
+    RaftAppendEntriesResp resp2;
+
+    InsertBasicMsgInfo(resp1);
+    resp1.matchIndex = 0x11;
+    resp1.matchHash = h256(0x13);
+    resp1.success = false;
+
+    RLPStream s;
+    resp1.streamRLPFields(s);
+    RLPStream l;
+    l.appendList(1).append(s.out());
+    bytes out;
+    l.swapOut(out);
+
+    RLP r(ref(out));
+    resp2.populate(r[0]);
+    BOOST_CHECK(BasisMsgEqual(resp1, resp2) == true);
+    BOOST_CHECK(resp1.matchIndex == resp2.matchIndex);
+    BOOST_CHECK(resp1.matchHash == resp2.matchHash);
+    BOOST_CHECK(resp2.success == false);
+}
+
 BOOST_AUTO_TEST_CASE(testBadMessage)
 {
     RaftMsg msg;
@@ -194,6 +248,10 @@ BOOST_AUTO_TEST_CASE(testBadMessage)
     BOOST_CHECK_THROW(hb.populate(r[0]), Exception);
     RaftHeartBeatResp hbResp;
     BOOST_CHECK_THROW(hbResp.populate(r[0]), Exception);
+    RaftAppendEntries ae;
+    BOOST_CHECK_THROW(ae.populate(r[0]), Exception);
+    RaftAppendEntriesResp aeResp;
+    BOOST_CHECK_THROW(aeResp.populate(r[0]), Exception);
     BOOST_CHECK_THROW(msg.populate(RLP()), Exception);
 }
 
@@ -22,6 +22,7 @@
  * @date: 2018-11-30
  */
 #include "FakeRaftEngine.h"
+#include <libconfig/GlobalConfigure.h>
 #include <libdevcrypto/Common.h>
 #include <libethcore/Protocol.h>
 #include <libp2p/P2PSession.h>
@@ -60,10 +61,16 @@ public:
 
     void asyncSendMessage(Message::Ptr, Options = Options(), CallbackFunc = CallbackFunc()) override
     {}
+    bool asyncSendMessages(std::vector<Message::Ptr> const&, Options) override { return true; }
     void setMessageHandler(
         std::function<void(NetworkException, std::shared_ptr<SessionFace>, Message::Ptr)>) override
     {}
     bool actived() const override { return true; }
+    bool congested(dev::network::PacketPriority) const override { return false; }
+    dev::network::WriteQueueStats writeQueueStats() const override
+    {
+        return dev::network::WriteQueueStats();
+    }
     std::shared_ptr<SocketFace> socket() override { return nullptr; }
 
 private:
@@ -238,6 +245,49 @@ BOOST_AUTO_TEST_CASE(testHandleHeartbeatMsg)
     BOOST_CHECK(stepDown == true);
 }
 
+BOOST_AUTO_TEST_CASE(testHandleAppendEntries)
+{
+    auto version = g_BCOSConfig.version();
+    auto supportedVersion = g_BCOSConfig.supportedVersion();
+    g_BCOSConfig.setSupportedVersion("2.1.0", V2_1_0);
+    raftEngine->setTerm(10);
+    raftEngine->setLastLeaderTerm(9);
+
+    RaftAppendEntries ae;
+    ae.term = 10;
+    ae.leader = 1;
+    ae.commitIndex = 4;
+    /// the block after the highest one is pending until the commit index covers it
+    auto block = fakeBlock.m_block;
+    block.header().setNumber(5);
+    ae.entries.push_back(bytes());
+    block.encode(ae.entries.back());
+    ae.uncommittedHash = block.header().hash();
+    BOOST_CHECK(raftEngine->handleAppendEntries(u256(1), h512(1), ae) == true);
+    BOOST_CHECK(raftEngine->getUncommitedBlock().header().number() == 5);
+    BOOST_CHECK(raftEngine->getHighestBlock().number() == 4);
+
+    /// the entries after a missing block are ignored
+    block.header().setNumber(7);
+    ae.entries.clear();
+    ae.entries.push_back(bytes());
+    block.encode(ae.entries.back());
+    raftEngine->handleAppendEntries(u256(1), h512(1), ae);
+    BOOST_CHECK(raftEngine->getUncommitedBlock().header().number() == 5);
+
+    /// the pending block is dropped if the leader holds another one
+    ae.entries.clear();
+    ae.uncommittedHash = h256(5);
+    raftEngine->handleAppendEntries(u256(1), h512(1), ae);
+    BOOST_CHECK(!bool(raftEngine->getUncommitedBlock()));
+    BOOST_CHECK(raftEngine->getHighestBlock().number() == 4);
+
+    /// discard the entries of a stale leader
+    ae.term = 8;
+    BOOST_CHECK(raftEngine->handleAppendEntries(u256(1), h512(1), ae) == false);
+    g_BCOSConfig.setSupportedVersion(supportedVersion, version);
+}
+
 BOOST_AUTO_TEST_CASE(testHandleVoteResponse)
 {
     VoteState voteState;
@@ -0,0 +1,99 @@
+/**
+ * @CopyRight:
+ * FISCO-BCOS is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * FISCO-BCOS is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with FISCO-BCOS.  If not, see <http://www.gnu.org/licenses/>
+ * (c) 2016-2018 fisco-dev contributors.
+ *
+ * @brief unit test of the metrics registry
+ *
+ * @file Metrics.cpp
+ */
+
+#include <libdevcore/Metrics.h>
+#include <test/tools/libutils/TestOutputHelper.h>
+#include <boost/test/unit_test.hpp>
+#include <thread>
+
+using namespace dev;
+using namespace dev::metrics;
+using namespace std;
+
+namespace dev
+{
+namespace test
+{
+BOOST_FIXTURE_TEST_SUITE(Metrics, TestOutputHelperFixture)
+
+BOOST_AUTO_TEST_CASE(testHistogramBuckets)
+{
+    for (uint64_t value : {0, 1, 3, 4, 7, 8, 9, 10, 100, 1000, 123456789})
+    {
+        size_t index = Histogram::bucketIndex(value);
+        BOOST_CHECK_LE(value, Histogram::bucketUpperBound(index));
+        if (index > 0)
+        {
+            BOOST_CHECK_GT(value, Histogram::bucketUpperBound(index - 1));
+        }
+    }
+    BOOST_CHECK_EQUAL(Histogram::bucketIndex(uint64_t(-1)), Histogram::c_bucketNum - 1);
+}
+
+BOOST_AUTO_TEST_CASE(testHistogramQuantile)
+{
+    Histogram histogram;
+    std::vector<std::thread> threads;
+    for (size_t i = 0; i < 4; ++i)
+    {
+        threads.emplace_back([&histogram]() {
+            for (uint64_t value = 1; value <= 1000; ++value)
+            {
+                histogram.observe(value);
+            }
+        });
+    }
+    for (auto& thread : threads)
+    {
+        thread.join();
+    }
+    auto snapshot = histogram.snapshot();
+    BOOST_CHECK_EQUAL(snapshot.count, 4000u);
+    BOOST_CHECK_EQUAL(snapshot.sum, 4 * 500500u);
+    // the bucket error is below 25%
+    BOOST_CHECK_GE(snapshot.quantile(0.5), 500u);
+    BOOST_CHECK_LE(snapshot.quantile(0.5), 625u);
+    BOOST_CHECK_GE(snapshot.quantile(0.99), 990u);
+}
+
+BOOST_AUTO_TEST_CASE(testRegistry)
+{
+    auto& registry = MetricsRegistry::instance();
+    auto& counter = registry.counter("metrics_test_total", "test counter", groupLabels(1));
+    BOOST_CHECK_EQUAL(&counter, &registry.counter("metrics_test_total", "", groupLabels(1)));
+    BOOST_CHECK_NE(&counter, &registry.counter("metrics_test_total", "", groupLabels(2)));
+    counter.inc(3);
+    registry.gauge("metrics_test_gauge", "test gauge").set(-2);
+    registry.histogram("metrics_test_us", "test histogram").observe(5);
+
+    auto text = registry.prometheusText();
+    BOOST_CHECK(text.find("# TYPE metrics_test_total counter\n") != std::string::npos);
+    BOOST_CHECK(text.find("metrics_test_total{group=\"1\"} 3\n") != std::string::npos);
+    BOOST_CHECK(text.find("metrics_test_total{group=\"2\"} 0\n") != std::string::npos);
+    BOOST_CHECK(text.find("metrics_test_gauge -2\n") != std::string::npos);
+    BOOST_CHECK(text.find("metrics_test_us_bucket{le=\"5\"} 1\n") != std::string::npos);
+    BOOST_CHECK(text.find("metrics_test_us_bucket{le=\"+Inf\"} 1\n") != std::string::npos);
+    BOOST_CHECK(text.find("metrics_test_us_count 1\n") != std::string::npos);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+}  // namespace test
+}  // namespace dev
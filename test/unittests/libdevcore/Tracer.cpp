@@ -0,0 +1,135 @@
+/**
+ * @CopyRight:
+ * FISCO-BCOS is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * FISCO-BCOS is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with FISCO-BCOS.  If not, see <http://www.gnu.org/licenses/>
+ * (c) 2016-2018 fisco-dev contributors.
+ *
+ * @brief unit test of the block pipeline tracer
+ *
+ * @file Tracer.cpp
+ */
+
+#include <libdevcore/Tracer.h>
+#include <test/tools/libutils/TestOutputHelper.h>
+#include <boost/test/unit_test.hpp>
+#include <set>
+#include <thread>
+
+using namespace dev;
+using namespace dev::trace;
+using namespace std;
+
+namespace dev
+{
+namespace test
+{
+struct TracerFixture : public TestOutputHelperFixture
+{
+    TracerFixture() { Tracer::instance().clear(); }
+    ~TracerFixture()
+    {
+        Tracer::instance().setEnabled(false);
+        Tracer::instance().setMaxBlocks(c_defaultMaxTracedBlocks);
+        Tracer::instance().clear();
+    }
+};
+
+BOOST_FIXTURE_TEST_SUITE(TracerTest, TracerFixture)
+
+BOOST_AUTO_TEST_CASE(testDisabled)
+{
+    Tracer::instance().setEnabled(false);
+    {
+        TRACE_SPAN("executeBlock", "execute", 1, 10);
+    }
+    BOOST_CHECK(Tracer::instance().traces(1, 10).empty());
+}
+
+BOOST_AUTO_TEST_CASE(testSpansAcrossThreads)
+{
+    auto& tracer = Tracer::instance();
+    tracer.setEnabled(true);
+    {
+        TRACE_SPAN("executeBlock", "execute", 1, 10);
+        std::vector<std::thread> threads;
+        for (size_t i = 0; i < 4; ++i)
+        {
+            threads.emplace_back([]() {
+                for (size_t j = 0; j < 10; ++j)
+                {
+                    TRACE_SPAN("executeTx", "execute", 1, 10);
+                }
+            });
+        }
+        for (auto& thread : threads)
+        {
+            thread.join();
+        }
+    }
+    auto traces = tracer.traces(1, 10);
+    BOOST_CHECK_EQUAL(traces.size(), 1u);
+    BOOST_CHECK_EQUAL(traces[0].number, 10);
+    BOOST_CHECK_EQUAL(traces[0].spans.size(), 41u);
+    // the block span encloses the transaction spans and is recorded last
+    auto const& blockSpan = traces[0].spans.back();
+    BOOST_CHECK_EQUAL(blockSpan.name, "executeBlock");
+    std::set<uint64_t> threadIds;
+    for (size_t i = 0; i + 1 < traces[0].spans.size(); ++i)
+    {
+        auto const& span = traces[0].spans[i];
+        BOOST_CHECK_EQUAL(span.name, "executeTx");
+        BOOST_CHECK_GE(span.startUs, blockSpan.startUs);
+        BOOST_CHECK_LE(span.startUs + span.durationUs, blockSpan.startUs + blockSpan.durationUs);
+        threadIds.insert(span.threadId);
+    }
+    BOOST_CHECK_EQUAL(threadIds.size(), 4u);
+    BOOST_CHECK_EQUAL(threadIds.count(blockSpan.threadId), 0u);
+    auto threadNames = tracer.threadNames();
+    for (auto id : threadIds)
+    {
+        BOOST_CHECK(threadNames.count(id));
+    }
+}
+
+BOOST_AUTO_TEST_CASE(testRingBuffer)
+{
+    auto& tracer = Tracer::instance();
+    tracer.setEnabled(true);
+    tracer.setMaxBlocks(3);
+    // the blocks do not arrive in order with several groups in parallel
+    for (int64_t number : {5, 1, 2, 4, 3, 6})
+    {
+        TRACE_SPAN("commitBlock", "blockchain", 1, number);
+    }
+    {
+        TRACE_SPAN("commitBlock", "blockchain", 2, 1);
+    }
+    auto traces = tracer.traces(1, 10);
+    BOOST_CHECK_EQUAL(traces.size(), 3u);
+    BOOST_CHECK_EQUAL(traces[0].number, 4);
+    BOOST_CHECK_EQUAL(traces[1].number, 5);
+    BOOST_CHECK_EQUAL(traces[2].number, 6);
+
+    traces = tracer.traces(1, 2);
+    BOOST_CHECK_EQUAL(traces.size(), 2u);
+    BOOST_CHECK_EQUAL(traces[0].number, 5);
+    BOOST_CHECK_EQUAL(traces[1].number, 6);
+
+    traces = tracer.traces(2, 10);
+    BOOST_CHECK_EQUAL(traces.size(), 1u);
+    BOOST_CHECK_EQUAL(traces[0].groupId, 2);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+}  // namespace test
+}  // namespace dev
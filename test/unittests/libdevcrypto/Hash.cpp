@@ -21,6 +21,7 @@
  */
 
 #include "libdevcrypto/Hash.h"
+#include "libdevcrypto/HashBatch.h"
 #include <libdevcore/Assertions.h>
 #include <libdevcore/CommonJS.h>
 #include <test/tools/libutils/TestOutputHelper.h>
@@ -190,6 +191,52 @@ BOOST_AUTO_TEST_CASE(testRipemd160)
     BOOST_CHECK(toJS(ripemd160(bsConst)) == cipherText);
 }
 #endif
+
+BOOST_AUTO_TEST_CASE(testSha3Batch)
+{
+    // lengths around the block sizes of keccak (136) and SM3 (64, 56 for the padding)
+    std::vector<bytes> contents;
+    for (size_t length = 0; length <= 300; ++length)
+    {
+        bytes content(length);
+        for (size_t i = 0; i < length; ++i)
+        {
+            content[i] = (byte)(i * 31 + length);
+        }
+        contents.push_back(content);
+    }
+    contents.push_back(bytes(5000, 0xab));
+
+    std::vector<crypto::HashKernel> kernels{crypto::HashKernel::Scalar};
+    if (crypto::bestHashKernel() != crypto::HashKernel::Scalar)
+    {
+        kernels.push_back(crypto::HashKernel::AVX2);
+    }
+    if (crypto::bestHashKernel() == crypto::HashKernel::AVX512)
+    {
+        kernels.push_back(crypto::HashKernel::AVX512);
+    }
+    // batch sizes around the lane numbers
+    for (size_t batchSize : {0, 1, 3, 4, 5, 8, 9, 17, 302})
+    {
+        std::vector<bytesConstRef> inputs;
+        for (size_t i = 0; i < batchSize; ++i)
+        {
+            // interleave long and short inputs
+            inputs.push_back(ref(contents[(i * 37) % contents.size()]));
+        }
+        for (auto kernel : kernels)
+        {
+            auto hashes = crypto::sha3Batch(inputs, kernel);
+            BOOST_REQUIRE_EQUAL(hashes.size(), inputs.size());
+            for (size_t i = 0; i < inputs.size(); ++i)
+            {
+                BOOST_CHECK_EQUAL(hashes[i], sha3(inputs[i]));
+            }
+        }
+        BOOST_CHECK(sha3Batch(inputs) == crypto::sha3Batch(inputs, crypto::HashKernel::Scalar));
+    }
+}
 BOOST_AUTO_TEST_SUITE_END()
 }  // namespace test
 }  // namespace dev
@@ -671,6 +671,36 @@ BOOST_AUTO_TEST_CASE(ContractABI_AbiOutString1)
     BOOST_CHECK(allOut[0] == "aaaaaaa");
 }
 
+BOOST_AUTO_TEST_CASE(ContractABI_AbiOutView)
+{
+    u256 u = 111111111;
+    std::string s = "test string";
+    std::string l(100, 'l');
+    std::vector<std::string> v{"a", l, ""};
+    ContractABI ct;
+    auto in = ct.abiIn("", s, u, l, v);
+    BOOST_CHECK_EQUAL(in.size(), 4 * 32 + ContractABI::encodedSize(s) +
+                                     ContractABI::encodedSize(l) + ContractABI::encodedSize(v));
+
+    bytesConstRef sRef, lRef;
+    u256 outU;
+    std::vector<std::string> outV;
+    BOOST_CHECK(ct.abiOut(bytesConstRef(&in), sRef, outU, lRef, outV));
+    BOOST_CHECK_EQUAL(sRef.toString(), s);
+    BOOST_CHECK_EQUAL(lRef.toString(), l);
+    BOOST_CHECK(outU == u);
+    BOOST_CHECK(outV == v);
+    // the views point into the encoded data
+    BOOST_CHECK(sRef.data() >= in.data() && sRef.data() + sRef.size() <= in.data() + in.size());
+
+    // a view encodes like the string
+    BOOST_CHECK(ct.abiIn("", sRef, u, lRef, v) == in);
+    BOOST_CHECK(ct.serialise(sRef) == ct.serialise(s));
+
+    bytes truncated(in.begin(), in.begin() + in.size() - 32);
+    BOOST_CHECK(!ct.abiOut(bytesConstRef(&truncated), sRef, outU, lRef, outV));
+}
+
 BOOST_AUTO_TEST_SUITE_END()
 }  // namespace test
 }  // namespace dev
\ No newline at end of file
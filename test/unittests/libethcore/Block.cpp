@@ -23,6 +23,7 @@
 #include "FakeBlock.h"
 #include <libethcore/Block.h>
 #include <libethcore/BlockHeader.h>
+#include <libethcore/ReceiptsParallelParser.h>
 #include <libethcore/Transaction.h>
 #include <test/tools/libutils/TestOutputHelper.h>
 #include <boost/test/unit_test.hpp>
@@ -89,6 +90,48 @@ BOOST_AUTO_TEST_CASE(testExceptionCases)
     fake_block.CheckInvalidBlockData(1);
 }
 
+/// test the receipts encoded with offsets since 2.1.0
+BOOST_AUTO_TEST_CASE(testLazyReceipts)
+{
+    auto version = g_BCOSConfig.version();
+    auto supportedVersion = g_BCOSConfig.supportedVersion();
+    g_BCOSConfig.setSupportedVersion("2.1.0", V2_1_0);
+    FakeBlock fake_block(5);
+    Block& block = fake_block.getBlock();
+    for (size_t i = 0; i < block.transactionReceipts().size(); ++i)
+    {
+        block.setTransactionReceipt(i, TransactionReceipt(h256(i), u256(100 + i), LogEntries(),
+                                           executive::TransactionException::None, bytes(),
+                                           Address(i)));
+    }
+    block.calReceiptRoot();
+    bytes blockData;
+    block.encode(blockData);
+
+    Block decoded(blockData);
+    BOOST_CHECK_EQUAL(decoded.receiptsSize(), 5u);
+    BOOST_CHECK(decoded.transactionReceipt(3).rlp() == block.transactionReceipts()[3].rlp());
+    BOOST_CHECK_THROW(decoded.transactionReceipt(5), InvalidBlockFormat);
+    /// the copy decodes the shared receipts on its own
+    Block copied(decoded);
+    BOOST_CHECK_EQUAL(decoded.transactionReceipts().size(), 5u);
+    for (size_t i = 0; i < 5; ++i)
+    {
+        BOOST_CHECK(decoded.transactionReceipts()[i].rlp() == block.transactionReceipts()[i].rlp());
+        BOOST_CHECK(copied.transactionReceipt(i).gasUsed() == u256(100 + i));
+    }
+    decoded.calReceiptRoot();
+    BOOST_CHECK(decoded.header().receiptsRoot() == block.header().receiptsRoot());
+
+    /// the offsets are checked when the block is decoded
+    std::vector<bytes> receiptRLPs(2, block.transactionReceipts()[0].rlp());
+    bytes receiptsData = ReceiptsParallelParser::encode(receiptRLPs);
+    BOOST_CHECK_EQUAL(ReceiptsParallelParser::split(ref(receiptsData)).size(), 2u);
+    receiptsData.pop_back();
+    BOOST_CHECK_THROW(ReceiptsParallelParser::split(ref(receiptsData)), InvalidBlockFormat);
+    g_BCOSConfig.setSupportedVersion(supportedVersion, version);
+}
+
 BOOST_AUTO_TEST_SUITE_END()
 
 }  // namespace test
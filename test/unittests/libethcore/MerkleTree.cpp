@@ -0,0 +1,124 @@
+/*
+ * @CopyRight:
+ * FISCO-BCOS is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * FISCO-BCOS is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with FISCO-BCOS.  If not, see <http://www.gnu.org/licenses/>
+ * (c) 2016-2018 fisco-dev contributors.
+ */
+/**
+ * @brief unit test of the binary Merkle tree
+ *
+ * @file MerkleTree.cpp
+ */
+#include "FakeBlock.h"
+#include <libethcore/Block.h>
+#include <libethcore/MerkleTree.h>
+#include <test/tools/libutils/TestOutputHelper.h>
+#include <boost/test/unit_test.hpp>
+
+using namespace dev;
+using namespace dev::eth;
+
+namespace dev
+{
+namespace test
+{
+/// the root computed level by level as the reference, with the prefixes of RFC 6962
+static h256 referenceRoot(std::vector<h256> const& _leaves)
+{
+    std::vector<h256> nodes;
+    for (auto const& leaf : _leaves)
+    {
+        nodes.push_back(sha3(bytes{0} + leaf.asBytes()));
+    }
+    while (nodes.size() > 1)
+    {
+        std::vector<h256> parents;
+        for (size_t i = 0; i + 1 < nodes.size(); i += 2)
+        {
+            parents.push_back(sha3(bytes{1} + nodes[i].asBytes() + nodes[i + 1].asBytes()));
+        }
+        if (nodes.size() % 2)
+        {
+            parents.push_back(nodes.back());
+        }
+        nodes = parents;
+    }
+    return nodes[0];
+}
+
+BOOST_FIXTURE_TEST_SUITE(MerkleTreeTest, TestOutputHelperFixture)
+
+BOOST_AUTO_TEST_CASE(testRootAndProof)
+{
+    BOOST_CHECK(MerkleTree(std::vector<h256>()).root() == sha3(bytes()));
+    // above c_pairsPerTask for the parallel levels
+    for (size_t count : {1, 2, 3, 5, 8, 13, 1000})
+    {
+        std::vector<h256> leaves;
+        for (size_t i = 0; i < count; ++i)
+        {
+            leaves.push_back(sha3(toString(i)));
+        }
+        MerkleTree tree(leaves);
+        BOOST_CHECK_EQUAL(tree.leafCount(), count);
+        BOOST_CHECK(tree.root() == referenceRoot(leaves));
+        for (size_t i = 0; i < count; ++i)
+        {
+            auto proof = tree.proof(i);
+            BOOST_CHECK(proof.size() <= 10);
+            BOOST_CHECK(MerkleTree::verify(leaves[i], proof, tree.root()));
+            BOOST_CHECK(!MerkleTree::verify(sha3("invalid"), proof, tree.root()));
+        }
+        BOOST_CHECK_THROW(tree.proof(count), InvalidBlockFormat);
+    }
+}
+
+BOOST_AUTO_TEST_CASE(testNodeIsNotLeaf)
+{
+    std::vector<h256> leaves;
+    for (size_t i = 0; i < 4; ++i)
+    {
+        leaves.push_back(sha3(toString(i)));
+    }
+    MerkleTree tree(leaves);
+    // the parent of the first two leaves and its sibling, the parent of the last two
+    auto left = tree.proof(2).back();
+    auto right = tree.proof(0).back();
+    BOOST_REQUIRE(left.siblingIsLeft);
+    BOOST_CHECK(!MerkleTree::verify(
+        left.sibling, MerkleProof{MerkleProofNode{right.sibling, false}}, tree.root()));
+}
+
+BOOST_AUTO_TEST_CASE(testBlockRoots)
+{
+    auto version = g_BCOSConfig.version();
+    auto supportedVersion = g_BCOSConfig.supportedVersion();
+    g_BCOSConfig.setSupportedVersion("2.1.0", V2_1_0);
+    FakeBlock fakeBlock(5);
+    Block& block = fakeBlock.getBlock();
+    block.calTransactionRoot();
+    block.calReceiptRoot();
+    BOOST_CHECK(
+        block.header().transactionsRoot() == MerkleTree(block.transactionHashes()).root());
+    BOOST_CHECK(block.header().receiptsRoot() == MerkleTree(block.receiptHashes()).root());
+    BOOST_CHECK(block.transactionHashes()[1] == block.transactions()[1].sha3());
+
+    MerkleTree tree(block.transactionHashes());
+    BOOST_CHECK(MerkleTree::verify(
+        block.transactions()[3].sha3(), tree.proof(3), block.header().transactionsRoot()));
+    g_BCOSConfig.setSupportedVersion(supportedVersion, version);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+}  // namespace test
+}  // namespace dev
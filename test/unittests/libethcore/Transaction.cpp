@@ -93,6 +93,42 @@ BOOST_AUTO_TEST_CASE(testCreateTxByRLP)
     BOOST_CHECK_NO_THROW(decodeTxRC2.decode(ref(rlpBytes)));
     g_BCOSConfig.setSupportedVersion("2.0.0-rc2", RC2_VERSION);
 }
+
+BOOST_AUTO_TEST_CASE(testRetainedRLP)
+{
+    std::string str = "test transaction";
+    bytes data(str.begin(), str.end());
+    Transaction tx(u256(100), u256(0), u256(100000000), Address(0x1000), data);
+    KeyPair sigKeyPair = KeyPair::create();
+    SignatureStruct sig = dev::sign(sigKeyPair.secret(), tx.sha3(WithoutSignature));
+    tx.updateSignature(sig);
+    bytes encodeBytes;
+    tx.encode(encodeBytes, WithSignature);
+
+    /// the decoded tx keeps the origin RLP and the copies share it
+    Transaction decodeTx(ref(encodeBytes), CheckTransaction::Everything);
+    Transaction copiedTx = decodeTx;
+    BOOST_CHECK(decodeTx.rlpBuffer() == copiedTx.rlpBuffer());
+    BOOST_CHECK(*decodeTx.rlpBuffer() == encodeBytes);
+    BOOST_CHECK(decodeTx.rlp() == encodeBytes);
+    BOOST_CHECK(decodeTx.sha3() == sha3(encodeBytes));
+    BOOST_CHECK(decodeTx.rlp(WithoutSignature) != encodeBytes);
+
+    /// a tx built locally is encoded once
+    auto buffer = tx.rlpBuffer();
+    BOOST_CHECK(*buffer == encodeBytes);
+    BOOST_CHECK(tx.rlpBuffer() == buffer);
+    BOOST_CHECK(tx.sha3() == decodeTx.sha3());
+
+    /// modifying the tx drops the RLP
+    copiedTx.setNonce(u256(1));
+    sig = dev::sign(sigKeyPair.secret(), copiedTx.sha3(WithoutSignature));
+    copiedTx.updateSignature(sig);
+    BOOST_CHECK(copiedTx.rlpBuffer() != decodeTx.rlpBuffer());
+    BOOST_CHECK(copiedTx.rlp() != encodeBytes);
+    BOOST_CHECK(copiedTx.sha3() == sha3(copiedTx.rlp()));
+    BOOST_CHECK(*decodeTx.rlpBuffer() == encodeBytes);
+}
 BOOST_AUTO_TEST_SUITE_END()
 }  // namespace test
 }  // namespace dev
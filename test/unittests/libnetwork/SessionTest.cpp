@@ -0,0 +1,186 @@
+/*
+ * @CopyRight:
+ * FISCO-BCOS is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * FISCO-BCOS is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with FISCO-BCOS.  If not, see <http://www.gnu.org/licenses/>
+ * (c) 2016-2018 fisco-dev contributors.
+ */
+/** @file SessionTest.cpp
+ * @brief the priority lanes of the write queue of a session
+ */
+
+#include "libnetwork/Host.h"
+#include "FakeASIOInterface.h"
+#include "libnetwork/Session.h"
+#include "libp2p/P2PMessage.h"
+#include "libp2p/P2PMessageFactory.h"
+#include <boost/test/unit_test.hpp>
+
+using namespace dev;
+using namespace std;
+using namespace dev::network;
+using namespace dev::p2p;
+
+namespace test_Session
+{
+/// a host always connected to the network
+class FakeHost : public dev::network::Host
+{
+public:
+    bool haveNetwork() const override { return true; }
+};
+
+/// the writes are pending until completed by the test, nothing is read
+class LaneASIOInterface : public FakeASIOInterface
+{
+public:
+    void asyncWrite(std::shared_ptr<SocketFace>, boost::asio::mutable_buffers_1 buffers,
+        ReadWriteHandler handler) override
+    {
+        auto message = std::make_shared<P2PMessage>();
+        message->decode(boost::asio::buffer_cast<const byte*>(buffers), buffers.size());
+        m_written.push_back(message->seq());
+        m_pending.push_back(std::make_pair(handler, buffers.size()));
+    }
+
+    void asyncReadSome(
+        std::shared_ptr<SocketFace>, boost::asio::mutable_buffers_1, ReadWriteHandler) override
+    {}
+
+    void strandPost(Base_Handler) override {}
+
+    /// complete the write in flight, the session writes the next packet
+    void complete()
+    {
+        BOOST_REQUIRE(!m_pending.empty());
+        auto pending = m_pending.front();
+        m_pending.pop_front();
+        pending.first(boost::system::error_code(), pending.second);
+    }
+
+    std::vector<uint32_t> m_written;
+    std::deque<std::pair<ReadWriteHandler, size_t>> m_pending;
+};
+
+struct SessionFixture
+{
+    SessionFixture()
+    {
+        m_asioInterface = std::make_shared<LaneASIOInterface>();
+        m_asioInterface->setIOService(std::make_shared<ba::io_service>());
+        m_asioInterface->setSSLContext(
+            std::make_shared<boost::asio::ssl::context>(boost::asio::ssl::context::tlsv12));
+        m_asioInterface->setType(dev::network::ASIOInterface::SSL);
+        m_host = std::make_shared<FakeHost>();
+        m_host->setASIOInterface(m_asioInterface);
+
+        m_session = std::make_shared<Session>();
+        m_session->setHost(m_host);
+        m_session->setSocket(m_asioInterface->newSocket());
+        m_session->setMessageFactory(std::make_shared<P2PMessageFactory>());
+        m_session->start();
+    }
+
+    Message::Ptr message(uint32_t _seq, size_t _size = 16)
+    {
+        auto message = std::make_shared<P2PMessage>();
+        message->setSeq(_seq);
+        message->setBuffer(std::make_shared<bytes>(_size, byte(_seq)));
+        return message;
+    }
+
+    Options options(PacketPriority _priority)
+    {
+        Options options;
+        options.priority = _priority;
+        return options;
+    }
+
+    std::shared_ptr<LaneASIOInterface> m_asioInterface;
+    std::shared_ptr<FakeHost> m_host;
+    std::shared_ptr<Session> m_session;
+};
+
+BOOST_FIXTURE_TEST_SUITE(Session, SessionFixture)
+
+BOOST_AUTO_TEST_CASE(priorityLanes)
+{
+    BOOST_REQUIRE(m_session->actived());
+    // the first packet is written at once, the others wait for it
+    m_session->asyncSendMessage(message(1), options(AMOPPriority));
+    m_session->asyncSendMessage(message(2), options(AMOPPriority));
+    m_session->asyncSendMessage(message(3), options(TxGossipPriority));
+    m_session->asyncSendMessage(message(4), options(BlockSyncPriority));
+    m_session->asyncSendMessage(message(5), options(ConsensusPriority));
+    BOOST_CHECK(m_asioInterface->m_written == std::vector<uint32_t>{1});
+    auto stats = m_session->writeQueueStats();
+    BOOST_CHECK_EQUAL(stats.packets[AMOPPriority], 1u);
+    BOOST_CHECK_EQUAL(stats.packets[ConsensusPriority], 1u);
+
+    // the queued packets are written by their priority
+    for (size_t i = 0; i < 4; ++i)
+    {
+        m_asioInterface->complete();
+    }
+    BOOST_CHECK(m_asioInterface->m_written == (std::vector<uint32_t>{1, 5, 4, 3, 2}));
+    m_asioInterface->complete();
+    BOOST_CHECK(m_asioInterface->m_pending.empty());
+    stats = m_session->writeQueueStats();
+    for (size_t i = 0; i < PriorityCount; ++i)
+    {
+        BOOST_CHECK_EQUAL(stats.packets[i], 0u);
+        BOOST_CHECK_EQUAL(stats.bytes[i], 0u);
+    }
+}
+
+BOOST_AUTO_TEST_CASE(writeQueueBudget)
+{
+    BOOST_REQUIRE(m_session->actived());
+    // keep a packet in flight, the others are queued
+    m_session->asyncSendMessage(message(0), options(AMOPPriority));
+    auto bulk = [&](uint32_t _seq, size_t _count) -> std::vector<Message::Ptr> {
+        std::vector<Message::Ptr> messages;
+        for (size_t i = 0; i < _count; ++i)
+        {
+            messages.push_back(message(_seq + i, 1000 * 1000));
+        }
+        return messages;
+    };
+    BOOST_CHECK(m_session->asyncSendMessages(bulk(100, 15), options(AMOPPriority)));
+    BOOST_CHECK(m_session->congested(AMOPPriority));
+    BOOST_CHECK(!m_session->congested(ConsensusPriority));
+
+    // the bulk packets over the budget are dropped all or none
+    BOOST_CHECK(!m_session->asyncSendMessages(bulk(200, 2), options(AMOPPriority)));
+    auto stats = m_session->writeQueueStats();
+    BOOST_CHECK_EQUAL(stats.packets[AMOPPriority], 15u);
+    BOOST_CHECK_EQUAL(stats.dropped[AMOPPriority], 2u);
+
+    // the consensus packets have a budget of their own
+    BOOST_CHECK(m_session->asyncSendMessages(bulk(300, 2), options(ConsensusPriority)));
+    m_session->asyncSendMessage(message(400), options(ConsensusPriority));
+    stats = m_session->writeQueueStats();
+    BOOST_CHECK_EQUAL(stats.packets[ConsensusPriority], 3u);
+    BOOST_CHECK_EQUAL(stats.dropped[ConsensusPriority], 0u);
+    BOOST_CHECK(!m_session->congested(ConsensusPriority));
+
+    // and are written before the queued bulk packets
+    for (size_t i = 0; i < 4; ++i)
+    {
+        m_asioInterface->complete();
+    }
+    BOOST_CHECK(m_asioInterface->m_written == (std::vector<uint32_t>{0, 300, 301, 400, 100}));
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+}  // namespace test_Session
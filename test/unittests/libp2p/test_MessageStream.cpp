@@ -0,0 +1,136 @@
+/*
+ * @CopyRight:
+ * FISCO-BCOS is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * FISCO-BCOS is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with FISCO-BCOS.  If not, see <http://www.gnu.org/licenses/>
+ * (c) 2016-2018 fisco-dev contributors.
+ */
+/** @file test_MessageStream.cpp
+ *  @brief unit test of the frames of the large messages
+ */
+
+#include <libconfig/GlobalConfigure.h>
+#include <libp2p/MessageStream.h>
+#include <test/tools/libutils/TestOutputHelper.h>
+#include <boost/test/unit_test.hpp>
+
+using namespace dev;
+using namespace dev::p2p;
+
+namespace dev
+{
+namespace test
+{
+struct MessageStreamFixture : public TestOutputHelperFixture
+{
+    MessageStreamFixture()
+      : version(g_BCOSConfig.version()), supportedVersion(g_BCOSConfig.supportedVersion())
+    {
+        g_BCOSConfig.setSupportedVersion("2.1.0", V2_1_0);
+        factory = std::make_shared<P2PMessageFactoryRC2>();
+        message = std::dynamic_pointer_cast<P2PMessage>(factory->buildMessage());
+        message->setProtocolID(dev::eth::getGroupProtoclID(1, dev::eth::ProtocolID::BlockSync));
+        message->setPacketType(5);
+        message->setSeq(100);
+        auto payload = std::make_shared<bytes>(3 * MessageStream::c_chunkSize + 100);
+        for (size_t i = 0; i < payload->size(); ++i)
+        {
+            (*payload)[i] = byte(i);
+        }
+        message->setBuffer(payload);
+    }
+    ~MessageStreamFixture() { g_BCOSConfig.setSupportedVersion(supportedVersion, version); }
+
+    VERSION version;
+    std::string supportedVersion;
+    P2PMessageFactory::Ptr factory;
+    P2PMessage::Ptr message;
+};
+
+BOOST_FIXTURE_TEST_SUITE(MessageStreamTest, MessageStreamFixture)
+
+BOOST_AUTO_TEST_CASE(testSplitAndReassemble)
+{
+    BOOST_CHECK(MessageStream::shouldSplit(message));
+    auto frames = MessageStream::split(message, 7, factory);
+    BOOST_CHECK_EQUAL(frames.size(), 4u);
+
+    MessageStream stream;
+    for (size_t i = 0; i + 1 < frames.size(); ++i)
+    {
+        BOOST_CHECK_EQUAL(frames[i]->protocolID(), dev::eth::ProtocolID::Stream);
+        BOOST_CHECK_EQUAL(frames[i]->seq(), 7u);
+        /// the frames are decoded from the wire
+        bytes encoded;
+        frames[i]->encode(encoded);
+        auto frame = std::dynamic_pointer_cast<P2PMessage>(factory->buildMessage());
+        BOOST_CHECK_EQUAL(frame->decode(encoded.data(), encoded.size()), ssize_t(encoded.size()));
+        BOOST_CHECK(stream.onFrame(frame, factory) == nullptr);
+    }
+    BOOST_CHECK_EQUAL(stream.pendingStreams(), 1u);
+    BOOST_CHECK_EQUAL(stream.pendingBytes(), 3 * MessageStream::c_chunkSize);
+    auto reassembled = stream.onFrame(frames.back(), factory);
+    BOOST_REQUIRE(reassembled);
+    BOOST_CHECK_EQUAL(reassembled->protocolID(), message->protocolID());
+    BOOST_CHECK_EQUAL(reassembled->packetType(), message->packetType());
+    BOOST_CHECK_EQUAL(reassembled->seq(), message->seq());
+    BOOST_CHECK(*reassembled->buffer() == *message->buffer());
+    BOOST_CHECK_EQUAL(stream.pendingStreams(), 0u);
+    BOOST_CHECK_EQUAL(stream.pendingBytes(), 0u);
+}
+
+BOOST_AUTO_TEST_CASE(testDeclaredLength)
+{
+    auto frames = MessageStream::split(message, 7, factory);
+    auto& start = *frames[0]->buffer();
+    MessageStream stream;
+    /// a length over the limit is refused
+    uint32_t length = htonl(MessageStream::c_maxLength + 1);
+    memcpy(start.data(), &length, sizeof(length));
+    BOOST_CHECK(stream.onFrame(frames[0], factory) == nullptr);
+    BOOST_CHECK_EQUAL(stream.pendingStreams(), 0u);
+
+    /// only the bytes received are held for the declared length
+    length = htonl(MessageStream::c_maxLength);
+    memcpy(start.data(), &length, sizeof(length));
+    BOOST_CHECK(stream.onFrame(frames[0], factory) == nullptr);
+    BOOST_CHECK_EQUAL(stream.pendingStreams(), 1u);
+    BOOST_CHECK_EQUAL(stream.pendingBytes(), MessageStream::c_chunkSize);
+
+    /// the stream is dropped when a new one starts with the same ID
+    auto next = MessageStream::split(message, 7, factory);
+    BOOST_CHECK(stream.onFrame(next[0], factory) == nullptr);
+    BOOST_CHECK_EQUAL(stream.pendingStreams(), 1u);
+    BOOST_CHECK_EQUAL(stream.pendingBytes(), MessageStream::c_chunkSize);
+}
+
+BOOST_AUTO_TEST_CASE(testMissingFrame)
+{
+    auto frames = MessageStream::split(message, 7, factory);
+    MessageStream stream;
+    BOOST_CHECK(stream.onFrame(frames[0], factory) == nullptr);
+    /// the second frame is dropped by the sender
+    BOOST_CHECK(stream.onFrame(frames[2], factory) == nullptr);
+    BOOST_CHECK_EQUAL(stream.pendingStreams(), 0u);
+    BOOST_CHECK(stream.onFrame(frames[3], factory) == nullptr);
+
+    /// the small messages and the AMOP messages are not split
+    message->setBuffer(std::make_shared<bytes>(MessageStream::c_chunkSize));
+    BOOST_CHECK(!MessageStream::shouldSplit(message));
+    message->setBuffer(std::make_shared<bytes>(2 * MessageStream::c_chunkSize));
+    message->setProtocolID(dev::eth::ProtocolID::AMOP);
+    BOOST_CHECK(!MessageStream::shouldSplit(message));
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+}  // namespace test
+}  // namespace dev
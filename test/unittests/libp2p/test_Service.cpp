@@ -29,6 +29,7 @@
 #include <boost/property_tree/ini_parser.hpp>
 #include <boost/property_tree/ptree.hpp>
 #include <boost/test/unit_test.hpp>
+#include <future>
 
 using namespace dev;
 using namespace std;
@@ -118,6 +119,43 @@ BOOST_AUTO_TEST_CASE(Service_run)
     //         });
     m_p2pService->stop();
 }
+
+BOOST_AUTO_TEST_CASE(Service_groupDispatch)
+{
+    m_p2pService->setDispatchThreads(1);
+    std::promise<void> release;
+    std::shared_future<void> released = release.get_future().share();
+    std::atomic<int> handled = {0};
+    /// the handler of group 1 is blocked
+    PROTOCOL_ID blockedProtocol = dev::eth::getGroupProtoclID(1, dev::eth::ProtocolID::BlockSync);
+    m_p2pService->registerHandlerByProtoclID(
+        blockedProtocol, [&](NetworkException, std::shared_ptr<P2PSession>, P2PMessage::Ptr) {
+            released.wait();
+            ++handled;
+        });
+    PROTOCOL_ID protocol = dev::eth::getGroupProtoclID(2, dev::eth::ProtocolID::PBFT);
+    std::promise<void> done;
+    m_p2pService->registerHandlerByProtoclID(
+        protocol, [&](NetworkException, std::shared_ptr<P2PSession>, P2PMessage::Ptr) {
+            ++handled;
+            done.set_value();
+        });
+
+    auto message = std::dynamic_pointer_cast<P2PMessage>(m_messageFactory->buildMessage());
+    message->setProtocolID(blockedProtocol);
+    m_p2pService->onMessage(NetworkException(), nullptr, message, nullptr);
+    message = std::dynamic_pointer_cast<P2PMessage>(m_messageFactory->buildMessage());
+    message->setProtocolID(protocol);
+    m_p2pService->onMessage(NetworkException(), nullptr, message, nullptr);
+    /// the message of group 2 is handled while group 1 is blocked
+    BOOST_CHECK(done.get_future().wait_for(std::chrono::seconds(5)) == std::future_status::ready);
+    BOOST_CHECK_EQUAL(handled, 1);
+    release.set_value();
+    while (handled < 2)
+    {
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    }
+}
 BOOST_AUTO_TEST_SUITE_END()
 
 }  // namespace test_Host
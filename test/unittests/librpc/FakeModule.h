@@ -172,6 +172,16 @@ public:
     {
         return "300000000";
     };
+    dev::eth::LocalisedLogEntries getLogs(dev::eth::LogFilter const& _filter) override
+    {
+        LocalisedLogEntries logs;
+        auto log = getTransactionReceiptByHash(h256()).log()[0];
+        if (_filter.fromBlock() <= 0 && _filter.toBlock() >= 0 && _filter.matches(log))
+        {
+            logs.emplace_back(log, blockHash, 0, transaction.sha3(), 0, 0);
+        }
+        return logs;
+    }
 
     void createTransaction()
     {
@@ -328,6 +338,7 @@ public:
         dev::eth::TransactionReceipt reciept;
         return std::make_pair(res, reciept);
     }
+    Json::Value conflictPredictions() override { return Json::Value(); }
 
 private:
     std::shared_ptr<ExecutiveContext> m_executiveContext;
@@ -21,8 +21,11 @@
 #include "FakeModule.h"
 
 #include <jsonrpccpp/common/exception.h>
+#include <libdevcore/Metrics.h>
+#include <libdevcore/Tracer.h>
 #include <libdevcrypto/Common.h>
 #include <libethcore/CommonJS.h>
+#include <libethcore/MerkleTree.h>
 #include <librpc/Rpc.h>
 #include <test/tools/libutils/Common.h>
 #include <test/tools/libutils/TestOutputHelper.h>
@@ -547,6 +550,7 @@ BOOST_AUTO_TEST_CASE(testSyncPart)
     Json::Value status = rpc->getSyncStatus(groupId);
     BOOST_CHECK(status.size() == 9);
     BOOST_CHECK_THROW(rpc->getSyncStatus(invalidGroup), JsonRpcException);
+    BOOST_CHECK_THROW(rpc->getConflictPredictions(invalidGroup), JsonRpcException);
 }
 
 BOOST_AUTO_TEST_CASE(testP2pPart)
@@ -567,6 +571,37 @@ BOOST_AUTO_TEST_CASE(testP2pPart)
 
     response = rpc->getNodeIDList(groupId);
     BOOST_CHECK(response.size() == 2);
+
+    dev::metrics::MetricsRegistry::instance()
+        .counter("rpc_test_total", "counter of the rpc test", dev::metrics::groupLabels(groupId))
+        .inc();
+    response = rpc->getMetrics();
+    bool found = false;
+    for (auto const& metric : response)
+    {
+        if (metric["name"].asString() == "rpc_test_total")
+        {
+            found = true;
+            BOOST_CHECK(metric["type"].asString() == "counter");
+            BOOST_CHECK(metric["labels"]["group"].asString() == std::to_string(groupId));
+            BOOST_CHECK(metric["value"].asInt64() >= 1);
+        }
+    }
+    BOOST_CHECK(found);
+
+    dev::trace::Tracer::instance().setEnabled(true);
+    {
+        TRACE_SPAN("commitBlock", "blockchain", groupId, 1);
+    }
+    dev::trace::Tracer::instance().setEnabled(false);
+    response = rpc->getBlockTraces(groupId, 1);
+    BOOST_CHECK(response["traceEvents"].size() >= 2);
+    auto const& event = response["traceEvents"][0];
+    BOOST_CHECK(event["name"].asString() == "commitBlock");
+    BOOST_CHECK(event["ph"].asString() == "X");
+    BOOST_CHECK(event["pid"].asInt() == groupId);
+    BOOST_CHECK(event["args"]["number"].asInt64() == 1);
+    dev::trace::Tracer::instance().clear();
 }
 
 BOOST_AUTO_TEST_CASE(testGetBlockByHash)
@@ -737,6 +772,8 @@ BOOST_AUTO_TEST_CASE(testGetTransactionByHash)
     BOOST_CHECK(response["value"].asString() == "0x0");
 
     BOOST_CHECK_THROW(rpc->getTransactionByHash(invalidGroup, txHash), JsonRpcException);
+    /// the roots of the blocks before 2.1.0 are not Merkle roots
+    BOOST_CHECK_THROW(rpc->getTransactionByHashWithProof(groupId, txHash), JsonRpcException);
 }
 
 BOOST_AUTO_TEST_CASE(testGetTransactionByBlockHashAndIndex)
@@ -857,6 +894,89 @@ BOOST_AUTO_TEST_CASE(testGetTransactionReceipt)
 
     BOOST_CHECK_THROW(rpc->getTransactionReceipt(invalidGroup, txHash), JsonRpcException);
 }
+
+static dev::eth::MerkleProof merkleProofFromJson(Json::Value const& _proof)
+{
+    dev::eth::MerkleProof proof;
+    for (auto const& node : _proof)
+    {
+        proof.push_back(dev::eth::MerkleProofNode{
+            jsToFixed<32>(node["sibling"].asString()), node["siblingIsLeft"].asBool()});
+    }
+    return proof;
+}
+
+BOOST_AUTO_TEST_CASE(testGetProofs)
+{
+    auto version = g_BCOSConfig.version();
+    auto supportedVersion = g_BCOSConfig.supportedVersion();
+    g_BCOSConfig.setSupportedVersion("2.1.0", V2_1_0);
+    auto blockChain =
+        std::dynamic_pointer_cast<MockBlockChain>(m_ledgerManager->blockChain(groupId));
+    BOOST_REQUIRE(blockChain);
+    // the roots of three leaves, the proof of the first one has two nodes
+    auto block = blockChain->getBlockByNumber(0);
+    block->setTransactions(Transactions(3, blockChain->transaction));
+    block->setTransactionReceipts(
+        TransactionReceipts(3, blockChain->getTransactionReceiptByHash(h256())));
+    auto transactionsRoot = dev::eth::MerkleTree(block->transactionHashes()).root();
+    block->header().setTransactionsRoot(transactionsRoot);
+    block->header().setReceiptsRoot(dev::eth::MerkleTree(block->receiptHashes()).root());
+
+    h256 txHash = blockChain->transaction.sha3();
+    Json::Value response = rpc->getTransactionByHashWithProof(groupId, toJS(txHash));
+    BOOST_CHECK(response["transaction"]["hash"].asString() == toJS(txHash));
+    auto proof = merkleProofFromJson(response["txProof"]);
+    BOOST_CHECK_EQUAL(proof.size(), 2u);
+    BOOST_CHECK(dev::eth::MerkleTree::verify(txHash, proof, transactionsRoot));
+
+    // the receipt of the mock is returned for this hash only
+    response = rpc->getTransactionReceiptByHashWithProof(
+        groupId, "0x7536cf1286b5ce6c110cd4fea5c891467884240c9af366d678eb4191e1c31c6f");
+    auto receiptRlp = jsToBytes(response["receiptRlp"].asString());
+    BOOST_CHECK(!receiptRlp.empty());
+    BOOST_CHECK(dev::eth::MerkleTree::verify(sha3(receiptRlp),
+        merkleProofFromJson(response["receiptProof"]), block->header().receiptsRoot()));
+
+    // the transaction found by the mock for an unknown hash isn't the leaf of the hash
+    BOOST_CHECK_THROW(
+        rpc->getTransactionByHashWithProof(groupId, toJS(sha3("unknown"))), JsonRpcException);
+    // the leaves don't match the root of the block
+    block->header().setTransactionsRoot(h256(0x4));
+    BOOST_CHECK_THROW(rpc->getTransactionByHashWithProof(groupId, toJS(txHash)), JsonRpcException);
+
+    // the roots of the blocks before 2.1.0 are not Merkle roots
+    block->header().setTransactionsRoot(transactionsRoot);
+    g_BCOSConfig.setSupportedVersion("2.0.0-rc3", RC3_VERSION);
+    BOOST_CHECK_THROW(rpc->getTransactionByHashWithProof(groupId, toJS(txHash)), JsonRpcException);
+    g_BCOSConfig.setSupportedVersion(supportedVersion, version);
+}
+
+BOOST_AUTO_TEST_CASE(testGetLogs)
+{
+    Json::Value filter;
+    filter["fromBlock"] = "0x0";
+    filter["address"] = "0x0000000000000000000000000000000000002000";
+    Json::Value response = rpc->getLogs(groupId, filter);
+    BOOST_CHECK_EQUAL(response.size(), 1u);
+    BOOST_CHECK(response[0]["address"].asString() == "0x0000000000000000000000000000000000002000");
+    BOOST_CHECK(response[0]["blockNumber"].asString() == "0x0");
+    BOOST_CHECK(response[0]["logIndex"].asString() == "0x0");
+
+    /// the log has no topic
+    filter["topics"] = Json::Value(Json::arrayValue);
+    filter["topics"].append(
+        "0x0000000000000000000000000000000000000000000000000000000000000001");
+    BOOST_CHECK_EQUAL(rpc->getLogs(groupId, filter).size(), 0u);
+
+    filter["topics"][0] = "0x01";
+    BOOST_CHECK_THROW(rpc->getLogs(groupId, filter), JsonRpcException);
+    filter.removeMember("topics");
+    filter["toBlock"] = "20000";
+    BOOST_CHECK_THROW(rpc->getLogs(groupId, filter), JsonRpcException);
+    BOOST_CHECK_THROW(rpc->getLogs(invalidGroup, Json::Value()), JsonRpcException);
+}
+
 BOOST_AUTO_TEST_CASE(testGetPendingTransactions)
 {
     Json::Value response = rpc->getPendingTransactions(groupId);
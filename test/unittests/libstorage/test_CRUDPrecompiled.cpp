@@ -246,6 +246,76 @@ BOOST_AUTO_TEST_CASE(CRUD)
     BOOST_TEST(funcResult == CODE_UNKNOW_FUNCTION_CALL);
 }
 
+BOOST_AUTO_TEST_CASE(selectBinary)
+{
+    auto version = g_BCOSConfig.version();
+    auto supportedVersion = g_BCOSConfig.supportedVersion();
+    g_BCOSConfig.setSupportedVersion("2.1.0", V2_1_0);
+
+    dev::eth::ContractABI abi;
+    std::string tableName = "t_test", key = "fruit", valueField = "item_id,item_name";
+    bytes param = abi.abiIn("createTable(string,string,string)", tableName, key, valueField);
+    bytes out = tableFactoryPrecompiled->call(context, bytesConstRef(&param));
+    for (auto const& item : {"apple", "orange"})
+    {
+        std::string entryStr = "{\"item_id\":\"" + std::string(item).substr(0, 1) +
+                               "\",\"item_name\":\"" + item + "\"}";
+        param = abi.abiIn(
+            "insert(string,string,string,string)", tableName, key, entryStr, std::string(""));
+        crudPrecompiled->call(context, bytesConstRef(&param));
+    }
+
+    // the JSON rows are written without styling
+    std::string conditionStr = "{\"item_id\":{\"eq\":\"o\"}}";
+    param = abi.abiIn(
+        "select(string,string,string,string)", tableName, key, conditionStr, std::string(""));
+    out = crudPrecompiled->call(context, bytesConstRef(&param));
+    std::string selectResult;
+    abi.abiOut(&out, selectResult);
+    BOOST_CHECK(selectResult.find('\n') == std::string::npos);
+    BOOST_CHECK(selectResult.find("\"item_name\":\"orange\"") != std::string::npos);
+
+    std::string selectBinaryFunc = "selectBinary(string,string,bytes,string)";
+    RLPStream condition(2);
+    condition.appendList(3) << unsigned(Condition::eq) << std::string("item_id")
+                            << std::string("o");
+    condition.appendList(3) << unsigned(dev::precompiled::CRUDPrecompiled::c_limitOp) << 0 << 10;
+    param = abi.abiIn(selectBinaryFunc, tableName, key, ref(condition.out()), std::string(""));
+    out = crudPrecompiled->call(context, bytesConstRef(&param));
+    bytesConstRef rowsData;
+    BOOST_REQUIRE(abi.abiOut(&out, rowsData));
+    RLP rows(rowsData);
+    BOOST_REQUIRE_EQUAL(rows.itemCount(), 1u);
+    std::map<std::string, std::string> fields;
+    for (size_t i = 0; i + 1 < rows[0].itemCount(); i += 2)
+    {
+        fields[rows[0][i].toString()] = rows[0][i + 1].toString();
+    }
+    BOOST_CHECK_EQUAL(fields["item_name"], "orange");
+    BOOST_CHECK_EQUAL(fields["fruit"], key);
+
+    // all the rows of the key without conditions
+    param = abi.abiIn(selectBinaryFunc, tableName, key, ref(RLPStream(0).out()), std::string(""));
+    out = crudPrecompiled->call(context, bytesConstRef(&param));
+    BOOST_REQUIRE(abi.abiOut(&out, rowsData));
+    BOOST_CHECK_EQUAL(RLP(rowsData).itemCount(), 2u);
+
+    // invalid conditions
+    RLPStream undefinedOp(1);
+    undefinedOp.appendList(3) << 100 << std::string("item_id") << std::string("o");
+    param = abi.abiIn(selectBinaryFunc, tableName, key, ref(undefinedOp.out()), std::string(""));
+    out = crudPrecompiled->call(context, bytesConstRef(&param));
+    u256 result = 0;
+    abi.abiOut(&out, result);
+    BOOST_TEST(result == CODE_CONDITION_OPERATION_UNDEFINED);
+    param = abi.abiIn(selectBinaryFunc, tableName, key, std::string("{}"), std::string(""));
+    out = crudPrecompiled->call(context, bytesConstRef(&param));
+    abi.abiOut(&out, result);
+    BOOST_TEST(result == CODE_PARSE_CONDITION_ERROR);
+
+    g_BCOSConfig.setSupportedVersion(supportedVersion, version);
+}
+
 BOOST_AUTO_TEST_CASE(toString)
 {
     BOOST_TEST(crudPrecompiled->toString() == "CRUD");
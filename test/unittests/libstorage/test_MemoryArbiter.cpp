@@ -0,0 +1,127 @@
+/*
+ * @CopyRight:
+ * FISCO-BCOS is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * FISCO-BCOS is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with FISCO-BCOS.  If not, see <http://www.gnu.org/licenses/>
+ * (c) 2016-2018 fisco-dev contributors.
+ */
+/** @file test_MemoryArbiter.cpp
+ *  @brief test the node-wide memory budget
+ */
+
+#include <libstorage/MemoryArbiter.h>
+#include <boost/test/unit_test.hpp>
+
+using namespace dev;
+using namespace dev::storage;
+
+namespace test_MemoryArbiter
+{
+class MockCacheConsumer : public CacheConsumer
+{
+public:
+    int64_t cacheUsage() override { return usage; }
+    uint64_t cacheQueries() override { return queries; }
+    uint64_t cacheHits() override { return hits; }
+    void setCacheCapacity(int64_t _capacity) override { capacity = _capacity; }
+
+    int64_t usage = 0;
+    uint64_t queries = 0;
+    uint64_t hits = 0;
+    int64_t capacity = 0;
+};
+
+struct MemoryArbiterFixture
+{
+    MemoryArbiterFixture() { arbiter = std::make_shared<MemoryArbiter>(400 * 1024 * 1024, 0.25); }
+    MemoryArbiter::Ptr arbiter;
+};
+
+BOOST_FIXTURE_TEST_SUITE(MemoryArbiter, MemoryArbiterFixture)
+
+BOOST_AUTO_TEST_CASE(evenSplit)
+{
+    BOOST_CHECK_EQUAL(arbiter->cacheBudget(), 300 * 1024 * 1024);
+
+    auto group1 = std::make_shared<MockCacheConsumer>();
+    auto group2 = std::make_shared<MockCacheConsumer>();
+    arbiter->registerConsumer("group1", group1);
+    BOOST_CHECK_EQUAL(group1->capacity, arbiter->cacheBudget());
+
+    arbiter->registerConsumer("group2", group2);
+    BOOST_CHECK_EQUAL(group2->capacity, arbiter->cacheBudget() / 2);
+    BOOST_CHECK_EQUAL(arbiter->consumersStatus().size(), 2u);
+}
+
+BOOST_AUTO_TEST_CASE(rebalanceToHotGroup)
+{
+    auto hot = std::make_shared<MockCacheConsumer>();
+    auto idle = std::make_shared<MockCacheConsumer>();
+    arbiter->registerConsumer("hot", hot);
+    arbiter->registerConsumer("idle", idle);
+
+    for (size_t i = 0; i < 10; ++i)
+    {
+        hot->queries += 1000;
+        hot->hits += 100;
+        arbiter->rebalance();
+    }
+    BOOST_CHECK_GT(hot->capacity, idle->capacity);
+    // the idle group keeps its minimum share
+    BOOST_CHECK_GE(idle->capacity, arbiter->cacheBudget() / 2 / 4 - 1);
+    BOOST_CHECK_LE(hot->capacity + idle->capacity, arbiter->cacheBudget());
+
+    for (auto const& status : arbiter->consumersStatus())
+    {
+        if (status.name == "hot")
+        {
+            BOOST_CHECK_EQUAL(status.queries, 1000u);
+            BOOST_CHECK_EQUAL(status.misses, 900u);
+        }
+    }
+}
+
+BOOST_AUTO_TEST_CASE(releasedConsumer)
+{
+    auto group1 = std::make_shared<MockCacheConsumer>();
+    auto group2 = std::make_shared<MockCacheConsumer>();
+    arbiter->registerConsumer("group1", group1);
+    arbiter->registerConsumer("group2", group2);
+
+    group2.reset();
+    arbiter->rebalance();
+    BOOST_CHECK_EQUAL(arbiter->consumersStatus().size(), 1u);
+    BOOST_CHECK_GT(group1->capacity, arbiter->cacheBudget() / 2);
+}
+
+BOOST_AUTO_TEST_CASE(exportedMetrics)
+{
+    auto& registry = dev::metrics::MetricsRegistry::instance();
+    auto labels = dev::metrics::groupLabels(1);
+    labels["cache"] = "storage";
+    auto& capacity = registry.gauge("memory_cache_capacity_bytes", "", labels);
+    auto& usage = registry.gauge("memory_cache_usage_bytes", "", labels);
+
+    auto group1 = std::make_shared<MockCacheConsumer>();
+    group1->usage = 1024;
+    arbiter->registerConsumer("storage-1", group1, labels);
+    BOOST_CHECK_EQUAL(capacity.value(), group1->capacity);
+    BOOST_CHECK_EQUAL(usage.value(), 1024);
+
+    arbiter->unregisterConsumer("storage-1");
+    BOOST_CHECK_EQUAL(capacity.value(), 0);
+    BOOST_CHECK_EQUAL(usage.value(), 0);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+}  // namespace test_MemoryArbiter
@@ -19,11 +19,14 @@
 #include <libdevcore/FixedHash.h>
 #include <libdevcore/easylog.h>
 #include <libstorage/Common.h>
+#include <libconfig/GlobalConfigure.h>
 #include <libstorage/MemoryTable.h>
+#include <libstorage/MemoryTable2.h>
 #include <libstorage/MemoryTableFactory2.h>
 #include <libstorage/Storage.h>
 #include <libstorage/Table.h>
 #include <tbb/parallel_for.h>
+#include <tbb/task_arena.h>
 #include <boost/test/unit_test.hpp>
 #include <string>
 #include <thread>
@@ -242,6 +245,36 @@ BOOST_AUTO_TEST_CASE(setBlockNum)
     memoryDBFactory->setBlockNum(2);
 }
 
+BOOST_AUTO_TEST_CASE(hashEntries)
+{
+    auto version = g_BCOSConfig.version();
+    auto supportedVersion = g_BCOSConfig.supportedVersion();
+    tbb::concurrent_vector<Entry::Ptr> entries;
+    BOOST_CHECK(MemoryTable2::hashEntries(entries) == sha256(bytesConstRef()));
+    size_t count = 3 * MemoryTable2::c_hashChunkEntries + 7;
+    for (size_t i = 0; i < count; ++i)
+    {
+        auto entry = std::make_shared<Entry>();
+        entry->setField("key", "name" + std::to_string(i));
+        entry->setField("value", std::to_string(i));
+        entries.push_back(entry);
+    }
+    h256 legacyHash = MemoryTable2::hashEntries(entries);
+
+    g_BCOSConfig.setSupportedVersion("2.1.0", V2_1_0);
+    BOOST_CHECK(MemoryTable2::hashEntries(tbb::concurrent_vector<Entry::Ptr>()) == h256());
+    h256 chunkedHash = MemoryTable2::hashEntries(entries);
+    BOOST_CHECK(chunkedHash != legacyHash);
+    // the hash does not depend on the number of the threads
+    h256 serialHash;
+    tbb::task_arena serial(1);
+    serial.execute([&]() { serialHash = MemoryTable2::hashEntries(entries); });
+    BOOST_CHECK(serialHash == chunkedHash);
+    entries[count - 1]->setField("value", "changed");
+    BOOST_CHECK(MemoryTable2::hashEntries(entries) != chunkedHash);
+    g_BCOSConfig.setSupportedVersion(supportedVersion, version);
+}
+
 BOOST_AUTO_TEST_SUITE_END()
 
 }  // namespace test_MemoryTableFactory2
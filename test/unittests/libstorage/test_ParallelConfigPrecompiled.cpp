@@ -164,6 +164,99 @@ BOOST_AUTO_TEST_CASE(registerParallelFunction)
     BOOST_CHECK(hasRegistered(contractAddr, TRANSFER_FUNC) == false);
 }
 
+BOOST_AUTO_TEST_CASE(parallelConfigCache)
+{
+    Address contractAddr = Address(0x23333333);
+    const string TRANSFER_FUNC = "transfer(string,string,uint256)";
+    uint32_t selector = getFuncSelector(TRANSFER_FUNC);
+    auto cache = std::make_shared<ParallelConfigCache>();
+    parallelConfigPrecompiled->setParallelConfigCache(cache);
+
+    // the functions never registered are cached too
+    BOOST_CHECK(parallelConfigPrecompiled->getParallelConfig(
+                    context, contractAddr, selector, Address(0x12345)) == nullptr);
+    BOOST_CHECK_EQUAL(cache->size(), 1u);
+
+    ContractABI abi;
+    bytes param =
+        abi.abiIn(PARA_CONFIG_REGISTER_METHOD_ADDR_STR_UINT, contractAddr, TRANSFER_FUNC, 2);
+    callPrecompiled(ref(param));
+    BOOST_CHECK_EQUAL(cache->size(), 0u);
+    // the write is not committed, the config is read from the table
+    auto config = parallelConfigPrecompiled->getParallelConfig(
+        context, contractAddr, selector, Address(0x12345));
+    BOOST_REQUIRE(config);
+    BOOST_CHECK_EQUAL(config->criticalTypes.size(), 2u);
+    BOOST_CHECK_EQUAL(config->criticalTypes[1], "string");
+    BOOST_CHECK_EQUAL(cache->size(), 0u);
+
+    // cached when read from the state of the next block
+    cache->set(contractAddr, selector, blockInfo.number + 1, config);
+    ParallelConfig::Ptr cached;
+    BOOST_CHECK(cache->get(contractAddr, selector, blockInfo.number + 1, cached));
+    BOOST_CHECK(cached == config);
+    BOOST_CHECK(!cache->get(contractAddr, selector, blockInfo.number, cached));
+
+    cache->invalidate(contractAddr, selector, blockInfo.number + 1);
+    BOOST_CHECK(!cache->get(contractAddr, selector, blockInfo.number + 2, cached));
+    cache->set(contractAddr, selector, blockInfo.number + 1, config);
+    BOOST_CHECK_EQUAL(cache->size(), 0u);
+
+    cache->set(contractAddr, selector, blockInfo.number + 3, config);
+    BOOST_CHECK_EQUAL(cache->size(), 1u);
+    cache->clear();
+    BOOST_CHECK_EQUAL(cache->size(), 0u);
+    BOOST_CHECK(!cache->get(contractAddr, selector, blockInfo.number + 3, cached));
+}
+
+BOOST_AUTO_TEST_CASE(parallelConfigCacheReload)
+{
+    Address contractAddr = Address(0x23333333);
+    const string TRANSFER_FUNC = "transfer(string,string,uint256)";
+    uint32_t selector = getFuncSelector(TRANSFER_FUNC);
+    auto storage = std::make_shared<MemoryStorage>();
+    auto newExecutiveContext = [storage](ExecutiveContextFactory::Ptr _factory,
+                                   int64_t _number) -> ExecutiveContext::Ptr {
+        BlockInfo info;
+        info.hash = h256(_number);
+        info.number = _number;
+        auto context = std::make_shared<ExecutiveContext>();
+        _factory->setStateStorage(storage);
+        _factory->setStateFactory(std::make_shared<StorageStateFactory>(h256(0)));
+        _factory->setTableFactoryFactory(std::make_shared<MemoryTableFactoryFactory>());
+        _factory->initExecutiveContext(info, h256(0), context);
+        return context;
+    };
+    auto getConfig = [contractAddr, selector](
+                         ExecutiveContext::Ptr _context) -> ParallelConfig::Ptr {
+        auto precompiled = std::dynamic_pointer_cast<ParallelConfigPrecompiled>(
+            _context->getPrecompiled(Address(0x1006)));
+        return precompiled->getParallelConfig(_context, contractAddr, selector, Address(0x12345));
+    };
+
+    // the function is not parallel on the local chain
+    auto factory = std::make_shared<ExecutiveContextFactory>();
+    BOOST_CHECK(getConfig(newExecutiveContext(factory, 1)) == nullptr);
+
+    // the state is replaced by the one of another chain, on which the function is registered
+    auto otherFactory = std::make_shared<ExecutiveContextFactory>();
+    auto otherContext = newExecutiveContext(otherFactory, 1);
+    auto precompiled = std::dynamic_pointer_cast<ParallelConfigPrecompiled>(
+        otherContext->getPrecompiled(Address(0x1006)));
+    ContractABI abi;
+    bytes param =
+        abi.abiIn(PARA_CONFIG_REGISTER_METHOD_ADDR_STR_UINT, contractAddr, TRANSFER_FUNC, 2);
+    precompiled->call(otherContext, ref(param), Address(0x12345));
+    otherContext->getMemoryTableFactory()->commitDB(h256(1), 1);
+
+    // the stale config is served until the cache is cleared
+    BOOST_CHECK(getConfig(newExecutiveContext(factory, 2)) == nullptr);
+    factory->clearParallelConfigCache();
+    auto config = getConfig(newExecutiveContext(factory, 2));
+    BOOST_REQUIRE(config);
+    BOOST_CHECK_EQUAL(config->criticalSize, u256(2));
+}
+
 BOOST_AUTO_TEST_SUITE_END()
 
 }  // namespace test
@@ -26,6 +26,9 @@
 #include "rocksdb/write_batch.h"
 #include <libdevcore/FixedHash.h>
 #include <libdevcore/Log.h>
+#include <libdevcrypto/Hash.h>
+#include <libstorage/StorageException.h>
+#include <boost/filesystem.hpp>
 #include <boost/test/unit_test.hpp>
 
 using namespace dev;
@@ -220,7 +223,7 @@ struct RocksDBFixture
     RocksDBFixture()
     {
         rocksDB = std::make_shared<dev::storage::RocksDBStorage>();
-        std::shared_ptr<MockRocksDB> mockRocksDB = std::make_shared<MockRocksDB>();
+        mockRocksDB = std::make_shared<MockRocksDB>();
         rocksDB->setDB(mockRocksDB);
     }
     Entries::Ptr getEntries()
@@ -233,6 +236,7 @@ struct RocksDBFixture
         return entries;
     }
     dev::storage::RocksDBStorage::Ptr rocksDB;
+    std::shared_ptr<MockRocksDB> mockRocksDB;
 };
 
 BOOST_FIXTURE_TEST_SUITE(RocksDB, RocksDBFixture)
@@ -304,6 +308,130 @@ BOOST_AUTO_TEST_CASE(exception)
         rocksDB->select(h, num, tableInfo, key, std::make_shared<Condition>()), boost::exception);
 }
 
+BOOST_AUTO_TEST_CASE(snapshotChunk)
+{
+    SnapshotKVs kvs{{"t_test_LiSi", "value"}, {"t_test_WangWu", std::string("\0\1", 2)}};
+    auto chunk = encodeSnapshotChunk(kvs);
+    BOOST_CHECK(decodeSnapshotChunk(ref(chunk)) == kvs);
+
+    chunk.pop_back();
+    BOOST_CHECK_THROW(decodeSnapshotChunk(ref(chunk)), boost::exception);
+}
+
+BOOST_AUTO_TEST_CASE(importSnapshot)
+{
+    auto dir = boost::filesystem::temp_directory_path() / boost::filesystem::unique_path();
+    auto openStorage = [&dir](std::string const& _name) -> dev::storage::RocksDBStorage::Ptr {
+        rocksdb::Options options;
+        options.create_if_missing = true;
+        boost::filesystem::create_directories(dir);
+        rocksdb::DB* db = nullptr;
+        BOOST_REQUIRE(rocksdb::DB::Open(options, (dir / _name).string(), &db).ok());
+        auto storage = std::make_shared<dev::storage::RocksDBStorage>();
+        storage->setDB(std::shared_ptr<rocksdb::DB>(db));
+        return storage;
+    };
+    auto row = [](std::string const& _table, std::string const& _keyField,
+                   std::string const& _key, std::string const& _value) -> TableData::Ptr {
+        auto data = std::make_shared<TableData>();
+        data->info->name = _table;
+        data->info->key = _keyField;
+        auto entry = std::make_shared<Entry>();
+        entry->setField(_keyField, _key);
+        entry->setField(SYS_VALUE, _value);
+        data->newEntries->addEntry(entry);
+        return data;
+    };
+    auto select = [](dev::storage::RocksDBStorage::Ptr _storage, std::string const& _key) {
+        auto tableInfo = std::make_shared<TableInfo>();
+        tableInfo->name = "t_test";
+        return _storage->select(h256(), 1, tableInfo, _key, std::make_shared<Condition>())->size();
+    };
+    h256 blockHash(0x02);
+
+    // the snapshot of block 2 exported by another node
+    auto exporter = openStorage("exporter");
+    exporter->setSnapshotInterval(2);
+    exporter->commit(h256(0x01), 1,
+        std::vector<TableData::Ptr>{row("t_test", "Name", "LiSi", "1"),
+            row(SYS_CURRENT_STATE, SYS_KEY, SYS_KEY_CURRENT_NUMBER, "1")});
+    BOOST_CHECK(!exporter->createSnapshot(1024 * 1024));
+    exporter->commit(blockHash, 2,
+        std::vector<TableData::Ptr>{row(SYS_CURRENT_STATE, SYS_KEY, SYS_KEY_CURRENT_NUMBER, "2"),
+            row(SYS_NUMBER_2_HASH, "number", "2", blockHash.hex())});
+    exporter->commit(h256(0x03), 3,
+        std::vector<TableData::Ptr>{row("t_test", "Name", "WangWu", "1"),
+            row(SYS_CURRENT_STATE, SYS_KEY, SYS_KEY_CURRENT_NUMBER, "3")});
+    // the view of block 2 is pinned when it is committed
+    auto info = exporter->createSnapshot(1024 * 1024);
+    BOOST_REQUIRE(info);
+    BOOST_CHECK_EQUAL(info->number, 2);
+    BOOST_CHECK(exporter->createSnapshot(1024 * 1024) == info);
+    std::vector<std::shared_ptr<bytes>> chunks;
+    for (size_t i = 0; i < info->chunkHashes.size(); ++i)
+    {
+        chunks.push_back(exporter->readSnapshotChunk(i));
+        BOOST_CHECK(sha3(*chunks.back()) == info->chunkHashes[i]);
+    }
+
+    auto importer = openStorage("importer");
+    importer->commit(
+        h256(0x01), 1, std::vector<TableData::Ptr>{row("t_test", "Name", "ZhangSan", "1")});
+    importer->setSnapshotStagingPath((dir / "staging").string());
+
+    // the staged chunks don't belong to the block, the live data is untouched
+    importer->beginSnapshotImport();
+    for (auto const& chunk : chunks)
+    {
+        importer->importSnapshotChunk(ref(*chunk));
+    }
+    BOOST_CHECK(!importer->finishSnapshotImport(2, h256(0x03)));
+    BOOST_CHECK_EQUAL(select(importer, "LiSi"), 0u);
+    BOOST_CHECK_EQUAL(select(importer, "ZhangSan"), 1u);
+    BOOST_CHECK_THROW(importer->importSnapshotChunk(ref(*chunks[0])), StorageException);
+
+    importer->beginSnapshotImport();
+    for (auto const& chunk : chunks)
+    {
+        importer->importSnapshotChunk(ref(*chunk));
+    }
+    BOOST_CHECK(importer->finishSnapshotImport(2, blockHash));
+    BOOST_CHECK_EQUAL(select(importer, "LiSi"), 1u);
+    BOOST_CHECK_EQUAL(select(importer, "WangWu"), 0u);
+    BOOST_CHECK_EQUAL(select(importer, "ZhangSan"), 0u);
+    BOOST_CHECK(!boost::filesystem::exists(dir / "staging"));
+
+    // a chunk is closed before a row overflows it, an oversized row is a chunk alone
+    std::vector<TableData::Ptr> rows{row(SYS_CURRENT_STATE, SYS_KEY, SYS_KEY_CURRENT_NUMBER, "4"),
+        row("t_test", "Name", "Big", std::string(4096, 'b'))};
+    for (size_t i = 0; i < 16; ++i)
+    {
+        rows.push_back(row("t_test", "Name", "Row" + std::to_string(i), std::string(100, 'r')));
+    }
+    exporter->commit(h256(0x04), 4, rows);
+    size_t chunkSize = 1024;
+    info = exporter->createSnapshot(chunkSize);
+    BOOST_REQUIRE(info);
+    BOOST_CHECK_EQUAL(info->number, 4);
+    bool oversized = false;
+    for (size_t i = 0; i < info->chunkHashes.size(); ++i)
+    {
+        auto kvs = decodeSnapshotChunk(ref(*exporter->readSnapshotChunk(i)));
+        size_t size = 0;
+        for (auto const& kv : kvs)
+        {
+            size += kv.first.size() + kv.second.size();
+        }
+        BOOST_CHECK(size <= chunkSize || kvs.size() == 1u);
+        oversized = oversized || size > chunkSize;
+    }
+    BOOST_CHECK(oversized);
+
+    exporter.reset();
+    importer.reset();
+    boost::filesystem::remove_all(dir);
+}
+
 BOOST_AUTO_TEST_SUITE_END()
 
 }  // namespace test_RocksDBStorage
@@ -46,10 +46,20 @@ public:
     virtual void asyncSendMessage(dev::network::Message::Ptr, dev::network::Options = Options(),
         CallbackFunc = CallbackFunc()) override
     {}
+    bool asyncSendMessages(
+        std::vector<dev::network::Message::Ptr> const&, dev::network::Options) override
+    {
+        return true;
+    }
     void setMessageHandler(std::function<void(NetworkException,
             std::shared_ptr<dev::network::SessionFace>, dev::network::Message::Ptr)>) override
     {}
     bool actived() const override { return true; }
+    bool congested(dev::network::PacketPriority) const override { return false; }
+    dev::network::WriteQueueStats writeQueueStats() const override
+    {
+        return dev::network::WriteQueueStats();
+    }
 
     virtual std::shared_ptr<dev::network::SocketFace> socket() override
     {
@@ -111,6 +111,10 @@ public:
     };
 
     bool isConnected(NodeID const&) const override { return true; };
+    bool isCongested(NodeID const&, dev::network::PacketPriority) const override
+    {
+        return false;
+    };
 
     std::vector<std::string> topics() override { return std::vector<std::string>(); };
 
@@ -184,6 +184,32 @@ BOOST_AUTO_TEST_CASE(SyncReqBlockPacketTest)
     BOOST_CHECK(rlpReqBlock[1].toInt<unsigned>() == 0x40);
 }
 
+BOOST_AUTO_TEST_CASE(SyncSnapshotPacketTest)
+{
+    SyncSnapshotManifestPacket manifestPacket;
+    FakeBlock fakeBlock;
+    std::vector<h256> chunkHashes{h256(0x01), h256(0x02)};
+    manifestPacket.encode(int64_t(0x30), fakeBlock.getBlock().rlp(), chunkHashes);
+    auto msgPtr = manifestPacket.toMessage(0x03);
+    manifestPacket.decode(fakeSessionPtr, msgPtr);
+    auto rlpManifest = manifestPacket.rlp();
+    BOOST_CHECK(manifestPacket.packetType == SnapshotManifestPacket);
+    BOOST_CHECK(rlpManifest[0].toInt<int64_t>() == 0x30);
+    BOOST_CHECK(Block(rlpManifest[1].toBytes()).equalAll(fakeBlock.getBlock()));
+    BOOST_CHECK(rlpManifest[2].toVector<h256>() == chunkHashes);
+
+    SyncSnapshotChunkPacket chunkPacket;
+    bytes chunk{0x01, 0x02, 0x03};
+    chunkPacket.encode(int64_t(0x30), 0x01, chunk);
+    msgPtr = chunkPacket.toMessage(0x03);
+    chunkPacket.decode(fakeSessionPtr, msgPtr);
+    auto rlpChunk = chunkPacket.rlp();
+    BOOST_CHECK(chunkPacket.packetType == SnapshotChunkPacket);
+    BOOST_CHECK(rlpChunk[0].toInt<int64_t>() == 0x30);
+    BOOST_CHECK(rlpChunk[1].toInt<unsigned>() == 0x01);
+    BOOST_CHECK(rlpChunk[2].toBytes() == chunk);
+}
+
 BOOST_AUTO_TEST_SUITE_END()
 }  // namespace test
 }  // namespace dev
@@ -207,12 +207,17 @@ public:
         m_blockHash[p_block->blockHeader().hash()] = m_blockNumber;
         m_blockNumber += 1;
         m_totalTransactionCount += block.transactions().size();
+        m_onBlockCommitted(*p_block);
         return CommitResult::OK;
     }
 
     dev::bytes getCode(dev::Address) override { return bytes(); }
     bool checkAndBuildGenesisBlock(GenesisBlockParam&) override { return true; }
     std::string getSystemConfigByKey(std::string const&, int64_t) override { return "300000000"; };
+    dev::eth::LocalisedLogEntries getLogs(dev::eth::LogFilter const&) override
+    {
+        return dev::eth::LocalisedLogEntries();
+    }
     dev::h512s sealerList() override { return m_sealerList; }
     dev::h512s observerList() override { return m_observerList; }
     void setSealerList(dev::h512s const& sealers) { m_sealerList = sealers; }
@@ -0,0 +1,84 @@
+/*
+ * @CopyRight:
+ * FISCO-BCOS is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * FISCO-BCOS is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with FISCO-BCOS.  If not, see <http://www.gnu.org/licenses/>
+ * (c) 2016-2018 fisco-dev contributors.
+ */
+
+/**
+ * @brief: unit test for the sliding window of TransactionNonceCheck
+ * @file: TransactionNonceCheck.cpp
+ */
+#include "FakeBlockChain.h"
+#include <libdevcrypto/Common.h>
+#include <test/tools/libutils/TestOutputHelper.h>
+#include <boost/test/unit_test.hpp>
+using namespace dev;
+using namespace dev::txpool;
+using namespace dev::blockchain;
+namespace dev
+{
+namespace test
+{
+BOOST_FIXTURE_TEST_SUITE(TransactionNonceCheckTest, TestOutputHelperFixture)
+
+static Transaction fakeNonceTransaction(u256 const& _nonce)
+{
+    std::string str = "test transaction for TransactionNonceCheck";
+    bytes data(str.begin(), str.end());
+    Transaction fakeTx(u256(100), u256(0), u256(100000000), Address(), data, _nonce);
+    SignatureStruct sig =
+        dev::sign(KeyPair::create().secret(), fakeTx.sha3(WithoutSignature));
+    fakeTx.updateSignature(sig);
+    return fakeTx;
+}
+
+static void commitNonceBlock(std::shared_ptr<FakeBlockChain> _blockChain, u256 const& _nonce)
+{
+    Block block;
+    block.setTransactions(Transactions{fakeNonceTransaction(_nonce)});
+    _blockChain->commitBlock(block, nullptr);
+}
+
+BOOST_AUTO_TEST_CASE(slidingWindow)
+{
+    /// the nonces of the existing blocks are loaded from storage
+    auto blockChain = std::make_shared<FakeBlockChain>(2, 1);
+    TransactionNonceCheck checker(blockChain);
+    BOOST_CHECK_EQUAL(checker.blockNumber(), 1);
+    BOOST_CHECK(!checker.isNonceOk(fakeNonceTransaction(2)));
+
+    checker.setBlockLimit(2);
+    for (size_t i = 2; i <= 5; i++)
+    {
+        commitNonceBlock(blockChain, u256(100 + i));
+    }
+    /// updated by the committed blocks directly
+    BOOST_CHECK_EQUAL(checker.blockNumber(), 5);
+    BOOST_CHECK(checker.isNonceOk(fakeNonceTransaction(2)));
+    BOOST_CHECK(checker.isNonceOk(fakeNonceTransaction(102)));
+    BOOST_CHECK(!checker.isNonceOk(fakeNonceTransaction(103)));
+    BOOST_CHECK(!checker.isNonceOk(fakeNonceTransaction(105)));
+    BOOST_CHECK_EQUAL(checker.cacheSize(), 3);
+
+    /// nothing to read when the window is up to date
+    checker.updateCache(false);
+    BOOST_CHECK_EQUAL(checker.cacheSize(), 3);
+    checker.updateCache(true);
+    BOOST_CHECK_EQUAL(checker.cacheSize(), 3);
+    BOOST_CHECK(!checker.isNonceOk(fakeNonceTransaction(104)));
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+}  // namespace test
+}  // namespace dev
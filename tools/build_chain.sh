@@ -437,6 +437,8 @@ generate_config_ini()
     listen_ip=${listen_ip}
     channel_listen_port=$(( offset + port_start[1] ))
     jsonrpc_listen_port=$(( offset + port_start[2] ))
+    ; Prometheus scrape port on 127.0.0.1, 0 to disable
+    ;metrics_listen_port=0
 [p2p]
     listen_ip=0.0.0.0
     listen_port=$(( offset + port_start[0] ))
@@ -444,6 +446,8 @@ generate_config_ini()
     $ip_list
     ;enable/disable network compress
     ;enable_compress=true
+    ; threads handling the p2p requests of each group
+    ;dispatch_threads=4
 
 [certificate_blacklist]		
     ; crl.0 should be nodeid, nodeid's length is 128 
@@ -452,6 +456,8 @@ generate_config_ini()
 [group]
     group_data_path=data/
     group_config_path=${conf_path}/
+    ; MB, memory shared by the caches of all groups, 0 means each group uses its storage.max_capacity
+    memory_budget=0
 
 [network_security]
     ; directory the certificates located in
@@ -488,6 +494,8 @@ cipher_data_key=
     ; easylog config
     format=%level|%datetime{%Y-%M-%d %H:%m:%s:%g}|%msg
     log_flush_threshold=100
+    ; trace the block pipeline, dumped by the getBlockTraces rpc
+    ;enable_block_trace=false
 EOF
 }
 
@@ -545,6 +553,14 @@ function generate_group_ini()
     limit=150000
 [tx_execute]
     enable_parallel=${enable_parallel}
+    ; threads executing the call requests, separate from block execution
+    call_threads=4
+    ; learn the storage slots accessed by the contracts without parallel configs to execute
+    ; their transactions in parallel
+    enable_conflict_prediction=false
+[sync]
+    ; download a state snapshot instead of all blocks when far behind, rocksdb only
+    enable_snapshot_sync=false
 EOF
 }
 